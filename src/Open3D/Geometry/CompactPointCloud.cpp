@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/CompactPointCloud.h"
+
+#include "Open3D/Geometry/PointCloud.h"
+
+namespace open3d {
+
+namespace {
+
+/// Applies the affine map \param A (translation \param t) to the vectors
+/// stored in the three component arrays. Products are computed in double
+/// precision and rounded once when stored.
+void TransformComponents(const Eigen::Matrix3d &A,
+                         const Eigen::Vector3d &t,
+                         std::vector<float> &x,
+                         std::vector<float> &y,
+                         std::vector<float> &z) {
+    const int64_t n = (int64_t)x.size();
+    float *px = x.data();
+    float *py = y.data();
+    float *pz = z.data();
+    for (int64_t i = 0; i < n; i++) {
+        const double vx = px[i], vy = py[i], vz = pz[i];
+        px[i] = (float)(A(0, 0) * vx + A(0, 1) * vy + A(0, 2) * vz + t(0));
+        py[i] = (float)(A(1, 0) * vx + A(1, 1) * vy + A(1, 2) * vz + t(1));
+        pz[i] = (float)(A(2, 0) * vx + A(2, 1) * vy + A(2, 2) * vz + t(2));
+    }
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+CompactPointCloud::CompactPointCloud(const PointCloud &cloud)
+    : CompactPointCloud() {
+    Resize(cloud.points_.size(), cloud.HasNormals(), cloud.HasColors());
+    for (size_t i = 0; i < cloud.points_.size(); i++) {
+        SetPoint(i, cloud.points_[i]);
+    }
+    if (HasNormals()) {
+        for (size_t i = 0; i < cloud.normals_.size(); i++) {
+            SetNormal(i, cloud.normals_[i]);
+        }
+    }
+    if (HasColors()) {
+        for (size_t i = 0; i < cloud.colors_.size(); i++) {
+            SetColor(i, cloud.colors_[i]);
+        }
+    }
+}
+
+void CompactPointCloud::Clear() { Resize(0, false, false); }
+
+bool CompactPointCloud::IsEmpty() const { return !HasPoints(); }
+
+Eigen::Vector3d CompactPointCloud::GetMinBound() const {
+    if (!HasPoints()) {
+        return Eigen::Vector3d(0.0, 0.0, 0.0);
+    }
+    return Eigen::Vector3d(*std::min_element(x_.begin(), x_.end()),
+                           *std::min_element(y_.begin(), y_.end()),
+                           *std::min_element(z_.begin(), z_.end()));
+}
+
+Eigen::Vector3d CompactPointCloud::GetMaxBound() const {
+    if (!HasPoints()) {
+        return Eigen::Vector3d(0.0, 0.0, 0.0);
+    }
+    return Eigen::Vector3d(*std::max_element(x_.begin(), x_.end()),
+                           *std::max_element(y_.begin(), y_.end()),
+                           *std::max_element(z_.begin(), z_.end()));
+}
+
+CompactPointCloud &CompactPointCloud::Transform(
+        const Eigen::Matrix4d &transformation) {
+    const Eigen::Matrix3d A = transformation.block<3, 3>(0, 0);
+    TransformComponents(A, transformation.block<3, 1>(0, 3), x_, y_, z_);
+    if (HasNormals()) {
+        TransformComponents(A, Eigen::Vector3d::Zero(), nx_, ny_, nz_);
+    }
+    return *this;
+}
+
+CompactPointCloud &CompactPointCloud::Translate(
+        const Eigen::Vector3d &translation) {
+    TransformComponents(Eigen::Matrix3d::Identity(), translation, x_, y_, z_);
+    return *this;
+}
+
+CompactPointCloud &CompactPointCloud::Scale(const double scale) {
+    TransformComponents(Eigen::Matrix3d::Identity() * scale,
+                        Eigen::Vector3d::Zero(), x_, y_, z_);
+    return *this;
+}
+
+CompactPointCloud &CompactPointCloud::Rotate(const Eigen::Vector3d &rotation,
+                                             RotationType type) {
+    const Eigen::Matrix3d R = GetRotationMatrix(rotation, type);
+    TransformComponents(R, Eigen::Vector3d::Zero(), x_, y_, z_);
+    if (HasNormals()) {
+        TransformComponents(R, Eigen::Vector3d::Zero(), nx_, ny_, nz_);
+    }
+    return *this;
+}
+
+void CompactPointCloud::Resize(size_t num_points,
+                               bool has_normals,
+                               bool has_colors) {
+    x_.resize(num_points);
+    y_.resize(num_points);
+    z_.resize(num_points);
+    size_t num_normals = has_normals ? num_points : 0;
+    nx_.resize(num_normals);
+    ny_.resize(num_normals);
+    nz_.resize(num_normals);
+    size_t num_colors = has_colors ? num_points : 0;
+    r_.resize(num_colors);
+    g_.resize(num_colors);
+    b_.resize(num_colors);
+}
+
+void CompactPointCloud::NormalizeNormals() {
+    for (size_t i = 0; i < nx_.size(); i++) {
+        SetNormal(i, GetNormal(i).normalized());
+    }
+}
+
+void CompactPointCloud::PaintUniformColor(const Eigen::Vector3d &color) {
+    r_.assign(x_.size(), QuantizeColor(color(0)));
+    g_.assign(x_.size(), QuantizeColor(color(1)));
+    b_.assign(x_.size(), QuantizeColor(color(2)));
+}
+
+std::shared_ptr<PointCloud> CompactPointCloud::ToPointCloud() const {
+    auto cloud = std::make_shared<PointCloud>();
+    cloud->points_.resize(x_.size());
+    for (size_t i = 0; i < x_.size(); i++) {
+        cloud->points_[i] = GetPoint(i);
+    }
+    if (HasNormals()) {
+        cloud->normals_.resize(x_.size());
+        for (size_t i = 0; i < x_.size(); i++) {
+            cloud->normals_[i] = GetNormal(i);
+        }
+    }
+    if (HasColors()) {
+        cloud->colors_.resize(x_.size());
+        for (size_t i = 0; i < x_.size(); i++) {
+            cloud->colors_[i] = GetColor(i);
+        }
+    }
+    return cloud;
+}
+
+}  // namespace geometry
+}  // namespace open3d
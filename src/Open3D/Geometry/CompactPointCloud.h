@@ -0,0 +1,178 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Geometry/Geometry3D.h"
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+
+namespace open3d {
+
+namespace camera {
+class PinholeCameraIntrinsic;
+}
+
+namespace geometry {
+
+class Image;
+class PointCloud;
+class RGBDImage;
+
+/// Point cloud stored as a structure of arrays: one float32 array per
+/// coordinate and normal component, and one uint8 array per color channel.
+/// A point with normal and color takes 27 bytes instead of the 72 bytes of
+/// PointCloud, and the per-component loops vectorize. Colors are quantized to
+/// 8 bits; the accessors convert them from and to the [0, 1] range used by
+/// PointCloud.
+class CompactPointCloud : public Geometry3D {
+public:
+    CompactPointCloud()
+        : Geometry3D(Geometry::GeometryType::CompactPointCloud) {}
+    explicit CompactPointCloud(const PointCloud &cloud);
+    ~CompactPointCloud() override {}
+
+public:
+    void Clear() override;
+    bool IsEmpty() const override;
+    Eigen::Vector3d GetMinBound() const override;
+    Eigen::Vector3d GetMaxBound() const override;
+    CompactPointCloud &Transform(
+            const Eigen::Matrix4d &transformation) override;
+    CompactPointCloud &Translate(const Eigen::Vector3d &translation) override;
+    CompactPointCloud &Scale(const double scale) override;
+    CompactPointCloud &Rotate(const Eigen::Vector3d &rotation,
+                              RotationType type = RotationType::XYZ) override;
+
+public:
+    size_t GetNumberOfPoints() const { return x_.size(); }
+
+    bool HasPoints() const { return x_.size() > 0; }
+
+    bool HasNormals() const {
+        return x_.size() > 0 && nx_.size() == x_.size();
+    }
+
+    bool HasColors() const { return x_.size() > 0 && r_.size() == x_.size(); }
+
+    /// Resizes the point arrays to \param num_points. The normal and color
+    /// arrays are resized along with them if requested, and cleared otherwise.
+    void Resize(size_t num_points, bool has_normals, bool has_colors);
+
+    Eigen::Vector3d GetPoint(size_t i) const {
+        return Eigen::Vector3d(x_[i], y_[i], z_[i]);
+    }
+
+    void SetPoint(size_t i, const Eigen::Vector3d &point) {
+        x_[i] = (float)point(0);
+        y_[i] = (float)point(1);
+        z_[i] = (float)point(2);
+    }
+
+    Eigen::Vector3d GetNormal(size_t i) const {
+        return Eigen::Vector3d(nx_[i], ny_[i], nz_[i]);
+    }
+
+    void SetNormal(size_t i, const Eigen::Vector3d &normal) {
+        nx_[i] = (float)normal(0);
+        ny_[i] = (float)normal(1);
+        nz_[i] = (float)normal(2);
+    }
+
+    Eigen::Vector3d GetColor(size_t i) const {
+        return Eigen::Vector3d(r_[i], g_[i], b_[i]) / 255.0;
+    }
+
+    void SetColor(size_t i, const Eigen::Vector3d &color) {
+        r_[i] = QuantizeColor(color(0));
+        g_[i] = QuantizeColor(color(1));
+        b_[i] = QuantizeColor(color(2));
+    }
+
+    void NormalizeNormals();
+
+    /// Assigns each point in the CompactPointCloud the same color
+    /// \param color.
+    void PaintUniformColor(const Eigen::Vector3d &color);
+
+    /// Converts to a PointCloud with double precision points and normals.
+    std::shared_ptr<PointCloud> ToPointCloud() const;
+
+    static uint8_t QuantizeColor(double value) {
+        return (uint8_t)std::max(0.0, std::min(255.0, value * 255.0 + 0.5));
+    }
+
+public:
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> z_;
+    std::vector<float> nx_;
+    std::vector<float> ny_;
+    std::vector<float> nz_;
+    std::vector<uint8_t> r_;
+    std::vector<uint8_t> g_;
+    std::vector<uint8_t> b_;
+};
+
+/// Function to downsample \param input compact pointcloud into output compact
+/// pointcloud with a voxel, same as VoxelDownSample for PointCloud. Points are
+/// averaged in double precision before being stored back as float.
+std::shared_ptr<CompactPointCloud> VoxelDownSample(
+        const CompactPointCloud &input, double voxel_size);
+
+/// Function to compute the normals of a compact point cloud, same as
+/// EstimateNormals for PointCloud. Neighbors are searched in blocks of points
+/// so that the search results of the whole cloud are never held at once.
+bool EstimateNormals(
+        CompactPointCloud &cloud,
+        const KDTreeSearchParam &search_param = KDTreeSearchParamKNN());
+
+/// Factory function to create a compact pointcloud from a depth image and a
+/// camera model (PointCloudFactory.cpp), same as
+/// CreatePointCloudFromDepthImage but with float32 points.
+std::shared_ptr<CompactPointCloud> CreateCompactPointCloudFromDepthImage(
+        const Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic = Eigen::Matrix4d::Identity(),
+        double depth_scale = 1000.0,
+        double depth_trunc = 1000.0,
+        int stride = 1);
+
+/// Factory function to create a compact pointcloud from an RGB-D image and a
+/// camera model (PointCloudFactory.cpp), same as
+/// CreatePointCloudFromRGBDImage but with float32 points and 8-bit colors.
+std::shared_ptr<CompactPointCloud> CreateCompactPointCloudFromRGBDImage(
+        const RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic = Eigen::Matrix4d::Identity());
+
+}  // namespace geometry
+}  // namespace open3d
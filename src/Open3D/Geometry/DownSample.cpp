@@ -24,9 +24,16 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <unordered_map>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Geometry/CompactPointCloud.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
@@ -80,17 +87,10 @@ public:
     Eigen::Vector3d color_;
 };
 
-class point_cubic_id {
-public:
-    size_t point_id;
-    int cubic_id;
-};
-
 class AccumulatedPointForTrace : public AccumulatedPoint {
 public:
     void AddPoint(const PointCloud &cloud,
                   size_t index,
-                  int cubic_index,
                   bool approximate_class) {
         point_ += cloud.points_[index];
         if (cloud.HasNormals()) {
@@ -111,10 +111,6 @@ public:
                 color_ += cloud.colors_[index];
             }
         }
-        point_cubic_id new_id;
-        new_id.point_id = index;
-        new_id.cubic_id = cubic_index;
-        original_id.push_back(new_id);
         num_of_points_++;
     }
 
@@ -130,14 +126,185 @@ public:
         return Eigen::Vector3d(max_class, max_class, max_class);
     }
 
-    std::vector<point_cubic_id> GetOriginalID() { return original_id; }
-
 private:
-    // original point cloud id in higher resolution + its cubic id
-    std::vector<point_cubic_id> original_id;
     std::unordered_map<int, int> classes;
 };
 
+int GetNumberOfChunks() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/// Stable parallel LSD radix sort of (key, index) pairs on the lowest
+/// \param num_bits bits of the keys. The input is split into one chunk per
+/// thread; each pass builds per-chunk histograms, turns them into scatter
+/// offsets and scatters every chunk independently.
+void RadixSortKeysAndIndices(std::vector<uint64_t> &keys,
+                             std::vector<int> &indices,
+                             int num_bits) {
+    const int radix_bits = 8;
+    const int radix = 1 << radix_bits;
+    const int64_t n = (int64_t)keys.size();
+    const int num_chunks = GetNumberOfChunks();
+    std::vector<uint64_t> keys_tmp(n);
+    std::vector<int> indices_tmp(n);
+    std::vector<int64_t> offsets(num_chunks * radix);
+    for (int shift = 0; shift < num_bits; shift += radix_bits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < num_chunks; c++) {
+            int64_t *histogram = &offsets[c * radix];
+            for (int64_t i = n * c / num_chunks; i < n * (c + 1) / num_chunks;
+                 i++) {
+                histogram[(keys[i] >> shift) & (radix - 1)]++;
+            }
+        }
+        // Exclusive prefix sum in (digit, chunk) order keeps the sort stable.
+        int64_t sum = 0;
+        for (int d = 0; d < radix; d++) {
+            for (int c = 0; c < num_chunks; c++) {
+                int64_t count = offsets[c * radix + d];
+                offsets[c * radix + d] = sum;
+                sum += count;
+            }
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < num_chunks; c++) {
+            int64_t *offset = &offsets[c * radix];
+            for (int64_t i = n * c / num_chunks; i < n * (c + 1) / num_chunks;
+                 i++) {
+                int64_t dst = offset[(keys[i] >> shift) & (radix - 1)]++;
+                keys_tmp[dst] = keys[i];
+                indices_tmp[dst] = indices[i];
+            }
+        }
+        keys.swap(keys_tmp);
+        indices.swap(indices_tmp);
+    }
+}
+
+/// Sorts the \param n points returned by \param get_point(i) by voxel, with
+/// voxel coordinates measured from \param voxel_min_bound. On return
+/// \param indices holds the point indices grouped by voxel, ascending within
+/// each voxel, and \param voxel_begin the start of each voxel's run in
+/// \param indices (with a trailing sentinel equal to the number of points).
+/// Voxel coordinates are packed into 64-bit keys and radix sorted when the
+/// occupied grid fits, otherwise a comparison sort on the integer coordinates
+/// is used. Points may lie below \param voxel_min_bound.
+template <typename GetPoint>
+void ComputeSortedVoxelIndex(int64_t n,
+                             const GetPoint &get_point,
+                             const Eigen::Vector3d &voxel_min_bound,
+                             double voxel_size,
+                             std::vector<int> &indices,
+                             std::vector<int64_t> &voxel_begin) {
+    indices.resize(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    voxel_begin.clear();
+    if (n == 0) {
+        voxel_begin.push_back(0);
+        return;
+    }
+
+    std::vector<Eigen::Vector3i> voxel_indices(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < n; i++) {
+        Eigen::Vector3d ref_coord =
+                (get_point(i) - voxel_min_bound) / voxel_size;
+        voxel_indices[i] << int(floor(ref_coord(0))), int(floor(ref_coord(1))),
+                int(floor(ref_coord(2)));
+    }
+
+    // Number of bits needed to store each voxel coordinate, relative to the
+    // lowest occupied one.
+    const int num_chunks = GetNumberOfChunks();
+    std::vector<Eigen::Vector3i> chunk_min(num_chunks, voxel_indices[0]);
+    std::vector<Eigen::Vector3i> chunk_max(num_chunks, voxel_indices[0]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        for (int64_t i = n * c / num_chunks; i < n * (c + 1) / num_chunks;
+             i++) {
+            chunk_min[c] = chunk_min[c].cwiseMin(voxel_indices[i]);
+            chunk_max[c] = chunk_max[c].cwiseMax(voxel_indices[i]);
+        }
+    }
+    Eigen::Vector3i min_voxel = chunk_min[0];
+    Eigen::Vector3i max_voxel = chunk_max[0];
+    for (int c = 1; c < num_chunks; c++) {
+        min_voxel = min_voxel.cwiseMin(chunk_min[c]);
+        max_voxel = max_voxel.cwiseMax(chunk_max[c]);
+    }
+    int bits[3];
+    for (int c = 0; c < 3; c++) {
+        uint64_t max_coord = (uint64_t)((int64_t)max_voxel(c) - min_voxel(c));
+        bits[c] = 0;
+        while (bits[c] < 64 && (max_coord >> bits[c]) != 0) bits[c]++;
+    }
+    const int total_bits = bits[0] + bits[1] + bits[2];
+
+    std::vector<uint64_t> keys(n);
+    if (total_bits <= 64) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int64_t i = 0; i < n; i++) {
+            uint64_t v[3];
+            for (int c = 0; c < 3; c++) {
+                v[c] = (uint64_t)((int64_t)voxel_indices[i](c) - min_voxel(c));
+            }
+            keys[i] = v[0] | (v[1] << bits[0]) | (v[2] << (bits[0] + bits[1]));
+        }
+        voxel_indices.clear();
+        voxel_indices.shrink_to_fit();
+        RadixSortKeysAndIndices(keys, indices, total_bits);
+    } else {
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&voxel_indices](int a, int b) {
+                             const Eigen::Vector3i &va = voxel_indices[a];
+                             const Eigen::Vector3i &vb = voxel_indices[b];
+                             return std::make_tuple(va(2), va(1), va(0)) <
+                                    std::make_tuple(vb(2), vb(1), vb(0));
+                         });
+        uint64_t key = 0;
+        for (int64_t i = 0; i < n; i++) {
+            if (i > 0 && voxel_indices[indices[i]] !=
+                                 voxel_indices[indices[i - 1]]) {
+                key++;
+            }
+            keys[i] = key;
+        }
+    }
+
+    // Collect the run boundaries chunk by chunk.
+    std::vector<std::vector<int64_t>> chunk_begin(num_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        for (int64_t i = n * c / num_chunks; i < n * (c + 1) / num_chunks;
+             i++) {
+            if (i == 0 || keys[i] != keys[i - 1]) {
+                chunk_begin[c].push_back(i);
+            }
+        }
+    }
+    for (const auto &begin : chunk_begin) {
+        voxel_begin.insert(voxel_begin.end(), begin.begin(), begin.end());
+    }
+    voxel_begin.push_back(n);
+}
+
 }  // unnamed namespace
 
 namespace geometry {
@@ -243,7 +410,66 @@ std::shared_ptr<TriangleMesh> SelectDownSample(
 
 std::shared_ptr<PointCloud> VoxelDownSample(const PointCloud &input,
                                             double voxel_size) {
+    return std::get<0>(VoxelDownSampleAndIndex(input, voxel_size));
+}
+
+std::tuple<std::shared_ptr<PointCloud>, std::vector<int>>
+VoxelDownSampleAndIndex(const PointCloud &input, double voxel_size) {
     auto output = std::make_shared<PointCloud>();
+    std::vector<int> point_to_voxel;
+    if (voxel_size <= 0.0) {
+        utility::PrintDebug("[VoxelDownSample] voxel_size <= 0.\n");
+        return std::make_tuple(output, point_to_voxel);
+    }
+    Eigen::Vector3d voxel_size3 =
+            Eigen::Vector3d(voxel_size, voxel_size, voxel_size);
+    Eigen::Vector3d voxel_min_bound = input.GetMinBound() - voxel_size3 * 0.5;
+    Eigen::Vector3d voxel_max_bound = input.GetMaxBound() + voxel_size3 * 0.5;
+    if (voxel_size * std::numeric_limits<int>::max() <
+        (voxel_max_bound - voxel_min_bound).maxCoeff()) {
+        utility::PrintDebug("[VoxelDownSample] voxel_size is too small.\n");
+        return std::make_tuple(output, point_to_voxel);
+    }
+    std::vector<int> indices;
+    std::vector<int64_t> voxel_begin;
+    ComputeSortedVoxelIndex(
+            (int64_t)input.points_.size(),
+            [&input](int64_t i) { return input.points_[i]; }, voxel_min_bound,
+            voxel_size, indices, voxel_begin);
+
+    bool has_normals = input.HasNormals();
+    bool has_colors = input.HasColors();
+    int num_voxels = (int)voxel_begin.size() - 1;
+    output->points_.resize(num_voxels);
+    if (has_normals) output->normals_.resize(num_voxels);
+    if (has_colors) output->colors_.resize(num_voxels);
+    point_to_voxel.resize(input.points_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels; v++) {
+        AccumulatedPoint accpoint;
+        for (int64_t i = voxel_begin[v]; i < voxel_begin[v + 1]; i++) {
+            accpoint.AddPoint(input, indices[i]);
+            point_to_voxel[indices[i]] = v;
+        }
+        output->points_[v] = accpoint.GetAveragePoint();
+        if (has_normals) {
+            output->normals_[v] = accpoint.GetAverageNormal();
+        }
+        if (has_colors) {
+            output->colors_[v] = accpoint.GetAverageColor();
+        }
+    }
+    utility::PrintDebug(
+            "Pointcloud down sampled from %d points to %d points.\n",
+            (int)input.points_.size(), (int)output->points_.size());
+    return std::make_tuple(output, point_to_voxel);
+}
+
+std::shared_ptr<CompactPointCloud> VoxelDownSample(
+        const CompactPointCloud &input, double voxel_size) {
+    auto output = std::make_shared<CompactPointCloud>();
     if (voxel_size <= 0.0) {
         utility::PrintDebug("[VoxelDownSample] voxel_size <= 0.\n");
         return output;
@@ -257,32 +483,50 @@ std::shared_ptr<PointCloud> VoxelDownSample(const PointCloud &input,
         utility::PrintDebug("[VoxelDownSample] voxel_size is too small.\n");
         return output;
     }
-    std::unordered_map<Eigen::Vector3i, AccumulatedPoint,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxelindex_to_accpoint;
+    std::vector<int> indices;
+    std::vector<int64_t> voxel_begin;
+    ComputeSortedVoxelIndex(
+            (int64_t)input.GetNumberOfPoints(),
+            [&input](int64_t i) { return input.GetPoint(i); }, voxel_min_bound,
+            voxel_size, indices, voxel_begin);
 
-    Eigen::Vector3d ref_coord;
-    Eigen::Vector3i voxel_index;
-    for (int i = 0; i < (int)input.points_.size(); i++) {
-        ref_coord = (input.points_[i] - voxel_min_bound) / voxel_size;
-        voxel_index << int(floor(ref_coord(0))), int(floor(ref_coord(1))),
-                int(floor(ref_coord(2)));
-        voxelindex_to_accpoint[voxel_index].AddPoint(input, i);
-    }
     bool has_normals = input.HasNormals();
     bool has_colors = input.HasColors();
-    for (auto accpoint : voxelindex_to_accpoint) {
-        output->points_.push_back(accpoint.second.GetAveragePoint());
+    int num_voxels = (int)voxel_begin.size() - 1;
+    output->Resize(num_voxels, has_normals, has_colors);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels; v++) {
+        Eigen::Vector3d point(0.0, 0.0, 0.0);
+        Eigen::Vector3d normal(0.0, 0.0, 0.0);
+        Eigen::Vector3d color(0.0, 0.0, 0.0);
+        for (int64_t i = voxel_begin[v]; i < voxel_begin[v + 1]; i++) {
+            int index = indices[i];
+            point += input.GetPoint(index);
+            if (has_normals) {
+                Eigen::Vector3d n = input.GetNormal(index);
+                if (!std::isnan(n(0)) && !std::isnan(n(1)) &&
+                    !std::isnan(n(2))) {
+                    normal += n;
+                }
+            }
+            if (has_colors) {
+                color += input.GetColor(index);
+            }
+        }
+        double num_of_points = double(voxel_begin[v + 1] - voxel_begin[v]);
+        output->SetPoint(v, point / num_of_points);
         if (has_normals) {
-            output->normals_.push_back(accpoint.second.GetAverageNormal());
+            output->SetNormal(v, normal.normalized());
         }
         if (has_colors) {
-            output->colors_.push_back(accpoint.second.GetAverageColor());
+            output->SetColor(v, color / num_of_points);
         }
     }
     utility::PrintDebug(
             "Pointcloud down sampled from %d points to %d points.\n",
-            (int)input.points_.size(), (int)output->points_.size());
+            (int)input.GetNumberOfPoints(), num_voxels);
     return output;
 }
 
@@ -307,48 +551,51 @@ VoxelDownSampleAndTrace(const PointCloud &input,
         utility::PrintDebug("[VoxelDownSample] voxel_size is too small.\n");
         return std::make_tuple(output, cubic_id);
     }
-    std::unordered_map<Eigen::Vector3i, AccumulatedPointForTrace,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxelindex_to_accpoint;
-    int cid_temp[3] = {1, 2, 4};
-    for (size_t i = 0; i < input.points_.size(); i++) {
-        auto ref_coord = (input.points_[i] - voxel_min_bound) / voxel_size;
-        auto voxel_index = Eigen::Vector3i(int(floor(ref_coord(0))),
-                                           int(floor(ref_coord(1))),
-                                           int(floor(ref_coord(2))));
-        int cid = 0;
-        for (int c = 0; c < 3; c++) {
-            if ((ref_coord(c) - voxel_index(c)) >= 0.5) {
-                cid += cid_temp[c];
-            }
-        }
-        voxelindex_to_accpoint[voxel_index].AddPoint(input, i, cid,
-                                                     approximate_class);
-    }
+    std::vector<int> indices;
+    std::vector<int64_t> voxel_begin;
+    ComputeSortedVoxelIndex(
+            (int64_t)input.points_.size(),
+            [&input](int64_t i) { return input.points_[i]; }, voxel_min_bound,
+            voxel_size, indices, voxel_begin);
+
     bool has_normals = input.HasNormals();
     bool has_colors = input.HasColors();
-    int cnt = 0;
-    cubic_id.resize(voxelindex_to_accpoint.size(), 8);
+    int num_voxels = (int)voxel_begin.size() - 1;
+    output->points_.resize(num_voxels);
+    if (has_normals) output->normals_.resize(num_voxels);
+    if (has_colors) output->colors_.resize(num_voxels);
+    cubic_id.resize(num_voxels, 8);
     cubic_id.setConstant(-1);
-    for (auto accpoint : voxelindex_to_accpoint) {
-        output->points_.push_back(accpoint.second.GetAveragePoint());
+    int cid_temp[3] = {1, 2, 4};
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels; v++) {
+        AccumulatedPointForTrace accpoint;
+        for (int64_t i = voxel_begin[v]; i < voxel_begin[v + 1]; i++) {
+            int index = indices[i];
+            auto ref_coord =
+                    (input.points_[index] - voxel_min_bound) / voxel_size;
+            int cid = 0;
+            for (int c = 0; c < 3; c++) {
+                if ((ref_coord(c) - floor(ref_coord(c))) >= 0.5) {
+                    cid += cid_temp[c];
+                }
+            }
+            accpoint.AddPoint(input, index, approximate_class);
+            cubic_id(v, cid) = index;
+        }
+        output->points_[v] = accpoint.GetAveragePoint();
         if (has_normals) {
-            output->normals_.push_back(accpoint.second.GetAverageNormal());
+            output->normals_[v] = accpoint.GetAverageNormal();
         }
         if (has_colors) {
             if (approximate_class) {
-                output->colors_.push_back(accpoint.second.GetMaxClass());
+                output->colors_[v] = accpoint.GetMaxClass();
             } else {
-                output->colors_.push_back(accpoint.second.GetAverageColor());
+                output->colors_[v] = accpoint.GetAverageColor();
             }
         }
-        auto original_id = accpoint.second.GetOriginalID();
-        for (int i = 0; i < (int)original_id.size(); i++) {
-            size_t pid = original_id[i].point_id;
-            int cid = original_id[i].cubic_id;
-            cubic_id(cnt, cid) = pid;
-        }
-        cnt++;
     }
     utility::PrintDebug(
             "Pointcloud down sampled from %d points to %d points.\n",
@@ -445,17 +692,18 @@ RemoveStatisticalOutliers(const PointCloud &input,
             std::vector<double>(input.points_.size());
     std::vector<size_t> indices;
     size_t valid_distances = 0;
+    KDTreeSearchResult neighbors;
+    kdtree.SearchKNNBatch(input.points_, (int)nb_neighbors, neighbors);
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(static) reduction(+ : valid_distances)
 #endif
-    for (auto i = 0; i < input.points_.size(); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        kdtree.SearchKNN(input.points_[i], nb_neighbors, tmp_indices, dist);
+    for (int i = 0; i < (int)input.points_.size(); i++) {
+        const double *dist = neighbors.GetDistance2(i);
+        int count = neighbors.GetNeighborCount(i);
         double mean = -1;
-        if (dist.size() > 0) {
+        if (count > 0) {
             valid_distances++;
-            mean = std::accumulate(dist.begin(), dist.end(), 0.0) / dist.size();
+            mean = std::accumulate(dist, dist + count, 0.0) / count;
         }
         avg_distances[i] = mean;
     }
@@ -25,7 +25,9 @@
 // ----------------------------------------------------------------------------
 
 #include <Eigen/Eigenvalues>
+#include <algorithm>
 
+#include "Open3D/Geometry/CompactPointCloud.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
@@ -77,16 +79,18 @@ Eigen::Vector3d FastEigen3x3(const Eigen::Matrix3d &A) {
     }
 }
 
-Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
-                              const std::vector<int> &indices) {
-    if (indices.size() == 0) {
+template <typename GetPoint>
+Eigen::Vector3d ComputeNormal(const GetPoint &get_point,
+                              const int *indices,
+                              int num_indices) {
+    if (num_indices == 0) {
         return Eigen::Vector3d::Zero();
     }
     Eigen::Matrix3d covariance;
     Eigen::Matrix<double, 9, 1> cumulants;
     cumulants.setZero();
-    for (size_t i = 0; i < indices.size(); i++) {
-        const Eigen::Vector3d &point = cloud.points_[indices[i]];
+    for (int i = 0; i < num_indices; i++) {
+        const Eigen::Vector3d &point = get_point(indices[i]);
         cumulants(0) += point(0);
         cumulants(1) += point(1);
         cumulants(2) += point(2);
@@ -97,7 +101,7 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
         cumulants(7) += point(1) * point(2);
         cumulants(8) += point(2) * point(2);
     }
-    cumulants /= (double)indices.size();
+    cumulants /= (double)num_indices;
     covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
     covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
     covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
@@ -127,16 +131,19 @@ bool EstimateNormals(
     }
     KDTreeFlann kdtree;
     kdtree.SetGeometry(cloud);
+    KDTreeSearchResult neighbors;
+    kdtree.SearchBatch(cloud.points_, search_param, neighbors);
+    auto get_point = [&cloud](int i) -> const Eigen::Vector3d & {
+        return cloud.points_[i];
+    };
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)cloud.points_.size(); i++) {
-        std::vector<int> indices;
-        std::vector<double> distance2;
         Eigen::Vector3d normal;
-        if (kdtree.Search(cloud.points_[i], search_param, indices, distance2) >=
-            3) {
-            normal = ComputeNormal(cloud, indices);
+        if (neighbors.GetNeighborCount(i) >= 3) {
+            normal = ComputeNormal(get_point, neighbors.GetIndices(i),
+                                   neighbors.GetNeighborCount(i));
             if (normal.norm() == 0.0) {
                 if (has_normal) {
                     normal = cloud.normals_[i];
@@ -156,6 +163,57 @@ bool EstimateNormals(
     return true;
 }
 
+bool EstimateNormals(
+        CompactPointCloud &cloud,
+        const KDTreeSearchParam &search_param /* = KDTreeSearchParamKNN()*/) {
+    bool has_normal = cloud.HasNormals();
+    const int64_t num_points = (int64_t)cloud.GetNumberOfPoints();
+    if (has_normal == false) {
+        cloud.Resize(num_points, true, cloud.HasColors());
+    }
+    KDTreeFlann kdtree;
+    kdtree.SetGeometry(cloud);
+    auto get_point = [&cloud](int i) { return cloud.GetPoint(i); };
+    // Search and estimate block by block so that only the neighbors of one
+    // block are held at a time.
+    const int64_t block_size = 1 << 16;
+    std::vector<Eigen::Vector3d> queries;
+    KDTreeSearchResult neighbors;
+    for (int64_t begin = 0; begin < num_points; begin += block_size) {
+        const int64_t end = std::min(num_points, begin + block_size);
+        queries.resize(end - begin);
+        for (int64_t i = begin; i < end; i++) {
+            queries[i - begin] = cloud.GetPoint(i);
+        }
+        kdtree.SearchBatch(queries, search_param, neighbors);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int64_t i = begin; i < end; i++) {
+            const int64_t q = i - begin;
+            Eigen::Vector3d normal;
+            if (neighbors.GetNeighborCount(q) >= 3) {
+                normal = ComputeNormal(get_point, neighbors.GetIndices(q),
+                                       neighbors.GetNeighborCount(q));
+                if (normal.norm() == 0.0) {
+                    if (has_normal) {
+                        normal = cloud.GetNormal(i);
+                    } else {
+                        normal = Eigen::Vector3d(0.0, 0.0, 1.0);
+                    }
+                }
+                if (has_normal && normal.dot(cloud.GetNormal(i)) < 0.0) {
+                    normal *= -1.0;
+                }
+                cloud.SetNormal(i, normal);
+            } else {
+                cloud.SetNormal(i, Eigen::Vector3d(0.0, 0.0, 1.0));
+            }
+        }
+    }
+    return true;
+}
+
 bool OrientNormalsToAlignWithDirection(
         PointCloud &cloud, const Eigen::Vector3d &orientation_reference
         /* = Eigen::Vector3d(0.0, 0.0, 1.0)*/) {
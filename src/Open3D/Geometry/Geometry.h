@@ -43,7 +43,9 @@ public:
 
         PointCloudCuda = 8,
         TriangleMeshCuda = 9,
-        ImageCuda = 10
+        ImageCuda = 10,
+
+        CompactPointCloud = 11
     };
 
 public:
@@ -26,6 +26,8 @@
 
 #include "Open3D/Geometry/Image.h"
 
+#include <algorithm>
+
 namespace {
 /// Isotropic 2D kernels are separable:
 /// two 1D kernels are applied in x and y direction.
@@ -35,6 +37,128 @@ const std::vector<double> Gaussian7 = {0.03125, 0.109375, 0.21875, 0.28125,
                                        0.21875, 0.109375, 0.03125};
 const std::vector<double> Sobel31 = {-1.0, 0.0, 1.0};
 const std::vector<double> Sobel32 = {1.0, 2.0, 1.0};
+
+/// Separable filters work on whole rows of a single-channel float image: the
+/// horizontal pass pads a row with replicated border pixels and the vertical
+/// pass clamps the source row indices, so that the inner loops run over
+/// contiguous memory without any per-pixel boundary test and can be
+/// vectorized by the compiler. As in the original implementation, every tap is
+/// multiplied in float and accumulated in double.
+inline float *RowAt(open3d::geometry::Image &image, int v) {
+    return (float *)image.data_.data() + (size_t)v * image.width_;
+}
+
+bool IsFloatImage(const open3d::geometry::ImageView &image) {
+    return image.num_of_channels_ == 1 && image.bytes_per_channel_ == 4;
+}
+
+std::vector<float> ConvertKernelToFloat(const std::vector<double> &kernel) {
+    return std::vector<float>(kernel.begin(), kernel.end());
+}
+
+void AccumulateRow(const float *src,
+                   int width,
+                   float weight,
+                   std::vector<double> &sum) {
+    double *s = sum.data();
+    for (int u = 0; u < width; u++) {
+        s[u] += src[u] * weight;
+    }
+}
+
+void StoreRow(const std::vector<double> &sum, int width, float *dst) {
+    const double *s = sum.data();
+    for (int u = 0; u < width; u++) {
+        dst[u] = (float)s[u];
+    }
+}
+
+void FilterRowHorizontal(const float *src,
+                         int width,
+                         const std::vector<float> &kernel,
+                         std::vector<float> &padded,
+                         std::vector<double> &sum,
+                         float *dst) {
+    const int half_kernel_size = (int)kernel.size() / 2;
+    padded.resize(width + 2 * half_kernel_size);
+    std::fill(padded.begin(), padded.begin() + half_kernel_size, src[0]);
+    std::copy(src, src + width, padded.begin() + half_kernel_size);
+    std::fill(padded.begin() + half_kernel_size + width, padded.end(),
+              src[width - 1]);
+    sum.assign(width, 0.0);
+    for (size_t i = 0; i < kernel.size(); i++) {
+        AccumulateRow(padded.data() + i, width, kernel[i], sum);
+    }
+    StoreRow(sum, width, dst);
+}
+
+void FilterRowVertical(const open3d::geometry::Image &input,
+                       int v,
+                       const std::vector<float> &kernel,
+                       std::vector<double> &sum,
+                       float *dst) {
+    const int half_kernel_size = (int)kernel.size() / 2;
+    const float *data = (const float *)input.data_.data();
+    sum.assign(input.width_, 0.0);
+    for (int i = -half_kernel_size; i <= half_kernel_size; i++) {
+        int v_shift = std::min(std::max(v + i, 0), input.height_ - 1);
+        AccumulateRow(data + (size_t)v_shift * input.width_, input.width_,
+                      kernel[i + half_kernel_size], sum);
+    }
+    StoreRow(sum, input.width_, dst);
+}
+
+void FilterImageHorizontal(const open3d::geometry::ImageView &input,
+                           const std::vector<float> &kernel,
+                           open3d::geometry::Image &output) {
+    output.PrepareImage(input.width_, input.height_, 1, 4);
+    if (input.width_ <= 0) {
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::vector<float> padded;
+        std::vector<double> sum;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int v = 0; v < input.height_; v++) {
+            FilterRowHorizontal(input.RowAt<float>(v), input.width_, kernel,
+                                padded, sum, RowAt(output, v));
+        }
+#ifdef _OPENMP
+    }
+#endif
+}
+
+bool GetFilterKernels(open3d::geometry::Image::FilterType type,
+                      const std::vector<double> *&dx,
+                      const std::vector<double> *&dy) {
+    using FilterType = open3d::geometry::Image::FilterType;
+    switch (type) {
+        case FilterType::Gaussian3:
+            dx = dy = &Gaussian3;
+            return true;
+        case FilterType::Gaussian5:
+            dx = dy = &Gaussian5;
+            return true;
+        case FilterType::Gaussian7:
+            dx = dy = &Gaussian7;
+            return true;
+        case FilterType::Sobel3Dx:
+            dx = &Sobel31;
+            dy = &Sobel32;
+            return true;
+        case FilterType::Sobel3Dy:
+            dx = &Sobel32;
+            dy = &Sobel31;
+            return true;
+        default:
+            return false;
+    }
+}
 }  // unnamed namespace
 
 namespace open3d {
@@ -111,17 +235,27 @@ std::shared_ptr<Image> ConvertDepthToFloatImage(
         const Image &depth,
         double depth_scale /* = 1000.0*/,
         double depth_trunc /* = 3.0*/) {
+    auto output = std::make_shared<Image>();
+    ConvertDepthToFloatImage(depth, *output, depth_scale, depth_trunc);
+    return output;
+}
+
+bool ConvertDepthToFloatImage(const ImageView &depth,
+                              Image &output,
+                              double depth_scale /* = 1000.0*/,
+                              double depth_trunc /* = 3.0*/) {
     // don't need warning message about image type
     // as we call CreateFloatImageFromImage
-    auto output = CreateFloatImageFromImage(depth);
-    for (int y = 0; y < output->height_; y++) {
-        for (int x = 0; x < output->width_; x++) {
-            float *p = PointerAt<float>(*output, x, y);
-            *p /= (float)depth_scale;
-            if (*p >= depth_trunc) *p = 0.0f;
-        }
+    if (!CreateFloatImageFromImage(depth, output)) {
+        return false;
     }
-    return output;
+    float *p = (float *)output.data_.data();
+    const size_t num_pixels = (size_t)output.width_ * output.height_;
+    for (size_t i = 0; i < num_pixels; i++) {
+        p[i] /= (float)depth_scale;
+        if (p[i] >= depth_trunc) p[i] = 0.0f;
+    }
+    return true;
 }
 
 void ClipIntensityImage(Image &input,
@@ -157,93 +291,165 @@ void LinearTransformImage(Image &input,
     }
 }
 
+std::shared_ptr<Image> CreateImageFromImageView(const ImageView &view) {
+    auto output = std::make_shared<Image>();
+    if (view.IsEmpty()) {
+        return output;
+    }
+    output->PrepareImage(view.width_, view.height_, view.num_of_channels_,
+                         view.bytes_per_channel_);
+    const int bytes_per_line = output->BytesPerLine();
+    for (int v = 0; v < view.height_; v++) {
+        const uint8_t *src = view.RowAt<uint8_t>(v);
+        std::copy(src, src + bytes_per_line,
+                  output->data_.data() + (size_t)v * bytes_per_line);
+    }
+    return output;
+}
+
+ImageView ImageView::Crop(int u, int v, int width, int height) const {
+    int u0 = std::min(std::max(u, 0), width_);
+    int v0 = std::min(std::max(v, 0), height_);
+    int u1 = std::min(std::max(u + width, u0), width_);
+    int v1 = std::min(std::max(v + height, v0), height_);
+    return ImageView(data_ == nullptr
+                             ? nullptr
+                             : data_ + (size_t)v0 * stride_ +
+                                       u0 * num_of_channels_ *
+                                               bytes_per_channel_,
+                     u1 - u0, v1 - v0, num_of_channels_, bytes_per_channel_,
+                     stride_);
+}
+
 std::shared_ptr<Image> DownsampleImage(const Image &input) {
     auto output = std::make_shared<Image>();
-    if (input.num_of_channels_ != 1 || input.bytes_per_channel_ != 4) {
+    DownsampleImage(input, *output);
+    return output;
+}
+
+bool DownsampleImage(const ImageView &input, Image &output) {
+    if (!IsFloatImage(input)) {
         utility::PrintWarning("[DownsampleImage] Unsupported image format.\n");
-        return output;
+        return false;
     }
     int half_width = (int)floor((double)input.width_ / 2.0);
     int half_height = (int)floor((double)input.height_ / 2.0);
-    output->PrepareImage(half_width, half_height, 1, 4);
+    output.PrepareImage(half_width, half_height, 1, 4);
 
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
-    for (int y = 0; y < output->height_; y++) {
-        for (int x = 0; x < output->width_; x++) {
-            float *p1 = PointerAt<float>(input, x * 2, y * 2);
-            float *p2 = PointerAt<float>(input, x * 2 + 1, y * 2);
-            float *p3 = PointerAt<float>(input, x * 2, y * 2 + 1);
-            float *p4 = PointerAt<float>(input, x * 2 + 1, y * 2 + 1);
-            float *p = PointerAt<float>(*output, x, y);
-            *p = (*p1 + *p2 + *p3 + *p4) / 4.0f;
+    for (int y = 0; y < output.height_; y++) {
+        const float *p0 = input.RowAt<float>(y * 2);
+        const float *p1 = input.RowAt<float>(y * 2 + 1);
+        float *p = RowAt(output, y);
+        for (int x = 0; x < output.width_; x++) {
+            p[x] = (p0[x * 2] + p0[x * 2 + 1] + p1[x * 2] + p1[x * 2 + 1]) /
+                   4.0f;
         }
     }
-    return output;
+    return true;
 }
 
-std::shared_ptr<Image> FilterHorizontalImage(
-        const Image &input, const std::vector<double> &kernel) {
+std::shared_ptr<Image> FilterAndDownsampleImage(const Image &input,
+                                                Image::FilterType type) {
     auto output = std::make_shared<Image>();
-    if (input.num_of_channels_ != 1 || input.bytes_per_channel_ != 4 ||
-        kernel.size() % 2 != 1) {
+    FilterAndDownsampleImage(input, type, *output);
+    return output;
+}
+
+bool FilterAndDownsampleImage(const ImageView &input,
+                              Image::FilterType type,
+                              Image &output) {
+    if (!IsFloatImage(input)) {
         utility::PrintWarning(
-                "[FilterHorizontalImage] Unsupported image format or kernel "
-                "size.\n");
-        return output;
+                "[FilterAndDownsampleImage] Unsupported image format.\n");
+        return false;
+    }
+    const std::vector<double> *dx, *dy;
+    if (!GetFilterKernels(type, dx, dy)) {
+        utility::PrintWarning(
+                "[FilterAndDownsampleImage] Unsupported filter type.\n");
+        return false;
+    }
+    int half_width = (int)floor((double)input.width_ / 2.0);
+    int half_height = (int)floor((double)input.height_ / 2.0);
+    output.PrepareImage(half_width, half_height, 1, 4);
+    if (half_width == 0 || half_height == 0) {
+        return true;
     }
-    output->PrepareImage(input.width_, input.height_, 1, 4);
 
-    const int half_kernel_size = (int)(floor((double)kernel.size() / 2.0));
+    Image horizontal;
+    FilterImageHorizontal(input, ConvertKernelToFloat(*dx), horizontal);
+    const std::vector<float> kernel = ConvertKernelToFloat(*dy);
+    // The two filtered rows averaged into an output row are produced on the
+    // fly, the full resolution filtered image is never stored.
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel
+    {
 #endif
-    for (int y = 0; y < input.height_; y++) {
-        for (int x = 0; x < input.width_; x++) {
-            float *po = PointerAt<float>(*output, x, y, 0);
-            double temp = 0;
-            for (int i = -half_kernel_size; i <= half_kernel_size; i++) {
-                int x_shift = x + i;
-                if (x_shift < 0) x_shift = 0;
-                if (x_shift > input.width_ - 1) x_shift = input.width_ - 1;
-                float *pi = PointerAt<float>(input, x_shift, y, 0);
-                temp += (*pi * (float)kernel[i + half_kernel_size]);
+        std::vector<double> sum;
+        std::vector<float> row0(input.width_), row1(input.width_);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int y = 0; y < half_height; y++) {
+            FilterRowVertical(horizontal, y * 2, kernel, sum, row0.data());
+            FilterRowVertical(horizontal, y * 2 + 1, kernel, sum, row1.data());
+            const float *p0 = row0.data();
+            const float *p1 = row1.data();
+            float *p = RowAt(output, y);
+            for (int x = 0; x < half_width; x++) {
+                p[x] = (p0[x * 2] + p0[x * 2 + 1] + p1[x * 2] +
+                        p1[x * 2 + 1]) /
+                       4.0f;
             }
-            *po = (float)temp;
         }
+#ifdef _OPENMP
     }
+#endif
+    return true;
+}
+
+std::shared_ptr<Image> FilterHorizontalImage(
+        const Image &input, const std::vector<double> &kernel) {
+    auto output = std::make_shared<Image>();
+    FilterHorizontalImage(input, kernel, *output);
     return output;
 }
 
+bool FilterHorizontalImage(const ImageView &input,
+                           const std::vector<double> &kernel,
+                           Image &output) {
+    if (!IsFloatImage(input) || kernel.size() % 2 != 1) {
+        utility::PrintWarning(
+                "[FilterHorizontalImage] Unsupported image format or kernel "
+                "size.\n");
+        return false;
+    }
+    FilterImageHorizontal(input, ConvertKernelToFloat(kernel), output);
+    return true;
+}
+
 std::shared_ptr<Image> FilterImage(const Image &input, Image::FilterType type) {
     auto output = std::make_shared<Image>();
-    if (input.num_of_channels_ != 1 || input.bytes_per_channel_ != 4) {
+    FilterImage(input, type, *output);
+    return output;
+}
+
+bool FilterImage(const ImageView &input,
+                 Image::FilterType type,
+                 Image &output) {
+    if (!IsFloatImage(input)) {
         utility::PrintWarning("[FilterImage] Unsupported image format.\n");
-        return output;
+        return false;
     }
-
-    switch (type) {
-        case Image::FilterType::Gaussian3:
-            output = FilterImage(input, Gaussian3, Gaussian3);
-            break;
-        case Image::FilterType::Gaussian5:
-            output = FilterImage(input, Gaussian5, Gaussian5);
-            break;
-        case Image::FilterType::Gaussian7:
-            output = FilterImage(input, Gaussian7, Gaussian7);
-            break;
-        case Image::FilterType::Sobel3Dx:
-            output = FilterImage(input, Sobel31, Sobel32);
-            break;
-        case Image::FilterType::Sobel3Dy:
-            output = FilterImage(input, Sobel32, Sobel31);
-            break;
-        default:
-            utility::PrintWarning("[FilterImage] Unsupported filter type.\n");
-            break;
+    const std::vector<double> *dx, *dy;
+    if (!GetFilterKernels(type, dx, dy)) {
+        utility::PrintWarning("[FilterImage] Unsupported filter type.\n");
+        return false;
     }
-    return output;
+    return FilterImage(input, *dx, *dy, output);
 }
 
 ImagePyramid FilterImagePyramid(const ImagePyramid &input,
@@ -260,37 +466,71 @@ std::shared_ptr<Image> FilterImage(const Image &input,
                                    const std::vector<double> &dx,
                                    const std::vector<double> &dy) {
     auto output = std::make_shared<Image>();
-    if (input.num_of_channels_ != 1 || input.bytes_per_channel_ != 4) {
+    FilterImage(input, dx, dy, *output);
+    return output;
+}
+
+bool FilterImage(const ImageView &input,
+                 const std::vector<double> &dx,
+                 const std::vector<double> &dy,
+                 Image &output) {
+    if (!IsFloatImage(input)) {
         utility::PrintWarning("[FilterImage] Unsupported image format.\n");
-        return output;
+        return false;
+    }
+    if (dx.size() % 2 != 1 || dy.size() % 2 != 1) {
+        utility::PrintWarning("[FilterImage] Unsupported kernel size.\n");
+        return false;
     }
 
-    auto temp1 = FilterHorizontalImage(input, dx);
-    auto temp2 = FlipImage(*temp1);
-    auto temp3 = FilterHorizontalImage(*temp2, dy);
-    auto temp4 = FlipImage(*temp3);
-    return temp4;
+    Image horizontal;
+    FilterImageHorizontal(input, ConvertKernelToFloat(dx), horizontal);
+    output.PrepareImage(input.width_, input.height_, 1, 4);
+    if (input.width_ <= 0) {
+        return true;
+    }
+    const std::vector<float> kernel = ConvertKernelToFloat(dy);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::vector<double> sum;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int y = 0; y < input.height_; y++) {
+            FilterRowVertical(horizontal, y, kernel, sum, RowAt(output, y));
+        }
+#ifdef _OPENMP
+    }
+#endif
+    return true;
 }
 
 std::shared_ptr<Image> FlipImage(const Image &input) {
     auto output = std::make_shared<Image>();
-    if (input.num_of_channels_ != 1 || input.bytes_per_channel_ != 4) {
+    FlipImage(input, *output);
+    return output;
+}
+
+bool FlipImage(const ImageView &input, Image &output) {
+    if (!IsFloatImage(input)) {
         utility::PrintWarning("[FilpImage] Unsupported image format.\n");
-        return output;
+        return false;
     }
-    output->PrepareImage(input.height_, input.width_, 1, 4);
+    output.PrepareImage(input.height_, input.width_, 1, 4);
 
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int y = 0; y < input.height_; y++) {
+        const float *pi = input.RowAt<float>(y);
+        float *po = (float *)output.data_.data() + y;
         for (int x = 0; x < input.width_; x++) {
-            float *pi = PointerAt<float>(input, x, y, 0);
-            float *po = PointerAt<float>(*output, y, x, 0);
-            *po = *pi;
+            po[(size_t)x * input.height_] = pi[x];
         }
     }
-    return output;
+    return true;
 }
 
 std::shared_ptr<Image> DilateImage(const Image &input,
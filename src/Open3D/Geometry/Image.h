@@ -105,6 +105,65 @@ public:
     std::vector<uint8_t> data_;
 };
 
+/// A non-owning view of an Image, or of a rectangular region of it. Rows are
+/// stride_ bytes apart, so that crops are represented without copying pixels.
+/// The view is valid only as long as the viewed buffer is neither destroyed
+/// nor reallocated.
+class ImageView {
+public:
+    ImageView() {}
+    ImageView(const Image &image)
+        : data_(image.data_.data()),
+          width_(image.width_),
+          height_(image.height_),
+          num_of_channels_(image.num_of_channels_),
+          bytes_per_channel_(image.bytes_per_channel_),
+          stride_(image.BytesPerLine()) {}
+    ImageView(const uint8_t *data,
+              int width,
+              int height,
+              int num_of_channels,
+              int bytes_per_channel,
+              int stride)
+        : data_(data),
+          width_(width),
+          height_(height),
+          num_of_channels_(num_of_channels),
+          bytes_per_channel_(bytes_per_channel),
+          stride_(stride) {}
+
+public:
+    bool IsEmpty() const {
+        return data_ == nullptr || width_ <= 0 || height_ <= 0;
+    }
+
+    int BytesPerLine() const {
+        return width_ * num_of_channels_ * bytes_per_channel_;
+    }
+
+    template <typename T>
+    const T *RowAt(int v) const {
+        return (const T *)(data_ + (size_t)v * stride_);
+    }
+
+    template <typename T>
+    const T *PointerAt(int u, int v, int ch = 0) const {
+        return RowAt<T>(v) + u * num_of_channels_ + ch;
+    }
+
+    /// Function to view the region [u, u + width) x [v, v + height), clipped
+    /// to the boundary of this view
+    ImageView Crop(int u, int v, int width, int height) const;
+
+public:
+    const uint8_t *data_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    int num_of_channels_ = 0;
+    int bytes_per_channel_ = 0;
+    int stride_ = 0;
+};
+
 /// Factory function to create a float image composed of multipliers that
 /// convert depth values into camera distances (ImageFactory.cpp)
 /// The multiplier function M(u,v) is defined as:
@@ -128,26 +187,75 @@ T *PointerAt(const Image &image, int u, int v);
 template <typename T>
 T *PointerAt(const Image &image, int u, int v, int ch);
 
+/// Function to copy the pixels of an ImageView into a new Image
+std::shared_ptr<Image> CreateImageFromImageView(const ImageView &view);
+
+/// The functions below that take an ImageView input and an Image &output
+/// write their result into \param output, reusing its buffer when it is large
+/// enough, and return false if the input is not supported. Calling them
+/// repeatedly with the same output image avoids allocating per call. The
+/// output must not be the image viewed by the input.
+
+/// Output parameter version of CreateFloatImageFromImage
+bool CreateFloatImageFromImage(
+        const ImageView &image,
+        Image &output,
+        Image::ColorToIntensityConversionType type =
+                Image::ColorToIntensityConversionType::Weighted);
+
 std::shared_ptr<Image> ConvertDepthToFloatImage(const Image &depth,
                                                 double depth_scale = 1000.0,
                                                 double depth_trunc = 3.0);
 
+bool ConvertDepthToFloatImage(const ImageView &depth,
+                              Image &output,
+                              double depth_scale = 1000.0,
+                              double depth_trunc = 3.0);
+
 std::shared_ptr<Image> FlipImage(const Image &input);
 
+bool FlipImage(const ImageView &input, Image &output);
+
 /// Function to filter image with pre-defined filtering type
 std::shared_ptr<Image> FilterImage(const Image &input, Image::FilterType type);
 
+bool FilterImage(const ImageView &input,
+                 Image::FilterType type,
+                 Image &output);
+
 /// Function to filter image with arbitrary dx, dy separable filters
 std::shared_ptr<Image> FilterImage(const Image &input,
                                    const std::vector<double> &dx,
                                    const std::vector<double> &dy);
 
+bool FilterImage(const ImageView &input,
+                 const std::vector<double> &dx,
+                 const std::vector<double> &dy,
+                 Image &output);
+
 std::shared_ptr<Image> FilterHorizontalImage(const Image &input,
                                              const std::vector<double> &kernel);
 
+bool FilterHorizontalImage(const ImageView &input,
+                           const std::vector<double> &kernel,
+                           Image &output);
+
 /// Function to 2x image downsample using simple 2x2 averaging
 std::shared_ptr<Image> DownsampleImage(const Image &input);
 
+bool DownsampleImage(const ImageView &input, Image &output);
+
+/// Function to filter image with pre-defined filtering type and 2x downsample
+/// the result using 2x2 averaging. Same result as
+/// DownsampleImage(*FilterImage(input, type)), but the full resolution
+/// filtered image is never stored.
+std::shared_ptr<Image> FilterAndDownsampleImage(const Image &input,
+                                                Image::FilterType type);
+
+bool FilterAndDownsampleImage(const ImageView &input,
+                              Image::FilterType type,
+                              Image &output);
+
 /// Function to dilate 8bit mask map
 std::shared_ptr<Image> DilateImage(const Image &input,
                                    int half_kernel_size = 1);
@@ -181,6 +289,14 @@ ImagePyramid CreateImagePyramid(const Image &image,
                                 size_t num_of_levels,
                                 bool with_gaussian_filter = true);
 
+/// Function to create image pyramid in place. Levels already held by
+/// \param pyramid are overwritten and their buffers reused, unless they are
+/// shared with another owner, in which case a new level is allocated.
+bool CreateImagePyramid(const ImageView &image,
+                        size_t num_of_levels,
+                        bool with_gaussian_filter,
+                        ImagePyramid &pyramid);
+
 /// Function to create a depthmap boundary mask from depth image
 std::shared_ptr<Image> CreateDepthBoundaryMask(
         const Image &depth_image_input,
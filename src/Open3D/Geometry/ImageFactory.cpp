@@ -24,6 +24,8 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
 
@@ -64,61 +66,75 @@ std::shared_ptr<Image> CreateFloatImageFromImage(
         const Image &image,
         Image::ColorToIntensityConversionType type /* = WEIGHTED*/) {
     auto fimage = std::make_shared<Image>();
+    CreateFloatImageFromImage(image, *fimage, type);
+    return fimage;
+}
+
+bool CreateFloatImageFromImage(
+        const ImageView &image,
+        Image &output,
+        Image::ColorToIntensityConversionType type /* = WEIGHTED*/) {
     if (image.IsEmpty()) {
-        return fimage;
+        output.Clear();
+        return false;
     }
-    fimage->PrepareImage(image.width_, image.height_, 1, 4);
-    for (int i = 0; i < image.height_ * image.width_; i++) {
-        float *p = (float *)(fimage->data_.data() + i * 4);
-        const uint8_t *pi =
-                image.data_.data() +
-                i * image.num_of_channels_ * image.bytes_per_channel_;
-        if (image.num_of_channels_ == 1) {
-            // grayscale image
-            if (image.bytes_per_channel_ == 1) {
-                *p = (float)(*pi) / 255.0f;
-            } else if (image.bytes_per_channel_ == 2) {
-                const uint16_t *pi16 = (const uint16_t *)pi;
-                *p = (float)(*pi16);
-            } else if (image.bytes_per_channel_ == 4) {
-                const float *pf = (const float *)pi;
-                *p = *pf;
-            }
-        } else if (image.num_of_channels_ == 3) {
-            if (image.bytes_per_channel_ == 1) {
-                if (type == Image::ColorToIntensityConversionType::Equal) {
-                    *p = ((float)(pi[0]) + (float)(pi[1]) + (float)(pi[2])) /
-                         3.0f / 255.0f;
-                } else if (type ==
-                           Image::ColorToIntensityConversionType::Weighted) {
-                    *p = (0.2990f * (float)(pi[0]) + 0.5870f * (float)(pi[1]) +
-                          0.1140f * (float)(pi[2])) /
-                         255.0f;
-                }
-            } else if (image.bytes_per_channel_ == 2) {
-                const uint16_t *pi16 = (const uint16_t *)pi;
-                if (type == Image::ColorToIntensityConversionType::Equal) {
-                    *p = ((float)(pi16[0]) + (float)(pi16[1]) +
-                          (float)(pi16[2])) /
-                         3.0f;
-                } else if (type ==
-                           Image::ColorToIntensityConversionType::Weighted) {
-                    *p = (0.2990f * (float)(pi16[0]) +
-                          0.5870f * (float)(pi16[1]) +
-                          0.1140f * (float)(pi16[2]));
+    output.PrepareImage(image.width_, image.height_, 1, 4);
+    const int pixel_bytes = image.num_of_channels_ * image.bytes_per_channel_;
+    for (int v = 0; v < image.height_; v++) {
+        const uint8_t *row = image.RowAt<uint8_t>(v);
+        float *p = (float *)output.data_.data() + (size_t)v * image.width_;
+        for (int u = 0; u < image.width_; u++, p++) {
+            const uint8_t *pi = row + u * pixel_bytes;
+            if (image.num_of_channels_ == 1) {
+                // grayscale image
+                if (image.bytes_per_channel_ == 1) {
+                    *p = (float)(*pi) / 255.0f;
+                } else if (image.bytes_per_channel_ == 2) {
+                    const uint16_t *pi16 = (const uint16_t *)pi;
+                    *p = (float)(*pi16);
+                } else if (image.bytes_per_channel_ == 4) {
+                    const float *pf = (const float *)pi;
+                    *p = *pf;
                 }
-            } else if (image.bytes_per_channel_ == 4) {
-                const float *pf = (const float *)pi;
-                if (type == Image::ColorToIntensityConversionType::Equal) {
-                    *p = (pf[0] + pf[1] + pf[2]) / 3.0f;
-                } else if (type ==
-                           Image::ColorToIntensityConversionType::Weighted) {
-                    *p = (0.2990f * pf[0] + 0.5870f * pf[1] + 0.1140f * pf[2]);
+            } else if (image.num_of_channels_ == 3) {
+                if (image.bytes_per_channel_ == 1) {
+                    if (type == Image::ColorToIntensityConversionType::Equal) {
+                        *p = ((float)(pi[0]) + (float)(pi[1]) +
+                              (float)(pi[2])) /
+                             3.0f / 255.0f;
+                    } else if (type == Image::ColorToIntensityConversionType::
+                                               Weighted) {
+                        *p = (0.2990f * (float)(pi[0]) +
+                              0.5870f * (float)(pi[1]) +
+                              0.1140f * (float)(pi[2])) /
+                             255.0f;
+                    }
+                } else if (image.bytes_per_channel_ == 2) {
+                    const uint16_t *pi16 = (const uint16_t *)pi;
+                    if (type == Image::ColorToIntensityConversionType::Equal) {
+                        *p = ((float)(pi16[0]) + (float)(pi16[1]) +
+                              (float)(pi16[2])) /
+                             3.0f;
+                    } else if (type == Image::ColorToIntensityConversionType::
+                                               Weighted) {
+                        *p = (0.2990f * (float)(pi16[0]) +
+                              0.5870f * (float)(pi16[1]) +
+                              0.1140f * (float)(pi16[2]));
+                    }
+                } else if (image.bytes_per_channel_ == 4) {
+                    const float *pf = (const float *)pi;
+                    if (type == Image::ColorToIntensityConversionType::Equal) {
+                        *p = (pf[0] + pf[1] + pf[2]) / 3.0f;
+                    } else if (type == Image::ColorToIntensityConversionType::
+                                               Weighted) {
+                        *p = (0.2990f * pf[0] + 0.5870f * pf[1] +
+                              0.1140f * pf[2]);
+                    }
                 }
             }
         }
     }
-    return fimage;
+    return true;
 }
 
 template <typename T>
@@ -149,33 +165,48 @@ template std::shared_ptr<Image> CreateImageFromFloatImage<uint16_t>(
 ImagePyramid CreateImagePyramid(const Image &input,
                                 size_t num_of_levels,
                                 bool with_gaussian_filter /*= true*/) {
-    std::vector<std::shared_ptr<Image>> pyramid_image;
-    pyramid_image.clear();
+    ImagePyramid pyramid_image;
+    CreateImagePyramid(input, num_of_levels, with_gaussian_filter,
+                       pyramid_image);
+    return pyramid_image;
+}
+
+bool CreateImagePyramid(const ImageView &input,
+                        size_t num_of_levels,
+                        bool with_gaussian_filter,
+                        ImagePyramid &pyramid_image) {
     if ((input.num_of_channels_ != 1) || (input.bytes_per_channel_ != 4)) {
         utility::PrintWarning(
                 "[CreateImagePyramid] Unsupported image format.\n");
-        return pyramid_image;
+        pyramid_image.clear();
+        return false;
     }
 
-    for (int i = 0; i < num_of_levels; i++) {
+    pyramid_image.resize(num_of_levels);
+    for (size_t i = 0; i < num_of_levels; i++) {
+        if (!pyramid_image[i] || pyramid_image[i].use_count() > 1) {
+            pyramid_image[i] = std::make_shared<Image>();
+        }
+        Image &level = *pyramid_image[i];
         if (i == 0) {
-            std::shared_ptr<Image> input_copy_ptr = std::make_shared<Image>();
-            *input_copy_ptr = input;
-            pyramid_image.push_back(input_copy_ptr);
+            level.PrepareImage(input.width_, input.height_, 1, 4);
+            const int bytes_per_line = level.BytesPerLine();
+            for (int v = 0; v < input.height_; v++) {
+                const uint8_t *src = input.RowAt<uint8_t>(v);
+                std::copy(src, src + bytes_per_line,
+                          level.data_.data() + (size_t)v * bytes_per_line);
+            }
         } else {
             if (with_gaussian_filter) {
                 // https://en.wikipedia.org/wiki/Pyramid_(image_processing)
-                auto level_b = FilterImage(*pyramid_image[i - 1],
-                                           Image::FilterType::Gaussian3);
-                auto level_bd = DownsampleImage(*level_b);
-                pyramid_image.push_back(level_bd);
+                FilterAndDownsampleImage(*pyramid_image[i - 1],
+                                         Image::FilterType::Gaussian3, level);
             } else {
-                auto level_d = DownsampleImage(*pyramid_image[i - 1]);
-                pyramid_image.push_back(level_d);
+                DownsampleImage(*pyramid_image[i - 1], level);
             }
         }
     }
-    return pyramid_image;
+    return true;
 }
 
 }  // namespace geometry
@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/ImagePool.h"
+
+namespace open3d {
+namespace geometry {
+
+ImagePool::ImagePool() : state_(std::make_shared<PoolState>()) {}
+
+void ImagePool::ImageReleaser::operator()(Image *image) const {
+    std::unique_ptr<Image> owned(image);
+    auto state = state_.lock();
+    if (!state) {
+        return;
+    }
+    // The lock orders the last owner's writes before the next Acquire().
+    std::lock_guard<std::mutex> lock(state->mutex_);
+    if (generation_ != state->generation_) {
+        return;
+    }
+    state->num_images_in_use_--;
+    state->free_images_[ImageFormat(image->width_, image->height_,
+                                    image->num_of_channels_,
+                                    image->bytes_per_channel_)]
+            .push_back(std::move(owned));
+}
+
+std::shared_ptr<Image> ImagePool::Acquire(int width,
+                                          int height,
+                                          int num_of_channels,
+                                          int bytes_per_channel) {
+    std::unique_ptr<Image> image;
+    size_t generation;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex_);
+        auto &images = state_->free_images_[ImageFormat(
+                width, height, num_of_channels, bytes_per_channel)];
+        if (!images.empty()) {
+            image = std::move(images.back());
+            images.pop_back();
+        }
+        state_->num_images_in_use_++;
+        generation = state_->generation_;
+    }
+    if (!image) {
+        image.reset(new Image());
+    }
+    // Does not reallocate when the image already has the format.
+    image->PrepareImage(width, height, num_of_channels, bytes_per_channel);
+    return std::shared_ptr<Image>(image.release(),
+                                  ImageReleaser{state_, generation});
+}
+
+void ImagePool::Shrink() {
+    std::lock_guard<std::mutex> lock(state_->mutex_);
+    state_->free_images_.clear();
+}
+
+void ImagePool::Clear() {
+    std::lock_guard<std::mutex> lock(state_->mutex_);
+    state_->free_images_.clear();
+    state_->num_images_in_use_ = 0;
+    state_->generation_++;
+}
+
+size_t ImagePool::GetNumberOfImages() const {
+    std::lock_guard<std::mutex> lock(state_->mutex_);
+    size_t num_images = state_->num_images_in_use_;
+    for (const auto &format_images : state_->free_images_) {
+        num_images += format_images.second.size();
+    }
+    return num_images;
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "Open3D/Geometry/Image.h"
+
+namespace open3d {
+namespace geometry {
+
+/// A pool of Image buffers keyed by (width, height, num_of_channels,
+/// bytes_per_channel). Acquire() hands out an image that no one else holds, so
+/// that per-frame temporaries of a streaming pipeline are recycled instead of
+/// being allocated and freed for every frame. An image returns to the pool,
+/// under the format it has at that point, as soon as the last shared_ptr
+/// handed out for it is released. The pixels of an acquired image are left as
+/// they were. The pool is thread-safe, and images may outlive it.
+class ImagePool {
+public:
+    ImagePool();
+    ImagePool(const ImagePool &) = delete;
+    ImagePool &operator=(const ImagePool &) = delete;
+
+public:
+    /// Function to get an image of the given format that is not in use
+    std::shared_ptr<Image> Acquire(int width,
+                                   int height,
+                                   int num_of_channels,
+                                   int bytes_per_channel);
+
+    /// Function to release the images that are not in use
+    void Shrink();
+
+    /// Function to release all the images held by the pool. Images still in
+    /// use stay valid for their other owners and are freed, not returned,
+    /// when released.
+    void Clear();
+
+    /// Number of images held by the pool, in use or not
+    size_t GetNumberOfImages() const;
+
+protected:
+    typedef std::tuple<int, int, int, int> ImageFormat;
+
+    /// State shared with the deleters of the images handed out, so that an
+    /// image released after the pool is destroyed is simply freed.
+    struct PoolState {
+        std::mutex mutex_;
+        std::map<ImageFormat, std::vector<std::unique_ptr<Image>>>
+                free_images_;
+        size_t num_images_in_use_ = 0;
+        /// Incremented by Clear() so that the images in use at that point
+        /// are not returned.
+        size_t generation_ = 0;
+    };
+
+    /// Deleter of the images handed out, which returns them to the pool
+    struct ImageReleaser {
+        std::weak_ptr<PoolState> state_;
+        size_t generation_;
+        void operator()(Image *image) const;
+    };
+
+    std::shared_ptr<PoolState> state_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -33,12 +33,255 @@
 
 #include <flann/flann.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Geometry/CompactPointCloud.h"
 #include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
+
+namespace {
+
+Eigen::Map<const Eigen::MatrixXd> MapQueries(const Eigen::MatrixXd &queries) {
+    return Eigen::Map<const Eigen::MatrixXd>(queries.data(), queries.rows(),
+                                             queries.cols());
+}
+
+Eigen::Map<const Eigen::MatrixXd> MapQueries(
+        const std::vector<Eigen::Vector3d> &queries) {
+    return Eigen::Map<const Eigen::MatrixXd>((const double *)queries.data(), 3,
+                                             queries.size());
+}
+
+int GetSearchThreadCount() {
+#ifdef _OPENMP
+    // Do not oversubscribe when called from inside a parallel region.
+    return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// The queries are given in double precision. They are used in place by a
+// double index and converted into the buffer for a float index.
+const double *ConvertQueries(const double *queries,
+                             size_t size,
+                             std::vector<double> &buffer) {
+    return queries;
+}
+
+const float *ConvertQueries(const double *queries,
+                            size_t size,
+                            std::vector<float> &buffer) {
+    buffer.assign(queries, queries + size);
+    return buffer.data();
+}
+
+// Single queries of up to this dimension are converted on the stack.
+const size_t kMaxStackQueryDimension = 64;
+
+const double *ConvertQuery(const double *query,
+                           size_t dimension,
+                           double *stack_buffer,
+                           std::vector<double> &buffer) {
+    return query;
+}
+
+const float *ConvertQuery(const double *query,
+                          size_t dimension,
+                          float *stack_buffer,
+                          std::vector<float> &buffer) {
+    if (dimension <= kMaxStackQueryDimension) {
+        std::copy(query, query + dimension, stack_buffer);
+        return stack_buffer;
+    }
+    return ConvertQueries(query, dimension, buffer);
+}
+
+// Distances of the single float searches, reused by the searches of a thread
+// so that they do not allocate.
+std::vector<float> &GetFloatDistanceBuffer() {
+    static thread_local std::vector<float> buffer;
+    return buffer;
+}
+
+template <typename Scalar>
+int SearchKNNFlann(flann::Index<flann::L2<Scalar>> &index,
+                   const double *query,
+                   size_t dimension,
+                   int knn,
+                   std::vector<int> &indices,
+                   std::vector<Scalar> &distance2) {
+    Scalar query_stack[kMaxStackQueryDimension];
+    std::vector<Scalar> query_buffer;
+    flann::Matrix<Scalar> query_flann(
+            (Scalar *)ConvertQuery(query, dimension, query_stack,
+                                   query_buffer),
+            1, dimension);
+    indices.resize(knn);
+    distance2.resize(knn);
+    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, knn);
+    flann::Matrix<Scalar> dists_flann(distance2.data(), query_flann.rows, knn);
+    int k = index.knnSearch(query_flann, indices_flann, dists_flann, knn,
+                            flann::SearchParams(-1, 0.0));
+    indices.resize(k);
+    distance2.resize(k);
+    return k;
+}
+
+template <typename Scalar>
+int SearchRadiusFlann(flann::Index<flann::L2<Scalar>> &index,
+                      const double *query,
+                      size_t dimension,
+                      double radius,
+                      std::vector<int> &indices,
+                      std::vector<Scalar> &distance2) {
+    Scalar query_stack[kMaxStackQueryDimension];
+    std::vector<Scalar> query_buffer;
+    flann::Matrix<Scalar> query_flann(
+            (Scalar *)ConvertQuery(query, dimension, query_stack,
+                                   query_buffer),
+            1, dimension);
+    flann::SearchParams param(-1, 0.0);
+    param.max_neighbors = -1;
+    std::vector<std::vector<int>> indices_vec(1);
+    std::vector<std::vector<Scalar>> dists_vec(1);
+    int k = index.radiusSearch(query_flann, indices_vec, dists_vec,
+                               float(radius * radius), param);
+    indices = indices_vec[0];
+    distance2 = dists_vec[0];
+    return k;
+}
+
+template <typename Scalar>
+int SearchHybridFlann(flann::Index<flann::L2<Scalar>> &index,
+                      const double *query,
+                      size_t dimension,
+                      double radius,
+                      int max_nn,
+                      std::vector<int> &indices,
+                      std::vector<Scalar> &distance2) {
+    Scalar query_stack[kMaxStackQueryDimension];
+    std::vector<Scalar> query_buffer;
+    flann::Matrix<Scalar> query_flann(
+            (Scalar *)ConvertQuery(query, dimension, query_stack,
+                                   query_buffer),
+            1, dimension);
+    flann::SearchParams param(-1, 0.0);
+    param.max_neighbors = max_nn;
+    indices.resize(max_nn);
+    distance2.resize(max_nn);
+    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, max_nn);
+    flann::Matrix<Scalar> dists_flann(distance2.data(), query_flann.rows,
+                                      max_nn);
+    int k = index.radiusSearch(query_flann, indices_flann, dists_flann,
+                               float(radius * radius), param);
+    indices.resize(k);
+    distance2.resize(k);
+    return k;
+}
+
+template <typename Scalar>
+void SearchBatchFlann(flann::Index<flann::L2<Scalar>> &index,
+                      const Eigen::Map<const Eigen::MatrixXd> &queries,
+                      size_t dimension,
+                      size_t dataset_size,
+                      geometry::KDTreeSearchParam::SearchType type,
+                      int max_nn,
+                      double radius,
+                      geometry::KDTreeSearchResult &result) {
+    using SearchType = geometry::KDTreeSearchParam::SearchType;
+    const size_t num_queries = (size_t)queries.cols();
+
+    // Queries are handed to flann in blocks, which searches each block in
+    // parallel into scratch buffers that are reused from block to block. The
+    // neighbors of a block are then appended to the result in parallel.
+    const size_t block_size = 16384;
+    flann::SearchParams param(-1, 0.0);
+    param.cores = GetSearchThreadCount();
+    std::vector<Scalar> block_queries;
+    std::vector<size_t> block_indices;
+    std::vector<Scalar> block_dists;
+    std::vector<std::vector<size_t>> block_indices_vec;
+    std::vector<std::vector<Scalar>> block_dists_vec;
+    if (type != SearchType::Radius) {
+        block_indices.resize(std::min(block_size, num_queries) * max_nn);
+        block_dists.resize(block_indices.size());
+    }
+    for (size_t begin = 0; begin < num_queries; begin += block_size) {
+        const int rows = (int)std::min(block_size, num_queries - begin);
+        flann::Matrix<Scalar> query_flann(
+                (Scalar *)ConvertQueries(queries.data() + begin * dimension,
+                                         rows * dimension, block_queries),
+                rows, dimension);
+        size_t *offsets = result.offsets_.data() + begin;
+        if (type == SearchType::Radius) {
+            param.max_neighbors = -1;
+            index.radiusSearch(query_flann, block_indices_vec, block_dists_vec,
+                               float(radius * radius), param);
+            for (int i = 0; i < rows; i++) {
+                offsets[i + 1] = block_indices_vec[i].size();
+            }
+        } else {
+            flann::Matrix<size_t> indices_flann(block_indices.data(), rows,
+                                                max_nn);
+            flann::Matrix<Scalar> dists_flann(block_dists.data(), rows,
+                                              max_nn);
+            if (type == SearchType::Knn) {
+                index.knnSearch(query_flann, indices_flann, dists_flann,
+                                max_nn, param);
+                size_t k = std::min((size_t)max_nn, dataset_size);
+                for (int i = 0; i < rows; i++) {
+                    offsets[i + 1] = k;
+                }
+            } else {
+                param.max_neighbors = max_nn;
+                index.radiusSearch(query_flann, indices_flann, dists_flann,
+                                   float(radius * radius), param);
+                // flann marks the end of a row with an index of -1
+                for (int i = 0; i < rows; i++) {
+                    size_t k = 0;
+                    while (k < (size_t)max_nn &&
+                           indices_flann[i][k] != size_t(-1)) {
+                        k++;
+                    }
+                    offsets[i + 1] = k;
+                }
+            }
+        }
+        for (int i = 0; i < rows; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        result.indices_.resize(offsets[rows]);
+        result.distance2_.resize(offsets[rows]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(param.cores)
+#endif
+        for (int i = 0; i < rows; i++) {
+            const size_t *row_indices;
+            const Scalar *row_dists;
+            if (type == SearchType::Radius) {
+                row_indices = block_indices_vec[i].data();
+                row_dists = block_dists_vec[i].data();
+            } else {
+                row_indices = block_indices.data() + (size_t)i * max_nn;
+                row_dists = block_dists.data() + (size_t)i * max_nn;
+            }
+            for (size_t k = 0; k < offsets[i + 1] - offsets[i]; k++) {
+                result.indices_[offsets[i] + k] = (int)row_indices[k];
+                result.distance2_[offsets[i] + k] = row_dists[k];
+            }
+        }
+    }
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
 KDTreeFlann::KDTreeFlann() {}
@@ -51,6 +294,10 @@ KDTreeFlann::KDTreeFlann(const registration::Feature &feature) {
     SetFeature(feature);
 }
 
+KDTreeFlann::KDTreeFlann(const registration::CompactFeature &feature) {
+    SetFeature(feature);
+}
+
 KDTreeFlann::~KDTreeFlann() {}
 
 bool KDTreeFlann::SetMatrixData(const Eigen::MatrixXd &data) {
@@ -71,6 +318,9 @@ bool KDTreeFlann::SetGeometry(const Geometry &geometry) {
                     (const double *)((const TriangleMesh &)geometry)
                             .vertices_.data(),
                     3, ((const TriangleMesh &)geometry).vertices_.size()));
+        case Geometry::GeometryType::CompactPointCloud:
+            return SetCompactPointCloudData(
+                    (const CompactPointCloud &)geometry);
         case Geometry::GeometryType::Image:
         case Geometry::GeometryType::Unspecified:
         default:
@@ -84,6 +334,20 @@ bool KDTreeFlann::SetFeature(const registration::Feature &feature) {
     return SetMatrixData(feature.data_);
 }
 
+bool KDTreeFlann::SetFeature(const registration::CompactFeature &feature) {
+    dimension_ = feature.Dimension();
+    dataset_size_ = feature.Num();
+    if (dimension_ == 0 || dataset_size_ == 0) {
+        utility::PrintDebug(
+                "[KDTreeFlann::SetFeature] Failed due to no data.\n");
+        return false;
+    }
+    data_float_.resize(dataset_size_ * dimension_);
+    memcpy(data_float_.data(), feature.data_.data(),
+           dataset_size_ * dimension_ * sizeof(float));
+    return BuildFloatIndex();
+}
+
 template <typename T>
 int KDTreeFlann::Search(const T &query,
                         const KDTreeSearchParam &param,
@@ -116,20 +380,19 @@ int KDTreeFlann::SearchKNN(const T &query,
     // This is optimized code for heavily repeated search.
     // Other flann::Index::knnSearch() implementations lose performance due to
     // memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 || query.rows() != dimension_ ||
-        knn < 0) {
+    if ((data_.empty() && data_float_.empty()) || dataset_size_ <= 0 ||
+        query.rows() != dimension_ || knn < 0) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
-    indices.resize(knn);
-    distance2.resize(knn);
-    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, knn);
-    flann::Matrix<double> dists_flann(distance2.data(), query_flann.rows, knn);
-    int k = flann_index_->knnSearch(query_flann, indices_flann, dists_flann,
-                                    knn, flann::SearchParams(-1, 0.0));
-    indices.resize(k);
-    distance2.resize(k);
-    return k;
+    if (flann_index_float_) {
+        std::vector<float> &dists = GetFloatDistanceBuffer();
+        int k = SearchKNNFlann(*flann_index_float_, query.data(), dimension_,
+                               knn, indices, dists);
+        distance2.assign(dists.begin(), dists.end());
+        return k;
+    }
+    return SearchKNNFlann(*flann_index_, query.data(), dimension_, knn,
+                          indices, distance2);
 }
 
 template <typename T>
@@ -141,19 +404,19 @@ int KDTreeFlann::SearchRadius(const T &query,
     // Since max_nn is not given, we let flann to do its own memory management.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory management and CPU caching.
-    if (data_.empty() || dataset_size_ <= 0 || query.rows() != dimension_) {
+    if ((data_.empty() && data_float_.empty()) || dataset_size_ <= 0 ||
+        query.rows() != dimension_) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
-    flann::SearchParams param(-1, 0.0);
-    param.max_neighbors = -1;
-    std::vector<std::vector<int>> indices_vec(1);
-    std::vector<std::vector<double>> dists_vec(1);
-    int k = flann_index_->radiusSearch(query_flann, indices_vec, dists_vec,
-                                       float(radius * radius), param);
-    indices = indices_vec[0];
-    distance2 = dists_vec[0];
-    return k;
+    if (flann_index_float_) {
+        std::vector<float> &dists = GetFloatDistanceBuffer();
+        int k = SearchRadiusFlann(*flann_index_float_, query.data(),
+                                  dimension_, radius, indices, dists);
+        distance2.assign(dists.begin(), dists.end());
+        return k;
+    }
+    return SearchRadiusFlann(*flann_index_, query.data(), dimension_, radius,
+                             indices, distance2);
 }
 
 template <typename T>
@@ -166,23 +429,97 @@ int KDTreeFlann::SearchHybrid(const T &query,
     // It is also the recommended setting for search.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 || query.rows() != dimension_ ||
-        max_nn < 0) {
+    if ((data_.empty() && data_float_.empty()) || dataset_size_ <= 0 ||
+        query.rows() != dimension_ || max_nn < 0) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
-    flann::SearchParams param(-1, 0.0);
-    param.max_neighbors = max_nn;
-    indices.resize(max_nn);
-    distance2.resize(max_nn);
-    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, max_nn);
-    flann::Matrix<double> dists_flann(distance2.data(), query_flann.rows,
-                                      max_nn);
-    int k = flann_index_->radiusSearch(query_flann, indices_flann, dists_flann,
-                                       float(radius * radius), param);
-    indices.resize(k);
-    distance2.resize(k);
-    return k;
+    if (flann_index_float_) {
+        std::vector<float> &dists = GetFloatDistanceBuffer();
+        int k = SearchHybridFlann(*flann_index_float_, query.data(),
+                                  dimension_, radius, max_nn, indices, dists);
+        distance2.assign(dists.begin(), dists.end());
+        return k;
+    }
+    return SearchHybridFlann(*flann_index_, query.data(), dimension_, radius,
+                             max_nn, indices, distance2);
+}
+
+template <typename T>
+int KDTreeFlann::SearchBatch(const T &queries,
+                             const KDTreeSearchParam &param,
+                             KDTreeSearchResult &result) const {
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Knn:
+            return SearchKNNBatch(queries,
+                                  ((const KDTreeSearchParamKNN &)param).knn_,
+                                  result);
+        case KDTreeSearchParam::SearchType::Radius:
+            return SearchRadiusBatch(
+                    queries, ((const KDTreeSearchParamRadius &)param).radius_,
+                    result);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            return SearchHybridBatch(
+                    queries, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    ((const KDTreeSearchParamHybrid &)param).max_nn_, result);
+        default:
+            return -1;
+    }
+    return -1;
+}
+
+template <typename T>
+int KDTreeFlann::SearchKNNBatch(const T &queries,
+                                int knn,
+                                KDTreeSearchResult &result) const {
+    return SearchBatchRaw(MapQueries(queries), KDTreeSearchParam::SearchType::Knn,
+                          knn, 0.0, result);
+}
+
+template <typename T>
+int KDTreeFlann::SearchRadiusBatch(const T &queries,
+                                   double radius,
+                                   KDTreeSearchResult &result) const {
+    return SearchBatchRaw(MapQueries(queries),
+                          KDTreeSearchParam::SearchType::Radius, -1, radius,
+                          result);
+}
+
+template <typename T>
+int KDTreeFlann::SearchHybridBatch(const T &queries,
+                                   double radius,
+                                   int max_nn,
+                                   KDTreeSearchResult &result) const {
+    return SearchBatchRaw(MapQueries(queries),
+                          KDTreeSearchParam::SearchType::Hybrid, max_nn, radius,
+                          result);
+}
+
+int KDTreeFlann::SearchBatchRaw(
+        const Eigen::Map<const Eigen::MatrixXd> &queries,
+        KDTreeSearchParam::SearchType type,
+        int max_nn,
+        double radius,
+        KDTreeSearchResult &result) const {
+    const size_t num_queries = (size_t)queries.cols();
+    result.offsets_.assign(num_queries + 1, 0);
+    result.indices_.clear();
+    result.distance2_.clear();
+    if ((data_.empty() && data_float_.empty()) || dataset_size_ <= 0 ||
+        (num_queries > 0 && queries.rows() != dimension_) ||
+        (type != KDTreeSearchParam::SearchType::Radius && max_nn < 0)) {
+        return -1;
+    }
+    if (num_queries == 0 || max_nn == 0) {
+        return 0;
+    }
+    if (flann_index_float_) {
+        SearchBatchFlann(*flann_index_float_, queries, dimension_,
+                         dataset_size_, type, max_nn, radius, result);
+    } else {
+        SearchBatchFlann(*flann_index_, queries, dimension_, dataset_size_,
+                         type, max_nn, radius, result);
+    }
+    return (int)result.indices_.size();
 }
 
 bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
@@ -196,6 +533,33 @@ bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
     data_.resize(dataset_size_ * dimension_);
     memcpy(data_.data(), data.data(),
            dataset_size_ * dimension_ * sizeof(double));
+    return BuildIndex();
+}
+
+bool KDTreeFlann::SetCompactPointCloudData(const CompactPointCloud &cloud) {
+    dimension_ = 3;
+    dataset_size_ = cloud.GetNumberOfPoints();
+    if (dataset_size_ == 0) {
+        utility::PrintDebug(
+                "[KDTreeFlann::SetCompactPointCloudData] Failed due to no "
+                "data.\n");
+        return false;
+    }
+    // Interleave the coordinate arrays into a float index, which keeps the
+    // precision of the cloud at half the memory of a double one.
+    data_float_.resize(dataset_size_ * dimension_);
+    for (size_t i = 0; i < dataset_size_; i++) {
+        data_float_[i * 3 + 0] = cloud.x_[i];
+        data_float_[i * 3 + 1] = cloud.y_[i];
+        data_float_[i * 3 + 2] = cloud.z_[i];
+    }
+    return BuildFloatIndex();
+}
+
+bool KDTreeFlann::BuildIndex() {
+    data_float_.clear();
+    flann_dataset_float_.reset();
+    flann_index_float_.reset();
     flann_dataset_.reset(new flann::Matrix<double>((double *)data_.data(),
                                                    dataset_size_, dimension_));
     flann_index_.reset(new flann::Index<flann::L2<double>>(
@@ -204,6 +568,18 @@ bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
     return true;
 }
 
+bool KDTreeFlann::BuildFloatIndex() {
+    data_.clear();
+    flann_dataset_.reset();
+    flann_index_.reset();
+    flann_dataset_float_.reset(new flann::Matrix<float>(
+            (float *)data_float_.data(), dataset_size_, dimension_));
+    flann_index_float_.reset(new flann::Index<flann::L2<float>>(
+            *flann_dataset_float_, flann::KDTreeSingleIndexParams(15)));
+    flann_index_float_->buildIndex();
+    return true;
+}
+
 template int KDTreeFlann::Search<Eigen::Vector3d>(
         const Eigen::Vector3d &query,
         const KDTreeSearchParam &param,
@@ -248,6 +624,42 @@ template int KDTreeFlann::SearchHybrid<Eigen::VectorXd>(
         std::vector<int> &indices,
         std::vector<double> &distance2) const;
 
+template int KDTreeFlann::SearchBatch<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        const KDTreeSearchParam &param,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchKNNBatch<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        int knn,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchRadiusBatch<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        double radius,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchHybridBatch<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        double radius,
+        int max_nn,
+        KDTreeSearchResult &result) const;
+
+template int KDTreeFlann::SearchBatch<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        const KDTreeSearchParam &param,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchKNNBatch<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        int knn,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchRadiusBatch<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        double radius,
+        KDTreeSearchResult &result) const;
+template int KDTreeFlann::SearchHybridBatch<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        double radius,
+        int max_nn,
+        KDTreeSearchResult &result) const;
+
 }  // namespace geometry
 }  // namespace open3d
 
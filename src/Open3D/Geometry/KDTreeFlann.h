@@ -46,12 +46,44 @@ class Index;
 namespace open3d {
 namespace geometry {
 
+class CompactPointCloud;
+
+/// Neighbors found by a batched KDTreeFlann search, stored in compressed
+/// sparse row layout: the neighbors of query i and their squared distances are
+/// indices_[k] and distance2_[k] for k in [offsets_[i], offsets_[i + 1]).
+/// Reusing one KDTreeSearchResult across searches reuses its buffers.
+class KDTreeSearchResult {
+public:
+    KDTreeSearchResult() {}
+    ~KDTreeSearchResult() {}
+
+public:
+    size_t GetQueryCount() const {
+        return offsets_.empty() ? 0 : offsets_.size() - 1;
+    }
+    int GetNeighborCount(size_t query) const {
+        return (int)(offsets_[query + 1] - offsets_[query]);
+    }
+    const int *GetIndices(size_t query) const {
+        return indices_.data() + offsets_[query];
+    }
+    const double *GetDistance2(size_t query) const {
+        return distance2_.data() + offsets_[query];
+    }
+
+public:
+    std::vector<size_t> offsets_;
+    std::vector<int> indices_;
+    std::vector<double> distance2_;
+};
+
 class KDTreeFlann {
 public:
     KDTreeFlann();
     KDTreeFlann(const Eigen::MatrixXd &data);
     KDTreeFlann(const Geometry &geometry);
     KDTreeFlann(const registration::Feature &feature);
+    KDTreeFlann(const registration::CompactFeature &feature);
     ~KDTreeFlann();
     KDTreeFlann(const KDTreeFlann &) = delete;
     KDTreeFlann &operator=(const KDTreeFlann &) = delete;
@@ -60,6 +92,10 @@ public:
     bool SetMatrixData(const Eigen::MatrixXd &data);
     bool SetGeometry(const Geometry &geometry);
     bool SetFeature(const registration::Feature &feature);
+    /// Indexes the float32 \param feature without converting it to double,
+    /// so the index takes half the memory of one built from a Feature. Queries
+    /// are still given in double precision and converted when searched.
+    bool SetFeature(const registration::CompactFeature &feature);
 
     template <typename T>
     int Search(const T &query,
@@ -86,13 +122,52 @@ public:
                      std::vector<int> &indices,
                      std::vector<double> &distance2) const;
 
+    /// Batched versions of Search, SearchKNN, SearchRadius and SearchHybrid.
+    /// \param queries is either an Eigen::MatrixXd with one query per column
+    /// or a std::vector<Eigen::Vector3d>. Queries are processed in parallel
+    /// and the neighbors of all of them are written to \param result, so a
+    /// batch only allocates a bounded number of buffers regardless of its
+    /// size. Returns the total number of neighbors found, or -1 on invalid
+    /// input, in which case every query in \param result has no neighbors.
+    template <typename T>
+    int SearchBatch(const T &queries,
+                    const KDTreeSearchParam &param,
+                    KDTreeSearchResult &result) const;
+
+    template <typename T>
+    int SearchKNNBatch(const T &queries,
+                       int knn,
+                       KDTreeSearchResult &result) const;
+
+    template <typename T>
+    int SearchRadiusBatch(const T &queries,
+                          double radius,
+                          KDTreeSearchResult &result) const;
+
+    template <typename T>
+    int SearchHybridBatch(const T &queries,
+                          double radius,
+                          int max_nn,
+                          KDTreeSearchResult &result) const;
+
 private:
     bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+    bool SetCompactPointCloudData(const CompactPointCloud &cloud);
+    bool BuildIndex();
+    bool BuildFloatIndex();
+    int SearchBatchRaw(const Eigen::Map<const Eigen::MatrixXd> &queries,
+                       KDTreeSearchParam::SearchType type,
+                       int max_nn,
+                       double radius,
+                       KDTreeSearchResult &result) const;
 
 protected:
     std::vector<double> data_;
     std::unique_ptr<flann::Matrix<double>> flann_dataset_;
     std::unique_ptr<flann::Index<flann::L2<double>>> flann_index_;
+    std::vector<float> data_float_;
+    std::unique_ptr<flann::Matrix<float>> flann_dataset_float_;
+    std::unique_ptr<flann::Index<flann::L2<float>>> flann_index_float_;
     size_t dimension_ = 0;
     size_t dataset_size_ = 0;
 };
@@ -134,8 +134,17 @@ std::shared_ptr<PointCloud> SelectDownSample(const PointCloud &input,
 std::shared_ptr<PointCloud> VoxelDownSample(const PointCloud &input,
                                             double voxel_size);
 
+/// Function to downsample \param input pointcloud with a voxel, same as
+/// VoxelDownSample. In addition, \return for every input point the index of
+/// the output point it has been merged into, so that later passes can
+/// aggregate other per-point attributes (e.g. labels) over the same voxels
+/// without hashing them again. Output points are ordered by voxel.
+std::tuple<std::shared_ptr<PointCloud>, std::vector<int>>
+VoxelDownSampleAndIndex(const PointCloud &input, double voxel_size);
+
 /// Function to downsample using VoxelDownSample, but specialized for
-/// Surface convolution project. Experimental function.
+/// Surface convolution project. Experimental function. Output points are
+/// ordered by voxel.
 std::tuple<std::shared_ptr<PointCloud>, Eigen::MatrixXi>
 VoxelDownSampleAndTrace(const PointCloud &input,
                         double voxel_size,
@@ -27,6 +27,7 @@
 #include <Eigen/Dense>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/CompactPointCloud.h"
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -37,44 +38,158 @@ namespace open3d {
 namespace {
 using namespace geometry;
 
-int CountValidDepthPixels(const Image &depth, int stride) {
-    int num_valid_pixels = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
-        for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = PointerAt<float>(depth, j, i);
-            if (*p > 0) num_valid_pixels += 1;
+/// Converts depth pixels of type T to depth values. uint16_t depth is scaled
+/// by 1 / depth_scale and truncated at depth_trunc exactly as
+/// ConvertDepthToFloatImage does it, float depth is used as is.
+template <typename T>
+class DepthConverter;
+
+template <>
+class DepthConverter<float> {
+public:
+    DepthConverter(double depth_scale, double depth_trunc) {}
+    bool IsValid(float depth) const { return depth > 0; }
+    float operator()(float depth) const { return depth; }
+};
+
+template <>
+class DepthConverter<uint16_t> {
+public:
+    DepthConverter(double depth_scale, double depth_trunc)
+        : depth_scale_((float)depth_scale) {
+        if (!(depth_scale_ > 0)) {
+            upper_ = 0;
+            return;
+        }
+        // The depth grows with the raw value, so the pixels that are
+        // truncated are exactly the raw values from upper_ on. Finding upper_
+        // once saves a division per pixel when testing for validity.
+        int lower = 1;
+        upper_ = 65536;
+        while (lower < upper_) {
+            int middle = (lower + upper_) / 2;
+            if ((float)middle / depth_scale_ >= depth_trunc) {
+                upper_ = middle;
+            } else {
+                lower = middle + 1;
+            }
         }
     }
-    return num_valid_pixels;
-}
+    bool IsValid(uint16_t depth) const {
+        return depth > 0 && (int)depth < upper_;
+    }
+    float operator()(uint16_t depth) const {
+        return (float)depth / depth_scale_;
+    }
 
-std::shared_ptr<PointCloud> CreatePointCloudFromFloatDepthImage(
-        const Image &depth,
-        const camera::PinholeCameraIntrinsic &intrinsic,
-        const Eigen::Matrix4d &extrinsic,
-        int stride) {
-    auto pointcloud = std::make_shared<PointCloud>();
+private:
+    float depth_scale_;
+    int upper_;
+};
+
+/// Back-projects every stride-th pixel of every stride-th row of a depth image
+/// of type T. Valid pixels are counted per row in parallel, the counts are
+/// prefix-summed into the output offsets of the rows, and the rows are then
+/// back-projected in parallel into their own output range, so that the
+/// points come out in the same row-major order as a serial pass. The rays of
+/// the pixels are precomputed per column and per row. resize(n) is called
+/// once with the number of valid pixels and write(k, u, v, point) for the
+/// k-th valid pixel (u, v).
+template <typename T, typename ResizeFunc, typename WriteFunc>
+void BackProjectDepthImage(const Image &depth,
+                           const camera::PinholeCameraIntrinsic &intrinsic,
+                           const Eigen::Matrix4d &extrinsic,
+                           double depth_scale,
+                           double depth_trunc,
+                           int stride,
+                           const ResizeFunc &resize,
+                           const WriteFunc &write) {
     Eigen::Matrix4d camera_pose = extrinsic.inverse();
+    const Eigen::Matrix3d R = camera_pose.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = camera_pose.block<3, 1>(0, 3);
     auto focal_length = intrinsic.GetFocalLength();
     auto principal_point = intrinsic.GetPrincipalPoint();
-    int num_valid_pixels = CountValidDepthPixels(depth, stride);
-    pointcloud->points_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
-        for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = PointerAt<float>(depth, j, i);
-            if (*p > 0) {
-                double z = (double)(*p);
-                double x = (j - principal_point.first) * z / focal_length.first;
-                double y =
-                        (i - principal_point.second) * z / focal_length.second;
-                Eigen::Vector4d point =
-                        camera_pose * Eigen::Vector4d(x, y, z, 1.0);
-                pointcloud->points_[cnt++] = point.block<3, 1>(0, 0);
+    const int num_cols = (depth.width_ + stride - 1) / stride;
+    const int num_rows = (depth.height_ + stride - 1) / stride;
+    std::vector<double> ray_x(num_cols), ray_y(num_rows);
+    for (int c = 0; c < num_cols; c++) {
+        ray_x[c] = (c * stride - principal_point.first) / focal_length.first;
+    }
+    for (int r = 0; r < num_rows; r++) {
+        ray_y[r] = (r * stride - principal_point.second) / focal_length.second;
+    }
+    const DepthConverter<T> convert(depth_scale, depth_trunc);
+    auto row_at = [&depth, stride](int r) {
+        return (const T *)(depth.data_.data() +
+                           (size_t)r * stride * depth.BytesPerLine());
+    };
+
+    std::vector<int64_t> row_offset(num_rows + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int r = 0; r < num_rows; r++) {
+        const T *p = row_at(r);
+        int64_t count = 0;
+        for (int c = 0; c < num_cols; c++) {
+            if (convert.IsValid(p[c * stride])) {
+                count++;
             }
         }
+        row_offset[r + 1] = count;
     }
-    return pointcloud;
+    for (int r = 0; r < num_rows; r++) {
+        row_offset[r + 1] += row_offset[r];
+    }
+    resize((size_t)row_offset[num_rows]);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int r = 0; r < num_rows; r++) {
+        const T *p = row_at(r);
+        int64_t k = row_offset[r];
+        for (int c = 0; c < num_cols; c++) {
+            if (convert.IsValid(p[c * stride])) {
+                double z = (double)convert(p[c * stride]);
+                Eigen::Vector3d point =
+                        R * Eigen::Vector3d(ray_x[c] * z, ray_y[r] * z, z) + t;
+                write((size_t)k++, c * stride, r * stride, point);
+            }
+        }
+    }
+}
+
+template <typename ResizeFunc, typename WriteFunc>
+bool BackProjectDepthImageOfAnyType(
+        const Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        double depth_scale,
+        double depth_trunc,
+        int stride,
+        const ResizeFunc &resize,
+        const WriteFunc &write) {
+    if (depth.num_of_channels_ == 1 && depth.bytes_per_channel_ == 2) {
+        BackProjectDepthImage<uint16_t>(depth, intrinsic, extrinsic,
+                                        depth_scale, depth_trunc, stride,
+                                        resize, write);
+        return true;
+    } else if (depth.num_of_channels_ == 1 && depth.bytes_per_channel_ == 4) {
+        BackProjectDepthImage<float>(depth, intrinsic, extrinsic, depth_scale,
+                                     depth_trunc, stride, resize, write);
+        return true;
+    }
+    return false;
+}
+
+template <typename TC, int NC>
+Eigen::Vector3d GetPixelColor(const Image &color, int u, int v) {
+    double scale = (sizeof(TC) == 1) ? 255.0 : 1.0;
+    const TC *pc =
+            (const TC *)(color.data_.data() + v * color.BytesPerLine()) +
+            u * NC;
+    return Eigen::Vector3d(pc[0], pc[(NC - 1) / 2], pc[NC - 1]) / scale;
 }
 
 template <typename TC, int NC>
@@ -83,34 +198,36 @@ std::shared_ptr<PointCloud> CreatePointCloudFromRGBDImageT(
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
     auto pointcloud = std::make_shared<PointCloud>();
-    Eigen::Matrix4d camera_pose = extrinsic.inverse();
-    auto focal_length = intrinsic.GetFocalLength();
-    auto principal_point = intrinsic.GetPrincipalPoint();
-    double scale = (sizeof(TC) == 1) ? 255.0 : 1.0;
-    int num_valid_pixels = CountValidDepthPixels(image.depth_, 1);
-    pointcloud->points_.resize(num_valid_pixels);
-    pointcloud->colors_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < image.depth_.height_; i++) {
-        float *p = (float *)(image.depth_.data_.data() +
-                             i * image.depth_.BytesPerLine());
-        TC *pc = (TC *)(image.color_.data_.data() +
-                        i * image.color_.BytesPerLine());
-        for (int j = 0; j < image.depth_.width_; j++, p++, pc += NC) {
-            if (*p > 0) {
-                double z = (double)(*p);
-                double x = (j - principal_point.first) * z / focal_length.first;
-                double y =
-                        (i - principal_point.second) * z / focal_length.second;
-                Eigen::Vector4d point =
-                        camera_pose * Eigen::Vector4d(x, y, z, 1.0);
-                pointcloud->points_[cnt] = point.block<3, 1>(0, 0);
-                pointcloud->colors_[cnt++] =
-                        Eigen::Vector3d(pc[0], pc[(NC - 1) / 2], pc[NC - 1]) /
-                        scale;
-            }
-        }
-    }
+    BackProjectDepthImage<float>(
+            image.depth_, intrinsic, extrinsic, 1.0, 0.0, 1,
+            [&pointcloud](size_t n) {
+                pointcloud->points_.resize(n);
+                pointcloud->colors_.resize(n);
+            },
+            [&pointcloud, &image](size_t k, int u, int v,
+                                  const Eigen::Vector3d &point) {
+                pointcloud->points_[k] = point;
+                pointcloud->colors_[k] =
+                        GetPixelColor<TC, NC>(image.color_, u, v);
+            });
+    return pointcloud;
+}
+
+template <typename TC, int NC>
+std::shared_ptr<CompactPointCloud> CreateCompactPointCloudFromRGBDImageT(
+        const RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic) {
+    auto pointcloud = std::make_shared<CompactPointCloud>();
+    BackProjectDepthImage<float>(
+            image.depth_, intrinsic, extrinsic, 1.0, 0.0, 1,
+            [&pointcloud](size_t n) { pointcloud->Resize(n, false, true); },
+            [&pointcloud, &image](size_t k, int u, int v,
+                                  const Eigen::Vector3d &point) {
+                pointcloud->SetPoint(k, point);
+                pointcloud->SetColor(
+                        k, GetPixelColor<TC, NC>(image.color_, u, v));
+            });
     return pointcloud;
 }
 
@@ -124,16 +241,15 @@ std::shared_ptr<PointCloud> CreatePointCloudFromDepthImage(
         double depth_scale /* = 1000.0*/,
         double depth_trunc /* = 1000.0*/,
         int stride /* = 1*/) {
-    if (depth.num_of_channels_ == 1) {
-        if (depth.bytes_per_channel_ == 2) {
-            auto float_depth =
-                    ConvertDepthToFloatImage(depth, depth_scale, depth_trunc);
-            return CreatePointCloudFromFloatDepthImage(*float_depth, intrinsic,
-                                                       extrinsic, stride);
-        } else if (depth.bytes_per_channel_ == 4) {
-            return CreatePointCloudFromFloatDepthImage(depth, intrinsic,
-                                                       extrinsic, stride);
-        }
+    auto pointcloud = std::make_shared<PointCloud>();
+    if (BackProjectDepthImageOfAnyType(
+                depth, intrinsic, extrinsic, depth_scale, depth_trunc, stride,
+                [&pointcloud](size_t n) { pointcloud->points_.resize(n); },
+                [&pointcloud](size_t k, int u, int v,
+                              const Eigen::Vector3d &point) {
+                    pointcloud->points_[k] = point;
+                })) {
+        return pointcloud;
     }
     utility::PrintDebug(
             "[CreatePointCloudFromDepthImage] Unsupported image format.\n");
@@ -160,5 +276,52 @@ std::shared_ptr<PointCloud> CreatePointCloudFromRGBDImage(
             "[CreatePointCloudFromRGBDImage] Unsupported image format.\n");
     return std::make_shared<PointCloud>();
 }
+
+std::shared_ptr<CompactPointCloud> CreateCompactPointCloudFromDepthImage(
+        const Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/,
+        double depth_scale /* = 1000.0*/,
+        double depth_trunc /* = 1000.0*/,
+        int stride /* = 1*/) {
+    auto pointcloud = std::make_shared<CompactPointCloud>();
+    if (BackProjectDepthImageOfAnyType(
+                depth, intrinsic, extrinsic, depth_scale, depth_trunc, stride,
+                [&pointcloud](size_t n) {
+                    pointcloud->Resize(n, false, false);
+                },
+                [&pointcloud](size_t k, int u, int v,
+                              const Eigen::Vector3d &point) {
+                    pointcloud->SetPoint(k, point);
+                })) {
+        return pointcloud;
+    }
+    utility::PrintDebug(
+            "[CreateCompactPointCloudFromDepthImage] Unsupported image "
+            "format.\n");
+    return pointcloud;
+}
+
+std::shared_ptr<CompactPointCloud> CreateCompactPointCloudFromRGBDImage(
+        const RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/) {
+    if (image.depth_.num_of_channels_ == 1 &&
+        image.depth_.bytes_per_channel_ == 4) {
+        if (image.color_.bytes_per_channel_ == 1 &&
+            image.color_.num_of_channels_ == 3) {
+            return CreateCompactPointCloudFromRGBDImageT<uint8_t, 3>(
+                    image, intrinsic, extrinsic);
+        } else if (image.color_.bytes_per_channel_ == 4 &&
+                   image.color_.num_of_channels_ == 1) {
+            return CreateCompactPointCloudFromRGBDImageT<float, 1>(
+                    image, intrinsic, extrinsic);
+        }
+    }
+    utility::PrintDebug(
+            "[CreateCompactPointCloudFromRGBDImage] Unsupported image "
+            "format.\n");
+    return std::make_shared<CompactPointCloud>();
+}
 }  // namespace geometry
 }  // namespace open3d
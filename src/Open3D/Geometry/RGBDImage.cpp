@@ -29,18 +29,32 @@
 namespace open3d {
 namespace geometry {
 
+namespace {
+
+void CreateImagePyramidLevel(const Image& previous_level,
+                             bool with_gaussian_filter,
+                             Image& level) {
+    if (with_gaussian_filter) {
+        FilterAndDownsampleImage(previous_level, Image::FilterType::Gaussian3,
+                                 level);
+    } else {
+        DownsampleImage(previous_level, level);
+    }
+}
+
+}  // unnamed namespace
+
 RGBDImagePyramid FilterRGBDImagePyramid(
         const RGBDImagePyramid& rgbd_image_pyramid, Image::FilterType type) {
     RGBDImagePyramid rgbd_image_pyramid_filtered;
     rgbd_image_pyramid_filtered.clear();
     int num_of_levels = (int)rgbd_image_pyramid.size();
     for (int level = 0; level < num_of_levels; level++) {
-        auto color_level = rgbd_image_pyramid[level]->color_;
-        auto depth_level = rgbd_image_pyramid[level]->depth_;
-        auto color_level_filtered = FilterImage(color_level, type);
-        auto depth_level_filtered = FilterImage(depth_level, type);
-        auto rgbd_image_level_filtered = std::make_shared<RGBDImage>(
-                RGBDImage(*color_level_filtered, *depth_level_filtered));
+        auto rgbd_image_level_filtered = std::make_shared<RGBDImage>();
+        FilterImage(rgbd_image_pyramid[level]->color_, type,
+                    rgbd_image_level_filtered->color_);
+        FilterImage(rgbd_image_pyramid[level]->depth_, type,
+                    rgbd_image_level_filtered->depth_);
         rgbd_image_pyramid_filtered.push_back(rgbd_image_level_filtered);
     }
     return rgbd_image_pyramid_filtered;
@@ -51,16 +65,33 @@ RGBDImagePyramid CreateRGBDImagePyramid(
         size_t num_of_levels,
         bool with_gaussian_filter_for_color /* = true */,
         bool with_gaussian_filter_for_depth /* = false */) {
-    ImagePyramid color_pyramid = CreateImagePyramid(
-            rgbd_image.color_, num_of_levels, with_gaussian_filter_for_color);
-    ImagePyramid depth_pyramid = CreateImagePyramid(
-            rgbd_image.depth_, num_of_levels, with_gaussian_filter_for_depth);
     RGBDImagePyramid rgbd_image_pyramid;
     rgbd_image_pyramid.clear();
+    if (rgbd_image.color_.num_of_channels_ != 1 ||
+        rgbd_image.color_.bytes_per_channel_ != 4 ||
+        rgbd_image.depth_.num_of_channels_ != 1 ||
+        rgbd_image.depth_.bytes_per_channel_ != 4) {
+        utility::PrintWarning(
+                "[CreateRGBDImagePyramid] Unsupported image format.\n");
+        return rgbd_image_pyramid;
+    }
+    // Each level is filtered and downsampled directly into the RGBDImage of
+    // the pyramid, without intermediate image copies.
     for (size_t level = 0; level < num_of_levels; level++) {
-        auto rgbd_image_level = std::make_shared<RGBDImage>(
-                RGBDImage(*color_pyramid[level], *depth_pyramid[level]));
-        rgbd_image_pyramid.push_back(rgbd_image_level);
+        if (level == 0) {
+            rgbd_image_pyramid.push_back(std::make_shared<RGBDImage>(
+                    rgbd_image.color_, rgbd_image.depth_));
+        } else {
+            const RGBDImage& previous = *rgbd_image_pyramid[level - 1];
+            auto rgbd_image_level = std::make_shared<RGBDImage>();
+            CreateImagePyramidLevel(previous.color_,
+                                    with_gaussian_filter_for_color,
+                                    rgbd_image_level->color_);
+            CreateImagePyramidLevel(previous.depth_,
+                                    with_gaussian_filter_for_depth,
+                                    rgbd_image_level->depth_);
+            rgbd_image_pyramid.push_back(rgbd_image_level);
+        }
     }
     return rgbd_image_pyramid;
 }
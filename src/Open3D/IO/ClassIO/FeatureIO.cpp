@@ -33,11 +33,20 @@ namespace open3d {
 namespace io {
 
 bool ReadFeature(const std::string &filename, registration::Feature &feature) {
+    if (utility::filesystem::GetFileExtensionInLowerCase(filename) == "o3d") {
+        return ReadFeatureFromO3D(filename, feature);
+    }
     return ReadFeatureFromBIN(filename, feature);
 }
 
 bool WriteFeature(const std::string &filename,
-                  const registration::Feature &feature) {
+                  const registration::Feature &feature,
+                  bool compressed /* = false*/,
+                  FeatureStorageType storage_type
+                  /* = FeatureStorageType::Float64*/) {
+    if (utility::filesystem::GetFileExtensionInLowerCase(filename) == "o3d") {
+        return WriteFeatureToO3D(filename, feature, compressed, storage_type);
+    }
     return WriteFeatureToBIN(filename, feature);
 }
 
@@ -33,14 +33,30 @@
 namespace open3d {
 namespace io {
 
+/// Precision of the feature data stored in O3D files. Float16 halves the size
+/// of the file; UInt8 quantizes every dimension linearly over its range of
+/// values, which suits histogram features such as FPFH.
+enum class FeatureStorageType {
+    Float64 = 0,
+    Float16 = 1,
+    UInt8 = 2,
+};
+
 /// The general entrance for reading a Feature from a file
+/// Files with the o3d extension are read as O3D containers, all other files
+/// as BIN.
 /// \return If the read function is successful.
 bool ReadFeature(const std::string &filename, registration::Feature &feature);
 
 /// The general entrance for writing a Feature to a file
+/// The compression and storage type are used by the O3D format and ignored
+/// by BIN.
 /// \return If the write function is successful.
-bool WriteFeature(const std::string &filename,
-                  const registration::Feature &feature);
+bool WriteFeature(
+        const std::string &filename,
+        const registration::Feature &feature,
+        bool compressed = false,
+        FeatureStorageType storage_type = FeatureStorageType::Float64);
 
 bool ReadFeatureFromBIN(const std::string &filename,
                         registration::Feature &feature);
@@ -48,5 +64,14 @@ bool ReadFeatureFromBIN(const std::string &filename,
 bool WriteFeatureToBIN(const std::string &filename,
                        const registration::Feature &feature);
 
+bool ReadFeatureFromO3D(const std::string &filename,
+                        registration::Feature &feature);
+
+bool WriteFeatureToO3D(
+        const std::string &filename,
+        const registration::Feature &feature,
+        bool compressed = false,
+        FeatureStorageType storage_type = FeatureStorageType::Float64);
+
 }  // namespace io
 }  // namespace open3d
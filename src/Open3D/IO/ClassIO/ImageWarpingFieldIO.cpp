@@ -45,7 +45,8 @@ bool ReadImageWarpingFieldFromJSON(
 
 bool WriteImageWarpingFieldToJSON(
         const std::string &filename,
-        const color_map::ImageWarpingField &warping_field) {
+        const color_map::ImageWarpingField &warping_field,
+        bool compressed) {
     return WriteIJsonConvertibleToJSON(filename, warping_field);
 }
 
@@ -55,14 +56,17 @@ static const std::unordered_map<
                            color_map::ImageWarpingField &)>>
         file_extension_to_warping_field_read_function{
                 {"json", ReadImageWarpingFieldFromJSON},
+                {"o3d", ReadImageWarpingFieldFromO3D},
         };
 
 static const std::unordered_map<
         std::string,
         std::function<bool(const std::string &,
-                           const color_map::ImageWarpingField &)>>
+                           const color_map::ImageWarpingField &,
+                           const bool)>>
         file_extension_to_warping_field_write_function{
                 {"json", WriteImageWarpingFieldToJSON},
+                {"o3d", WriteImageWarpingFieldToO3D},
         };
 
 }  // unnamed namespace
@@ -98,7 +102,8 @@ bool ReadImageWarpingField(const std::string &filename,
 }
 
 bool WriteImageWarpingField(const std::string &filename,
-                            const color_map::ImageWarpingField &trajectory) {
+                            const color_map::ImageWarpingField &trajectory,
+                            bool compressed /* = false*/) {
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
@@ -115,7 +120,7 @@ bool WriteImageWarpingField(const std::string &filename,
                 "extension.\n");
         return false;
     }
-    return map_itr->second(filename, trajectory);
+    return map_itr->second(filename, trajectory, compressed);
 }
 
 }  // namespace io
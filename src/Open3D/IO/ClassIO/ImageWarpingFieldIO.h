@@ -50,9 +50,20 @@ bool ReadImageWarpingField(const std::string &filename,
                            color_map::ImageWarpingField &warping_field);
 
 /// The general entrance for writing a ImageWarpingField to a file
+/// If the write function supports compression, \param compressed will be
+/// used. Otherwise it will be ignored.
 /// \return If the write function is successful.
 bool WriteImageWarpingField(const std::string &filename,
-                            const color_map::ImageWarpingField &warping_field);
+                            const color_map::ImageWarpingField &warping_field,
+                            bool compressed = false);
+
+bool ReadImageWarpingFieldFromO3D(const std::string &filename,
+                                  color_map::ImageWarpingField &warping_field);
+
+bool WriteImageWarpingFieldToO3D(
+        const std::string &filename,
+        const color_map::ImageWarpingField &warping_field,
+        bool compressed = false);
 
 }  // namespace io
 }  // namespace open3d
@@ -45,7 +45,8 @@ bool ReadPinholeCameraTrajectoryFromJSON(
 
 bool WritePinholeCameraTrajectoryToJSON(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory) {
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed) {
     return WriteIJsonConvertibleToJSON(filename, trajectory);
 }
 
@@ -57,16 +58,19 @@ static const std::unordered_map<
                 {"log", ReadPinholeCameraTrajectoryFromLOG},
                 {"json", ReadPinholeCameraTrajectoryFromJSON},
                 {"txt", ReadPinholeCameraTrajectoryFromTUM},
+                {"o3d", ReadPinholeCameraTrajectoryFromO3D},
         };
 
 static const std::unordered_map<
         std::string,
         std::function<bool(const std::string &,
-                           const camera::PinholeCameraTrajectory &)>>
+                           const camera::PinholeCameraTrajectory &,
+                           const bool)>>
         file_extension_to_trajectory_write_function{
                 {"log", WritePinholeCameraTrajectoryToLOG},
                 {"json", WritePinholeCameraTrajectoryToJSON},
                 {"txt", WritePinholeCameraTrajectoryToTUM},
+                {"o3d", WritePinholeCameraTrajectoryToO3D},
         };
 
 }  // unnamed namespace
@@ -103,7 +107,8 @@ bool ReadPinholeCameraTrajectory(const std::string &filename,
 
 bool WritePinholeCameraTrajectory(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory) {
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed /* = false*/) {
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
@@ -120,7 +125,7 @@ bool WritePinholeCameraTrajectory(
                 "extension.\n");
         return false;
     }
-    return map_itr->second(filename, trajectory);
+    return map_itr->second(filename, trajectory, compressed);
 }
 
 }  // namespace io
@@ -47,10 +47,13 @@ bool ReadPinholeCameraTrajectory(const std::string &filename,
 
 /// The general entrance for writing a PinholeCameraTrajectory to a file
 /// The function calls write functions based on the extension name of filename.
+/// If the write function supports compression, \param compressed will be
+/// used. Otherwise it will be ignored.
 /// \return If the write function is successful.
 bool WritePinholeCameraTrajectory(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory);
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed = false);
 
 bool ReadPinholeCameraTrajectoryFromLOG(
         const std::string &filename,
@@ -58,7 +61,8 @@ bool ReadPinholeCameraTrajectoryFromLOG(
 
 bool WritePinholeCameraTrajectoryToLOG(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory);
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed = false);
 
 bool ReadPinholeCameraTrajectoryFromTUM(
         const std::string &filename,
@@ -66,7 +70,17 @@ bool ReadPinholeCameraTrajectoryFromTUM(
 
 bool WritePinholeCameraTrajectoryToTUM(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory);
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed = false);
+
+bool ReadPinholeCameraTrajectoryFromO3D(
+        const std::string &filename,
+        camera::PinholeCameraTrajectory &trajectory);
+
+bool WritePinholeCameraTrajectoryToO3D(
+        const std::string &filename,
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed = false);
 
 }  // namespace io
 }  // namespace open3d
@@ -46,6 +46,7 @@ static const std::unordered_map<
                 {"ply", ReadPointCloudFromPLY},
                 {"pcd", ReadPointCloudFromPCD},
                 {"pts", ReadPointCloudFromPTS},
+                {"o3d", ReadPointCloudFromO3D},
         };
 
 static const std::unordered_map<std::string,
@@ -60,6 +61,7 @@ static const std::unordered_map<std::string,
                 {"ply", WritePointCloudToPLY},
                 {"pcd", WritePointCloudToPCD},
                 {"pts", WritePointCloudToPTS},
+                {"o3d", WritePointCloudToO3D},
         };
 }  // unnamed namespace
 
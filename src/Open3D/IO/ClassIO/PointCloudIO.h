@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "Open3D/Geometry/PointCloud.h"
@@ -87,6 +88,19 @@ bool WritePointCloudToPLY(const std::string &filename,
                           bool write_ascii = false,
                           bool compressed = false);
 
+/// Reads the vertices of a PLY file in chunks of at most \param chunk_size
+/// points and passes each chunk to \param callback, so that files larger than
+/// memory can be processed (e.g. downsampled) on the fly. The chunk is reused
+/// between calls. Reading stops early if the callback returns false. The
+/// vertex element must be the first element of the file; binary files must
+/// not have list properties on vertices.
+/// \return return true if the file is read successfully or stopped by the
+/// callback, false otherwise.
+bool ReadPointCloudFromPLYInChunks(
+        const std::string &filename,
+        size_t chunk_size,
+        const std::function<bool(const geometry::PointCloud &)> &callback);
+
 bool ReadPointCloudFromPCD(const std::string &filename,
                            geometry::PointCloud &pointcloud);
 
@@ -103,5 +117,18 @@ bool WritePointCloudToPTS(const std::string &filename,
                           bool write_ascii = false,
                           bool compressed = false);
 
+/// Reads the native O3D container. The file is memory mapped and every
+/// attribute is copied with a single memcpy, without parsing.
+bool ReadPointCloudFromO3D(const std::string &filename,
+                           geometry::PointCloud &pointcloud);
+
+/// Writes the native O3D container, in which attributes are stored in their
+/// in-memory layout. The file can only be read on machines with the same byte
+/// order.
+bool WritePointCloudToO3D(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          bool write_ascii = false,
+                          bool compressed = false);
+
 }  // namespace io
 }  // namespace open3d
@@ -43,7 +43,8 @@ bool ReadPoseGraphFromJSON(const std::string &filename,
 }
 
 bool WritePoseGraphToJSON(const std::string &filename,
-                          const registration::PoseGraph &pose_graph) {
+                          const registration::PoseGraph &pose_graph,
+                          bool compressed) {
     return WriteIJsonConvertibleToJSON(filename, pose_graph);
 }
 
@@ -52,14 +53,17 @@ static const std::unordered_map<
         std::function<bool(const std::string &, registration::PoseGraph &)>>
         file_extension_to_pose_graph_read_function{
                 {"json", ReadPoseGraphFromJSON},
+                {"o3d", ReadPoseGraphFromO3D},
         };
 
 static const std::unordered_map<
         std::string,
         std::function<bool(const std::string &,
-                           const registration::PoseGraph &)>>
+                           const registration::PoseGraph &,
+                           const bool)>>
         file_extension_to_pose_graph_write_function{
                 {"json", WritePoseGraphToJSON},
+                {"o3d", WritePoseGraphToO3D},
         };
 
 }  // unnamed namespace
@@ -94,7 +98,8 @@ bool ReadPoseGraph(const std::string &filename,
 }
 
 bool WritePoseGraph(const std::string &filename,
-                    const registration::PoseGraph &pose_graph) {
+                    const registration::PoseGraph &pose_graph,
+                    bool compressed /* = false*/) {
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
@@ -111,7 +116,7 @@ bool WritePoseGraph(const std::string &filename,
                 "extension.\n");
         return false;
     }
-    return map_itr->second(filename, pose_graph);
+    return map_itr->second(filename, pose_graph, compressed);
 }
 
 }  // namespace io
@@ -47,9 +47,19 @@ bool ReadPoseGraph(const std::string &filename,
 
 /// The general entrance for writing a PoseGraph to a file.
 /// The function calls write functions based on the extension name of filename.
+/// If the write function supports compression, \param compressed will be
+/// used. Otherwise it will be ignored.
 /// \return return true if the write function is successful, false otherwise.
 bool WritePoseGraph(const std::string &filename,
-                    const registration::PoseGraph &pose_graph);
+                    const registration::PoseGraph &pose_graph,
+                    bool compressed = false);
+
+bool ReadPoseGraphFromO3D(const std::string &filename,
+                          registration::PoseGraph &pose_graph);
+
+bool WritePoseGraphToO3D(const std::string &filename,
+                         const registration::PoseGraph &pose_graph,
+                         bool compressed = false);
 
 }  // namespace io
 }  // namespace open3d
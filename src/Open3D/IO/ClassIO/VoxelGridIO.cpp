@@ -41,6 +41,7 @@ static const std::unordered_map<
         std::function<bool(const std::string &, geometry::VoxelGrid &)>>
         file_extension_to_voxelgrid_read_function{
                 {"ply", ReadVoxelGridFromPLY},
+                {"o3d", ReadVoxelGridFromO3D},
         };
 
 static const std::unordered_map<std::string,
@@ -50,6 +51,7 @@ static const std::unordered_map<std::string,
                                                    const bool)>>
         file_extension_to_voxelgrid_write_function{
                 {"ply", WriteVoxelGridToPLY},
+                {"o3d", WriteVoxelGridToO3D},
         };
 }  // unnamed namespace
 
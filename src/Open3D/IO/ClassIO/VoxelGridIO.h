@@ -63,5 +63,13 @@ bool WriteVoxelGridToPLY(const std::string &filename,
                          bool write_ascii = false,
                          bool compressed = false);
 
+bool ReadVoxelGridFromO3D(const std::string &filename,
+                          geometry::VoxelGrid &voxelgrid);
+
+bool WriteVoxelGridToO3D(const std::string &filename,
+                         const geometry::VoxelGrid &voxelgrid,
+                         bool write_ascii = false,
+                         bool compressed = false);
+
 }  // namespace io
 }  // namespace open3d
@@ -0,0 +1,383 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/FileFormat/FileASCII.h"
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace open3d {
+
+namespace {
+
+const double kPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                              1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                              1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+           c == '\f';
+}
+
+bool StartsWithNoCase(const char *begin, const char *end, const char *word) {
+    for (; *word != '\0'; word++, begin++) {
+        if (begin == end || (*begin | 0x20) != *word) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Parses "inf", "infinity" and "nan" after an optional sign.
+const char *ParseSpecialDouble(const char *begin,
+                               const char *end,
+                               bool negative,
+                               double &value) {
+    if (StartsWithNoCase(begin, end, "infinity")) {
+        value = negative ? -INFINITY : INFINITY;
+        return begin + 8;
+    }
+    if (StartsWithNoCase(begin, end, "inf")) {
+        value = negative ? -INFINITY : INFINITY;
+        return begin + 3;
+    }
+    if (StartsWithNoCase(begin, end, "nan")) {
+        value = negative ? -NAN : NAN;
+        return begin + 3;
+    }
+    return NULL;
+}
+
+char *FormatUInt(uint64_t value, char *buffer) {
+    char digits[20];
+    int num_digits = 0;
+    do {
+        digits[num_digits++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (num_digits > 0) {
+        *buffer++ = digits[--num_digits];
+    }
+    return buffer;
+}
+
+/// Parses the lines of [begin, end) with \param parse_line, splitting the
+/// range at line boundaries into one part per thread.
+void ParseLinesInParallel(
+        const char *begin,
+        const char *end,
+        int num_values,
+        const std::function<bool(const char *, const char *, double *)>
+                &parse_line,
+        std::vector<std::vector<double>> &part_values) {
+    const int num_parts = (int)part_values.size();
+    std::vector<const char *> bounds(num_parts + 1, end);
+    bounds[0] = begin;
+    for (int t = 1; t < num_parts; t++) {
+        const char *p = std::max(bounds[t - 1],
+                                 begin + (end - begin) * t / num_parts);
+        if (p > begin && p < end && p[-1] != '\n') {
+            p = (const char *)memchr(p, '\n', end - p);
+            p = p == NULL ? end : p + 1;
+        }
+        bounds[t] = p;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (int t = 0; t < num_parts; t++) {
+        std::vector<double> &values = part_values[t];
+        values.clear();
+        const char *line = bounds[t];
+        while (line < bounds[t + 1]) {
+            const char *line_end =
+                    (const char *)memchr(line, '\n', bounds[t + 1] - line);
+            if (line_end == NULL) {
+                line_end = bounds[t + 1];
+            }
+            const size_t size = values.size();
+            values.resize(size + num_values);
+            if (!parse_line(line, line_end, values.data() + size)) {
+                values.resize(size);
+            }
+            line = line_end + 1;
+        }
+    }
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+const char *ParseDouble(const char *begin, const char *end, double &value) {
+    const char *p = begin;
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    const char *number = p;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool is_exact = true;
+    for (; p < end && IsDigit(*p); p++) {
+        has_digits = true;
+        if (num_digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            num_digits += mantissa > 0 ? 1 : 0;
+        } else {
+            exponent++;
+            is_exact = false;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && IsDigit(*p); p++) {
+            has_digits = true;
+            if (num_digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                num_digits += mantissa > 0 ? 1 : 0;
+                exponent--;
+            } else {
+                is_exact = false;
+            }
+        }
+    }
+    if (!has_digits) {
+        return ParseSpecialDouble(p, end, negative, value);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negative_exponent = false;
+        if (q < end && (*q == '+' || *q == '-')) {
+            negative_exponent = *q == '-';
+            q++;
+        }
+        if (q < end && IsDigit(*q)) {
+            int e = 0;
+            for (; q < end && IsDigit(*q); q++) {
+                e = std::min(e * 10 + (*q - '0'), 100000);
+            }
+            exponent += negative_exponent ? -e : e;
+            p = q;
+        }
+    }
+    if (is_exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 &&
+        exponent <= 22) {
+        // Both the mantissa and the power of 10 are exact doubles, so a
+        // single correctly rounded operation gives the correct result.
+        value = (double)mantissa;
+        value = exponent < 0 ? value / kPowersOf10[-exponent]
+                             : value * kPowersOf10[exponent];
+        value = negative ? -value : value;
+        return p;
+    }
+    const std::string token(number, p);
+    if (*localeconv()->decimal_point == '.') {
+        value = strtod(token.c_str(), NULL);
+        return p;
+    }
+    std::istringstream stream(token);
+    stream.imbue(std::locale::classic());
+    stream >> value;
+    return stream.fail() ? NULL : p;
+}
+
+char *FormatDouble(double value, int precision, char *buffer) {
+    if (std::isnan(value)) {
+        memcpy(buffer, "nan", 3);
+        return buffer + 3;
+    }
+    if (std::signbit(value)) {
+        *buffer++ = '-';
+        value = -value;
+    }
+    if (std::isinf(value)) {
+        memcpy(buffer, "inf", 3);
+        return buffer + 3;
+    }
+    uint64_t integer_part;
+    uint64_t fraction_part = 0;
+    if (precision == 0 && value < 9007199254740992.0) {
+        integer_part = (uint64_t)std::nearbyint(value);
+        buffer = FormatUInt(integer_part, buffer);
+    } else if (value < 9007199254740992.0) {
+        // Both parts are exact, only the scaled fraction is rounded.
+        const double integer = std::floor(value);
+        const uint64_t scale = (uint64_t)kPowersOf10[precision];
+        const double fraction = value - integer;
+        const double scaled = fraction * scale;
+        double rounded = std::nearbyint(scaled);
+        const double remainder = scaled - rounded;
+        if (std::abs(std::abs(remainder) - 0.5) < 1e-3) {
+            // Close to a tie the rounding error of the product, which fma
+            // gives exactly, decides the direction.
+            const double exact =
+                    remainder + std::fma(fraction, (double)scale, -scaled);
+            if (exact > 0.5) {
+                rounded += 1.0;
+            } else if (exact < -0.5) {
+                rounded -= 1.0;
+            }
+        }
+        integer_part = (uint64_t)integer;
+        fraction_part = (uint64_t)rounded;
+        if (fraction_part >= scale) {
+            fraction_part -= scale;
+            integer_part++;
+        }
+        buffer = FormatUInt(integer_part, buffer);
+    } else {
+        // Doubles above 2^53 are integers; "%.0f" prints no decimal point.
+        buffer += snprintf(buffer, 320, "%.0f", value);
+    }
+    if (precision > 0) {
+        *buffer++ = '.';
+        for (int i = precision - 1; i >= 0; i--) {
+            buffer[i] = (char)('0' + fraction_part % 10);
+            fraction_part /= 10;
+        }
+        buffer += precision;
+    }
+    return buffer;
+}
+
+bool ReadASCIILines(
+        FILE *file,
+        int num_values,
+        const std::function<bool(const char *, const char *, double *)>
+                &parse_line,
+        const std::function<void(const double *, size_t)> &append,
+        size_t chunk_size /* = 1 << 24*/) {
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    std::vector<std::vector<double>> part_values(num_threads);
+    std::vector<char> buffer;
+    size_t size = 0;
+    bool eof = false;
+    while (!eof) {
+        buffer.resize(size + chunk_size);
+        const size_t num_read =
+                fread(buffer.data() + size, 1, chunk_size, file);
+        if (num_read < chunk_size) {
+            if (ferror(file)) {
+                return false;
+            }
+            eof = true;
+        }
+        size += num_read;
+        // Parse whole lines only, the rest is kept for the next chunk.
+        size_t cut = size;
+        if (!eof) {
+            while (cut > 0 && buffer[cut - 1] != '\n') {
+                cut--;
+            }
+            if (cut == 0) {
+                continue;
+            }
+        }
+        ParseLinesInParallel(buffer.data(), buffer.data() + cut, num_values,
+                             parse_line, part_values);
+        for (const auto &values : part_values) {
+            if (!values.empty()) {
+                append(values.data(), values.size() / num_values);
+            }
+        }
+        memmove(buffer.data(), buffer.data() + cut, size - cut);
+        size -= cut;
+    }
+    return true;
+}
+
+void ASCIIWriter::WriteInt(int value) {
+    Reserve(12);
+    char *buffer = buffer_.data() + size_;
+    if (value < 0) {
+        *buffer++ = '-';
+    }
+    const uint64_t magnitude =
+            value < 0 ? uint64_t(-(int64_t)value) : uint64_t(value);
+    size_ = FormatUInt(magnitude, buffer) - buffer_.data();
+}
+
+bool ASCIIWriter::Flush() {
+    if (size_ > 0 && fwrite(buffer_.data(), 1, size_, file_) != size_) {
+        failed_ = true;
+    }
+    size_ = 0;
+    return !failed_;
+}
+
+bool ParseDoubles(const char *begin,
+                  const char *end,
+                  int num_values,
+                  double *values) {
+    for (int i = 0; i < num_values; i++) {
+        begin = ParseDouble(begin, end, values[i]);
+        if (begin == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int CountTokens(const char *begin, const char *end) {
+    int num_tokens = 0;
+    while (begin < end) {
+        while (begin < end && IsSpace(*begin)) {
+            begin++;
+        }
+        if (begin == end) {
+            break;
+        }
+        num_tokens++;
+        while (begin < end && !IsSpace(*begin)) {
+            begin++;
+        }
+    }
+    return num_tokens;
+}
+
+}  // namespace io
+}  // namespace open3d
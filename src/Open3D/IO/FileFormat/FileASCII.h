@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace open3d {
+namespace io {
+
+/// Locale independent parser of a decimal floating point number starting at
+/// \param begin, such as "-1.25e+3". Leading spaces and tabs are skipped.
+/// Mantissas up to 2^53 with a decimal exponent of at most 22 are converted
+/// exactly with one multiplication or division. Other numbers fall back to
+/// strtod, or to a classic locale stream if the C locale does not use '.' as
+/// decimal point.
+/// \return the end of the number, or NULL if no number starts at \param begin.
+const char *ParseDouble(const char *begin, const char *end, double &value);
+
+/// Parses the first \param num_values numbers of the line [begin, end) into
+/// \param values, like sscanf("%lf %lf ...") does.
+/// \return false if the line starts with fewer numbers.
+bool ParseDoubles(const char *begin,
+                  const char *end,
+                  int num_values,
+                  double *values);
+
+/// \return the number of whitespace separated tokens in [begin, end).
+int CountTokens(const char *begin, const char *end);
+
+/// Size of a buffer that can hold any double written by FormatDouble.
+const int MAX_FORMATTED_DOUBLE_SIZE = 352;
+
+/// Writes \param value with \param precision (0 to 15) digits after the
+/// decimal point, as printf("%.*f") does but independently of the locale, to
+/// \param buffer, which must hold MAX_FORMATTED_DOUBLE_SIZE characters.
+/// Values below 2^53 are converted with integer arithmetic.
+/// \return the end of the written characters. No terminating zero is written.
+char *FormatDouble(double value, int precision, char *buffer);
+
+/// Reads the lines of \param file from its current position in chunks of
+/// about \param chunk_size bytes that end at line boundaries. The lines of a
+/// chunk are parsed in parallel by parse_line(begin, end, values), which
+/// writes \param num_values values and returns false to drop the line. The
+/// values of the kept lines are passed to append(values, num_lines) in file
+/// order.
+/// \return false if reading \param file failed.
+bool ReadASCIILines(
+        FILE *file,
+        int num_values,
+        const std::function<bool(const char *, const char *, double *)>
+                &parse_line,
+        const std::function<void(const double *, size_t)> &append,
+        size_t chunk_size = 1 << 24);
+
+/// Formats text into a large buffer and writes it to a file in big blocks
+/// instead of one fprintf call per line.
+class ASCIIWriter {
+public:
+    explicit ASCIIWriter(FILE *file) : file_(file) {}
+    ~ASCIIWriter() { Flush(); }
+
+public:
+    /// Writes \param value with \param precision digits after the decimal
+    /// point.
+    void WriteDouble(double value, int precision) {
+        Reserve(MAX_FORMATTED_DOUBLE_SIZE);
+        size_ = FormatDouble(value, precision, buffer_.data() + size_) -
+                buffer_.data();
+    }
+
+    void WriteInt(int value);
+
+    void WriteString(const char *str) {
+        for (; *str != '\0'; str++) {
+            WriteChar(*str);
+        }
+    }
+
+    void WriteChar(char c) {
+        Reserve(1);
+        buffer_[size_++] = c;
+    }
+
+    /// Writes the buffered text to the file.
+    /// \return false if any write failed so far.
+    bool Flush();
+
+private:
+    void Reserve(size_t num_chars) {
+        if (size_ + num_chars > buffer_.size()) {
+            Flush();
+        }
+    }
+
+private:
+    FILE *file_;
+    std::vector<char> buffer_ = std::vector<char>(1 << 22);
+    size_t size_ = 0;
+    bool failed_ = false;
+};
+
+}  // namespace io
+}  // namespace open3d
@@ -114,7 +114,8 @@ bool ReadPinholeCameraTrajectoryFromLOG(
 
 bool WritePinholeCameraTrajectoryToLOG(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory) {
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed /* = false*/) {
     FILE *f = fopen(filename.c_str(), "w");
     if (f == NULL) {
         utility::PrintWarning("Write LOG failed: unable to open file: %s\n",
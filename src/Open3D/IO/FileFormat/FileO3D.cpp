@@ -0,0 +1,1120 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <liblzf/lzf.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+#ifndef WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/IO/ClassIO/FeatureIO.h"
+#include "Open3D/IO/ClassIO/ImageWarpingFieldIO.h"
+#include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
+#include "Open3D/IO/ClassIO/VoxelGridIO.h"
+#include "Open3D/Utility/Console.h"
+
+// The native O3D container stores a file header, a table of chunk headers
+// and the chunk data. Each chunk is a named array of fixed-size elements in
+// the native memory layout of the geometry attribute it comes from (e.g. an
+// std::vector<Eigen::Vector3d> is stored as packed triplets of doubles). Chunk
+// data starts at offsets aligned to O3D_ALIGNMENT, so reading a file is a
+// memory mapping followed by one memcpy per attribute, without any parsing.
+// Readers skip chunks they do not know; unknown or newer versions are
+// rejected, as are files written on a machine with a different byte order.
+//
+// Since version 2 a chunk may be LZF compressed. Its data is then a sequence
+// of blocks of at most O3D_COMPRESSION_BLOCK_SIZE bytes, each one prefixed by
+// its uncompressed and stored sizes, so that blocks are compressed and
+// decompressed in parallel. Blocks that do not compress are stored as is.
+
+namespace open3d {
+
+namespace {
+using namespace io;
+
+const char O3D_MAGIC[8] = {'O', '3', 'D', 'B', 'I', 'N', '\r', '\n'};
+const uint32_t O3D_VERSION = 2;
+const uint32_t O3D_BYTE_ORDER_MARK = 0x01020304;
+const uint64_t O3D_ALIGNMENT = 64;
+const size_t O3D_CHUNK_NAME_SIZE = 32;
+const uint32_t O3D_COMPRESSION_BLOCK_SIZE = 1 << 20;
+
+enum class O3DContentType : uint32_t {
+    PointCloud = 1,
+    TriangleMesh = 2,
+    VoxelGrid = 3,
+    Feature = 4,
+    PoseGraph = 5,
+    PinholeCameraTrajectory = 6,
+    ImageWarpingField = 7,
+};
+
+enum class O3DScalarType : uint32_t {
+    Float64 = 1,
+    Int32 = 2,
+    UInt8 = 3,
+    Float16 = 4,
+};
+
+enum class O3DEncoding : uint32_t {
+    Raw = 0,
+    LZF = 1,
+};
+
+struct O3DFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint32_t content_type;
+    uint32_t num_chunks;
+    uint64_t file_size;
+};
+
+struct O3DChunkHeader {
+    char name[O3D_CHUNK_NAME_SIZE];
+    uint32_t scalar_type;
+    uint32_t num_components;
+    uint64_t num_elements;
+    uint64_t offset;
+    uint32_t encoding;
+    uint32_t reserved;
+    /// Number of bytes stored in the file.
+    uint64_t size;
+};
+
+/// Chunk header of version 1 files, which are always uncompressed.
+struct O3DChunkHeaderV1 {
+    char name[O3D_CHUNK_NAME_SIZE];
+    uint32_t scalar_type;
+    uint32_t num_components;
+    uint64_t num_elements;
+    uint64_t offset;
+};
+
+template <typename Scalar>
+struct O3DScalarTypeOf;
+
+template <>
+struct O3DScalarTypeOf<double> {
+    static const O3DScalarType value = O3DScalarType::Float64;
+};
+
+template <>
+struct O3DScalarTypeOf<int> {
+    static const O3DScalarType value = O3DScalarType::Int32;
+};
+
+template <>
+struct O3DScalarTypeOf<uint8_t> {
+    static const O3DScalarType value = O3DScalarType::UInt8;
+};
+
+/// Half precision floats are handled as their bit patterns.
+template <>
+struct O3DScalarTypeOf<uint16_t> {
+    static const O3DScalarType value = O3DScalarType::Float16;
+};
+
+size_t O3DScalarSize(uint32_t scalar_type) {
+    switch ((O3DScalarType)scalar_type) {
+        case O3DScalarType::Float64:
+            return 8;
+        case O3DScalarType::Int32:
+            return 4;
+        case O3DScalarType::UInt8:
+            return 1;
+        case O3DScalarType::Float16:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+uint64_t AlignO3DOffset(uint64_t offset) {
+    return (offset + O3D_ALIGNMENT - 1) / O3D_ALIGNMENT * O3D_ALIGNMENT;
+}
+
+/// Converts to IEEE 754 half precision, rounding to nearest even.
+uint16_t DoubleToHalf(double value) {
+    const float value_float = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &value_float, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+    if (((bits >> 23) & 0xff) == 0xff) {
+        return (uint16_t)(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+    }
+    if (exponent >= 31) {
+        return (uint16_t)(sign | 0x7c00);
+    }
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return (uint16_t)sign;
+        }
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) {
+            half++;
+        }
+        return (uint16_t)(sign | half);
+    }
+    uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1fff;
+    // A carry out of the mantissa correctly rounds up to the next exponent.
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        half++;
+    }
+    return (uint16_t)(sign | half);
+}
+
+double HalfToDouble(uint16_t half) {
+    const double sign = (half & 0x8000) ? -1.0 : 1.0;
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+    if (exponent == 0) {
+        return sign * std::ldexp((double)mantissa, -24);
+    }
+    if (exponent == 31) {
+        return mantissa != 0 ? std::numeric_limits<double>::quiet_NaN()
+                             : sign * std::numeric_limits<double>::infinity();
+    }
+    return sign * std::ldexp((double)(mantissa | 0x400), exponent - 25);
+}
+
+/// Compresses \param size bytes into blocks appended to \param encoded.
+void EncodeLZF(const char *data, uint64_t size, std::vector<char> &encoded) {
+    const int64_t num_blocks =
+            (int64_t)((size + O3D_COMPRESSION_BLOCK_SIZE - 1) /
+                      O3D_COMPRESSION_BLOCK_SIZE);
+    std::vector<std::vector<char>> blocks(num_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const uint64_t begin = b * (uint64_t)O3D_COMPRESSION_BLOCK_SIZE;
+        const uint32_t raw_size = (uint32_t)std::min(
+                (uint64_t)O3D_COMPRESSION_BLOCK_SIZE, size - begin);
+        auto &block = blocks[b];
+        block.resize(2 * sizeof(uint32_t) + raw_size);
+        char *stored = block.data() + 2 * sizeof(uint32_t);
+        // lzf_compress fails if the output would not be smaller.
+        uint32_t stored_size = lzf_compress(data + begin, raw_size, stored,
+                                            raw_size - 1);
+        if (stored_size == 0) {
+            stored_size = raw_size;
+            memcpy(stored, data + begin, raw_size);
+        }
+        memcpy(block.data(), &raw_size, sizeof(uint32_t));
+        memcpy(block.data() + sizeof(uint32_t), &stored_size,
+               sizeof(uint32_t));
+        block.resize(2 * sizeof(uint32_t) + stored_size);
+    }
+    for (const auto &block : blocks) {
+        encoded.insert(encoded.end(), block.begin(), block.end());
+    }
+}
+
+/// Decompresses the blocks in \param encoded into exactly \param size bytes.
+bool DecodeLZF(const char *encoded,
+               uint64_t encoded_size,
+               char *data,
+               uint64_t size) {
+    std::vector<uint64_t> encoded_offsets, offsets;
+    uint64_t encoded_offset = 0, offset = 0;
+    while (encoded_offset < encoded_size) {
+        uint32_t sizes[2];
+        if (encoded_size - encoded_offset < sizeof(sizes)) {
+            return false;
+        }
+        memcpy(sizes, encoded + encoded_offset, sizeof(sizes));
+        if (sizes[1] > sizes[0] || sizes[0] > O3D_COMPRESSION_BLOCK_SIZE ||
+            sizes[1] > encoded_size - encoded_offset - sizeof(sizes) ||
+            sizes[0] > size - offset) {
+            return false;
+        }
+        encoded_offsets.push_back(encoded_offset);
+        offsets.push_back(offset);
+        encoded_offset += sizeof(sizes) + sizes[1];
+        offset += sizes[0];
+    }
+    if (offset != size) {
+        return false;
+    }
+    bool success = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : success)
+#endif
+    for (int64_t b = 0; b < (int64_t)offsets.size(); b++) {
+        uint32_t sizes[2];
+        memcpy(sizes, encoded + encoded_offsets[b], sizeof(sizes));
+        const char *stored = encoded + encoded_offsets[b] + sizeof(sizes);
+        if (sizes[1] == sizes[0]) {
+            memcpy(data + offsets[b], stored, sizes[0]);
+        } else if (lzf_decompress(stored, sizes[1], data + offsets[b],
+                                  sizes[0]) != sizes[0]) {
+            success = false;
+        }
+    }
+    return success;
+}
+
+/// Collects the chunks of a file and writes them. The data is not copied, so
+/// it must stay alive until Write() returns.
+class O3DWriter {
+public:
+    template <typename Scalar>
+    void AddChunk(const char *name,
+                  const Scalar *data,
+                  size_t num_elements,
+                  uint32_t num_components) {
+        O3DChunkHeader chunk;
+        memset(&chunk, 0, sizeof(chunk));
+        strncpy(chunk.name, name, O3D_CHUNK_NAME_SIZE - 1);
+        chunk.scalar_type = (uint32_t)O3DScalarTypeOf<Scalar>::value;
+        chunk.num_components = num_components;
+        chunk.num_elements = num_elements;
+        chunk.encoding = (uint32_t)O3DEncoding::Raw;
+        chunk.size = num_elements * num_components * sizeof(Scalar);
+        chunks_.push_back(chunk);
+        data_.push_back((const char *)data);
+    }
+
+    /// Adds a chunk of fixed-size Eigen vectors, e.g. Eigen::Vector3d.
+    template <typename T>
+    void AddChunk(const char *name, const std::vector<T> &data) {
+        typedef typename T::Scalar Scalar;
+        static_assert(sizeof(T) == sizeof(Scalar) * T::SizeAtCompileTime,
+                      "Elements must be densely packed.");
+        AddChunk(name, data.empty() ? (const Scalar *)NULL : data[0].data(),
+                 data.size(), (uint32_t)T::SizeAtCompileTime);
+    }
+
+    bool Write(const std::string &filename,
+               O3DContentType content_type,
+               bool compressed) {
+        std::vector<std::vector<char>> encoded(chunks_.size());
+        if (compressed) {
+            for (size_t i = 0; i < chunks_.size(); i++) {
+                if (chunks_[i].size < O3D_ALIGNMENT) {
+                    continue;
+                }
+                EncodeLZF(data_[i], chunks_[i].size, encoded[i]);
+                chunks_[i].encoding = (uint32_t)O3DEncoding::LZF;
+                chunks_[i].size = encoded[i].size();
+                data_[i] = encoded[i].data();
+            }
+        }
+
+        O3DFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, O3D_MAGIC, sizeof(O3D_MAGIC));
+        header.version = O3D_VERSION;
+        header.byte_order_mark = O3D_BYTE_ORDER_MARK;
+        header.content_type = (uint32_t)content_type;
+        header.num_chunks = (uint32_t)chunks_.size();
+        uint64_t offset =
+                sizeof(header) + chunks_.size() * sizeof(O3DChunkHeader);
+        for (auto &chunk : chunks_) {
+            offset = AlignO3DOffset(offset);
+            chunk.offset = offset;
+            offset += chunk.size;
+        }
+        header.file_size = offset;
+
+        FILE *file = fopen(filename.c_str(), "wb");
+        if (file == NULL) {
+            utility::PrintWarning("Write O3D failed: unable to open file: %s\n",
+                                  filename.c_str());
+            return false;
+        }
+        bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+        if (success && !chunks_.empty()) {
+            success = fwrite(chunks_.data(), sizeof(O3DChunkHeader),
+                             chunks_.size(), file) == chunks_.size();
+        }
+        offset = sizeof(header) + chunks_.size() * sizeof(O3DChunkHeader);
+        const char padding[O3D_ALIGNMENT] = {0};
+        for (size_t i = 0; success && i < chunks_.size(); i++) {
+            const size_t padding_size = (size_t)(chunks_[i].offset - offset);
+            const size_t size = (size_t)chunks_[i].size;
+            success = fwrite(padding, 1, padding_size, file) == padding_size &&
+                      (size == 0 || fwrite(data_[i], 1, size, file) == size);
+            offset = chunks_[i].offset + size;
+        }
+        if (fclose(file) != 0) {
+            success = false;
+        }
+        if (!success) {
+            utility::PrintWarning(
+                    "Write O3D failed: unable to write file: %s\n",
+                    filename.c_str());
+        }
+        return success;
+    }
+
+private:
+    std::vector<O3DChunkHeader> chunks_;
+    std::vector<const char *> data_;
+};
+
+/// Maps a file into memory and looks up its chunks. Where memory mapping is
+/// not available the file is read into a buffer instead.
+class O3DReader {
+public:
+    O3DReader() {}
+    ~O3DReader() { Close(); }
+    O3DReader(const O3DReader &) = delete;
+    O3DReader &operator=(const O3DReader &) = delete;
+
+public:
+    bool Open(const std::string &filename, O3DContentType content_type) {
+        if (!Map(filename)) {
+            utility::PrintWarning("Read O3D failed: unable to open file: %s\n",
+                                  filename.c_str());
+            return false;
+        }
+        O3DFileHeader header;
+        if (size_ < sizeof(header)) {
+            utility::PrintWarning("Read O3D failed: unexpected EOF.\n");
+            return false;
+        }
+        memcpy(&header, data_, sizeof(header));
+        if (memcmp(header.magic, O3D_MAGIC, sizeof(O3D_MAGIC)) != 0) {
+            utility::PrintWarning("Read O3D failed: not an O3D file: %s\n",
+                                  filename.c_str());
+            return false;
+        }
+        if (header.byte_order_mark != O3D_BYTE_ORDER_MARK) {
+            utility::PrintWarning(
+                    "Read O3D failed: the file was written with a different "
+                    "byte order.\n");
+            return false;
+        }
+        if (header.version > O3D_VERSION) {
+            utility::PrintWarning(
+                    "Read O3D failed: unsupported version %u.\n",
+                    header.version);
+            return false;
+        }
+        if (header.content_type != (uint32_t)content_type) {
+            utility::PrintWarning(
+                    "Read O3D failed: the file stores a different type of "
+                    "data.\n");
+            return false;
+        }
+        const size_t chunk_header_size = header.version == 1
+                                                 ? sizeof(O3DChunkHeaderV1)
+                                                 : sizeof(O3DChunkHeader);
+        if ((size_ - sizeof(header)) / chunk_header_size < header.num_chunks) {
+            utility::PrintWarning("Read O3D failed: unexpected EOF.\n");
+            return false;
+        }
+        chunks_.resize(header.num_chunks);
+        for (uint32_t i = 0; i < header.num_chunks; i++) {
+            const char *chunk_header =
+                    data_ + sizeof(header) + i * chunk_header_size;
+            auto &chunk = chunks_[i];
+            if (header.version == 1) {
+                O3DChunkHeaderV1 chunk_v1;
+                memcpy(&chunk_v1, chunk_header, sizeof(chunk_v1));
+                memset(&chunk, 0, sizeof(chunk));
+                memcpy(chunk.name, chunk_v1.name, O3D_CHUNK_NAME_SIZE);
+                chunk.scalar_type = chunk_v1.scalar_type;
+                chunk.num_components = chunk_v1.num_components;
+                chunk.num_elements = chunk_v1.num_elements;
+                chunk.offset = chunk_v1.offset;
+                chunk.encoding = (uint32_t)O3DEncoding::Raw;
+                chunk.size = chunk.num_elements * chunk.num_components *
+                             O3DScalarSize(chunk.scalar_type);
+            } else {
+                memcpy(&chunk, chunk_header, sizeof(chunk));
+            }
+            chunk.name[O3D_CHUNK_NAME_SIZE - 1] = '\0';
+            const uint64_t element_size = chunk.num_components *
+                                          O3DScalarSize(chunk.scalar_type);
+            bool valid = O3DScalarSize(chunk.scalar_type) != 0 &&
+                         chunk.offset <= size_ &&
+                         chunk.size <= size_ - chunk.offset;
+            if (chunk.encoding == (uint32_t)O3DEncoding::Raw) {
+                valid = valid &&
+                        (element_size == 0 ||
+                         (chunk.num_elements == chunk.size / element_size &&
+                          chunk.size % element_size == 0));
+            } else if (chunk.encoding == (uint32_t)O3DEncoding::LZF) {
+                // Bound the decompressed size before allocating for it.
+                const uint64_t max_size = (chunk.size / 8 + 1) *
+                                          O3D_COMPRESSION_BLOCK_SIZE;
+                valid = valid &&
+                        (element_size == 0 ||
+                         chunk.num_elements <= max_size / element_size);
+            } else {
+                valid = false;
+            }
+            if (!valid) {
+                utility::PrintWarning(
+                        "Read O3D failed: chunk %s is corrupted.\n",
+                        chunk.name);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns the header of chunk \param name, or NULL if the file does not
+    /// have the chunk.
+    const O3DChunkHeader *FindChunk(const char *name) const {
+        for (const auto &chunk : chunks_) {
+            if (strcmp(chunk.name, name) == 0) {
+                return &chunk;
+            }
+        }
+        return NULL;
+    }
+
+    /// Copies chunk \param name into \param data, which is left empty if the
+    /// file does not have the chunk. Returns false if the chunk exists but
+    /// holds a different kind of element.
+    template <typename T>
+    bool ReadChunk(const char *name, std::vector<T> &data) {
+        typedef typename T::Scalar Scalar;
+        static_assert(sizeof(T) == sizeof(Scalar) * T::SizeAtCompileTime,
+                      "Elements must be densely packed.");
+        const O3DChunkHeader *chunk = FindChunk(name);
+        data.clear();
+        if (chunk == NULL) {
+            return true;
+        }
+        if (!CheckChunkType<Scalar>(*chunk, (uint32_t)T::SizeAtCompileTime)) {
+            return false;
+        }
+        data.resize((size_t)chunk->num_elements);
+        return data.empty() || DecodeChunk(*chunk, (char *)data[0].data());
+    }
+
+    /// Points \param data at the elements of chunk \param name, inside the
+    /// mapping unless the chunk is compressed; \param num_elements is 0 if the
+    /// file does not have the chunk.
+    template <typename Scalar>
+    bool GetChunk(const char *name,
+                  uint32_t num_components,
+                  const Scalar *&data,
+                  size_t &num_elements) {
+        data = NULL;
+        num_elements = 0;
+        const O3DChunkHeader *chunk = FindChunk(name);
+        if (chunk == NULL) {
+            return true;
+        }
+        if (!CheckChunkType<Scalar>(*chunk, num_components)) {
+            return false;
+        }
+        num_elements = (size_t)chunk->num_elements;
+        if (chunk->encoding == (uint32_t)O3DEncoding::Raw) {
+            data = (const Scalar *)(data_ + chunk->offset);
+            return true;
+        }
+        decoded_.push_back(std::vector<char>(num_elements * num_components *
+                                             sizeof(Scalar)));
+        auto &decoded = decoded_.back();
+        data = (const Scalar *)decoded.data();
+        return DecodeChunk(*chunk, decoded.data());
+    }
+
+private:
+    template <typename Scalar>
+    bool CheckChunkType(const O3DChunkHeader &chunk, uint32_t num_components) {
+        if (chunk.scalar_type != (uint32_t)O3DScalarTypeOf<Scalar>::value ||
+            chunk.num_components != num_components) {
+            utility::PrintWarning(
+                    "Read O3D failed: chunk %s has an unexpected element "
+                    "type.\n",
+                    chunk.name);
+            return false;
+        }
+        return true;
+    }
+
+    bool DecodeChunk(const O3DChunkHeader &chunk, char *data) {
+        const uint64_t size = chunk.num_elements * chunk.num_components *
+                              O3DScalarSize(chunk.scalar_type);
+        if (chunk.encoding == (uint32_t)O3DEncoding::Raw) {
+            memcpy(data, data_ + chunk.offset, (size_t)size);
+            return true;
+        }
+        if (!DecodeLZF(data_ + chunk.offset, chunk.size, data, size)) {
+            utility::PrintWarning(
+                    "Read O3D failed: chunk %s is corrupted.\n", chunk.name);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool Map(const std::string &filename) {
+#ifdef WINDOWS
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (file == NULL) {
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size < 0) {
+            fclose(file);
+            return false;
+        }
+        buffer_.resize((size_t)size);
+        const bool success = fread(buffer_.data(), 1, buffer_.size(),
+                                   file) == buffer_.size();
+        fclose(file);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return success;
+#else
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            return false;
+        }
+        size_ = (size_t)file_stat.st_size;
+        if (size_ == 0) {
+            close(fd);
+            return true;
+        }
+        void *mapping = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = (const char *)mapping;
+        return true;
+#endif
+    }
+
+    void Close() {
+#ifdef WINDOWS
+        buffer_.clear();
+#else
+        if (data_ != NULL) {
+            munmap((void *)data_, size_);
+        }
+#endif
+        data_ = NULL;
+        size_ = 0;
+    }
+
+private:
+    const char *data_ = NULL;
+    size_t size_ = 0;
+#ifdef WINDOWS
+    std::vector<char> buffer_;
+#endif
+    std::vector<O3DChunkHeader> chunks_;
+    /// Decompressed chunks handed out by GetChunk().
+    std::vector<std::vector<char>> decoded_;
+};
+
+/// Returns false if a non-empty attribute does not match \param num_elements.
+bool CheckO3DAttributeSize(const char *name,
+                           size_t size,
+                           size_t num_elements) {
+    if (size != 0 && size != num_elements) {
+        utility::PrintWarning(
+                "Read O3D failed: %s has %d elements instead of %d.\n", name,
+                (int)size, (int)num_elements);
+        return false;
+    }
+    return true;
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+bool ReadPointCloudFromO3D(const std::string &filename,
+                           geometry::PointCloud &pointcloud) {
+    O3DReader reader;
+    pointcloud.Clear();
+    if (!reader.Open(filename, O3DContentType::PointCloud) ||
+        !reader.ReadChunk("points", pointcloud.points_) ||
+        !reader.ReadChunk("normals", pointcloud.normals_) ||
+        !reader.ReadChunk("colors", pointcloud.colors_)) {
+        return false;
+    }
+    const size_t num_points = pointcloud.points_.size();
+    return CheckO3DAttributeSize("normals", pointcloud.normals_.size(),
+                                 num_points) &&
+           CheckO3DAttributeSize("colors", pointcloud.colors_.size(),
+                                 num_points);
+}
+
+bool WritePointCloudToO3D(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          bool write_ascii /* = false*/,
+                          bool compressed /* = false*/) {
+    O3DWriter writer;
+    writer.AddChunk("points", pointcloud.points_);
+    if (pointcloud.HasNormals()) {
+        writer.AddChunk("normals", pointcloud.normals_);
+    }
+    if (pointcloud.HasColors()) {
+        writer.AddChunk("colors", pointcloud.colors_);
+    }
+    return writer.Write(filename, O3DContentType::PointCloud, compressed);
+}
+
+bool ReadTriangleMeshFromO3D(const std::string &filename,
+                             geometry::TriangleMesh &mesh) {
+    O3DReader reader;
+    mesh.Clear();
+    if (!reader.Open(filename, O3DContentType::TriangleMesh) ||
+        !reader.ReadChunk("vertices", mesh.vertices_) ||
+        !reader.ReadChunk("vertex_normals", mesh.vertex_normals_) ||
+        !reader.ReadChunk("vertex_colors", mesh.vertex_colors_) ||
+        !reader.ReadChunk("triangles", mesh.triangles_) ||
+        !reader.ReadChunk("triangle_normals", mesh.triangle_normals_)) {
+        return false;
+    }
+    const size_t num_vertices = mesh.vertices_.size();
+    return CheckO3DAttributeSize("vertex_normals",
+                                 mesh.vertex_normals_.size(), num_vertices) &&
+           CheckO3DAttributeSize("vertex_colors", mesh.vertex_colors_.size(),
+                                 num_vertices) &&
+           CheckO3DAttributeSize("triangle_normals",
+                                 mesh.triangle_normals_.size(),
+                                 mesh.triangles_.size());
+}
+
+bool WriteTriangleMeshToO3D(const std::string &filename,
+                            const geometry::TriangleMesh &mesh,
+                            bool write_ascii /* = false*/,
+                            bool compressed /* = false*/) {
+    O3DWriter writer;
+    writer.AddChunk("vertices", mesh.vertices_);
+    if (mesh.HasVertexNormals()) {
+        writer.AddChunk("vertex_normals", mesh.vertex_normals_);
+    }
+    if (mesh.HasVertexColors()) {
+        writer.AddChunk("vertex_colors", mesh.vertex_colors_);
+    }
+    writer.AddChunk("triangles", mesh.triangles_);
+    if (mesh.HasTriangleNormals()) {
+        writer.AddChunk("triangle_normals", mesh.triangle_normals_);
+    }
+    return writer.Write(filename, O3DContentType::TriangleMesh, compressed);
+}
+
+bool ReadVoxelGridFromO3D(const std::string &filename,
+                          geometry::VoxelGrid &voxelgrid) {
+    O3DReader reader;
+    voxelgrid.Clear();
+    const double *voxel_size, *origin;
+    size_t num_voxel_size, num_origin;
+    if (!reader.Open(filename, O3DContentType::VoxelGrid) ||
+        !reader.GetChunk("voxel_size", 1, voxel_size, num_voxel_size) ||
+        !reader.GetChunk("origin", 3, origin, num_origin) ||
+        !reader.ReadChunk("voxels", voxelgrid.voxels_) ||
+        !reader.ReadChunk("colors", voxelgrid.colors_)) {
+        return false;
+    }
+    if (num_voxel_size != 1 || num_origin != 1) {
+        utility::PrintWarning("Read O3D failed: missing voxel grid origin.\n");
+        return false;
+    }
+    voxelgrid.voxel_size_ = voxel_size[0];
+    voxelgrid.origin_ = Eigen::Vector3d(origin[0], origin[1], origin[2]);
+    return CheckO3DAttributeSize("colors", voxelgrid.colors_.size(),
+                                 voxelgrid.voxels_.size());
+}
+
+bool WriteVoxelGridToO3D(const std::string &filename,
+                         const geometry::VoxelGrid &voxelgrid,
+                         bool write_ascii /* = false*/,
+                         bool compressed /* = false*/) {
+    O3DWriter writer;
+    writer.AddChunk("voxel_size", &voxelgrid.voxel_size_, 1, 1);
+    writer.AddChunk("origin", voxelgrid.origin_.data(), 1, 3);
+    writer.AddChunk("voxels", voxelgrid.voxels_);
+    if (voxelgrid.HasColors()) {
+        writer.AddChunk("colors", voxelgrid.colors_);
+    }
+    return writer.Write(filename, O3DContentType::VoxelGrid, compressed);
+}
+
+bool ReadFeatureFromO3D(const std::string &filename,
+                        registration::Feature &feature) {
+    O3DReader reader;
+    if (!reader.Open(filename, O3DContentType::Feature)) {
+        return false;
+    }
+    const int *dimension;
+    size_t num_dimension;
+    if (!reader.GetChunk("dimension", 1, dimension, num_dimension)) {
+        return false;
+    }
+    const O3DChunkHeader *chunk = reader.FindChunk("data");
+    if (num_dimension != 1 || dimension[0] < 0 || chunk == NULL) {
+        utility::PrintWarning("Read O3D failed: missing feature data.\n");
+        return false;
+    }
+    const uint32_t dim = (uint32_t)dimension[0];
+    size_t num_features;
+    if (chunk->scalar_type == (uint32_t)O3DScalarType::Float16) {
+        const uint16_t *data;
+        if (!reader.GetChunk("data", dim, data, num_features)) {
+            return false;
+        }
+        std::vector<double> half_to_double(1 << 16);
+        for (size_t i = 0; i < half_to_double.size(); i++) {
+            half_to_double[i] = HalfToDouble((uint16_t)i);
+        }
+        feature.data_.resize(dim, num_features);
+        double *feature_data = feature.data_.data();
+        const int64_t size = (int64_t)feature.data_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int64_t i = 0; i < size; i++) {
+            feature_data[i] = half_to_double[data[i]];
+        }
+    } else if (chunk->scalar_type == (uint32_t)O3DScalarType::UInt8) {
+        const uint8_t *data;
+        const double *offset, *scale;
+        size_t num_offset, num_scale;
+        if (!reader.GetChunk("data", dim, data, num_features) ||
+            !reader.GetChunk("data_offset", dim, offset, num_offset) ||
+            !reader.GetChunk("data_scale", dim, scale, num_scale)) {
+            return false;
+        }
+        if (num_offset != 1 || num_scale != 1) {
+            utility::PrintWarning(
+                    "Read O3D failed: missing feature quantization.\n");
+            return false;
+        }
+        feature.data_.resize(dim, num_features);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int64_t i = 0; i < (int64_t)num_features; i++) {
+            for (uint32_t d = 0; d < dim; d++) {
+                feature.data_(d, i) = offset[d] + scale[d] * data[i * dim + d];
+            }
+        }
+    } else {
+        const double *data;
+        if (!reader.GetChunk("data", dim, data, num_features)) {
+            return false;
+        }
+        feature.data_.resize(dim, num_features);
+        if (feature.data_.size() > 0) {
+            memcpy(feature.data_.data(), data,
+                   feature.data_.size() * sizeof(double));
+        }
+    }
+    return true;
+}
+
+bool WriteFeatureToO3D(const std::string &filename,
+                       const registration::Feature &feature,
+                       bool compressed /* = false*/,
+                       FeatureStorageType storage_type
+                       /* = FeatureStorageType::Float64*/) {
+    O3DWriter writer;
+    const int dimension = (int)feature.data_.rows();
+    const int64_t num_features = (int64_t)feature.data_.cols();
+    const int64_t size = (int64_t)feature.data_.size();
+    const double *feature_data = feature.data_.data();
+    writer.AddChunk("dimension", &dimension, 1, 1);
+    std::vector<uint16_t> data_float16;
+    std::vector<uint8_t> data_uint8;
+    Eigen::VectorXd offset, scale;
+    switch (storage_type) {
+        case FeatureStorageType::Float16:
+            data_float16.resize(size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int64_t i = 0; i < size; i++) {
+                data_float16[i] = DoubleToHalf(feature_data[i]);
+            }
+            writer.AddChunk("data", data_float16.data(), num_features,
+                            (uint32_t)dimension);
+            break;
+        case FeatureStorageType::UInt8:
+            // Every dimension is quantized over its own range of values. A
+            // feature without columns has no range.
+            if (num_features == 0) {
+                offset = Eigen::VectorXd::Zero(dimension);
+                scale = Eigen::VectorXd::Zero(dimension);
+            } else {
+                offset = feature.data_.rowwise().minCoeff();
+                scale = (feature.data_.rowwise().maxCoeff() - offset) / 255.0;
+            }
+            data_uint8.resize(size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int64_t i = 0; i < num_features; i++) {
+                for (int d = 0; d < dimension; d++) {
+                    const double value =
+                            scale(d) > 0.0
+                                    ? (feature.data_(d, i) - offset(d)) /
+                                              scale(d)
+                                    : 0.0;
+                    data_uint8[i * dimension + d] = (uint8_t)std::min(
+                            std::max(std::round(value), 0.0), 255.0);
+                }
+            }
+            writer.AddChunk("data", data_uint8.data(), num_features,
+                            (uint32_t)dimension);
+            writer.AddChunk("data_offset", offset.data(), 1,
+                            (uint32_t)dimension);
+            writer.AddChunk("data_scale", scale.data(), 1, (uint32_t)dimension);
+            break;
+        default:
+            writer.AddChunk("data", feature_data, num_features,
+                            (uint32_t)dimension);
+            break;
+    }
+    return writer.Write(filename, O3DContentType::Feature, compressed);
+}
+
+bool ReadPoseGraphFromO3D(const std::string &filename,
+                          registration::PoseGraph &pose_graph) {
+    O3DReader reader;
+    if (!reader.Open(filename, O3DContentType::PoseGraph)) {
+        return false;
+    }
+    const double *poses, *transformations, *information, *confidence;
+    const int *node_ids;
+    const uint8_t *uncertain;
+    size_t num_nodes, num_edges[5];
+    if (!reader.GetChunk("node_poses", 16, poses, num_nodes) ||
+        !reader.GetChunk("edge_node_ids", 2, node_ids, num_edges[0]) ||
+        !reader.GetChunk("edge_transforms", 16, transformations,
+                         num_edges[1]) ||
+        !reader.GetChunk("edge_information", 36, information,
+                         num_edges[2]) ||
+        !reader.GetChunk("edge_uncertain", 1, uncertain, num_edges[3]) ||
+        !reader.GetChunk("edge_confidence", 1, confidence, num_edges[4])) {
+        return false;
+    }
+    for (int i = 1; i < 5; i++) {
+        if (num_edges[i] != num_edges[0]) {
+            utility::PrintWarning(
+                    "Read O3D failed: inconsistent pose graph edges.\n");
+            return false;
+        }
+    }
+    pose_graph.nodes_.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+        memcpy(pose_graph.nodes_[i].pose_.data(), poses + i * 16,
+               16 * sizeof(double));
+    }
+    pose_graph.edges_.resize(num_edges[0]);
+    for (size_t i = 0; i < num_edges[0]; i++) {
+        auto &edge = pose_graph.edges_[i];
+        edge.source_node_id_ = node_ids[i * 2];
+        edge.target_node_id_ = node_ids[i * 2 + 1];
+        memcpy(edge.transformation_.data(), transformations + i * 16,
+               16 * sizeof(double));
+        memcpy(edge.information_.data(), information + i * 36,
+               36 * sizeof(double));
+        edge.uncertain_ = uncertain[i] != 0;
+        edge.confidence_ = confidence[i];
+    }
+    return true;
+}
+
+bool WritePoseGraphToO3D(const std::string &filename,
+                         const registration::PoseGraph &pose_graph,
+                         bool compressed /* = false*/) {
+    // Nodes and edges are polymorphic, so their members are gathered into
+    // one array per member.
+    const size_t num_nodes = pose_graph.nodes_.size();
+    const size_t num_edges = pose_graph.edges_.size();
+    std::vector<double> poses(num_nodes * 16);
+    for (size_t i = 0; i < num_nodes; i++) {
+        memcpy(poses.data() + i * 16, pose_graph.nodes_[i].pose_.data(),
+               16 * sizeof(double));
+    }
+    std::vector<int> node_ids(num_edges * 2);
+    std::vector<double> transformations(num_edges * 16);
+    std::vector<double> information(num_edges * 36);
+    std::vector<uint8_t> uncertain(num_edges);
+    std::vector<double> confidence(num_edges);
+    for (size_t i = 0; i < num_edges; i++) {
+        const auto &edge = pose_graph.edges_[i];
+        node_ids[i * 2] = edge.source_node_id_;
+        node_ids[i * 2 + 1] = edge.target_node_id_;
+        memcpy(transformations.data() + i * 16, edge.transformation_.data(),
+               16 * sizeof(double));
+        memcpy(information.data() + i * 36, edge.information_.data(),
+               36 * sizeof(double));
+        uncertain[i] = edge.uncertain_ ? 1 : 0;
+        confidence[i] = edge.confidence_;
+    }
+    O3DWriter writer;
+    writer.AddChunk("node_poses", poses.data(), num_nodes, 16);
+    writer.AddChunk("edge_node_ids", node_ids.data(), num_edges, 2);
+    writer.AddChunk("edge_transforms", transformations.data(), num_edges, 16);
+    writer.AddChunk("edge_information", information.data(), num_edges, 36);
+    writer.AddChunk("edge_uncertain", uncertain.data(), num_edges, 1);
+    writer.AddChunk("edge_confidence", confidence.data(), num_edges, 1);
+    return writer.Write(filename, O3DContentType::PoseGraph, compressed);
+}
+
+bool ReadPinholeCameraTrajectoryFromO3D(
+        const std::string &filename,
+        camera::PinholeCameraTrajectory &trajectory) {
+    O3DReader reader;
+    if (!reader.Open(filename, O3DContentType::PinholeCameraTrajectory)) {
+        return false;
+    }
+    const int *image_sizes;
+    const double *intrinsics, *extrinsics;
+    size_t num_cameras[3];
+    if (!reader.GetChunk("image_sizes", 2, image_sizes, num_cameras[0]) ||
+        !reader.GetChunk("intrinsics", 9, intrinsics, num_cameras[1]) ||
+        !reader.GetChunk("extrinsics", 16, extrinsics, num_cameras[2])) {
+        return false;
+    }
+    if (num_cameras[1] != num_cameras[0] || num_cameras[2] != num_cameras[0]) {
+        utility::PrintWarning(
+                "Read O3D failed: inconsistent camera parameters.\n");
+        return false;
+    }
+    trajectory.parameters_.resize(num_cameras[0]);
+    for (size_t i = 0; i < num_cameras[0]; i++) {
+        auto &parameters = trajectory.parameters_[i];
+        parameters.intrinsic_.width_ = image_sizes[i * 2];
+        parameters.intrinsic_.height_ = image_sizes[i * 2 + 1];
+        memcpy(parameters.intrinsic_.intrinsic_matrix_.data(),
+               intrinsics + i * 9, 9 * sizeof(double));
+        memcpy(parameters.extrinsic_.data(), extrinsics + i * 16,
+               16 * sizeof(double));
+    }
+    return true;
+}
+
+bool WritePinholeCameraTrajectoryToO3D(
+        const std::string &filename,
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed /* = false*/) {
+    const size_t num_cameras = trajectory.parameters_.size();
+    std::vector<int> image_sizes(num_cameras * 2);
+    std::vector<double> intrinsics(num_cameras * 9);
+    std::vector<double> extrinsics(num_cameras * 16);
+    for (size_t i = 0; i < num_cameras; i++) {
+        const auto &parameters = trajectory.parameters_[i];
+        image_sizes[i * 2] = parameters.intrinsic_.width_;
+        image_sizes[i * 2 + 1] = parameters.intrinsic_.height_;
+        memcpy(intrinsics.data() + i * 9,
+               parameters.intrinsic_.intrinsic_matrix_.data(),
+               9 * sizeof(double));
+        memcpy(extrinsics.data() + i * 16, parameters.extrinsic_.data(),
+               16 * sizeof(double));
+    }
+    O3DWriter writer;
+    writer.AddChunk("image_sizes", image_sizes.data(), num_cameras, 2);
+    writer.AddChunk("intrinsics", intrinsics.data(), num_cameras, 9);
+    writer.AddChunk("extrinsics", extrinsics.data(), num_cameras, 16);
+    return writer.Write(filename, O3DContentType::PinholeCameraTrajectory,
+                        compressed);
+}
+
+bool ReadImageWarpingFieldFromO3D(const std::string &filename,
+                                  color_map::ImageWarpingField &warping_field) {
+    O3DReader reader;
+    if (!reader.Open(filename, O3DContentType::ImageWarpingField)) {
+        return false;
+    }
+    const int *anchors;
+    const double *anchor_step, *flow;
+    size_t num_anchors, num_anchor_step, num_flow;
+    if (!reader.GetChunk("anchors", 2, anchors, num_anchors) ||
+        !reader.GetChunk("anchor_step", 1, anchor_step, num_anchor_step) ||
+        !reader.GetChunk("flow", 1, flow, num_flow)) {
+        return false;
+    }
+    if (num_anchors != 1 || num_anchor_step != 1 ||
+        (int64_t)num_flow != (int64_t)anchors[0] * anchors[1] * 2) {
+        utility::PrintWarning(
+                "Read O3D failed: inconsistent image warping field.\n");
+        return false;
+    }
+    warping_field.anchor_w_ = anchors[0];
+    warping_field.anchor_h_ = anchors[1];
+    warping_field.anchor_step_ = anchor_step[0];
+    warping_field.flow_.resize(num_flow);
+    if (num_flow > 0) {
+        memcpy(warping_field.flow_.data(), flow, num_flow * sizeof(double));
+    }
+    return true;
+}
+
+bool WriteImageWarpingFieldToO3D(
+        const std::string &filename,
+        const color_map::ImageWarpingField &warping_field,
+        bool compressed /* = false*/) {
+    const int anchors[2] = {warping_field.anchor_w_, warping_field.anchor_h_};
+    O3DWriter writer;
+    writer.AddChunk("anchors", anchors, 1, 2);
+    writer.AddChunk("anchor_step", &warping_field.anchor_step_, 1, 1);
+    writer.AddChunk("flow", warping_field.flow_.data(),
+                    warping_field.flow_.size(), 1);
+    return writer.Write(filename, O3DContentType::ImageWarpingField,
+                        compressed);
+}
+
+}  // namespace io
+}  // namespace open3d
@@ -25,10 +25,17 @@
 // ----------------------------------------------------------------------------
 
 #include <liblzf/lzf.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/IO/ClassIO/CompactPointCloudIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
@@ -331,23 +338,169 @@ Eigen::Vector3d UnpackASCIIPCDColor(const char *data_ptr,
     }
 }
 
-bool ReadPCDData(FILE *file,
-                 const PCDHeader &header,
-                 geometry::PointCloud &pointcloud) {
+// Per-point access shared by the PointCloud and CompactPointCloud readers and
+// writers below.
+void ResizePoints(geometry::PointCloud &pointcloud,
+                  int num_points,
+                  bool has_normals,
+                  bool has_colors) {
+    pointcloud.points_.resize(num_points);
+    if (has_normals) pointcloud.normals_.resize(num_points);
+    if (has_colors) pointcloud.colors_.resize(num_points);
+}
+
+void ResizePoints(geometry::CompactPointCloud &pointcloud,
+                  int num_points,
+                  bool has_normals,
+                  bool has_colors) {
+    pointcloud.Resize(num_points, has_normals, has_colors);
+}
+
+size_t GetNumberOfPoints(const geometry::PointCloud &pointcloud) {
+    return pointcloud.points_.size();
+}
+
+size_t GetNumberOfPoints(const geometry::CompactPointCloud &pointcloud) {
+    return pointcloud.GetNumberOfPoints();
+}
+
+void SetPointElement(geometry::PointCloud &pointcloud,
+                     int i,
+                     int dim,
+                     double value) {
+    pointcloud.points_[i](dim) = value;
+}
+
+void SetPointElement(geometry::CompactPointCloud &pointcloud,
+                     int i,
+                     int dim,
+                     double value) {
+    (dim == 0 ? pointcloud.x_ : (dim == 1 ? pointcloud.y_ : pointcloud.z_))[i] =
+            (float)value;
+}
+
+void SetNormalElement(geometry::PointCloud &pointcloud,
+                      int i,
+                      int dim,
+                      double value) {
+    pointcloud.normals_[i](dim) = value;
+}
+
+void SetNormalElement(geometry::CompactPointCloud &pointcloud,
+                      int i,
+                      int dim,
+                      double value) {
+    (dim == 0 ? pointcloud.nx_
+              : (dim == 1 ? pointcloud.ny_ : pointcloud.nz_))[i] = (float)value;
+}
+
+void SetColor(geometry::PointCloud &pointcloud,
+              int i,
+              const Eigen::Vector3d &color) {
+    pointcloud.colors_[i] = color;
+}
+
+void SetColor(geometry::CompactPointCloud &pointcloud,
+              int i,
+              const Eigen::Vector3d &color) {
+    pointcloud.SetColor(i, color);
+}
+
+const Eigen::Vector3d &GetPoint(const geometry::PointCloud &pointcloud,
+                                size_t i) {
+    return pointcloud.points_[i];
+}
+
+Eigen::Vector3d GetPoint(const geometry::CompactPointCloud &pointcloud,
+                         size_t i) {
+    return pointcloud.GetPoint(i);
+}
+
+const Eigen::Vector3d &GetNormal(const geometry::PointCloud &pointcloud,
+                                 size_t i) {
+    return pointcloud.normals_[i];
+}
+
+Eigen::Vector3d GetNormal(const geometry::CompactPointCloud &pointcloud,
+                          size_t i) {
+    return pointcloud.GetNormal(i);
+}
+
+void CopyPoint(geometry::PointCloud &pointcloud, size_t from, size_t to) {
+    pointcloud.points_[to] = pointcloud.points_[from];
+    if (pointcloud.HasNormals()) {
+        pointcloud.normals_[to] = pointcloud.normals_[from];
+    }
+    if (pointcloud.HasColors()) {
+        pointcloud.colors_[to] = pointcloud.colors_[from];
+    }
+}
+
+void CopyPoint(geometry::CompactPointCloud &pointcloud,
+               size_t from,
+               size_t to) {
+    pointcloud.SetPoint(to, pointcloud.GetPoint(from));
+    if (pointcloud.HasNormals()) {
+        pointcloud.SetNormal(to, pointcloud.GetNormal(from));
+    }
+    if (pointcloud.HasColors()) {
+        pointcloud.r_[to] = pointcloud.r_[from];
+        pointcloud.g_[to] = pointcloud.g_[from];
+        pointcloud.b_[to] = pointcloud.b_[from];
+    }
+}
+
+/// Unpacks \param field of \param num_points binary records, the first of
+/// which starts at \param base_ptr, \param stride bytes apart.
+template <typename PointCloudT>
+void UnpackBinaryPCDField(PointCloudT &pointcloud,
+                          const PCLPointField &field,
+                          const char *base_ptr,
+                          size_t stride,
+                          int num_points) {
+    static const char *const names[] = {"x",        "y",        "z",
+                                        "normal_x", "normal_y", "normal_z"};
+    int channel = -1;
+    for (int c = 0; c < 6; c++) {
+        if (field.name == names[c]) {
+            channel = c;
+        }
+    }
+    const bool is_color = field.name == "rgb" || field.name == "rgba";
+    if (channel < 0 && !is_color) {
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        const char *data_ptr = base_ptr + i * stride;
+        if (is_color) {
+            SetColor(pointcloud, i,
+                     UnpackBinaryPCDColor(data_ptr, field.type, field.size));
+        } else if (channel < 3) {
+            SetPointElement(
+                    pointcloud, i, channel,
+                    UnpackBinaryPCDElement(data_ptr, field.type, field.size));
+        } else {
+            SetNormalElement(
+                    pointcloud, i, channel - 3,
+                    UnpackBinaryPCDElement(data_ptr, field.type, field.size));
+        }
+    }
+}
+
+template <typename PointCloudT>
+bool ReadPCDData(FILE *file, const PCDHeader &header, PointCloudT &pointcloud) {
     // The header should have been checked
     if (header.has_points) {
-        pointcloud.points_.resize(header.points);
+        ResizePoints(pointcloud, header.points, header.has_normals,
+                     header.has_colors);
     } else {
         utility::PrintDebug(
                 "[ReadPCDData] Fields for point data are not complete.\n");
         return false;
     }
-    if (header.has_normals) {
-        pointcloud.normals_.resize(header.points);
-    }
-    if (header.has_colors) {
-        pointcloud.colors_.resize(header.points);
-    }
     if (header.datatype == PCD_DATA_ASCII) {
         char line_buffer[DEFAULT_IO_BUFFER_SIZE];
         int idx = 0;
@@ -361,78 +514,51 @@ bool ReadPCDData(FILE *file,
             }
             for (size_t i = 0; i < header.fields.size(); i++) {
                 const auto &field = header.fields[i];
+                const char *data_ptr = strs[field.count_offset].c_str();
                 if (field.name == "x") {
-                    pointcloud.points_[idx](0) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetPointElement(pointcloud, idx, 0,
+                                    UnpackASCIIPCDElement(data_ptr, field.type,
+                                                          field.size));
                 } else if (field.name == "y") {
-                    pointcloud.points_[idx](1) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetPointElement(pointcloud, idx, 1,
+                                    UnpackASCIIPCDElement(data_ptr, field.type,
+                                                          field.size));
                 } else if (field.name == "z") {
-                    pointcloud.points_[idx](2) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetPointElement(pointcloud, idx, 2,
+                                    UnpackASCIIPCDElement(data_ptr, field.type,
+                                                          field.size));
                 } else if (field.name == "normal_x") {
-                    pointcloud.normals_[idx](0) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetNormalElement(pointcloud, idx, 0,
+                                     UnpackASCIIPCDElement(data_ptr, field.type,
+                                                           field.size));
                 } else if (field.name == "normal_y") {
-                    pointcloud.normals_[idx](1) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetNormalElement(pointcloud, idx, 1,
+                                     UnpackASCIIPCDElement(data_ptr, field.type,
+                                                           field.size));
                 } else if (field.name == "normal_z") {
-                    pointcloud.normals_[idx](2) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetNormalElement(pointcloud, idx, 2,
+                                     UnpackASCIIPCDElement(data_ptr, field.type,
+                                                           field.size));
                 } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[idx] = UnpackASCIIPCDColor(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
+                    SetColor(pointcloud, idx,
+                             UnpackASCIIPCDColor(data_ptr, field.type,
+                                                 field.size));
                 }
             }
             idx++;
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<char[]> buffer(new char[header.pointsize]);
-        for (int i = 0; i < header.points; i++) {
-            if (fread(buffer.get(), header.pointsize, 1, file) != 1) {
-                utility::PrintDebug(
-                        "[ReadPCDData] Failed to read data record.\n");
-                pointcloud.Clear();
-                return false;
-            }
-            for (const auto &field : header.fields) {
-                if (field.name == "x") {
-                    pointcloud.points_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "y") {
-                    pointcloud.points_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "z") {
-                    pointcloud.points_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_x") {
-                    pointcloud.normals_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_y") {
-                    pointcloud.normals_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_z") {
-                    pointcloud.normals_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[i] =
-                            UnpackBinaryPCDColor(buffer.get() + field.offset,
-                                                 field.type, field.size);
-                }
-            }
+        const size_t data_size = (size_t)header.pointsize * header.points;
+        std::unique_ptr<char[]> buffer(new char[data_size]);
+        if (fread(buffer.get(), 1, data_size, file) != data_size) {
+            utility::PrintDebug("[ReadPCDData] Failed to read data record.\n");
+            pointcloud.Clear();
+            return false;
+        }
+        for (const auto &field : header.fields) {
+            UnpackBinaryPCDField(pointcloud, field,
+                                 buffer.get() + field.offset,
+                                 header.pointsize, header.points);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
         std::uint32_t compressed_size;
@@ -467,79 +593,38 @@ bool ReadPCDData(FILE *file,
             pointcloud.Clear();
             return false;
         }
+        // The data is stored field by field.
         for (const auto &field : header.fields) {
-            const char *base_ptr = buffer.get() + field.offset * header.points;
-            if (field.name == "x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "rgb" || field.name == "rgba") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.colors_[i] = UnpackBinaryPCDColor(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            }
+            UnpackBinaryPCDField(
+                    pointcloud, field,
+                    buffer.get() + (size_t)field.offset * header.points,
+                    field.size * field.count, header.points);
         }
     }
     return true;
 }
 
-void RemoveNanData(geometry::PointCloud &pointcloud) {
+template <typename PointCloudT>
+void RemoveNanData(PointCloudT &pointcloud) {
     bool has_normal = pointcloud.HasNormals();
     bool has_color = pointcloud.HasColors();
-    size_t old_point_num = pointcloud.points_.size();
+    size_t old_point_num = GetNumberOfPoints(pointcloud);
     size_t k = 0;                                 // new index
     for (size_t i = 0; i < old_point_num; i++) {  // old index
-        if (std::isnan(pointcloud.points_[i](0)) == false &&
-            std::isnan(pointcloud.points_[i](1)) == false &&
-            std::isnan(pointcloud.points_[i](0)) == false) {
-            pointcloud.points_[k] = pointcloud.points_[i];
-            if (has_normal) pointcloud.normals_[k] = pointcloud.normals_[i];
-            if (has_color) pointcloud.colors_[k] = pointcloud.colors_[i];
+        const Eigen::Vector3d &point = GetPoint(pointcloud, i);
+        if (std::isnan(point(0)) == false && std::isnan(point(1)) == false &&
+            std::isnan(point(0)) == false) {
+            CopyPoint(pointcloud, i, k);
             k++;
         }
     }
-    pointcloud.points_.resize(k);
-    if (has_normal) pointcloud.normals_.resize(k);
-    if (has_color) pointcloud.colors_.resize(k);
+    ResizePoints(pointcloud, (int)k, has_normal, has_color);
     utility::PrintDebug("[Purge] %d nan points have been removed.\n",
                         (int)(old_point_num - k));
 }
 
-bool GenerateHeader(const geometry::PointCloud &pointcloud,
+template <typename PointCloudT>
+bool GenerateHeader(const PointCloudT &pointcloud,
                     const bool write_ascii,
                     const bool compressed,
                     PCDHeader &header) {
@@ -547,7 +632,7 @@ bool GenerateHeader(const geometry::PointCloud &pointcloud,
         return false;
     }
     header.version = "0.7";
-    header.width = (int)pointcloud.points_.size();
+    header.width = (int)GetNumberOfPoints(pointcloud);
     header.height = 1;
     header.points = header.width;
     header.fields.clear();
@@ -645,94 +730,205 @@ float ConvertRGBToFloat(const Eigen::Vector3d &color) {
     return value;
 }
 
+float GetPackedColor(const geometry::PointCloud &pointcloud, size_t i) {
+    return ConvertRGBToFloat(pointcloud.colors_[i]);
+}
+
+float GetPackedColor(const geometry::CompactPointCloud &pointcloud, size_t i) {
+    std::uint8_t rgba[4] = {pointcloud.b_[i], pointcloud.g_[i],
+                            pointcloud.r_[i], 0};
+    float value;
+    memcpy(&value, rgba, 4);
+    return value;
+}
+
+/// Writes the values [begin, end) of the field \param name as floats to
+/// \param out.
+void GatherPCDField(const geometry::PointCloud &pointcloud,
+                    const std::string &name,
+                    size_t begin,
+                    size_t end,
+                    float *out) {
+    if (name == "rgb") {
+        for (size_t i = begin; i < end; i++) {
+            *out++ = GetPackedColor(pointcloud, i);
+        }
+        return;
+    }
+    const auto &values = name.compare(0, 7, "normal_") == 0
+                                 ? pointcloud.normals_
+                                 : pointcloud.points_;
+    const int c = name.back() - 'x';
+    for (size_t i = begin; i < end; i++) {
+        *out++ = (float)values[i](c);
+    }
+}
+
+void GatherPCDField(const geometry::CompactPointCloud &pointcloud,
+                    const std::string &name,
+                    size_t begin,
+                    size_t end,
+                    float *out) {
+    if (name == "rgb") {
+        for (size_t i = begin; i < end; i++) {
+            *out++ = GetPackedColor(pointcloud, i);
+        }
+        return;
+    }
+    const bool is_normal = name.compare(0, 7, "normal_") == 0;
+    const std::vector<float> *values[2][3] = {
+            {&pointcloud.x_, &pointcloud.y_, &pointcloud.z_},
+            {&pointcloud.nx_, &pointcloud.ny_, &pointcloud.nz_}};
+    const std::vector<float> &field = *values[is_normal][name.back() - 'x'];
+    memcpy(out, field.data() + begin, (end - begin) * sizeof(float));
+}
+
+/// Writes the floats [begin, end) of the binary_compressed data stream, which
+/// stores the fields of \param header one after the other, to \param out.
+template <typename PointCloudT>
+void GatherPCDData(const PointCloudT &pointcloud,
+                   const PCDHeader &header,
+                   size_t begin,
+                   size_t end,
+                   float *out) {
+    const size_t num_points = (size_t)header.points;
+    size_t f = begin / num_points;
+    size_t i = begin % num_points;
+    while (begin < end) {
+        const size_t count = std::min(end - begin, num_points - i);
+        GatherPCDField(pointcloud, header.fields[f].name, i, i + count, out);
+        out += count;
+        begin += count;
+        f++;
+        i = 0;
+    }
+}
+
+/// Compresses the binary_compressed data stream in blocks of this many bytes,
+/// in parallel. The LZF streams of the blocks are simply concatenated: the
+/// result is a valid LZF stream of the whole data, so the file stays readable
+/// by any PCD reader.
+const size_t PCD_COMPRESSION_BLOCK_SIZE = 1 << 20;
+
+template <typename PointCloudT>
+bool WriteCompressedPCDData(FILE *file,
+                            const PCDHeader &header,
+                            const PointCloudT &pointcloud) {
+    const size_t num_floats = header.fields.size() * (size_t)header.points;
+    if (num_floats * sizeof(float) > UINT32_MAX) {
+        utility::PrintDebug("[WritePCDData] Too much data to compress.\n");
+        return false;
+    }
+    const std::uint32_t buffer_size_in_bytes =
+            (std::uint32_t)(num_floats * sizeof(float));
+    const size_t block_floats = PCD_COMPRESSION_BLOCK_SIZE / sizeof(float);
+    const int num_blocks =
+            (int)((num_floats + block_floats - 1) / block_floats);
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    // The compressed size is known at the end only.
+    const long size_position = ftell(file);
+    std::uint32_t size_compressed = 0;
+    fwrite(&size_compressed, sizeof(size_compressed), 1, file);
+    fwrite(&buffer_size_in_bytes, sizeof(buffer_size_in_bytes), 1, file);
+
+    // LZF expands incompressible data by at most 1/32 plus one byte.
+    const size_t max_output_size = PCD_COMPRESSION_BLOCK_SIZE * 33 / 32 + 64;
+    const int batch_size = 4 * num_threads;
+    std::vector<std::vector<float>> inputs(batch_size);
+    std::vector<std::vector<char>> outputs(batch_size);
+    std::vector<unsigned int> output_sizes(batch_size);
+    for (int first = 0; first < num_blocks; first += batch_size) {
+        const int num = std::min(batch_size, num_blocks - first);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int k = 0; k < num; k++) {
+            const size_t begin = (first + k) * block_floats;
+            const size_t end = std::min(num_floats, begin + block_floats);
+            inputs[k].resize(end - begin);
+            outputs[k].resize(max_output_size);
+            GatherPCDData(pointcloud, header, begin, end, inputs[k].data());
+            output_sizes[k] = lzf_compress(
+                    inputs[k].data(),
+                    (unsigned int)((end - begin) * sizeof(float)),
+                    outputs[k].data(), (unsigned int)max_output_size);
+        }
+        for (int k = 0; k < num; k++) {
+            if (output_sizes[k] == 0) {
+                utility::PrintDebug(
+                        "[WritePCDData] Failed to compress data.\n");
+                return false;
+            }
+            if (fwrite(outputs[k].data(), 1, output_sizes[k], file) !=
+                output_sizes[k]) {
+                utility::PrintDebug("[WritePCDData] Failed to write data.\n");
+                return false;
+            }
+            size_compressed += output_sizes[k];
+        }
+    }
+    utility::PrintDebug(
+            "[WritePCDData] %d bytes data compressed into %d bytes.\n",
+            buffer_size_in_bytes, size_compressed);
+    fseek(file, size_position, SEEK_SET);
+    fwrite(&size_compressed, sizeof(size_compressed), 1, file);
+    fseek(file, 0, SEEK_END);
+    return true;
+}
+
+template <typename PointCloudT>
 bool WritePCDData(FILE *file,
                   const PCDHeader &header,
-                  const geometry::PointCloud &pointcloud) {
+                  const PointCloudT &pointcloud) {
     bool has_normal = pointcloud.HasNormals();
     bool has_color = pointcloud.HasColors();
+    const size_t num_points = GetNumberOfPoints(pointcloud);
     if (header.datatype == PCD_DATA_ASCII) {
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
+        for (size_t i = 0; i < num_points; i++) {
+            const Eigen::Vector3d &point = GetPoint(pointcloud, i);
             fprintf(file, "%.10g %.10g %.10g", point(0), point(1), point(2));
             if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
+                const Eigen::Vector3d &normal = GetNormal(pointcloud, i);
                 fprintf(file, " %.10g %.10g %.10g", normal(0), normal(1),
                         normal(2));
             }
             if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                fprintf(file, " %.10g", ConvertRGBToFloat(color));
+                fprintf(file, " %.10g", GetPackedColor(pointcloud, i));
             }
             fprintf(file, "\n");
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
         std::unique_ptr<float[]> data(new float[header.elementnum]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
+        for (size_t i = 0; i < num_points; i++) {
+            const Eigen::Vector3d &point = GetPoint(pointcloud, i);
             data[0] = (float)point(0);
             data[1] = (float)point(1);
             data[2] = (float)point(2);
             int idx = 3;
             if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
+                const Eigen::Vector3d &normal = GetNormal(pointcloud, i);
                 data[idx + 0] = (float)normal(0);
                 data[idx + 1] = (float)normal(1);
                 data[idx + 2] = (float)normal(2);
                 idx += 3;
             }
             if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                data[idx] = ConvertRGBToFloat(color);
+                data[idx] = GetPackedColor(pointcloud, i);
             }
             fwrite(data.get(), sizeof(float), header.elementnum, file);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
-        int strip_size = header.points;
-        std::uint32_t buffer_size =
-                (std::uint32_t)(header.elementnum * header.points);
-        std::unique_ptr<float[]> buffer(new float[buffer_size]);
-        std::unique_ptr<float[]> buffer_compressed(new float[buffer_size * 2]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            buffer[0 * strip_size + i] = (float)point(0);
-            buffer[1 * strip_size + i] = (float)point(1);
-            buffer[2 * strip_size + i] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                buffer[(idx + 0) * strip_size + i] = (float)normal(0);
-                buffer[(idx + 1) * strip_size + i] = (float)normal(1);
-                buffer[(idx + 2) * strip_size + i] = (float)normal(2);
-                idx += 3;
-            }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                buffer[idx * strip_size + i] = ConvertRGBToFloat(color);
-            }
-        }
-        std::uint32_t buffer_size_in_bytes = buffer_size * sizeof(float);
-        std::uint32_t size_compressed =
-                lzf_compress(buffer.get(), buffer_size_in_bytes,
-                             buffer_compressed.get(), buffer_size_in_bytes * 2);
-        if (size_compressed == 0) {
-            utility::PrintDebug("[WritePCDData] Failed to compress data.\n");
-            return false;
-        }
-        utility::PrintDebug(
-                "[WritePCDData] %d bytes data compressed into %d bytes.\n",
-                buffer_size_in_bytes, size_compressed);
-        fwrite(&size_compressed, sizeof(size_compressed), 1, file);
-        fwrite(&buffer_size_in_bytes, sizeof(buffer_size_in_bytes), 1, file);
-        fwrite(buffer_compressed.get(), 1, size_compressed, file);
+        return WriteCompressedPCDData(file, header, pointcloud);
     }
     return true;
 }
 
-}  // unnamed namespace
-
-namespace io {
-bool ReadPointCloudFromPCD(const std::string &filename,
-                           geometry::PointCloud &pointcloud) {
+template <typename PointCloudT>
+bool ReadPCD(const std::string &filename, PointCloudT &pointcloud) {
     PCDHeader header;
     FILE *file = fopen(filename.c_str(), "rb");
     if (file == NULL) {
@@ -769,10 +965,11 @@ bool ReadPointCloudFromPCD(const std::string &filename,
     return true;
 }
 
-bool WritePointCloudToPCD(const std::string &filename,
-                          const geometry::PointCloud &pointcloud,
-                          bool write_ascii /* = false*/,
-                          bool compressed /* = false*/) {
+template <typename PointCloudT>
+bool WritePCD(const std::string &filename,
+              const PointCloudT &pointcloud,
+              bool write_ascii,
+              bool compressed) {
     PCDHeader header;
     if (GenerateHeader(pointcloud, write_ascii, compressed, header) == false) {
         utility::PrintWarning("Write PCD failed: unable to generate header.\n");
@@ -797,5 +994,32 @@ bool WritePointCloudToPCD(const std::string &filename,
     return true;
 }
 
+}  // unnamed namespace
+
+namespace io {
+bool ReadPointCloudFromPCD(const std::string &filename,
+                           geometry::PointCloud &pointcloud) {
+    return ReadPCD(filename, pointcloud);
+}
+
+bool WritePointCloudToPCD(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          bool write_ascii /* = false*/,
+                          bool compressed /* = false*/) {
+    return WritePCD(filename, pointcloud, write_ascii, compressed);
+}
+
+bool ReadCompactPointCloudFromPCD(const std::string &filename,
+                                  geometry::CompactPointCloud &pointcloud) {
+    return ReadPCD(filename, pointcloud);
+}
+
+bool WriteCompactPointCloudToPCD(const std::string &filename,
+                                 const geometry::CompactPointCloud &pointcloud,
+                                 bool write_ascii /* = false*/,
+                                 bool compressed /* = false*/) {
+    return WritePCD(filename, pointcloud, write_ascii, compressed);
+}
+
 }  // namespace io
 }  // namespace open3d
@@ -24,12 +24,19 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
 #include <rply/rply.h>
+#include <sstream>
 
+#include "Open3D/IO/ClassIO/CompactPointCloudIO.h"
 #include "Open3D/IO/ClassIO/LineSetIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "Open3D/IO/ClassIO/VoxelGridIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -104,6 +111,82 @@ int ReadColorCallback(p_ply_argument argument) {
 
 }  // namespace ply_pointcloud_reader
 
+namespace ply_compact_pointcloud_reader {
+
+struct PLYReaderState {
+    geometry::CompactPointCloud *pointcloud_ptr;
+    long vertex_index;
+    long vertex_num;
+    long normal_index;
+    long normal_num;
+    long color_index;
+    long color_num;
+};
+
+int ReadVertexCallback(p_ply_argument argument) {
+    PLYReaderState *state_ptr;
+    long index;
+    ply_get_argument_user_data(argument, reinterpret_cast<void **>(&state_ptr),
+                               &index);
+    if (state_ptr->vertex_index >= state_ptr->vertex_num) {
+        return 0;
+    }
+
+    auto &pointcloud = *state_ptr->pointcloud_ptr;
+    std::vector<float> &values =
+            index == 0 ? pointcloud.x_
+                       : (index == 1 ? pointcloud.y_ : pointcloud.z_);
+    values[state_ptr->vertex_index] = (float)ply_get_argument_value(argument);
+    if (index == 2) {  // reading 'z'
+        state_ptr->vertex_index++;
+        utility::AdvanceConsoleProgress();
+    }
+    return 1;
+}
+
+int ReadNormalCallback(p_ply_argument argument) {
+    PLYReaderState *state_ptr;
+    long index;
+    ply_get_argument_user_data(argument, reinterpret_cast<void **>(&state_ptr),
+                               &index);
+    if (state_ptr->normal_index >= state_ptr->normal_num) {
+        return 0;
+    }
+
+    auto &pointcloud = *state_ptr->pointcloud_ptr;
+    std::vector<float> &values =
+            index == 0 ? pointcloud.nx_
+                       : (index == 1 ? pointcloud.ny_ : pointcloud.nz_);
+    values[state_ptr->normal_index] = (float)ply_get_argument_value(argument);
+    if (index == 2) {  // reading 'nz'
+        state_ptr->normal_index++;
+    }
+    return 1;
+}
+
+int ReadColorCallback(p_ply_argument argument) {
+    PLYReaderState *state_ptr;
+    long index;
+    ply_get_argument_user_data(argument, reinterpret_cast<void **>(&state_ptr),
+                               &index);
+    if (state_ptr->color_index >= state_ptr->color_num) {
+        return 0;
+    }
+
+    auto &pointcloud = *state_ptr->pointcloud_ptr;
+    std::vector<uint8_t> &values =
+            index == 0 ? pointcloud.r_
+                       : (index == 1 ? pointcloud.g_ : pointcloud.b_);
+    values[state_ptr->color_index] = geometry::CompactPointCloud::QuantizeColor(
+            ply_get_argument_value(argument) / 255.0);
+    if (index == 2) {  // reading 'blue'
+        state_ptr->color_index++;
+    }
+    return 1;
+}
+
+}  // namespace ply_compact_pointcloud_reader
+
 namespace ply_trianglemesh_reader {
 
 struct PLYReaderState {
@@ -336,12 +419,1009 @@ int ReadColorCallback(p_ply_argument argument) {
 
 }  // namespace ply_voxelgrid_reader
 
+namespace ply_fast_path {
+
+// Binary PLY files whose vertex element has a fixed record layout are read
+// in blocks of whole records and converted with one typed loop per property,
+// instead of one rply callback per scalar value. Everything else goes through
+// rply.
+
+enum class PLYType {
+    Int8 = 0,
+    UInt8 = 1,
+    Int16 = 2,
+    UInt16 = 3,
+    Int32 = 4,
+    UInt32 = 5,
+    Float32 = 6,
+    Float64 = 7,
+    Invalid = 8,
+};
+
+PLYType ParsePLYType(const std::string &name) {
+    static const char *const names[] = {"int8",   "uint8", "int16",
+                                        "uint16", "int32", "uint32",
+                                        "float32", "float64"};
+    static const char *const aliases[] = {"char", "uchar", "short", "ushort",
+                                          "int",  "uint",  "float", "double"};
+    for (int i = 0; i < 8; i++) {
+        if (name == names[i] || name == aliases[i]) {
+            return static_cast<PLYType>(i);
+        }
+    }
+    return PLYType::Invalid;
+}
+
+int SizeOfPLYType(PLYType type) {
+    static const int sizes[] = {1, 1, 2, 2, 4, 4, 4, 8, 0};
+    return sizes[static_cast<int>(type)];
+}
+
+struct PLYProperty {
+    std::string name;
+    PLYType type;
+    PLYType length_type;  // PLYType::Invalid for scalar properties
+    int offset;           // byte offset within a fixed size record
+    bool IsList() const { return length_type != PLYType::Invalid; }
+};
+
+struct PLYElement {
+    std::string name;
+    int64_t count;
+    std::vector<PLYProperty> properties;
+    int record_size;  // 0 if the element has a list property
+
+    int FindProperty(const std::string &property_name) const {
+        for (size_t i = 0; i < properties.size(); i++) {
+            if (properties[i].name == property_name) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+};
+
+enum class PLYFormat { ASCII, BinaryLittleEndian, BinaryBigEndian };
+
+bool IsHostLittleEndian() {
+    const uint16_t value = 1;
+    uint8_t byte;
+    memcpy(&byte, &value, 1);
+    return byte == 1;
+}
+
+template <typename T>
+inline T LoadValue(const uint8_t *data, bool swap) {
+    T value;
+    if (swap) {
+        uint8_t bytes[sizeof(T)];
+        std::reverse_copy(data, data + sizeof(T), bytes);
+        memcpy(&value, bytes, sizeof(T));
+    } else {
+        memcpy(&value, data, sizeof(T));
+    }
+    return value;
+}
+
+double LoadValue(const uint8_t *data, PLYType type, bool swap) {
+    switch (type) {
+        case PLYType::Int8:
+            return LoadValue<int8_t>(data, swap);
+        case PLYType::UInt8:
+            return LoadValue<uint8_t>(data, swap);
+        case PLYType::Int16:
+            return LoadValue<int16_t>(data, swap);
+        case PLYType::UInt16:
+            return LoadValue<uint16_t>(data, swap);
+        case PLYType::Int32:
+            return LoadValue<int32_t>(data, swap);
+        case PLYType::UInt32:
+            return LoadValue<uint32_t>(data, swap);
+        case PLYType::Float32:
+            return LoadValue<float>(data, swap);
+        case PLYType::Float64:
+            return LoadValue<double>(data, swap);
+        default:
+            return 0.0;
+    }
+}
+
+/// Calls set(i, value) for the property at byte \param offset of each of the
+/// \param num records of \param record_size bytes.
+template <typename T, typename SetFunc>
+void ConvertPropertyOfType(const uint8_t *records,
+                           size_t num,
+                           int record_size,
+                           int offset,
+                           bool swap,
+                           const SetFunc &set) {
+    const uint8_t *data = records + offset;
+    for (size_t i = 0; i < num; i++, data += record_size) {
+        set(i, (double)LoadValue<T>(data, swap));
+    }
+}
+
+template <typename SetFunc>
+void ConvertProperty(const uint8_t *records,
+                     size_t num,
+                     int record_size,
+                     const PLYProperty &property,
+                     bool swap,
+                     const SetFunc &set) {
+    const int offset = property.offset;
+    switch (property.type) {
+        case PLYType::Int8:
+            ConvertPropertyOfType<int8_t>(records, num, record_size, offset,
+                                          swap, set);
+            break;
+        case PLYType::UInt8:
+            ConvertPropertyOfType<uint8_t>(records, num, record_size, offset,
+                                           swap, set);
+            break;
+        case PLYType::Int16:
+            ConvertPropertyOfType<int16_t>(records, num, record_size, offset,
+                                           swap, set);
+            break;
+        case PLYType::UInt16:
+            ConvertPropertyOfType<uint16_t>(records, num, record_size, offset,
+                                            swap, set);
+            break;
+        case PLYType::Int32:
+            ConvertPropertyOfType<int32_t>(records, num, record_size, offset,
+                                           swap, set);
+            break;
+        case PLYType::UInt32:
+            ConvertPropertyOfType<uint32_t>(records, num, record_size, offset,
+                                            swap, set);
+            break;
+        case PLYType::Float32:
+            ConvertPropertyOfType<float>(records, num, record_size, offset,
+                                         swap, set);
+            break;
+        case PLYType::Float64:
+            ConvertPropertyOfType<double>(records, num, record_size, offset,
+                                          swap, set);
+            break;
+        default:
+            break;
+    }
+}
+
+/// Reads the header of a PLY file and then serves the data that follows it
+/// from a large buffer.
+class PLYReader {
+public:
+    PLYReader() {}
+    ~PLYReader() {
+        if (file_ != NULL) {
+            fclose(file_);
+        }
+    }
+    PLYReader(const PLYReader &) = delete;
+    PLYReader &operator=(const PLYReader &) = delete;
+
+public:
+    /// Opens \param filename and parses its header. Returns false if the file
+    /// cannot be opened or the header is not understood.
+    bool Open(const std::string &filename) {
+        filename_ = filename;
+        file_ = fopen(filename.c_str(), "rb");
+        if (file_ == NULL) {
+            return false;
+        }
+        std::string line;
+        if (!ReadHeaderLine(line) || line != "ply") {
+            return false;
+        }
+        bool has_format = false;
+        while (ReadHeaderLine(line)) {
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+            if (keyword == "format") {
+                std::string format;
+                stream >> format;
+                if (format == "ascii") {
+                    format_ = PLYFormat::ASCII;
+                } else if (format == "binary_little_endian") {
+                    format_ = PLYFormat::BinaryLittleEndian;
+                } else if (format == "binary_big_endian") {
+                    format_ = PLYFormat::BinaryBigEndian;
+                } else {
+                    return false;
+                }
+                has_format = true;
+            } else if (keyword == "element") {
+                PLYElement element;
+                if (!(stream >> element.name >> element.count) ||
+                    element.count < 0) {
+                    return false;
+                }
+                element.record_size = 0;
+                elements_.push_back(element);
+            } else if (keyword == "property") {
+                if (elements_.empty() || !ParseProperty(stream)) {
+                    return false;
+                }
+            } else if (keyword == "end_header") {
+                if (!has_format) {
+                    return false;
+                }
+                swap_ = format_ != PLYFormat::ASCII &&
+                        (format_ == PLYFormat::BinaryLittleEndian) !=
+                                IsHostLittleEndian();
+                return MeasureData();
+            } else if (keyword != "comment" && keyword != "obj_info" &&
+                       !keyword.empty()) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /// Returns true if the vertex element comes first and can be read in
+    /// blocks: a binary file with a fixed record size, or an ASCII file.
+    bool CanReadVertexBlocks(bool allow_ascii) const {
+        if (elements_.empty() || elements_[0].name != "vertex") {
+            return false;
+        }
+        if (format_ == PLYFormat::ASCII) {
+            return allow_ascii;
+        }
+        return elements_[0].record_size > 0;
+    }
+
+    /// Returns the number of bytes of data not consumed yet.
+    size_t RemainingBytes() const { return data_size_ - read_ + end_ - begin_; }
+
+    /// Returns a pointer to the next \param num_bytes bytes of data, or NULL
+    /// if the file ends before.
+    const uint8_t *Consume(size_t num_bytes) {
+        if (end_ - begin_ < num_bytes && !Fill(num_bytes)) {
+            return NULL;
+        }
+        const uint8_t *data = buffer_.data() + begin_;
+        begin_ += num_bytes;
+        return data;
+    }
+
+    /// Reads the next whitespace separated token of an ASCII file.
+    bool ReadToken(std::string &token) {
+        token.clear();
+        while (true) {
+            if (begin_ == end_ && !Fill(1)) {
+                return false;
+            }
+            if (!isspace(buffer_[begin_])) {
+                break;
+            }
+            begin_++;
+        }
+        while (true) {
+            if (begin_ == end_ && !Fill(1)) {
+                return true;
+            }
+            const char c = (char)buffer_[begin_];
+            if (isspace(c)) {
+                return true;
+            }
+            token.push_back(c);
+            begin_++;
+        }
+    }
+
+    /// Reads the next ASCII token as a number.
+    bool ReadNumber(double &value) {
+        if (!ReadToken(token_)) {
+            return false;
+        }
+        const char *end = token_.data() + token_.size();
+        return ParseDouble(token_.data(), end, value) == end;
+    }
+
+private:
+    bool ReadHeaderLine(std::string &line) {
+        line.clear();
+        int c;
+        while ((c = fgetc(file_)) != EOF && c != '\n') {
+            if (c != '\r') {
+                line.push_back((char)c);
+            }
+        }
+        return c != EOF || !line.empty();
+    }
+
+    bool ParseProperty(std::istringstream &stream) {
+        PLYElement &element = elements_.back();
+        PLYProperty property;
+        std::string type;
+        stream >> type;
+        if (type == "list") {
+            std::string length_type;
+            stream >> length_type >> type;
+            property.length_type = ParsePLYType(length_type);
+            if (property.length_type == PLYType::Invalid) {
+                return false;
+            }
+        } else {
+            property.length_type = PLYType::Invalid;
+        }
+        property.type = ParsePLYType(type);
+        if (property.type == PLYType::Invalid || !(stream >> property.name)) {
+            return false;
+        }
+        // The record size becomes 0 as soon as the element has a list.
+        const bool is_fixed =
+                element.properties.empty() || element.record_size > 0;
+        property.offset = element.record_size;
+        if (is_fixed && !property.IsList()) {
+            element.record_size += SizeOfPLYType(property.type);
+        } else {
+            element.record_size = 0;
+        }
+        element.properties.push_back(property);
+        return true;
+    }
+
+    bool MeasureData() {
+        const long data_begin = ftell(file_);
+        if (data_begin < 0 || fseek(file_, 0, SEEK_END) != 0) {
+            return false;
+        }
+        const long file_end = ftell(file_);
+        if (file_end < data_begin || fseek(file_, data_begin, SEEK_SET) != 0) {
+            return false;
+        }
+        data_size_ = (size_t)(file_end - data_begin);
+        return true;
+    }
+
+    bool Fill(size_t num_bytes) {
+        if (num_bytes > RemainingBytes()) {
+            return false;
+        }
+        const size_t remaining = end_ - begin_;
+        if (begin_ > 0) {
+            memmove(buffer_.data(), buffer_.data() + begin_, remaining);
+            begin_ = 0;
+            end_ = remaining;
+        }
+        if (buffer_.size() < num_bytes) {
+            buffer_.resize(num_bytes);
+        }
+        const size_t num_read =
+                fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+        end_ += num_read;
+        read_ += num_read;
+        return end_ >= num_bytes;
+    }
+
+public:
+    std::string filename_;
+    PLYFormat format_ = PLYFormat::ASCII;
+    std::vector<PLYElement> elements_;
+    bool swap_ = false;
+
+private:
+    FILE *file_ = NULL;
+    std::vector<uint8_t> buffer_ = std::vector<uint8_t>(1 << 22);
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    size_t data_size_ = 0;  // bytes after the header
+    size_t read_ = 0;       // bytes of data read into the buffer so far
+    std::string token_;
+};
+
+/// Indices of the vertex properties Open3D reads, -1 if missing.
+struct PLYVertexLayout {
+    explicit PLYVertexLayout(const PLYElement &vertex) {
+        static const char *const names[9] = {"x",  "y",  "z",
+                                             "nx", "ny", "nz",
+                                             "red", "green", "blue"};
+        for (int i = 0; i < 3; i++) {
+            position_[i] = vertex.FindProperty(names[i]);
+            normal_[i] = vertex.FindProperty(names[i + 3]);
+            color_[i] = vertex.FindProperty(names[i + 6]);
+        }
+    }
+
+    bool HasPoints() const {
+        return position_[0] >= 0 && position_[1] >= 0 && position_[2] >= 0;
+    }
+    bool HasNormals() const {
+        return normal_[0] >= 0 && normal_[1] >= 0 && normal_[2] >= 0;
+    }
+    bool HasColors() const {
+        return color_[0] >= 0 && color_[1] >= 0 && color_[2] >= 0;
+    }
+
+    int position_[3];
+    int normal_[3];
+    int color_[3];
+};
+
+/// A block of consecutive vertices, either raw binary records or the values
+/// parsed from an ASCII file.
+class PLYVertexBlock {
+public:
+    PLYVertexBlock(const PLYElement &vertex,
+                   size_t num,
+                   const uint8_t *records,
+                   const double *values,
+                   bool swap)
+        : vertex_(vertex),
+          num_(num),
+          records_(records),
+          values_(values),
+          swap_(swap) {}
+
+    size_t size() const { return num_; }
+
+    /// Calls set(i, value) for property \param index of every vertex i.
+    template <typename SetFunc>
+    void DecodeProperty(int index, const SetFunc &set) const {
+        if (records_ != NULL) {
+            ConvertProperty(records_, num_, vertex_.record_size,
+                            vertex_.properties[index], swap_, set);
+        } else {
+            const size_t num_properties = vertex_.properties.size();
+            for (size_t i = 0; i < num_; i++) {
+                set(i, values_[i * num_properties + index]);
+            }
+        }
+    }
+
+private:
+    const PLYElement &vertex_;
+    size_t num_;
+    const uint8_t *records_;
+    const double *values_;
+    bool swap_;
+};
+
+/// Reads the vertex element in blocks of at most \param block_size vertices
+/// and calls block_func(begin, block) for each of them. Stops early and
+/// returns true if block_func returns false. The reader must satisfy
+/// CanReadVertexBlocks().
+template <typename BlockFunc>
+bool ReadVertexBlocks(PLYReader &reader,
+                      size_t block_size,
+                      const BlockFunc &block_func) {
+    const PLYElement &vertex = reader.elements_[0];
+    const size_t num_vertices = (size_t)vertex.count;
+    const size_t num_properties = vertex.properties.size();
+    std::vector<double> values;
+    for (size_t begin = 0; begin < num_vertices; begin += block_size) {
+        const size_t num = std::min(block_size, num_vertices - begin);
+        const uint8_t *records = NULL;
+        if (reader.format_ == PLYFormat::ASCII) {
+            values.resize(num * num_properties);
+            double *value = values.data();
+            for (size_t i = 0; i < num; i++) {
+                for (size_t k = 0; k < num_properties; k++, value++) {
+                    if (!reader.ReadNumber(*value)) {
+                        return false;
+                    }
+                    if (!vertex.properties[k].IsList()) {
+                        continue;
+                    }
+                    // Lists are not used for vertices, skip their entries.
+                    double entry;
+                    for (int j = 0; j < (int)*value; j++) {
+                        if (!reader.ReadNumber(entry)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        } else {
+            records = reader.Consume(num * vertex.record_size);
+            if (records == NULL) {
+                return false;
+            }
+        }
+        PLYVertexBlock block(vertex, num, records, values.data(),
+                             reader.swap_);
+        if (!block_func(begin, block)) {
+            return true;
+        }
+    }
+    return true;
+}
+
+/// Reads the face element that directly follows the vertex element of a
+/// binary file. Only the first three vertex indices of each face are kept.
+bool ReadBinaryFaces(PLYReader &reader,
+                     std::vector<Eigen::Vector3i> &triangles) {
+    const PLYElement &face = reader.elements_[1];
+    int indices = face.FindProperty("vertex_indices");
+    if (indices < 0) {
+        indices = face.FindProperty("vertex_index");
+    }
+    // Every face takes at least one value or list length per property, so
+    // the count cannot exceed what is left of the file.
+    size_t min_face_size = 0;
+    for (const PLYProperty &property : face.properties) {
+        min_face_size += (size_t)SizeOfPLYType(
+                property.IsList() ? property.length_type : property.type);
+    }
+    if (min_face_size > 0 &&
+        (size_t)face.count > reader.RemainingBytes() / min_face_size) {
+        return false;
+    }
+    triangles.resize(indices < 0 ? 0 : (size_t)face.count);
+    const bool swap = reader.swap_;
+    for (int64_t i = 0; i < face.count; i++) {
+        for (int k = 0; k < (int)face.properties.size(); k++) {
+            const PLYProperty &property = face.properties[k];
+            const size_t value_size = (size_t)SizeOfPLYType(property.type);
+            size_t length = 1;
+            if (property.IsList()) {
+                const int length_size = SizeOfPLYType(property.length_type);
+                const uint8_t *data = reader.Consume(length_size);
+                if (data == NULL) {
+                    return false;
+                }
+                const double value =
+                        LoadValue(data, property.length_type, swap);
+                if (!(value >= 0.0) ||
+                    value > (double)(reader.RemainingBytes() / value_size)) {
+                    return false;
+                }
+                length = (size_t)value;
+            }
+            const uint8_t *data = reader.Consume(length * value_size);
+            if (data == NULL) {
+                return false;
+            }
+            if (k != indices) {
+                continue;
+            }
+            Eigen::Vector3i &triangle = triangles[i];
+            triangle.setZero();
+            for (size_t j = 0; j < std::min(length, (size_t)3); j++) {
+                triangle(j) = (int)LoadValue(data + j * value_size,
+                                             property.type, swap);
+            }
+        }
+        utility::AdvanceConsoleProgress();
+    }
+    return true;
+}
+
+/// Decodes the positions, normals and colors of \param block into \param
+/// points, \param normals and \param colors starting at index \param begin.
+/// Normals and colors are skipped for empty vectors.
+void DecodeVertexBlock(const PLYVertexBlock &block,
+                       const PLYVertexLayout &layout,
+                       size_t begin,
+                       std::vector<Eigen::Vector3d> &points,
+                       std::vector<Eigen::Vector3d> &normals,
+                       std::vector<Eigen::Vector3d> &colors) {
+    for (int c = 0; c < 3; c++) {
+        block.DecodeProperty(layout.position_[c], [&](size_t i, double v) {
+            points[begin + i](c) = v;
+        });
+        if (!normals.empty()) {
+            block.DecodeProperty(layout.normal_[c], [&](size_t i, double v) {
+                normals[begin + i](c) = v;
+            });
+        }
+        if (!colors.empty()) {
+            block.DecodeProperty(layout.color_[c], [&](size_t i, double v) {
+                colors[begin + i](c) = v / 255.0;
+            });
+        }
+    }
+}
+
+// Number of vertices converted per block, and per progress update.
+const size_t kVertexBlockSize = 1 << 16;
+
+bool ReadPointCloud(PLYReader &reader, geometry::PointCloud &pointcloud) {
+    const PLYVertexLayout layout(reader.elements_[0]);
+    const int64_t num_vertices = reader.elements_[0].count;
+    if (!layout.HasPoints() || num_vertices <= 0) {
+        utility::PrintWarning("Read PLY failed: number of vertex <= 0.\n");
+        return false;
+    }
+    pointcloud.Clear();
+    pointcloud.points_.resize(num_vertices);
+    pointcloud.normals_.resize(layout.HasNormals() ? num_vertices : 0);
+    pointcloud.colors_.resize(layout.HasColors() ? num_vertices : 0);
+    utility::ResetConsoleProgress(
+            (num_vertices + kVertexBlockSize - 1) / kVertexBlockSize + 1,
+            "Reading PLY: ");
+    bool success = ReadVertexBlocks(
+            reader, kVertexBlockSize,
+            [&](size_t begin, const PLYVertexBlock &block) {
+                DecodeVertexBlock(block, layout, begin, pointcloud.points_,
+                                  pointcloud.normals_, pointcloud.colors_);
+                utility::AdvanceConsoleProgress();
+                return true;
+            });
+    if (!success) {
+        utility::PrintWarning("Read PLY failed: unable to read file: %s\n",
+                              reader.filename_.c_str());
+        return false;
+    }
+    utility::AdvanceConsoleProgress();
+    return true;
+}
+
+bool ReadCompactPointCloud(PLYReader &reader,
+                           geometry::CompactPointCloud &pointcloud) {
+    const PLYVertexLayout layout(reader.elements_[0]);
+    const int64_t num_vertices = reader.elements_[0].count;
+    if (!layout.HasPoints() || num_vertices <= 0) {
+        utility::PrintWarning("Read PLY failed: number of vertex <= 0.\n");
+        return false;
+    }
+    pointcloud.Clear();
+    pointcloud.Resize(num_vertices, layout.HasNormals(), layout.HasColors());
+    std::vector<float> *positions[3] = {&pointcloud.x_, &pointcloud.y_,
+                                        &pointcloud.z_};
+    std::vector<float> *normals[3] = {&pointcloud.nx_, &pointcloud.ny_,
+                                      &pointcloud.nz_};
+    std::vector<uint8_t> *colors[3] = {&pointcloud.r_, &pointcloud.g_,
+                                       &pointcloud.b_};
+    utility::ResetConsoleProgress(
+            (num_vertices + kVertexBlockSize - 1) / kVertexBlockSize + 1,
+            "Reading PLY: ");
+    bool success = ReadVertexBlocks(
+            reader, kVertexBlockSize,
+            [&](size_t begin, const PLYVertexBlock &block) {
+                for (int c = 0; c < 3; c++) {
+                    float *position = positions[c]->data() + begin;
+                    block.DecodeProperty(layout.position_[c],
+                                         [&](size_t i, double v) {
+                                             position[i] = (float)v;
+                                         });
+                    if (layout.HasNormals()) {
+                        float *normal = normals[c]->data() + begin;
+                        block.DecodeProperty(layout.normal_[c],
+                                             [&](size_t i, double v) {
+                                                 normal[i] = (float)v;
+                                             });
+                    }
+                    if (layout.HasColors()) {
+                        uint8_t *color = colors[c]->data() + begin;
+                        block.DecodeProperty(
+                                layout.color_[c], [&](size_t i, double v) {
+                                    color[i] = geometry::CompactPointCloud::
+                                            QuantizeColor(v / 255.0);
+                                });
+                    }
+                }
+                utility::AdvanceConsoleProgress();
+                return true;
+            });
+    if (!success) {
+        utility::PrintWarning("Read PLY failed: unable to read file: %s\n",
+                              reader.filename_.c_str());
+        return false;
+    }
+    utility::AdvanceConsoleProgress();
+    return true;
+}
+
+bool ReadTriangleMesh(PLYReader &reader, geometry::TriangleMesh &mesh) {
+    const PLYVertexLayout layout(reader.elements_[0]);
+    const int64_t num_vertices = reader.elements_[0].count;
+    if (!layout.HasPoints() || num_vertices <= 0) {
+        utility::PrintWarning("Read PLY failed: number of vertex <= 0.\n");
+        return false;
+    }
+    const int64_t num_faces =
+            reader.elements_.size() > 1 ? reader.elements_[1].count : 0;
+    mesh.Clear();
+    mesh.vertices_.resize(num_vertices);
+    mesh.vertex_normals_.resize(layout.HasNormals() ? num_vertices : 0);
+    mesh.vertex_colors_.resize(layout.HasColors() ? num_vertices : 0);
+    utility::ResetConsoleProgress(
+            (num_vertices + kVertexBlockSize - 1) / kVertexBlockSize +
+                    num_faces,
+            "Reading PLY: ");
+    if (!ReadVertexBlocks(reader, kVertexBlockSize,
+                          [&](size_t begin, const PLYVertexBlock &block) {
+                              DecodeVertexBlock(block, layout, begin,
+                                                mesh.vertices_,
+                                                mesh.vertex_normals_,
+                                                mesh.vertex_colors_);
+                              utility::AdvanceConsoleProgress();
+                              return true;
+                          }) ||
+        (reader.elements_.size() > 1 &&
+         !ReadBinaryFaces(reader, mesh.triangles_))) {
+        utility::PrintWarning("Read PLY failed: unable to read file: %s\n",
+                              reader.filename_.c_str());
+        return false;
+    }
+    return true;
+}
+
+/// Builds the same header rply writes for a binary little endian file.
+class PLYHeader {
+public:
+    PLYHeader() {
+        header_ = "ply\nformat binary_little_endian 1.0\n";
+        header_ += "comment Created by Open3D\n";
+    }
+
+    void AddElement(const char *name, size_t count) {
+        header_ += std::string("element ") + name + " " +
+                   std::to_string(count) + "\n";
+    }
+    void AddProperty(const char *type, const char *name) {
+        header_ += std::string("property ") + type + " " + name + "\n";
+    }
+    void AddVector3Properties(const char *type,
+                              const char *name0,
+                              const char *name1,
+                              const char *name2) {
+        AddProperty(type, name0);
+        AddProperty(type, name1);
+        AddProperty(type, name2);
+    }
+    void AddListProperty(const char *length_type,
+                         const char *type,
+                         const char *name) {
+        header_ += std::string("property list ") + length_type + " " + type +
+                   " " + name + "\n";
+    }
+    std::string ToString() const { return header_ + "end_header\n"; }
+
+private:
+    std::string header_;
+};
+
+/// Writes little endian binary data through a large buffer instead of one
+/// rply call per value.
+class PLYBinaryWriter {
+public:
+    ~PLYBinaryWriter() {
+        if (file_ != NULL) {
+            fclose(file_);
+        }
+    }
+
+public:
+    bool Open(const std::string &filename) {
+        file_ = fopen(filename.c_str(), "wb");
+        return file_ != NULL;
+    }
+
+    void WriteHeader(const std::string &header) {
+        Flush();
+        if (fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+            failed_ = true;
+        }
+    }
+
+    template <typename T>
+    void Write(T value) {
+        if (size_ + sizeof(T) > buffer_.size()) {
+            Flush();
+        }
+        uint8_t *bytes = buffer_.data() + size_;
+        memcpy(bytes, &value, sizeof(T));
+        if (swap_) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        size_ += sizeof(T);
+    }
+
+    void WriteColor(const Eigen::Vector3d &color) {
+        for (int c = 0; c < 3; c++) {
+            Write((uint8_t)std::min(255.0, std::max(0.0, color(c) * 255.0)));
+        }
+    }
+
+    /// Flushes the buffer and closes the file. Returns false if any write
+    /// failed.
+    bool Close() {
+        Flush();
+        const bool success = !failed_ && fclose(file_) == 0;
+        file_ = NULL;
+        return success;
+    }
+
+private:
+    void Flush() {
+        if (size_ > 0 && fwrite(buffer_.data(), 1, size_, file_) != size_) {
+            failed_ = true;
+        }
+        size_ = 0;
+    }
+
+private:
+    FILE *file_ = NULL;
+    std::vector<uint8_t> buffer_ = std::vector<uint8_t>(1 << 22);
+    size_t size_ = 0;
+    bool swap_ = !IsHostLittleEndian();
+    bool failed_ = false;
+};
+
+bool WritePointCloud(const std::string &filename,
+                     const geometry::PointCloud &pointcloud) {
+    PLYBinaryWriter writer;
+    if (!writer.Open(filename)) {
+        utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    const bool has_normals = pointcloud.HasNormals();
+    const bool has_colors = pointcloud.HasColors();
+    PLYHeader header;
+    header.AddElement("vertex", pointcloud.points_.size());
+    header.AddVector3Properties("double", "x", "y", "z");
+    if (has_normals) {
+        header.AddVector3Properties("double", "nx", "ny", "nz");
+    }
+    if (has_colors) {
+        header.AddVector3Properties("uchar", "red", "green", "blue");
+    }
+    writer.WriteHeader(header.ToString());
+
+    utility::ResetConsoleProgress(
+            (pointcloud.points_.size() + kVertexBlockSize - 1) /
+                    kVertexBlockSize,
+            "Writing PLY: ");
+    for (size_t i = 0; i < pointcloud.points_.size(); i++) {
+        const Eigen::Vector3d &point = pointcloud.points_[i];
+        writer.Write(point(0));
+        writer.Write(point(1));
+        writer.Write(point(2));
+        if (has_normals) {
+            const Eigen::Vector3d &normal = pointcloud.normals_[i];
+            writer.Write(normal(0));
+            writer.Write(normal(1));
+            writer.Write(normal(2));
+        }
+        if (has_colors) {
+            writer.WriteColor(pointcloud.colors_[i]);
+        }
+        if ((i + 1) % kVertexBlockSize == 0) {
+            utility::AdvanceConsoleProgress();
+        }
+    }
+    if (!writer.Close()) {
+        utility::PrintWarning("Write PLY failed: unable to write file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool WriteCompactPointCloud(const std::string &filename,
+                            const geometry::CompactPointCloud &pointcloud) {
+    PLYBinaryWriter writer;
+    if (!writer.Open(filename)) {
+        utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    const size_t num_points = pointcloud.GetNumberOfPoints();
+    const bool has_normals = pointcloud.HasNormals();
+    const bool has_colors = pointcloud.HasColors();
+    PLYHeader header;
+    header.AddElement("vertex", num_points);
+    header.AddVector3Properties("float", "x", "y", "z");
+    if (has_normals) {
+        header.AddVector3Properties("float", "nx", "ny", "nz");
+    }
+    if (has_colors) {
+        header.AddVector3Properties("uchar", "red", "green", "blue");
+    }
+    writer.WriteHeader(header.ToString());
+
+    utility::ResetConsoleProgress(
+            (num_points + kVertexBlockSize - 1) / kVertexBlockSize,
+            "Writing PLY: ");
+    for (size_t i = 0; i < num_points; i++) {
+        writer.Write(pointcloud.x_[i]);
+        writer.Write(pointcloud.y_[i]);
+        writer.Write(pointcloud.z_[i]);
+        if (has_normals) {
+            writer.Write(pointcloud.nx_[i]);
+            writer.Write(pointcloud.ny_[i]);
+            writer.Write(pointcloud.nz_[i]);
+        }
+        if (has_colors) {
+            writer.Write(pointcloud.r_[i]);
+            writer.Write(pointcloud.g_[i]);
+            writer.Write(pointcloud.b_[i]);
+        }
+        if ((i + 1) % kVertexBlockSize == 0) {
+            utility::AdvanceConsoleProgress();
+        }
+    }
+    if (!writer.Close()) {
+        utility::PrintWarning("Write PLY failed: unable to write file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool WriteTriangleMesh(const std::string &filename,
+                       const geometry::TriangleMesh &mesh) {
+    PLYBinaryWriter writer;
+    if (!writer.Open(filename)) {
+        utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    const bool has_normals = mesh.HasVertexNormals();
+    const bool has_colors = mesh.HasVertexColors();
+    PLYHeader header;
+    header.AddElement("vertex", mesh.vertices_.size());
+    header.AddVector3Properties("double", "x", "y", "z");
+    if (has_normals) {
+        header.AddVector3Properties("double", "nx", "ny", "nz");
+    }
+    if (has_colors) {
+        header.AddVector3Properties("uchar", "red", "green", "blue");
+    }
+    header.AddElement("face", mesh.triangles_.size());
+    header.AddListProperty("uchar", "uint", "vertex_indices");
+    writer.WriteHeader(header.ToString());
+
+    const size_t num_elements = mesh.vertices_.size() + mesh.triangles_.size();
+    utility::ResetConsoleProgress(
+            (num_elements + kVertexBlockSize - 1) / kVertexBlockSize,
+            "Writing PLY: ");
+    for (size_t i = 0; i < mesh.vertices_.size(); i++) {
+        const Eigen::Vector3d &vertex = mesh.vertices_[i];
+        writer.Write(vertex(0));
+        writer.Write(vertex(1));
+        writer.Write(vertex(2));
+        if (has_normals) {
+            const Eigen::Vector3d &normal = mesh.vertex_normals_[i];
+            writer.Write(normal(0));
+            writer.Write(normal(1));
+            writer.Write(normal(2));
+        }
+        if (has_colors) {
+            writer.WriteColor(mesh.vertex_colors_[i]);
+        }
+        if ((i + 1) % kVertexBlockSize == 0) {
+            utility::AdvanceConsoleProgress();
+        }
+    }
+    for (size_t i = 0; i < mesh.triangles_.size(); i++) {
+        const Eigen::Vector3i &triangle = mesh.triangles_[i];
+        writer.Write((uint8_t)3);
+        writer.Write((uint32_t)triangle(0));
+        writer.Write((uint32_t)triangle(1));
+        writer.Write((uint32_t)triangle(2));
+        if ((mesh.vertices_.size() + i + 1) % kVertexBlockSize == 0) {
+            utility::AdvanceConsoleProgress();
+        }
+    }
+    if (!writer.Close()) {
+        utility::PrintWarning("Write PLY failed: unable to write file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace ply_fast_path
+
 }  // unnamed namespace
 
 namespace io {
 
 bool ReadPointCloudFromPLY(const std::string &filename,
                            geometry::PointCloud &pointcloud) {
+    {
+        ply_fast_path::PLYReader reader;
+        if (reader.Open(filename) && reader.CanReadVertexBlocks(false)) {
+            return ply_fast_path::ReadPointCloud(reader, pointcloud);
+        }
+    }
+
     using namespace ply_pointcloud_reader;
 
     p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
@@ -410,10 +1490,11 @@ bool WritePointCloudToPLY(const std::string &filename,
         utility::PrintWarning("Write PLY failed: point cloud has 0 points.\n");
         return false;
     }
+    if (!write_ascii) {
+        return ply_fast_path::WritePointCloud(filename, pointcloud);
+    }
 
-    p_ply ply_file = ply_create(filename.c_str(),
-                                write_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
-                                NULL, 0, NULL);
+    p_ply ply_file = ply_create(filename.c_str(), PLY_ASCII, NULL, 0, NULL);
     if (!ply_file) {
         utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
                               filename.c_str());
@@ -471,8 +1552,202 @@ bool WritePointCloudToPLY(const std::string &filename,
     return true;
 }
 
+bool ReadPointCloudFromPLYInChunks(
+        const std::string &filename,
+        size_t chunk_size,
+        const std::function<bool(const geometry::PointCloud &)> &callback) {
+    if (chunk_size == 0) {
+        utility::PrintWarning("Read PLY failed: chunk size must be > 0.\n");
+        return false;
+    }
+    ply_fast_path::PLYReader reader;
+    if (!reader.Open(filename)) {
+        utility::PrintWarning(
+                "Read PLY failed: unable to open file or parse header: %s\n",
+                filename.c_str());
+        return false;
+    }
+    if (!reader.CanReadVertexBlocks(true)) {
+        utility::PrintWarning(
+                "Read PLY failed: vertex element must come first and have a "
+                "fixed size.\n");
+        return false;
+    }
+    const ply_fast_path::PLYVertexLayout layout(reader.elements_[0]);
+    if (!layout.HasPoints() || reader.elements_[0].count <= 0) {
+        utility::PrintWarning("Read PLY failed: number of vertex <= 0.\n");
+        return false;
+    }
+    geometry::PointCloud chunk;
+    bool success = ply_fast_path::ReadVertexBlocks(
+            reader, chunk_size,
+            [&](size_t begin, const ply_fast_path::PLYVertexBlock &block) {
+                chunk.points_.resize(block.size());
+                chunk.normals_.resize(layout.HasNormals() ? block.size() : 0);
+                chunk.colors_.resize(layout.HasColors() ? block.size() : 0);
+                ply_fast_path::DecodeVertexBlock(block, layout, 0,
+                                                 chunk.points_, chunk.normals_,
+                                                 chunk.colors_);
+                return callback(chunk);
+            });
+    if (!success) {
+        utility::PrintWarning("Read PLY failed: unable to read file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReadCompactPointCloudFromPLY(const std::string &filename,
+                                  geometry::CompactPointCloud &pointcloud) {
+    {
+        ply_fast_path::PLYReader reader;
+        if (reader.Open(filename) && reader.CanReadVertexBlocks(false)) {
+            return ply_fast_path::ReadCompactPointCloud(reader, pointcloud);
+        }
+    }
+
+    using namespace ply_compact_pointcloud_reader;
+
+    p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
+    if (!ply_file) {
+        utility::PrintWarning("Read PLY failed: unable to open file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    if (!ply_read_header(ply_file)) {
+        utility::PrintWarning("Read PLY failed: unable to parse header.\n");
+        ply_close(ply_file);
+        return false;
+    }
+
+    PLYReaderState state;
+    state.pointcloud_ptr = &pointcloud;
+    state.vertex_num = ply_set_read_cb(ply_file, "vertex", "x",
+                                       ReadVertexCallback, &state, 0);
+    ply_set_read_cb(ply_file, "vertex", "y", ReadVertexCallback, &state, 1);
+    ply_set_read_cb(ply_file, "vertex", "z", ReadVertexCallback, &state, 2);
+
+    state.normal_num = ply_set_read_cb(ply_file, "vertex", "nx",
+                                       ReadNormalCallback, &state, 0);
+    ply_set_read_cb(ply_file, "vertex", "ny", ReadNormalCallback, &state, 1);
+    ply_set_read_cb(ply_file, "vertex", "nz", ReadNormalCallback, &state, 2);
+
+    state.color_num = ply_set_read_cb(ply_file, "vertex", "red",
+                                      ReadColorCallback, &state, 0);
+    ply_set_read_cb(ply_file, "vertex", "green", ReadColorCallback, &state, 1);
+    ply_set_read_cb(ply_file, "vertex", "blue", ReadColorCallback, &state, 2);
+
+    if (state.vertex_num <= 0) {
+        utility::PrintWarning("Read PLY failed: number of vertex <= 0.\n");
+        ply_close(ply_file);
+        return false;
+    }
+
+    state.vertex_index = 0;
+    state.normal_index = 0;
+    state.color_index = 0;
+
+    pointcloud.Clear();
+    pointcloud.Resize(state.vertex_num, state.normal_num == state.vertex_num,
+                      state.color_num == state.vertex_num);
+    state.normal_num = (long)pointcloud.nx_.size();
+    state.color_num = (long)pointcloud.r_.size();
+
+    utility::ResetConsoleProgress(state.vertex_num + 1, "Reading PLY: ");
+
+    if (!ply_read(ply_file)) {
+        utility::PrintWarning("Read PLY failed: unable to read file: %s\n",
+                              filename.c_str());
+        ply_close(ply_file);
+        return false;
+    }
+
+    ply_close(ply_file);
+    utility::AdvanceConsoleProgress();
+    return true;
+}
+
+bool WriteCompactPointCloudToPLY(const std::string &filename,
+                                 const geometry::CompactPointCloud &pointcloud,
+                                 bool write_ascii /* = false*/,
+                                 bool compressed /* = false*/) {
+    if (pointcloud.IsEmpty()) {
+        utility::PrintWarning("Write PLY failed: point cloud has 0 points.\n");
+        return false;
+    }
+    if (!write_ascii) {
+        return ply_fast_path::WriteCompactPointCloud(filename, pointcloud);
+    }
+
+    p_ply ply_file = ply_create(filename.c_str(), PLY_ASCII, NULL, 0, NULL);
+    if (!ply_file) {
+        utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
+                              filename.c_str());
+        return false;
+    }
+    bool has_normals = pointcloud.HasNormals();
+    bool has_colors = pointcloud.HasColors();
+    ply_add_comment(ply_file, "Created by Open3D");
+    ply_add_element(ply_file, "vertex",
+                    static_cast<long>(pointcloud.GetNumberOfPoints()));
+    ply_add_property(ply_file, "x", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+    ply_add_property(ply_file, "y", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+    ply_add_property(ply_file, "z", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+    if (has_normals) {
+        ply_add_property(ply_file, "nx", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+        ply_add_property(ply_file, "ny", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+        ply_add_property(ply_file, "nz", PLY_FLOAT, PLY_FLOAT, PLY_FLOAT);
+    }
+    if (has_colors) {
+        ply_add_property(ply_file, "red", PLY_UCHAR, PLY_UCHAR, PLY_UCHAR);
+        ply_add_property(ply_file, "green", PLY_UCHAR, PLY_UCHAR, PLY_UCHAR);
+        ply_add_property(ply_file, "blue", PLY_UCHAR, PLY_UCHAR, PLY_UCHAR);
+    }
+    if (!ply_write_header(ply_file)) {
+        utility::PrintWarning("Write PLY failed: unable to write header.\n");
+        ply_close(ply_file);
+        return false;
+    }
+
+    utility::ResetConsoleProgress(
+            static_cast<int>(pointcloud.GetNumberOfPoints()), "Writing PLY: ");
+
+    for (size_t i = 0; i < pointcloud.GetNumberOfPoints(); i++) {
+        ply_write(ply_file, pointcloud.x_[i]);
+        ply_write(ply_file, pointcloud.y_[i]);
+        ply_write(ply_file, pointcloud.z_[i]);
+        if (has_normals) {
+            ply_write(ply_file, pointcloud.nx_[i]);
+            ply_write(ply_file, pointcloud.ny_[i]);
+            ply_write(ply_file, pointcloud.nz_[i]);
+        }
+        if (has_colors) {
+            ply_write(ply_file, pointcloud.r_[i]);
+            ply_write(ply_file, pointcloud.g_[i]);
+            ply_write(ply_file, pointcloud.b_[i]);
+        }
+        utility::AdvanceConsoleProgress();
+    }
+
+    ply_close(ply_file);
+    return true;
+}
+
 bool ReadTriangleMeshFromPLY(const std::string &filename,
                              geometry::TriangleMesh &mesh) {
+    {
+        // Faces are read by the fast path only if they directly follow the
+        // vertices.
+        ply_fast_path::PLYReader reader;
+        if (reader.Open(filename) && reader.CanReadVertexBlocks(false) &&
+            (reader.elements_.size() == 1 ||
+             (reader.elements_.size() == 2 &&
+              reader.elements_[1].name == "face"))) {
+            return ply_fast_path::ReadTriangleMesh(reader, mesh);
+        }
+    }
+
     using namespace ply_trianglemesh_reader;
 
     p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
@@ -550,10 +1825,11 @@ bool WriteTriangleMeshToPLY(const std::string &filename,
         utility::PrintWarning("Write PLY failed: mesh has 0 vertices.\n");
         return false;
     }
+    if (!write_ascii) {
+        return ply_fast_path::WriteTriangleMesh(filename, mesh);
+    }
 
-    p_ply ply_file = ply_create(filename.c_str(),
-                                write_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
-                                NULL, 0, NULL);
+    p_ply ply_file = ply_create(filename.c_str(), PLY_ASCII, NULL, 0, NULL);
     if (!ply_file) {
         utility::PrintWarning("Write PLY failed: unable to open file: %s\n",
                               filename.c_str());
@@ -24,9 +24,11 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
 
@@ -35,7 +37,7 @@ namespace io {
 
 bool ReadPointCloudFromPTS(const std::string &filename,
                            geometry::PointCloud &pointcloud) {
-    FILE *file = fopen(filename.c_str(), "r");
+    FILE *file = fopen(filename.c_str(), "rb");
     if (file == NULL) {
         utility::PrintWarning("Read PTS failed: unable to open file.\n");
         return false;
@@ -50,44 +52,58 @@ bool ReadPointCloudFromPTS(const std::string &filename,
         fclose(file);
         return false;
     }
+    // The number of fields of the first point decides the layout of all.
+    const long data_start = ftell(file);
+    if (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
+        std::vector<std::string> st;
+        utility::SplitString(st, line_buffer, " ");
+        num_of_fields = (int)st.size();
+    }
+    if (num_of_fields < 3) {
+        utility::PrintWarning("Read PTS failed: insufficient data fields.\n");
+        fclose(file);
+        return false;
+    }
+    fseek(file, data_start, SEEK_SET);
+
+    // X Y Z I R G B; the intensity is parsed but not stored.
+    const bool has_colors = num_of_fields >= 7;
+    const int num_values = has_colors ? 7 : 3;
+    pointcloud.points_.resize(num_of_pts);
+    if (has_colors) {
+        pointcloud.colors_.resize(num_of_pts);
+    }
     utility::ResetConsoleProgress(num_of_pts, "Reading PTS: ");
     int idx = 0;
-    while (idx < num_of_pts &&
-           fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (num_of_fields == 0) {
-            std::vector<std::string> st;
-            utility::SplitString(st, line_buffer, " ");
-            num_of_fields = (int)st.size();
-            if (num_of_fields < 3) {
-                utility::PrintWarning(
-                        "Read PTS failed: insufficient data fields.\n");
-                fclose(file);
-                return false;
-            }
-            pointcloud.points_.resize(num_of_pts);
-            if (num_of_fields >= 7) {
-                // X Y Z I R G B
-                pointcloud.colors_.resize(num_of_pts);
-            }
-        }
-        double x, y, z;
-        int i, r, g, b;
-        if (num_of_fields < 7) {
-            if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-            }
-        } else {
-            if (sscanf(line_buffer, "%lf %lf %lf %d %d %d %d", &x, &y, &z, &i,
-                       &r, &g, &b) == 7) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-                pointcloud.colors_[idx] = Eigen::Vector3d(r, g, b) / 255.0;
-            }
-        }
-        idx++;
-        utility::AdvanceConsoleProgress();
-    }
+    bool success = ReadASCIILines(
+            file, num_values,
+            [num_values](const char *begin, const char *end, double *values) {
+                // Lines that cannot be parsed still count as a point.
+                if (!ParseDoubles(begin, end, num_values, values)) {
+                    std::fill(values, values + num_values, 0.0);
+                }
+                return true;
+            },
+            [&](const double *values, size_t num) {
+                for (size_t i = 0; i < num && idx < num_of_pts;
+                     i++, values += num_values) {
+                    pointcloud.points_[idx] =
+                            Eigen::Vector3d(values[0], values[1], values[2]);
+                    if (has_colors) {
+                        pointcloud.colors_[idx] =
+                                Eigen::Vector3d((int)values[4], (int)values[5],
+                                                (int)values[6]) /
+                                255.0;
+                    }
+                    idx++;
+                    utility::AdvanceConsoleProgress();
+                }
+            });
     fclose(file);
-    return true;
+    if (!success) {
+        utility::PrintWarning("Read PTS failed: unable to read file.\n");
+    }
+    return success;
 }
 
 bool WritePointCloudToPTS(const std::string &filename,
@@ -99,24 +115,35 @@ bool WritePointCloudToPTS(const std::string &filename,
         utility::PrintWarning("Write PTS failed: unable to open file.\n");
         return false;
     }
-    fprintf(file, "%d\r\n", (int)pointcloud.points_.size());
+    ASCIIWriter writer(file);
+    writer.WriteInt((int)pointcloud.points_.size());
+    writer.WriteString("\r\n");
     utility::ResetConsoleProgress(static_cast<int>(pointcloud.points_.size()),
                                   "Writinging PTS: ");
     for (size_t i = 0; i < pointcloud.points_.size(); i++) {
         const auto &point = pointcloud.points_[i];
-        if (pointcloud.HasColors() == false) {
-            fprintf(file, "%.10f %.10f %.10f\r\n", point(0), point(1),
-                    point(2));
-        } else {
+        writer.WriteDouble(point(0), 10);
+        writer.WriteChar(' ');
+        writer.WriteDouble(point(1), 10);
+        writer.WriteChar(' ');
+        writer.WriteDouble(point(2), 10);
+        if (pointcloud.HasColors()) {
             const auto &color = pointcloud.colors_[i] * 255.0;
-            fprintf(file, "%.10f %.10f %.10f %d %d %d %d\r\n", point(0),
-                    point(1), point(2), 0, (int)color(0), (int)color(1),
-                    (int)(color(2)));
+            writer.WriteString(" 0");
+            for (int c = 0; c < 3; c++) {
+                writer.WriteChar(' ');
+                writer.WriteInt((int)color(c));
+            }
         }
+        writer.WriteString("\r\n");
         utility::AdvanceConsoleProgress();
     }
+    bool success = writer.Flush();
     fclose(file);
-    return true;
+    if (!success) {
+        utility::PrintWarning("Write PTS failed: unable to write file.\n");
+    }
+    return success;
 }
 
 }  // namespace io
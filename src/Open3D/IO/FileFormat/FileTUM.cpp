@@ -88,7 +88,8 @@ bool ReadPinholeCameraTrajectoryFromTUM(
 
 bool WritePinholeCameraTrajectoryToTUM(
         const std::string &filename,
-        const camera::PinholeCameraTrajectory &trajectory) {
+        const camera::PinholeCameraTrajectory &trajectory,
+        bool compressed /* = false*/) {
     FILE *f = fopen(filename.c_str(), "w");
     if (f == NULL) {
         utility::PrintWarning("Write TUM failed: unable to open file: %s\n",
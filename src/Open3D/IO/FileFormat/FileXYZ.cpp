@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -34,25 +35,35 @@ namespace io {
 
 bool ReadPointCloudFromXYZ(const std::string &filename,
                            geometry::PointCloud &pointcloud) {
-    FILE *file = fopen(filename.c_str(), "r");
+    FILE *file = fopen(filename.c_str(), "rb");
     if (file == NULL) {
         utility::PrintWarning("Read XYZ failed: unable to open file: %s\n",
                               filename.c_str());
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-        }
-    }
+    auto &points = pointcloud.points_;
+    bool success = ReadASCIILines(
+            file, 3,
+            [](const char *begin, const char *end, double *values) {
+                return ParseDoubles(begin, end, 3, values);
+            },
+            [&points](const double *values, size_t num) {
+                const size_t offset = points.size();
+                points.resize(offset + num);
+                for (size_t i = 0; i < num; i++, values += 3) {
+                    points[offset + i] =
+                            Eigen::Vector3d(values[0], values[1], values[2]);
+                }
+            });
 
     fclose(file);
-    return true;
+    if (!success) {
+        utility::PrintWarning("Read XYZ failed: unable to read file: %s\n",
+                              filename.c_str());
+    }
+    return success;
 }
 
 bool WritePointCloudToXYZ(const std::string &filename,
@@ -66,18 +77,23 @@ bool WritePointCloudToXYZ(const std::string &filename,
         return false;
     }
 
+    ASCIIWriter writer(file);
     for (size_t i = 0; i < pointcloud.points_.size(); i++) {
         const Eigen::Vector3d &point = pointcloud.points_[i];
-        if (fprintf(file, "%.10f %.10f %.10f\n", point(0), point(1), point(2)) <
-            0) {
-            utility::PrintWarning(
-                    "Write XYZ failed: unable to write file: %s\n",
-                    filename.c_str());
-            fclose(file);
-            return false;  // error happens during writing.
-        }
+        writer.WriteDouble(point(0), 10);
+        writer.WriteChar(' ');
+        writer.WriteDouble(point(1), 10);
+        writer.WriteChar(' ');
+        writer.WriteDouble(point(2), 10);
+        writer.WriteChar('\n');
     }
 
+    if (!writer.Flush()) {
+        utility::PrintWarning("Write XYZ failed: unable to write file: %s\n",
+                              filename.c_str());
+        fclose(file);
+        return false;  // error happens during writing.
+    }
     fclose(file);
     return true;
 }
@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -34,27 +35,39 @@ namespace io {
 
 bool ReadPointCloudFromXYZN(const std::string &filename,
                             geometry::PointCloud &pointcloud) {
-    FILE *file = fopen(filename.c_str(), "r");
+    FILE *file = fopen(filename.c_str(), "rb");
     if (file == NULL) {
         utility::PrintWarning("Read XYZN failed: unable to open file: %s\n",
                               filename.c_str());
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z, nx, ny, nz;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf %lf %lf %lf", &x, &y, &z, &nx, &ny,
-                   &nz) == 6) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            pointcloud.normals_.push_back(Eigen::Vector3d(nx, ny, nz));
-        }
-    }
+    auto &points = pointcloud.points_;
+    auto &normals = pointcloud.normals_;
+    bool success = ReadASCIILines(
+            file, 6,
+            [](const char *begin, const char *end, double *values) {
+                return ParseDoubles(begin, end, 6, values);
+            },
+            [&points, &normals](const double *values, size_t num) {
+                const size_t offset = points.size();
+                points.resize(offset + num);
+                normals.resize(offset + num);
+                for (size_t i = 0; i < num; i++, values += 6) {
+                    points[offset + i] =
+                            Eigen::Vector3d(values[0], values[1], values[2]);
+                    normals[offset + i] =
+                            Eigen::Vector3d(values[3], values[4], values[5]);
+                }
+            });
 
     fclose(file);
-    return true;
+    if (!success) {
+        utility::PrintWarning("Read XYZN failed: unable to read file: %s\n",
+                              filename.c_str());
+    }
+    return success;
 }
 
 bool WritePointCloudToXYZN(const std::string &filename,
@@ -72,19 +85,27 @@ bool WritePointCloudToXYZN(const std::string &filename,
         return false;
     }
 
+    ASCIIWriter writer(file);
     for (size_t i = 0; i < pointcloud.points_.size(); i++) {
         const Eigen::Vector3d &point = pointcloud.points_[i];
         const Eigen::Vector3d &normal = pointcloud.normals_[i];
-        if (fprintf(file, "%.10f %.10f %.10f %.10f %.10f %.10f\n", point(0),
-                    point(1), point(2), normal(0), normal(1), normal(2)) < 0) {
-            utility::PrintWarning(
-                    "Write XYZN failed: unable to write file: %s\n",
-                    filename.c_str());
-            fclose(file);
-            return false;  // error happens during writing.
+        for (int c = 0; c < 3; c++) {
+            writer.WriteDouble(point(c), 10);
+            writer.WriteChar(' ');
+        }
+        for (int c = 0; c < 3; c++) {
+            writer.WriteDouble(normal(c), 10);
+            writer.WriteChar(c < 2 ? ' ' : '\n');
         }
     }
 
+    if (!writer.Flush()) {
+        utility::PrintWarning(
+                "Write XYZN failed: unable to write file: %s\n",
+                filename.c_str());
+        fclose(file);
+        return false;  // error happens during writing.
+    }
     fclose(file);
     return true;
 }
@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -34,27 +35,39 @@ namespace io {
 
 bool ReadPointCloudFromXYZRGB(const std::string &filename,
                               geometry::PointCloud &pointcloud) {
-    FILE *file = fopen(filename.c_str(), "r");
+    FILE *file = fopen(filename.c_str(), "rb");
     if (file == NULL) {
         utility::PrintWarning("Read XYZRGB failed: unable to open file: %s\n",
                               filename.c_str());
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z, r, g, b;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf %lf %lf %lf", &x, &y, &z, &r, &g,
-                   &b) == 6) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            pointcloud.colors_.push_back(Eigen::Vector3d(r, g, b));
-        }
-    }
+    auto &points = pointcloud.points_;
+    auto &colors = pointcloud.colors_;
+    bool success = ReadASCIILines(
+            file, 6,
+            [](const char *begin, const char *end, double *values) {
+                return ParseDoubles(begin, end, 6, values);
+            },
+            [&points, &colors](const double *values, size_t num) {
+                const size_t offset = points.size();
+                points.resize(offset + num);
+                colors.resize(offset + num);
+                for (size_t i = 0; i < num; i++, values += 6) {
+                    points[offset + i] =
+                            Eigen::Vector3d(values[0], values[1], values[2]);
+                    colors[offset + i] =
+                            Eigen::Vector3d(values[3], values[4], values[5]);
+                }
+            });
 
     fclose(file);
-    return true;
+    if (!success) {
+        utility::PrintWarning("Read XYZRGB failed: unable to read file: %s\n",
+                              filename.c_str());
+    }
+    return success;
 }
 
 bool WritePointCloudToXYZRGB(const std::string &filename,
@@ -72,19 +85,27 @@ bool WritePointCloudToXYZRGB(const std::string &filename,
         return false;
     }
 
+    ASCIIWriter writer(file);
     for (size_t i = 0; i < pointcloud.points_.size(); i++) {
         const Eigen::Vector3d &point = pointcloud.points_[i];
         const Eigen::Vector3d &color = pointcloud.colors_[i];
-        if (fprintf(file, "%.10f %.10f %.10f %.10f %.10f %.10f\n", point(0),
-                    point(1), point(2), color(0), color(1), color(2)) < 0) {
-            utility::PrintWarning(
-                    "Write XYZRGB failed: unable to write file: %s\n",
-                    filename.c_str());
-            fclose(file);
-            return false;  // error happens during writing.
+        for (int c = 0; c < 3; c++) {
+            writer.WriteDouble(point(c), 10);
+            writer.WriteChar(' ');
+        }
+        for (int c = 0; c < 3; c++) {
+            writer.WriteDouble(color(c), 10);
+            writer.WriteChar(c < 2 ? ' ' : '\n');
         }
     }
 
+    if (!writer.Flush()) {
+        utility::PrintWarning(
+                "Write XYZRGB failed: unable to write file: %s\n",
+                filename.c_str());
+        fclose(file);
+        return false;  // error happens during writing.
+    }
     fclose(file);
     return true;
 }
@@ -26,25 +26,546 @@
 
 #include "Open3D/Integration/ScalableTSDFVolume.h"
 
+#include <algorithm>
+#include <tuple>
 #include <unordered_set>
 
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Integration/UniformTSDFVolume.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Eigen.h"
 
 namespace open3d {
 namespace integration {
 
+/// A vertex lies on a voxel edge and is owned by the unit holding the first
+/// voxel of that edge. Cubes at the upper faces of a unit also produce
+/// vertices owned by its +x, +y, +z neighbours; those are kept separately as
+/// foreign vertices and welded to the owner's copy when the unit meshes are
+/// merged.
+struct ScalableTSDFVolume::VolumeUnitMesh {
+    std::vector<Eigen::Vector3d> vertices_;
+    std::vector<Eigen::Vector3d> vertex_colors_;
+    /// (edge id within the unit, vertex) of the owned vertices on the lower
+    /// faces of the unit, sorted by edge id. Only these can be foreign
+    /// vertices of a neighbour.
+    std::vector<std::pair<int, int>> boundary_vertices_;
+    /// Global edge index (x, y, z, axis) of each foreign vertex.
+    std::vector<Eigen::Vector4i, utility::Vector4i_allocator> foreign_edges_;
+    std::vector<Eigen::Vector3d> foreign_vertices_;
+    std::vector<Eigen::Vector3d> foreign_vertex_colors_;
+    /// Owned vertex k is referred to as k, foreign vertex k as -(k + 1).
+    std::vector<Eigen::Vector3i> triangles_;
+};
+
+namespace {
+
+using VolumeUnitMesh = ScalableTSDFVolume::VolumeUnitMesh;
+
+/// The volume units in the 3x3x3 neighbourhood of a volume unit. They are
+/// resolved once per unit, so that voxel accesses across unit boundaries do
+/// not need a hash lookup each.
+class VolumeUnitNeighbourhood {
+public:
+    VolumeUnitNeighbourhood(const ScalableTSDFVolume &volume,
+                            const Eigen::Vector3i &index)
+        : volume_(volume), index_(index) {
+        for (int i = 0; i < 27; i++) {
+            units_[i] = FindVolumeUnit(
+                    index + Eigen::Vector3i(i / 9 - 1, i / 3 % 3 - 1,
+                                            i % 3 - 1));
+        }
+    }
+
+public:
+    /// Returns the volume unit at the given index, or nullptr if it has not
+    /// been allocated.
+    const UniformTSDFVolume *GetVolumeUnit(const Eigen::Vector3i &index) const {
+        Eigen::Vector3i offset = index - index_;
+        if (offset.cwiseAbs().maxCoeff() <= 1) {
+            return units_[(offset(0) + 1) * 9 + (offset(1) + 1) * 3 +
+                          offset(2) + 1];
+        }
+        return FindVolumeUnit(index);
+    }
+
+    /// Returns the volume unit holding the voxel idx, given relative to the
+    /// center unit, and rewrites idx to the voxel index within that unit.
+    const UniformTSDFVolume *LocateVoxel(Eigen::Vector3i &idx) const {
+        const int resolution = volume_.volume_unit_resolution_;
+        Eigen::Vector3i index = index_;
+        for (int j = 0; j < 3; j++) {
+            int offset = (idx(j) >= 0 ? idx(j) : idx(j) - resolution + 1) /
+                         resolution;
+            idx(j) -= offset * resolution;
+            index(j) += offset;
+        }
+        return GetVolumeUnit(index);
+    }
+
+    Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p) const {
+        Eigen::Vector3d n;
+        const double half_gap = 0.99 * volume_.voxel_length_;
+        for (int i = 0; i < 3; i++) {
+            Eigen::Vector3d p0 = p;
+            p0(i) -= half_gap;
+            Eigen::Vector3d p1 = p;
+            p1(i) += half_gap;
+            n(i) = GetTSDFAt(p1) - GetTSDFAt(p0);
+        }
+        return n.normalized();
+    }
+
+    double GetTSDFAt(const Eigen::Vector3d &p) const {
+        const double voxel_length = volume_.voxel_length_;
+        const double volume_unit_length = volume_.volume_unit_length_;
+        const int resolution = volume_.volume_unit_resolution_;
+        Eigen::Vector3d p_locate =
+                p - Eigen::Vector3d(0.5, 0.5, 0.5) * voxel_length;
+        Eigen::Vector3i index0(
+                (int)std::floor(p_locate(0) / volume_unit_length),
+                (int)std::floor(p_locate(1) / volume_unit_length),
+                (int)std::floor(p_locate(2) / volume_unit_length));
+        const UniformTSDFVolume *volume0 = GetVolumeUnit(index0);
+        if (volume0 == nullptr) {
+            return 0.0;
+        }
+        Eigen::Vector3i idx0;
+        Eigen::Vector3d p_grid =
+                (p_locate - index0.cast<double>() * volume_unit_length) /
+                voxel_length;
+        for (int i = 0; i < 3; i++) {
+            idx0(i) = (int)std::floor(p_grid(i));
+            if (idx0(i) < 0) idx0(i) = 0;
+            if (idx0(i) >= resolution) idx0(i) = resolution - 1;
+        }
+        Eigen::Vector3d r = p_grid - idx0.cast<double>();
+        float f[8];
+        for (int i = 0; i < 8; i++) {
+            Eigen::Vector3i index1 = index0;
+            Eigen::Vector3i idx1 = idx0 + shift[i];
+            if (idx1(0) < resolution && idx1(1) < resolution &&
+                idx1(2) < resolution) {
+                f[i] = volume0->GetTSDF(volume0->IndexOf(idx1));
+            } else {
+                for (int j = 0; j < 3; j++) {
+                    if (idx1(j) >= resolution) {
+                        idx1(j) -= resolution;
+                        index1(j) += 1;
+                    }
+                }
+                const UniformTSDFVolume *volume1 = GetVolumeUnit(index1);
+                if (volume1 == nullptr) {
+                    f[i] = 0.0f;
+                } else {
+                    f[i] = volume1->GetTSDF(volume1->IndexOf(idx1));
+                }
+            }
+        }
+        return (1 - r(0)) * ((1 - r(1)) * ((1 - r(2)) * f[0] + r(2) * f[4]) +
+                             r(1) * ((1 - r(2)) * f[3] + r(2) * f[7])) +
+               r(0) * ((1 - r(1)) * ((1 - r(2)) * f[1] + r(2) * f[5]) +
+                       r(1) * ((1 - r(2)) * f[2] + r(2) * f[6]));
+    }
+
+private:
+    const UniformTSDFVolume *FindVolumeUnit(
+            const Eigen::Vector3i &index) const {
+        auto unit_itr = volume_.volume_units_.find(index);
+        if (unit_itr == volume_.volume_units_.end()) {
+            return nullptr;
+        }
+        return unit_itr->second.volume_.get();
+    }
+
+private:
+    const ScalableTSDFVolume &volume_;
+    Eigen::Vector3i index_;
+    const UniformTSDFVolume *units_[27];
+};
+
+/// Returns the allocated volume units sorted by index, so that the parallel
+/// extraction produces its output in a deterministic order.
+std::vector<const ScalableTSDFVolume::VolumeUnit *> GetSortedVolumeUnits(
+        const ScalableTSDFVolume &volume) {
+    std::vector<const ScalableTSDFVolume::VolumeUnit *> units;
+    units.reserve(volume.volume_units_.size());
+    for (const auto &unit : volume.volume_units_) {
+        if (unit.second.volume_) {
+            units.push_back(&unit.second);
+        }
+    }
+    std::sort(units.begin(), units.end(),
+              [](const ScalableTSDFVolume::VolumeUnit *a,
+                 const ScalableTSDFVolume::VolumeUnit *b) {
+                  return std::make_tuple(a->index_(0), a->index_(1),
+                                         a->index_(2)) <
+                         std::make_tuple(b->index_(0), b->index_(1),
+                                         b->index_(2));
+              });
+    return units;
+}
+
+void ExtractVolumeUnitPointCloud(const ScalableTSDFVolume &volume,
+                                 const ScalableTSDFVolume::VolumeUnit &unit,
+                                 geometry::PointCloud &pointcloud) {
+    const double voxel_length = volume.voxel_length_;
+    const double half_voxel_length = voxel_length * 0.5;
+    const TSDFVolumeColorType color_type = volume.color_type_;
+    const VolumeUnitNeighbourhood neighbourhood(volume, unit.index_);
+    const auto &volume0 = *unit.volume_;
+    const auto &index0 = unit.index_;
+    float w0, w1, f0, f1;
+    Eigen::Vector3f c0, c1;
+    for (int x = 0; x < volume0.resolution_; x++) {
+        for (int y = 0; y < volume0.resolution_; y++) {
+            for (int z = 0; z < volume0.resolution_; z++) {
+                Eigen::Vector3i idx0(x, y, z);
+                w0 = volume0.GetWeight(volume0.IndexOf(idx0));
+                f0 = volume0.GetTSDF(volume0.IndexOf(idx0));
+                if (color_type != TSDFVolumeColorType::None)
+                    c0 = volume0.GetColor(volume0.IndexOf(idx0));
+                if (w0 == 0.0f || f0 >= 0.98f || f0 < -0.98f) {
+                    continue;
+                }
+                Eigen::Vector3d p0 =
+                        Eigen::Vector3d(half_voxel_length + voxel_length * x,
+                                        half_voxel_length + voxel_length * y,
+                                        half_voxel_length + voxel_length * z) +
+                        index0.cast<double>() * volume.volume_unit_length_;
+                for (int i = 0; i < 3; i++) {
+                    Eigen::Vector3d p1 = p0;
+                    Eigen::Vector3i idx1 = idx0;
+                    p1(i) += voxel_length;
+                    idx1(i) += 1;
+                    const UniformTSDFVolume *volume1 = &volume0;
+                    if (idx1(i) >= volume0.resolution_) {
+                        volume1 = neighbourhood.LocateVoxel(idx1);
+                    }
+                    if (volume1 == nullptr) {
+                        w1 = 0.0f;
+                        f1 = 0.0f;
+                    } else {
+                        w1 = volume1->GetWeight(volume1->IndexOf(idx1));
+                        f1 = volume1->GetTSDF(volume1->IndexOf(idx1));
+                        if (color_type != TSDFVolumeColorType::None)
+                            c1 = volume1->GetColor(volume1->IndexOf(idx1));
+                    }
+                    if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
+                        f0 * f1 < 0) {
+                        float r0 = std::fabs(f0);
+                        float r1 = std::fabs(f1);
+                        Eigen::Vector3d p = p0;
+                        p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
+                        pointcloud.points_.push_back(p);
+                        if (color_type == TSDFVolumeColorType::RGB8) {
+                            pointcloud.colors_.push_back(
+                                    ((c0 * r1 + c1 * r0) / (r0 + r1) / 255.0f)
+                                            .cast<double>());
+                        } else if (color_type == TSDFVolumeColorType::Gray32) {
+                            pointcloud.colors_.push_back(
+                                    ((c0 * r1 + c1 * r0) / (r0 + r1))
+                                            .cast<double>());
+                        }
+                        // has_normal
+                        pointcloud.normals_.push_back(
+                                neighbourhood.GetNormalAt(p));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Runs marching cubes on the voxels of a volume unit. edge_to_vertex is
+/// scratch space of (resolution + 1)^3 * 3 zeros and is left zeroed.
+void ExtractVolumeUnitMesh(const ScalableTSDFVolume &volume,
+                           const ScalableTSDFVolume::VolumeUnit &unit,
+                           std::vector<int> &edge_to_vertex,
+                           VolumeUnitMesh &mesh) {
+    // implementation of marching cubes, based on
+    // http://paulbourke.net/geometry/polygonise/
+    const int resolution = volume.volume_unit_resolution_;
+    const double voxel_length = volume.voxel_length_;
+    const double half_voxel_length = voxel_length * 0.5;
+    const TSDFVolumeColorType color_type = volume.color_type_;
+    const VolumeUnitNeighbourhood neighbourhood(volume, unit.index_);
+    const auto &volume0 = *unit.volume_;
+    const auto &index0 = unit.index_;
+    std::vector<int> touched_edges;
+    int edge_to_index[12];
+    for (int x = 0; x < resolution; x++) {
+        for (int y = 0; y < resolution; y++) {
+            for (int z = 0; z < resolution; z++) {
+                Eigen::Vector3i idx0(x, y, z);
+                int cube_index = 0;
+                float w[8];
+                float f[8];
+                Eigen::Vector3d c[8];
+                for (int i = 0; i < 8; i++) {
+                    Eigen::Vector3i idx1 = idx0 + shift[i];
+                    const UniformTSDFVolume *volume1 = &volume0;
+                    if (idx1(0) >= resolution || idx1(1) >= resolution ||
+                        idx1(2) >= resolution) {
+                        volume1 = neighbourhood.LocateVoxel(idx1);
+                    }
+                    if (volume1 == nullptr) {
+                        w[i] = 0.0f;
+                        f[i] = 0.0f;
+                    } else {
+                        w[i] = volume1->GetWeight(volume1->IndexOf(idx1));
+                        f[i] = volume1->GetTSDF(volume1->IndexOf(idx1));
+                        if (color_type == TSDFVolumeColorType::RGB8)
+                            c[i] = volume1->GetColor(volume1->IndexOf(idx1))
+                                           .cast<double>() /
+                                   255.0;
+                        else if (color_type == TSDFVolumeColorType::Gray32)
+                            c[i] = volume1->GetColor(volume1->IndexOf(idx1))
+                                           .cast<double>();
+                    }
+                    if (w[i] == 0.0f) {
+                        cube_index = 0;
+                        break;
+                    } else {
+                        if (f[i] < 0.0f) {
+                            cube_index |= (1 << i);
+                        }
+                    }
+                }
+                if (cube_index == 0 || cube_index == 255) {
+                    continue;
+                }
+                for (int i = 0; i < 12; i++) {
+                    if (!(edge_table[cube_index] & (1 << i))) {
+                        continue;
+                    }
+                    Eigen::Vector4i edge_local =
+                            Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
+                    int edge_id = ((edge_local(0) * (resolution + 1) +
+                                    edge_local(1)) *
+                                           (resolution + 1) +
+                                   edge_local(2)) *
+                                          3 +
+                                  edge_local(3);
+                    // 0: not created yet, k + 1: owned vertex k,
+                    // -(k + 1): foreign vertex k
+                    int &code = edge_to_vertex[edge_id];
+                    if (code == 0) {
+                        touched_edges.push_back(edge_id);
+                        Eigen::Vector4i edge_index =
+                                Eigen::Vector4i(index0(0), index0(1),
+                                                index0(2), 0) *
+                                        resolution +
+                                edge_local;
+                        Eigen::Vector3d pt(
+                                half_voxel_length +
+                                        voxel_length * edge_index(0),
+                                half_voxel_length +
+                                        voxel_length * edge_index(1),
+                                half_voxel_length +
+                                        voxel_length * edge_index(2));
+                        double f0 = std::abs((double)f[edge_to_vert[i][0]]);
+                        double f1 = std::abs((double)f[edge_to_vert[i][1]]);
+                        pt(edge_index(3)) += f0 * voxel_length / (f0 + f1);
+                        Eigen::Vector3d color;
+                        if (color_type != TSDFVolumeColorType::None) {
+                            const auto &c0 = c[edge_to_vert[i][0]];
+                            const auto &c1 = c[edge_to_vert[i][1]];
+                            color = (f1 * c0 + f0 * c1) / (f0 + f1);
+                        }
+                        if (edge_local(0) < resolution &&
+                            edge_local(1) < resolution &&
+                            edge_local(2) < resolution) {
+                            int vertex = (int)mesh.vertices_.size();
+                            mesh.vertices_.push_back(pt);
+                            if (color_type != TSDFVolumeColorType::None) {
+                                mesh.vertex_colors_.push_back(color);
+                            }
+                            if (edge_local(0) == 0 || edge_local(1) == 0 ||
+                                edge_local(2) == 0) {
+                                mesh.boundary_vertices_.push_back(
+                                        std::make_pair(
+                                                ((edge_local(0) * resolution +
+                                                  edge_local(1)) *
+                                                         resolution +
+                                                 edge_local(2)) *
+                                                                3 +
+                                                        edge_local(3),
+                                                vertex));
+                            }
+                            code = vertex + 1;
+                        } else {
+                            int vertex = (int)mesh.foreign_vertices_.size();
+                            mesh.foreign_edges_.push_back(edge_index);
+                            mesh.foreign_vertices_.push_back(pt);
+                            if (color_type != TSDFVolumeColorType::None) {
+                                mesh.foreign_vertex_colors_.push_back(color);
+                            }
+                            code = -(vertex + 1);
+                        }
+                    }
+                    edge_to_index[i] = code > 0 ? code - 1 : code;
+                }
+                for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
+                    mesh.triangles_.push_back(Eigen::Vector3i(
+                            edge_to_index[tri_table[cube_index][i]],
+                            edge_to_index[tri_table[cube_index][i + 2]],
+                            edge_to_index[tri_table[cube_index][i + 1]]));
+                }
+            }
+        }
+    }
+    std::sort(mesh.boundary_vertices_.begin(), mesh.boundary_vertices_.end());
+    for (int edge_id : touched_edges) {
+        edge_to_vertex[edge_id] = 0;
+    }
+}
+
+/// Concatenates the unit meshes in order and welds every foreign vertex to
+/// the vertex of its owner unit. Foreign vertices whose owner did not
+/// produce them (all owner cubes around the edge were skipped) are welded
+/// among themselves and appended after the owned vertices.
+std::shared_ptr<geometry::TriangleMesh> MergeVolumeUnitMeshes(
+        const ScalableTSDFVolume &volume,
+        const std::vector<const ScalableTSDFVolume::VolumeUnit *> &units,
+        const std::vector<const VolumeUnitMesh *> &unit_meshes) {
+    const int resolution = volume.volume_unit_resolution_;
+    const bool has_color = volume.color_type_ != TSDFVolumeColorType::None;
+    const int num_units = (int)units.size();
+    std::unordered_map<Eigen::Vector3i, int,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            unit_to_position;
+    for (int u = 0; u < num_units; u++) {
+        unit_to_position[units[u]->index_] = u;
+    }
+    std::vector<int> vertex_offsets(num_units + 1, 0);
+    std::vector<int> triangle_offsets(num_units + 1, 0);
+    for (int u = 0; u < num_units; u++) {
+        vertex_offsets[u + 1] =
+                vertex_offsets[u] + (int)unit_meshes[u]->vertices_.size();
+        triangle_offsets[u + 1] =
+                triangle_offsets[u] + (int)unit_meshes[u]->triangles_.size();
+    }
+
+    auto mesh = std::make_shared<geometry::TriangleMesh>();
+    std::vector<std::vector<int>> foreign_to_vertex(num_units);
+    std::unordered_map<
+            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
+            std::equal_to<Eigen::Vector4i>,
+            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
+            edgeindex_to_orphan;
+    for (int u = 0; u < num_units; u++) {
+        const VolumeUnitMesh &unit_mesh = *unit_meshes[u];
+        // Position of the +x, +y, +z neighbours, looked up on first use.
+        int owner_positions[8] = {-2, -2, -2, -2, -2, -2, -2, -2};
+        foreign_to_vertex[u].resize(unit_mesh.foreign_edges_.size());
+        for (size_t k = 0; k < unit_mesh.foreign_edges_.size(); k++) {
+            const Eigen::Vector4i &edge_index = unit_mesh.foreign_edges_[k];
+            Eigen::Vector3i owner_index = units[u]->index_;
+            Eigen::Vector4i edge_local = edge_index;
+            int slot = 0;
+            for (int j = 0; j < 3; j++) {
+                edge_local(j) -= owner_index(j) * resolution;
+                if (edge_local(j) >= resolution) {
+                    edge_local(j) -= resolution;
+                    owner_index(j) += 1;
+                    slot |= (1 << j);
+                }
+            }
+            if (owner_positions[slot] == -2) {
+                auto itr = unit_to_position.find(owner_index);
+                owner_positions[slot] =
+                        itr == unit_to_position.end() ? -1 : itr->second;
+            }
+            int vertex = -1;
+            if (owner_positions[slot] >= 0) {
+                const auto &boundary_vertices =
+                        unit_meshes[owner_positions[slot]]->boundary_vertices_;
+                int edge_id = ((edge_local(0) * resolution + edge_local(1)) *
+                                       resolution +
+                               edge_local(2)) *
+                                      3 +
+                              edge_local(3);
+                auto itr = std::lower_bound(
+                        boundary_vertices.begin(), boundary_vertices.end(),
+                        std::make_pair(edge_id, 0));
+                if (itr != boundary_vertices.end() && itr->first == edge_id) {
+                    vertex = vertex_offsets[owner_positions[slot]] +
+                             itr->second;
+                }
+            }
+            if (vertex < 0) {
+                auto inserted = edgeindex_to_orphan.insert(std::make_pair(
+                        edge_index,
+                        vertex_offsets[num_units] +
+                                (int)edgeindex_to_orphan.size()));
+                vertex = inserted.first->second;
+                if (inserted.second) {
+                    mesh->vertices_.push_back(unit_mesh.foreign_vertices_[k]);
+                    if (has_color) {
+                        mesh->vertex_colors_.push_back(
+                                unit_mesh.foreign_vertex_colors_[k]);
+                    }
+                }
+            }
+            foreign_to_vertex[u][k] = vertex;
+        }
+    }
+
+    // The orphan vertices collected above go after the owned ones.
+    std::vector<Eigen::Vector3d> orphan_vertices, orphan_vertex_colors;
+    orphan_vertices.swap(mesh->vertices_);
+    orphan_vertex_colors.swap(mesh->vertex_colors_);
+    mesh->vertices_.resize(vertex_offsets[num_units]);
+    mesh->vertices_.insert(mesh->vertices_.end(), orphan_vertices.begin(),
+                           orphan_vertices.end());
+    if (has_color) {
+        mesh->vertex_colors_.resize(vertex_offsets[num_units]);
+        mesh->vertex_colors_.insert(mesh->vertex_colors_.end(),
+                                    orphan_vertex_colors.begin(),
+                                    orphan_vertex_colors.end());
+    }
+    mesh->triangles_.resize(triangle_offsets[num_units]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int u = 0; u < num_units; u++) {
+        const VolumeUnitMesh &unit_mesh = *unit_meshes[u];
+        std::copy(unit_mesh.vertices_.begin(), unit_mesh.vertices_.end(),
+                  mesh->vertices_.begin() + vertex_offsets[u]);
+        if (has_color) {
+            std::copy(unit_mesh.vertex_colors_.begin(),
+                      unit_mesh.vertex_colors_.end(),
+                      mesh->vertex_colors_.begin() + vertex_offsets[u]);
+        }
+        for (size_t t = 0; t < unit_mesh.triangles_.size(); t++) {
+            Eigen::Vector3i &triangle =
+                    mesh->triangles_[triangle_offsets[u] + t];
+            for (int j = 0; j < 3; j++) {
+                int vertex = unit_mesh.triangles_[t](j);
+                triangle(j) = vertex >= 0 ? vertex_offsets[u] + vertex
+                                          : foreign_to_vertex[u][-vertex - 1];
+            }
+        }
+    }
+    return mesh;
+}
+
+}  // unnamed namespace
+
 ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
                                        double sdf_trunc,
                                        TSDFVolumeColorType color_type,
                                        int volume_unit_resolution /* = 16*/,
-                                       int depth_sampling_stride /* = 4*/)
+                                       int depth_sampling_stride /* = 4*/,
+                                       TSDFVolumeStorageType storage_type
+                                       /* = TSDFVolumeStorageType::Float32*/)
     : TSDFVolume(voxel_length, sdf_trunc, color_type),
       volume_unit_resolution_(volume_unit_resolution),
       volume_unit_length_(voxel_length * volume_unit_resolution),
-      depth_sampling_stride_(depth_sampling_stride) {}
+      depth_sampling_stride_(depth_sampling_stride),
+      storage_type_(storage_type) {}
 
 ScalableTSDFVolume::~ScalableTSDFVolume() {}
 
@@ -74,15 +595,19 @@ void ScalableTSDFVolume::Integrate(
                 "[ScalableTSDFVolume::Integrate] Unsupported image format.\n");
         return;
     }
-    auto depth2cameradistance =
-            geometry::CreateDepthToCameraDistanceMultiplierFloatImage(
-                    intrinsic);
+    const auto &depth2cameradistance =
+            GetDepthToCameraDistanceMultiplier(intrinsic);
     auto pointcloud = geometry::CreatePointCloudFromDepthImage(
             image.depth_, intrinsic, extrinsic, 1000.0, 1000.0,
             depth_sampling_stride_);
+
+    // Gather the unique volume units touched by the truncation band of the
+    // sampled points and open them in one batch, so that the integration of
+    // the (independent) units can run in parallel afterwards.
     std::unordered_set<Eigen::Vector3i,
                        utility::hash_eigen::hash<Eigen::Vector3i>>
             touched_volume_units_;
+    std::vector<Eigen::Vector3i> touched_volume_unit_indices;
     for (const auto &point : pointcloud->points_) {
         auto min_bound = LocateVolumeUnit(
                 point - Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
@@ -92,255 +617,150 @@ void ScalableTSDFVolume::Integrate(
             for (auto y = min_bound(1); y <= max_bound(1); y++) {
                 for (auto z = min_bound(2); z <= max_bound(2); z++) {
                     auto loc = Eigen::Vector3i(x, y, z);
-                    if (touched_volume_units_.find(loc) ==
-                        touched_volume_units_.end()) {
-                        touched_volume_units_.insert(loc);
-                        auto volume = OpenVolumeUnit(Eigen::Vector3i(x, y, z));
-                        volume->IntegrateWithDepthToCameraDistanceMultiplier(
-                                image, intrinsic, extrinsic,
-                                *depth2cameradistance);
+                    if (touched_volume_units_.insert(loc).second) {
+                        touched_volume_unit_indices.push_back(loc);
                     }
                 }
             }
         }
     }
+    std::vector<UniformTSDFVolume *> touched_volumes(
+            touched_volume_unit_indices.size());
+    for (size_t i = 0; i < touched_volume_unit_indices.size(); i++) {
+        touched_volumes[i] =
+                OpenVolumeUnit(touched_volume_unit_indices[i]).get();
+    }
+
+    // Each unit is too small for the inner parallel loop of
+    // UniformTSDFVolume to pay off, so parallelize across units instead.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < (int)touched_volumes.size(); i++) {
+        touched_volumes[i]->IntegrateWithDepthToCameraDistanceMultiplier(
+                image, intrinsic, extrinsic, depth2cameradistance);
+    }
 }
 
 std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
+    auto units = GetSortedVolumeUnits(*this);
+    std::vector<geometry::PointCloud> unit_pointclouds(units.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int u = 0; u < (int)units.size(); u++) {
+        ExtractVolumeUnitPointCloud(*this, *units[u], unit_pointclouds[u]);
+    }
+
     auto pointcloud = std::make_shared<geometry::PointCloud>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    float w0, w1, f0, f1;
-    Eigen::Vector3f c0, c1;
-    for (const auto &unit : volume_units_) {
-        if (unit.second.volume_) {
-            const auto &volume0 = *unit.second.volume_;
-            const auto &index0 = unit.second.index_;
-            for (int x = 0; x < volume0.resolution_; x++) {
-                for (int y = 0; y < volume0.resolution_; y++) {
-                    for (int z = 0; z < volume0.resolution_; z++) {
-                        Eigen::Vector3i idx0(x, y, z);
-                        w0 = volume0.weight_[volume0.IndexOf(idx0)];
-                        f0 = volume0.tsdf_[volume0.IndexOf(idx0)];
-                        if (color_type_ != TSDFVolumeColorType::None)
-                            c0 = volume0.color_[volume0.IndexOf(idx0)];
-                        if (w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f) {
-                            Eigen::Vector3d p0 =
-                                    Eigen::Vector3d(half_voxel_length +
-                                                            voxel_length_ * x,
-                                                    half_voxel_length +
-                                                            voxel_length_ * y,
-                                                    half_voxel_length +
-                                                            voxel_length_ * z) +
-                                    index0.cast<double>() * volume_unit_length_;
-                            for (int i = 0; i < 3; i++) {
-                                Eigen::Vector3d p1 = p0;
-                                Eigen::Vector3i idx1 = idx0;
-                                Eigen::Vector3i index1 = index0;
-                                p1(i) += voxel_length_;
-                                idx1(i) += 1;
-                                if (idx1(i) < volume0.resolution_) {
-                                    w1 = volume0.weight_[volume0.IndexOf(idx1)];
-                                    f1 = volume0.tsdf_[volume0.IndexOf(idx1)];
-                                    if (color_type_ !=
-                                        TSDFVolumeColorType::None)
-                                        c1 = volume0.color_[volume0.IndexOf(
-                                                idx1)];
-                                } else {
-                                    idx1(i) -= volume0.resolution_;
-                                    index1(i) += 1;
-                                    auto unit_itr = volume_units_.find(index1);
-                                    if (unit_itr == volume_units_.end()) {
-                                        w1 = 0.0f;
-                                        f1 = 0.0f;
-                                    } else {
-                                        const auto &volume1 =
-                                                *unit_itr->second.volume_;
-                                        w1 = volume1.weight_[volume1.IndexOf(
-                                                idx1)];
-                                        f1 = volume1.tsdf_[volume1.IndexOf(
-                                                idx1)];
-                                        if (color_type_ !=
-                                            TSDFVolumeColorType::None)
-                                            c1 = volume1.color_[volume1.IndexOf(
-                                                    idx1)];
-                                    }
-                                }
-                                if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
-                                    f0 * f1 < 0) {
-                                    float r0 = std::fabs(f0);
-                                    float r1 = std::fabs(f1);
-                                    Eigen::Vector3d p = p0;
-                                    p(i) = (p0(i) * r1 + p1(i) * r0) /
-                                           (r0 + r1);
-                                    pointcloud->points_.push_back(p);
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8) {
-                                        pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1) / 255.0f)
-                                                        .cast<double>());
-                                    } else if (color_type_ ==
-                                               TSDFVolumeColorType::Gray32) {
-                                        pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1))
-                                                        .cast<double>());
-                                    }
-                                    // has_normal
-                                    pointcloud->normals_.push_back(
-                                            GetNormalAt(p));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    for (const auto &unit_pointcloud : unit_pointclouds) {
+        pointcloud->points_.insert(pointcloud->points_.end(),
+                                   unit_pointcloud.points_.begin(),
+                                   unit_pointcloud.points_.end());
+        pointcloud->normals_.insert(pointcloud->normals_.end(),
+                                    unit_pointcloud.normals_.begin(),
+                                    unit_pointcloud.normals_.end());
+        pointcloud->colors_.insert(pointcloud->colors_.end(),
+                                   unit_pointcloud.colors_.begin(),
+                                   unit_pointcloud.colors_.end());
     }
     return pointcloud;
 }
 
 std::shared_ptr<geometry::TriangleMesh>
 ScalableTSDFVolume::ExtractTriangleMesh() {
-    // implementation of marching cubes, based on
-    // http://paulbourke.net/geometry/polygonise/
-    auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
-    for (const auto &unit : volume_units_) {
-        if (unit.second.volume_) {
-            const auto &volume0 = *unit.second.volume_;
-            const auto &index0 = unit.second.index_;
-            for (int x = 0; x < volume0.resolution_; x++) {
-                for (int y = 0; y < volume0.resolution_; y++) {
-                    for (int z = 0; z < volume0.resolution_; z++) {
-                        Eigen::Vector3i idx0(x, y, z);
-                        int cube_index = 0;
-                        float w[8];
-                        float f[8];
-                        Eigen::Vector3d c[8];
-                        for (int i = 0; i < 8; i++) {
-                            Eigen::Vector3i index1 = index0;
-                            Eigen::Vector3i idx1 = idx0 + shift[i];
-                            if (idx1(0) < volume_unit_resolution_ &&
-                                idx1(1) < volume_unit_resolution_ &&
-                                idx1(2) < volume_unit_resolution_) {
-                                w[i] = volume0.weight_[volume0.IndexOf(idx1)];
-                                f[i] = volume0.tsdf_[volume0.IndexOf(idx1)];
-                                if (color_type_ == TSDFVolumeColorType::RGB8)
-                                    c[i] = volume0.color_[volume0.IndexOf(idx1)]
-                                                   .cast<double>() /
-                                           255.0;
-                                else if (color_type_ ==
-                                         TSDFVolumeColorType::Gray32)
-                                    c[i] = volume0.color_[volume0.IndexOf(idx1)]
-                                                   .cast<double>();
-                            } else {
-                                for (int j = 0; j < 3; j++) {
-                                    if (idx1(j) >= volume_unit_resolution_) {
-                                        idx1(j) -= volume_unit_resolution_;
-                                        index1(j) += 1;
-                                    }
-                                }
-                                auto unit_itr1 = volume_units_.find(index1);
-                                if (unit_itr1 == volume_units_.end()) {
-                                    w[i] = 0.0f;
-                                    f[i] = 0.0f;
-                                } else {
-                                    const auto &volume1 =
-                                            *unit_itr1->second.volume_;
-                                    w[i] = volume1.weight_[volume1.IndexOf(
-                                            idx1)];
-                                    f[i] = volume1.tsdf_[volume1.IndexOf(idx1)];
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8)
-                                        c[i] = volume1.color_[volume1.IndexOf(
-                                                                      idx1)]
-                                                       .cast<double>() /
-                                               255.0;
-                                    else if (color_type_ ==
-                                             TSDFVolumeColorType::Gray32)
-                                        c[i] = volume1.color_[volume1.IndexOf(
-                                                                      idx1)]
-                                                       .cast<double>();
-                                }
-                            }
-                            if (w[i] == 0.0f) {
-                                cube_index = 0;
-                                break;
-                            } else {
-                                if (f[i] < 0.0f) {
-                                    cube_index |= (1 << i);
-                                }
-                            }
-                        }
-                        if (cube_index == 0 || cube_index == 255) {
-                            continue;
-                        }
-                        for (int i = 0; i < 12; i++) {
-                            if (edge_table[cube_index] & (1 << i)) {
-                                Eigen::Vector4i edge_index =
-                                        Eigen::Vector4i(index0(0), index0(1),
-                                                        index0(2), 0) *
-                                                volume_unit_resolution_ +
-                                        Eigen::Vector4i(x, y, z, 0) +
-                                        edge_shift[i];
-                                if (edgeindex_to_vertexindex.find(edge_index) ==
-                                    edgeindex_to_vertexindex.end()) {
-                                    edge_to_index[i] =
-                                            (int)mesh->vertices_.size();
-                                    edgeindex_to_vertexindex[edge_index] =
-                                            (int)mesh->vertices_.size();
-                                    Eigen::Vector3d pt(
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(0),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(1),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(2));
-                                    double f0 = std::abs(
-                                            (double)f[edge_to_vert[i][0]]);
-                                    double f1 = std::abs(
-                                            (double)f[edge_to_vert[i][1]]);
-                                    pt(edge_index(3)) +=
-                                            f0 * voxel_length_ / (f0 + f1);
-                                    mesh->vertices_.push_back(pt);
-                                    if (color_type_ !=
-                                        TSDFVolumeColorType::None) {
-                                        const auto &c0 = c[edge_to_vert[i][0]];
-                                        const auto &c1 = c[edge_to_vert[i][1]];
-                                        mesh->vertex_colors_.push_back(
-                                                (f1 * c0 + f0 * c1) /
-                                                (f0 + f1));
-                                    }
-                                } else {
-                                    edge_to_index[i] = edgeindex_to_vertexindex
-                                            [edge_index];
-                                }
-                            }
-                        }
-                        for (int i = 0; tri_table[cube_index][i] != -1;
-                             i += 3) {
-                            mesh->triangles_.push_back(Eigen::Vector3i(
-                                    edge_to_index[tri_table[cube_index][i]],
-                                    edge_to_index[tri_table[cube_index][i + 2]],
-                                    edge_to_index[tri_table[cube_index]
-                                                           [i + 1]]));
-                        }
-                    }
-                }
+    // Every unit is meshed independently, including the cubes reaching into
+    // its neighbours; shared vertices are welded in the final merge.
+    auto units = GetSortedVolumeUnits(*this);
+    std::vector<VolumeUnitMesh> unit_meshes(units.size());
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::vector<int> edge_to_vertex((volume_unit_resolution_ + 1) *
+                                                (volume_unit_resolution_ + 1) *
+                                                (volume_unit_resolution_ + 1) *
+                                                3,
+                                        0);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int u = 0; u < (int)units.size(); u++) {
+            ExtractVolumeUnitMesh(*this, *units[u], edge_to_vertex,
+                                  unit_meshes[u]);
+        }
+#ifdef _OPENMP
+    }
+#endif
+
+    std::vector<const VolumeUnitMesh *> unit_mesh_ptrs(units.size());
+    for (size_t u = 0; u < units.size(); u++) {
+        unit_mesh_ptrs[u] = &unit_meshes[u];
+    }
+    return MergeVolumeUnitMeshes(*this, units, unit_mesh_ptrs);
+}
+
+std::shared_ptr<geometry::TriangleMesh>
+ScalableTSDFVolume::ExtractTriangleMeshIncremental() {
+    // The mesh of a unit depends on its own voxels and on those of its +x,
+    // +y, +z neighbours, so a dirty unit invalidates the cached meshes of
+    // itself and of its -x, -y, -z neighbours.
+    std::unordered_set<Eigen::Vector3i,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            remesh_units;
+    for (auto &unit : volume_units_) {
+        if (!unit.second.volume_) {
+            continue;
+        }
+        if (!unit.second.mesh_) {
+            remesh_units.insert(unit.first);
+        }
+        if (!unit.second.is_dirty_) {
+            continue;
+        }
+        for (int i = 0; i < 8; i++) {
+            Eigen::Vector3i index = unit.first - shift[i];
+            auto unit_itr = volume_units_.find(index);
+            if (unit_itr != volume_units_.end() && unit_itr->second.volume_) {
+                remesh_units.insert(index);
             }
         }
+        unit.second.is_dirty_ = false;
     }
-    return mesh;
+    std::vector<VolumeUnit *> remesh_unit_ptrs;
+    remesh_unit_ptrs.reserve(remesh_units.size());
+    for (const auto &index : remesh_units) {
+        remesh_unit_ptrs.push_back(&volume_units_[index]);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::vector<int> edge_to_vertex((volume_unit_resolution_ + 1) *
+                                                (volume_unit_resolution_ + 1) *
+                                                (volume_unit_resolution_ + 1) *
+                                                3,
+                                        0);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int u = 0; u < (int)remesh_unit_ptrs.size(); u++) {
+            auto unit_mesh = std::make_shared<VolumeUnitMesh>();
+            ExtractVolumeUnitMesh(*this, *remesh_unit_ptrs[u], edge_to_vertex,
+                                  *unit_mesh);
+            remesh_unit_ptrs[u]->mesh_ = unit_mesh;
+        }
+#ifdef _OPENMP
+    }
+#endif
+
+    auto units = GetSortedVolumeUnits(*this);
+    std::vector<const VolumeUnitMesh *> unit_mesh_ptrs(units.size());
+    for (size_t u = 0; u < units.size(); u++) {
+        unit_mesh_ptrs[u] = units[u]->mesh_.get();
+    }
+    return MergeVolumeUnitMeshes(*this, units, unit_mesh_ptrs);
 }
 
 std::shared_ptr<geometry::PointCloud>
@@ -355,80 +775,34 @@ ScalableTSDFVolume::ExtractVoxelPointCloud() {
     return voxel;
 }
 
+const geometry::Image &ScalableTSDFVolume::GetDepthToCameraDistanceMultiplier(
+        const camera::PinholeCameraIntrinsic &intrinsic) {
+    if (!depth_to_camera_distance_multiplier_ ||
+        cached_intrinsic_.width_ != intrinsic.width_ ||
+        cached_intrinsic_.height_ != intrinsic.height_ ||
+        cached_intrinsic_.intrinsic_matrix_ != intrinsic.intrinsic_matrix_) {
+        depth_to_camera_distance_multiplier_ =
+                geometry::CreateDepthToCameraDistanceMultiplierFloatImage(
+                        intrinsic);
+        cached_intrinsic_ = intrinsic;
+    }
+    return *depth_to_camera_distance_multiplier_;
+}
+
 std::shared_ptr<UniformTSDFVolume> ScalableTSDFVolume::OpenVolumeUnit(
         const Eigen::Vector3i &index) {
     auto &unit = volume_units_[index];
     if (!unit.volume_) {
         unit.volume_.reset(new UniformTSDFVolume(
                 volume_unit_length_, volume_unit_resolution_, sdf_trunc_,
-                color_type_, index.cast<double>() * volume_unit_length_));
+                color_type_, index.cast<double>() * volume_unit_length_,
+                storage_type_));
         unit.index_ = index;
     }
+    // The unit is opened to be integrated, so its cached mesh is outdated.
+    unit.is_dirty_ = true;
     return unit.volume_;
 }
 
-Eigen::Vector3d ScalableTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
-    Eigen::Vector3d n;
-    const double half_gap = 0.99 * voxel_length_;
-    for (int i = 0; i < 3; i++) {
-        Eigen::Vector3d p0 = p;
-        p0(i) -= half_gap;
-        Eigen::Vector3d p1 = p;
-        p1(i) += half_gap;
-        n(i) = GetTSDFAt(p1) - GetTSDFAt(p0);
-    }
-    return n.normalized();
-}
-
-double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
-    Eigen::Vector3d p_locate =
-            p - Eigen::Vector3d(0.5, 0.5, 0.5) * voxel_length_;
-    Eigen::Vector3i index0 = LocateVolumeUnit(p_locate);
-    auto unit_itr = volume_units_.find(index0);
-    if (unit_itr == volume_units_.end()) {
-        return 0.0;
-    }
-    const auto &volume0 = *unit_itr->second.volume_;
-    Eigen::Vector3i idx0;
-    Eigen::Vector3d p_grid =
-            (p_locate - index0.cast<double>() * volume_unit_length_) /
-            voxel_length_;
-    for (int i = 0; i < 3; i++) {
-        idx0(i) = (int)std::floor(p_grid(i));
-        if (idx0(i) < 0) idx0(i) = 0;
-        if (idx0(i) >= volume_unit_resolution_)
-            idx0(i) = volume_unit_resolution_ - 1;
-    }
-    Eigen::Vector3d r = p_grid - idx0.cast<double>();
-    float f[8];
-    for (int i = 0; i < 8; i++) {
-        Eigen::Vector3i index1 = index0;
-        Eigen::Vector3i idx1 = idx0 + shift[i];
-        if (idx1(0) < volume_unit_resolution_ &&
-            idx1(1) < volume_unit_resolution_ &&
-            idx1(2) < volume_unit_resolution_) {
-            f[i] = volume0.tsdf_[volume0.IndexOf(idx1)];
-        } else {
-            for (int j = 0; j < 3; j++) {
-                if (idx1(j) >= volume_unit_resolution_) {
-                    idx1(j) -= volume_unit_resolution_;
-                    index1(j) += 1;
-                }
-            }
-            auto unit_itr1 = volume_units_.find(index1);
-            if (unit_itr1 == volume_units_.end()) {
-                f[i] = 0.0f;
-            } else {
-                const auto &volume1 = *unit_itr1->second.volume_;
-                f[i] = volume1.tsdf_[volume1.IndexOf(idx1)];
-            }
-        }
-    }
-    return (1 - r(0)) * ((1 - r(1)) * ((1 - r(2)) * f[0] + r(2) * f[4]) +
-                         r(1) * ((1 - r(2)) * f[3] + r(2) * f[7])) +
-           r(0) * ((1 - r(1)) * ((1 - r(2)) * f[1] + r(2) * f[5]) +
-                   r(1) * ((1 - r(2)) * f[2] + r(2) * f[6]));
-}
-
 }  // namespace integration
 }  // namespace open3d
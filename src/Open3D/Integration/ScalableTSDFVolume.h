@@ -57,13 +57,21 @@ class UniformTSDFVolume;
 
 class ScalableTSDFVolume : public TSDFVolume {
 public:
+    /// Marching cubes output of a single volume unit
+    struct VolumeUnitMesh;
+
     struct VolumeUnit {
     public:
-        VolumeUnit() : volume_(NULL) {}
+        VolumeUnit() : volume_(NULL), is_dirty_(true) {}
 
     public:
         std::shared_ptr<UniformTSDFVolume> volume_;
         Eigen::Vector3i index_;
+        /// Set when the unit is integrated, cleared when its mesh is cached
+        bool is_dirty_;
+        /// Cached mesh of the unit, maintained by
+        /// ExtractTriangleMeshIncremental
+        std::shared_ptr<VolumeUnitMesh> mesh_;
     };
 
 public:
@@ -71,7 +79,9 @@ public:
                        double sdf_trunc,
                        TSDFVolumeColorType color_type,
                        int volume_unit_resolution = 16,
-                       int depth_sampling_stride = 4);
+                       int depth_sampling_stride = 4,
+                       TSDFVolumeStorageType storage_type =
+                               TSDFVolumeStorageType::Float32);
     ~ScalableTSDFVolume() override;
 
 public:
@@ -83,10 +93,18 @@ public:
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud();
 
+    /// Function to extract the same triangle mesh as ExtractTriangleMesh,
+    /// re-running marching cubes only on the volume units integrated since the
+    /// previous call and on their neighbours. The meshes of the other units are
+    /// reused from a per-unit cache.
+    std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMeshIncremental();
+
 public:
     int volume_unit_resolution_;
     double volume_unit_length_;
     int depth_sampling_stride_;
+    /// Voxel storage of the volume units
+    TSDFVolumeStorageType storage_type_;
 
     /// Assume the index of the volume unit is (x, y, z), then the unit spans
     /// from (x, y, z) * volume_unit_length_
@@ -96,6 +114,10 @@ public:
                        utility::hash_eigen::hash<Eigen::Vector3i>>
             volume_units_;
 
+private:
+    camera::PinholeCameraIntrinsic cached_intrinsic_;
+    std::shared_ptr<geometry::Image> depth_to_camera_distance_multiplier_;
+
 private:
     Eigen::Vector3i LocateVolumeUnit(const Eigen::Vector3d &point) {
         return Eigen::Vector3i((int)std::floor(point(0) / volume_unit_length_),
@@ -106,9 +128,10 @@ private:
     std::shared_ptr<UniformTSDFVolume> OpenVolumeUnit(
             const Eigen::Vector3i &index);
 
-    Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
-
-    double GetTSDFAt(const Eigen::Vector3d &p);
+    /// Returns the depth to camera distance multiplier image of the
+    /// intrinsic, recomputing it only when the intrinsic changes.
+    const geometry::Image &GetDepthToCameraDistanceMultiplier(
+            const camera::PinholeCameraIntrinsic &intrinsic);
 };
 
 }  // namespace integration
@@ -40,6 +40,17 @@ enum class TSDFVolumeColorType {
     Gray32 = 2,
 };
 
+/// Voxel storage of a UniformTSDFVolume. Float32 keeps float TSDF, weight and
+/// color (20 bytes per voxel with color). Compact keeps the TSDF quantized to
+/// int16 over [-1, 1], a saturating uint16 weight and uint8 color (7 bytes
+/// per voxel with color). Its running averages are rounded with a dither and
+/// weigh the past by at most 255 observations for the TSDF and 16 for the
+/// color, so that it keeps following slow changes.
+enum class TSDFVolumeStorageType {
+    Float32 = 0,
+    Compact = 1,
+};
+
 /// Interface class of the Truncated Signed Distance Function (TSDF) volume
 /// This volume is usually used to integrate surface data (e.g., a series of
 /// RGB-D images) into a Mesh or PointCloud. The basic technique is presented in
@@ -26,6 +26,10 @@
 
 #include "Open3D/Integration/UniformTSDFVolume.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <thread>
 #include <unordered_map>
 
@@ -40,25 +44,36 @@ UniformTSDFVolume::UniformTSDFVolume(
         int resolution,
         double sdf_trunc,
         TSDFVolumeColorType color_type,
-        const Eigen::Vector3d &origin /* = Eigen::Vector3d::Zero()*/)
+        const Eigen::Vector3d &origin /* = Eigen::Vector3d::Zero()*/,
+        TSDFVolumeStorageType storage_type
+        /* = TSDFVolumeStorageType::Float32*/)
     : TSDFVolume(length / (double)resolution, sdf_trunc, color_type),
       origin_(origin),
       length_(length),
       resolution_(resolution),
       voxel_num_(resolution * resolution * resolution),
-      tsdf_(voxel_num_, 0.0f),
-      color_(color_type != TSDFVolumeColorType::None ? voxel_num_ : 0,
-             Eigen::Vector3f::Zero()),
-      weight_(voxel_num_, 0.0f) {}
+      storage_type_(storage_type) {
+    bool has_color = color_type != TSDFVolumeColorType::None;
+    if (storage_type_ == TSDFVolumeStorageType::Compact) {
+        tsdf_compact_.resize(voxel_num_, 0);
+        color_compact_.resize(has_color ? voxel_num_ * 3 : 0, 0);
+        weight_compact_.resize(voxel_num_, 0);
+    } else {
+        tsdf_.resize(voxel_num_, 0.0f);
+        color_.resize(has_color ? voxel_num_ : 0, Eigen::Vector3f::Zero());
+        weight_.resize(voxel_num_, 0.0f);
+    }
+}
 
 UniformTSDFVolume::~UniformTSDFVolume() {}
 
 void UniformTSDFVolume::Reset() {
-    std::memset(tsdf_.data(), 0, voxel_num_ * 4);
-    std::memset(weight_.data(), 0, voxel_num_ * 4);
-    if (color_type_ != TSDFVolumeColorType::None) {
-        std::memset(color_.data(), 0, voxel_num_ * 12);
-    }
+    std::fill(tsdf_.begin(), tsdf_.end(), 0.0f);
+    std::fill(weight_.begin(), weight_.end(), 0.0f);
+    std::fill(color_.begin(), color_.end(), Eigen::Vector3f::Zero());
+    std::fill(tsdf_compact_.begin(), tsdf_compact_.end(), 0);
+    std::fill(weight_compact_.begin(), weight_compact_.end(), 0);
+    std::fill(color_compact_.begin(), color_compact_.end(), 0);
 }
 
 void UniformTSDFVolume::Integrate(
@@ -102,8 +117,8 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
         for (int y = 1; y < resolution_ - 1; y++) {
             for (int z = 1; z < resolution_ - 1; z++) {
                 Eigen::Vector3i idx0(x, y, z);
-                float w0 = weight_[IndexOf(idx0)];
-                float f0 = tsdf_[IndexOf(idx0)];
+                float w0 = GetWeight(IndexOf(idx0));
+                float f0 = GetTSDF(IndexOf(idx0));
                 if (w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f) {
                     Eigen::Vector3d p0(half_voxel_length + voxel_length_ * x,
                                        half_voxel_length + voxel_length_ * y,
@@ -114,8 +129,8 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                         Eigen::Vector3i idx1 = idx0;
                         idx1(i) += 1;
                         if (idx1(i) < resolution_ - 1) {
-                            float w1 = weight_[IndexOf(idx1)];
-                            float f1 = tsdf_[IndexOf(idx1)];
+                            float w1 = GetWeight(IndexOf(idx1));
+                            float f1 = GetTSDF(IndexOf(idx1));
                             if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
                                 f0 * f1 < 0) {
                                 float r0 = std::fabs(f0);
@@ -125,15 +140,15 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                                 pointcloud->points_.push_back(p + origin_);
                                 if (color_type_ == TSDFVolumeColorType::RGB8) {
                                     pointcloud->colors_.push_back(
-                                            ((color_[IndexOf(idx0)] * r1 +
-                                              color_[IndexOf(idx1)] * r0) /
+                                            ((GetColor(IndexOf(idx0)) * r1 +
+                                              GetColor(IndexOf(idx1)) * r0) /
                                              (r0 + r1) / 255.0f)
                                                     .cast<double>());
                                 } else if (color_type_ ==
                                            TSDFVolumeColorType::Gray32) {
                                     pointcloud->colors_.push_back(
-                                            ((color_[IndexOf(idx0)] * r1 +
-                                              color_[IndexOf(idx1)] * r0) /
+                                            ((GetColor(IndexOf(idx0)) * r1 +
+                                              GetColor(IndexOf(idx1)) * r0) /
                                              (r0 + r1))
                                                     .cast<double>());
                                 }
@@ -169,18 +184,19 @@ UniformTSDFVolume::ExtractTriangleMesh() {
                 Eigen::Vector3d c[8];
                 for (int i = 0; i < 8; i++) {
                     Eigen::Vector3i idx = Eigen::Vector3i(x, y, z) + shift[i];
-                    if (weight_[IndexOf(idx)] == 0.0f) {
+                    if (GetWeight(IndexOf(idx)) == 0.0f) {
                         cube_index = 0;
                         break;
                     } else {
-                        f[i] = tsdf_[IndexOf(idx)];
+                        f[i] = GetTSDF(IndexOf(idx));
                         if (f[i] < 0.0f) {
                             cube_index |= (1 << i);
                         }
                         if (color_type_ == TSDFVolumeColorType::RGB8) {
-                            c[i] = color_[IndexOf(idx)].cast<double>() / 255.0;
+                            c[i] = GetColor(IndexOf(idx)).cast<double>() /
+                                   255.0;
                         } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                            c[i] = color_[IndexOf(idx)].cast<double>();
+                            c[i] = GetColor(IndexOf(idx)).cast<double>();
                         }
                     }
                 }
@@ -236,19 +252,17 @@ std::shared_ptr<geometry::PointCloud>
 UniformTSDFVolume::ExtractVoxelPointCloud() {
     auto voxel = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
-    float *p_tsdf = (float *)tsdf_.data();
-    float *p_weight = (float *)weight_.data();
-    float *p_color = (float *)color_.data();
+    int i = 0;
     for (int x = 0; x < resolution_; x++) {
         for (int y = 0; y < resolution_; y++) {
             Eigen::Vector3d pt(half_voxel_length + voxel_length_ * x,
                                half_voxel_length + voxel_length_ * y,
                                half_voxel_length);
-            for (int z = 0; z < resolution_; z++, pt(2) += voxel_length_,
-                     p_tsdf++, p_weight++, p_color += 3) {
-                if (*p_weight != 0.0f && *p_tsdf < 0.98f && *p_tsdf >= -0.98f) {
+            for (int z = 0; z < resolution_; z++, pt(2) += voxel_length_, i++) {
+                float tsdf = GetTSDF(i);
+                if (GetWeight(i) != 0.0f && tsdf < 0.98f && tsdf >= -0.98f) {
                     voxel->points_.push_back(pt + origin_);
-                    double c = (static_cast<double>(*p_tsdf) + 1.0) * 0.5;
+                    double c = (static_cast<double>(tsdf) + 1.0) * 0.5;
                     voxel->colors_.push_back(Eigen::Vector3d(c, c, c));
                 }
             }
@@ -281,9 +295,6 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
     for (int x = 0; x < resolution_; x++) {
         for (int y = 0; y < resolution_; y++) {
             int idx_shift = x * resolution_ * resolution_ + y * resolution_;
-            float *p_tsdf = (float *)tsdf_.data() + idx_shift;
-            float *p_weight = (float *)weight_.data() + idx_shift;
-            float *p_color = (float *)color_.data() + idx_shift * 3;
             Eigen::Vector4f voxel_pt_camera =
                     extrinsic_f *
                     Eigen::Vector4f(half_voxel_length_f + voxel_length_f * x +
@@ -295,8 +306,7 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
             for (int z = 0; z < resolution_; z++,
                      voxel_pt_camera(0) += extrinsic_scaled_f(0, 2),
                      voxel_pt_camera(1) += extrinsic_scaled_f(1, 2),
-                     voxel_pt_camera(2) += extrinsic_scaled_f(2, 2), p_tsdf++,
-                     p_weight++, p_color += 3) {
+                     voxel_pt_camera(2) += extrinsic_scaled_f(2, 2)) {
                 if (voxel_pt_camera(2) > 0) {
                     float u_f = voxel_pt_camera(0) * fx / voxel_pt_camera(2) +
                                 cx + 0.5f;
@@ -318,39 +328,29 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
                                 // integrate
                                 float tsdf =
                                         std::min(1.0f, sdf * sdf_trunc_inv_f);
-                                *p_tsdf = ((*p_tsdf) * (*p_weight) + tsdf) /
-                                          (*p_weight + 1.0f);
+                                float color[3] = {0.0f, 0.0f, 0.0f};
                                 if (color_type_ == TSDFVolumeColorType::RGB8) {
                                     const uint8_t *rgb =
                                             geometry::PointerAt<uint8_t>(
                                                     image.color_, u, v, 0);
-                                    p_color[0] = (p_color[0] * (*p_weight) +
-                                                  rgb[0]) /
-                                                 (*p_weight + 1.0f);
-                                    p_color[1] = (p_color[1] * (*p_weight) +
-                                                  rgb[1]) /
-                                                 (*p_weight + 1.0f);
-                                    p_color[2] = (p_color[2] * (*p_weight) +
-                                                  rgb[2]) /
-                                                 (*p_weight + 1.0f);
+                                    color[0] = rgb[0];
+                                    color[1] = rgb[1];
+                                    color[2] = rgb[2];
                                 } else if (color_type_ ==
                                            TSDFVolumeColorType::Gray32) {
                                     const float *intensity =
                                             geometry::PointerAt<float>(
                                                     image.color_, u, v, 0);
-                                    // PrintError("intensity : %f\n",
-                                    // *intensity);
-                                    p_color[0] = (p_color[0] * (*p_weight) +
-                                                  *intensity) /
-                                                 (*p_weight + 1.0f);
-                                    p_color[1] = (p_color[1] * (*p_weight) +
-                                                  *intensity) /
-                                                 (*p_weight + 1.0f);
-                                    p_color[2] = (p_color[2] * (*p_weight) +
-                                                  *intensity) /
-                                                 (*p_weight + 1.0f);
+                                    color[0] = color[1] = color[2] =
+                                            *intensity;
+                                }
+                                if (storage_type_ ==
+                                    TSDFVolumeStorageType::Compact) {
+                                    IntegrateCompactVoxel(idx_shift + z, tsdf,
+                                                          color);
+                                } else {
+                                    IntegrateVoxel(idx_shift + z, tsdf, color);
                                 }
-                                *p_weight += 1.0f;
                             }
                         }
                     }
@@ -360,6 +360,66 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
     }
 }
 
+void UniformTSDFVolume::IntegrateVoxel(int i, float tsdf, const float *color) {
+    float &weight = weight_[i];
+    tsdf_[i] = (tsdf_[i] * weight + tsdf) / (weight + 1.0f);
+    if (color_type_ != TSDFVolumeColorType::None) {
+        float *p_color = color_[i].data();
+        for (int c = 0; c < 3; c++) {
+            p_color[c] = (p_color[c] * weight + color[c]) / (weight + 1.0f);
+        }
+    }
+    weight += 1.0f;
+}
+
+void UniformTSDFVolume::IntegrateCompactVoxel(int i,
+                                              float tsdf,
+                                              const float *color) {
+    // The running average is computed in float and rounded back. Rounding to
+    // nearest would drop every update smaller than half a quantization step,
+    // which freezes the average once the weight grows, so the rounding is
+    // dithered to be unbiased. The dither is a hash of the voxel, its weight
+    // and the observation, which keeps the integration deterministic and
+    // still varies once the weight saturates. The averaging weight
+    // is capped as well so that the rounding noise stays bounded, past the
+    // cap the average becomes an exponential moving average.
+    const float max_tsdf_weight = 255.0f;
+    const float max_color_weight = 16.0f;
+    const int dither_levels = 1 << 24;
+    const float dither_scale = 1.0f / (float)dither_levels;
+    uint16_t &weight_compact = weight_compact_[i];
+    uint32_t tsdf_bits;
+    std::memcpy(&tsdf_bits, &tsdf, sizeof(tsdf_bits));
+    utility::RandomStream dither(
+            (uint64_t)i, ((uint64_t)tsdf_bits << 16) | weight_compact);
+    float weight = std::min((float)weight_compact, max_tsdf_weight);
+    float tsdf_old = (float)tsdf_compact_[i] * (1.0f / 32767.0f);
+    float tsdf_new = (tsdf_old * weight + tsdf) / (weight + 1.0f);
+    tsdf_new = std::max(-1.0f, std::min(1.0f, tsdf_new)) * 32767.0f;
+    tsdf_compact_[i] = (int16_t)std::max(
+            -32767.0f,
+            std::min(32767.0f,
+                     std::floor(tsdf_new +
+                                dither(dither_levels) * dither_scale)));
+    if (color_type_ != TSDFVolumeColorType::None) {
+        float scale =
+                color_type_ == TSDFVolumeColorType::Gray32 ? 255.0f : 1.0f;
+        weight = std::min((float)weight_compact, max_color_weight);
+        uint8_t *p_color = color_compact_.data() + i * 3;
+        for (int c = 0; c < 3; c++) {
+            float color_new =
+                    ((float)p_color[c] * weight + color[c] * scale) /
+                    (weight + 1.0f);
+            color_new = std::floor(color_new +
+                                   dither(dither_levels) * dither_scale);
+            p_color[c] = (uint8_t)std::max(0.0f, std::min(255.0f, color_new));
+        }
+    }
+    if (weight_compact < std::numeric_limits<uint16_t>::max()) {
+        weight_compact++;
+    }
+}
+
 Eigen::Vector3d UniformTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
     Eigen::Vector3d n;
     const double half_gap = 0.99 * voxel_length_;
@@ -383,18 +443,18 @@ double UniformTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
     // clang-format off
     return (1 - r(0)) * (
             (1 - r(1)) * (
-            (1 - r(2)) * tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 0))] +
-            r(2) * tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 1))]
+            (1 - r(2)) * GetTSDF(IndexOf(idx + Eigen::Vector3i(0, 0, 0))) +
+            r(2) * GetTSDF(IndexOf(idx + Eigen::Vector3i(0, 0, 1)))
             ) + r(1) * (
-            (1 - r(2)) * tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 0))] +
-            r(2) * tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 1))]
+            (1 - r(2)) * GetTSDF(IndexOf(idx + Eigen::Vector3i(0, 1, 0))) +
+            r(2) * GetTSDF(IndexOf(idx + Eigen::Vector3i(0, 1, 1)))
             )) + r(0) * (
             (1 - r(1)) * (
-            (1 - r(2)) * tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 0))] +
-            r(2) * tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 1))]
+            (1 - r(2)) * GetTSDF(IndexOf(idx + Eigen::Vector3i(1, 0, 0))) +
+            r(2) * GetTSDF(IndexOf(idx + Eigen::Vector3i(1, 0, 1)))
             ) + r(1) * (
-            (1 - r(2)) * tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 0))] +
-            r(2) * tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 1))]
+            (1 - r(2)) * GetTSDF(IndexOf(idx + Eigen::Vector3i(1, 1, 0))) +
+            r(2) * GetTSDF(IndexOf(idx + Eigen::Vector3i(1, 1, 1)))
             ));
     // clang-format on
 }
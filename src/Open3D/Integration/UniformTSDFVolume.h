@@ -37,7 +37,9 @@ public:
                       int resolution,
                       double sdf_trunc,
                       TSDFVolumeColorType color_type,
-                      const Eigen::Vector3d &origin = Eigen::Vector3d::Zero());
+                      const Eigen::Vector3d &origin = Eigen::Vector3d::Zero(),
+                      TSDFVolumeStorageType storage_type =
+                              TSDFVolumeStorageType::Float32);
     ~UniformTSDFVolume() override;
 
 public:
@@ -67,16 +69,55 @@ public:
         return IndexOf(xyz(0), xyz(1), xyz(2));
     }
 
+    /// Functions to read a voxel regardless of the storage type. The color is
+    /// in [0, 255] for TSDFVolumeColorType::RGB8 and the intensity for
+    /// TSDFVolumeColorType::Gray32.
+    inline float GetTSDF(int i) const {
+        return storage_type_ == TSDFVolumeStorageType::Compact
+                       ? (float)tsdf_compact_[i] * (1.0f / 32767.0f)
+                       : tsdf_[i];
+    }
+
+    inline float GetWeight(int i) const {
+        return storage_type_ == TSDFVolumeStorageType::Compact
+                       ? (float)weight_compact_[i]
+                       : weight_[i];
+    }
+
+    inline Eigen::Vector3f GetColor(int i) const {
+        if (storage_type_ == TSDFVolumeStorageType::Compact) {
+            Eigen::Vector3f color(color_compact_[i * 3],
+                                  color_compact_[i * 3 + 1],
+                                  color_compact_[i * 3 + 2]);
+            return color_type_ == TSDFVolumeColorType::Gray32
+                           ? Eigen::Vector3f(color / 255.0f)
+                           : color;
+        }
+        return color_[i];
+    }
+
 public:
     Eigen::Vector3d origin_;
     double length_;
     int resolution_;
     int voxel_num_;
+    TSDFVolumeStorageType storage_type_;
+    /// Voxel data of TSDFVolumeStorageType::Float32, empty otherwise
     std::vector<float> tsdf_;
     std::vector<Eigen::Vector3f> color_;
     std::vector<float> weight_;
+    /// Voxel data of TSDFVolumeStorageType::Compact, empty otherwise. The
+    /// color holds 3 channels per voxel, the intensity of
+    /// TSDFVolumeColorType::Gray32 being scaled to [0, 255].
+    std::vector<int16_t> tsdf_compact_;
+    std::vector<uint8_t> color_compact_;
+    std::vector<uint16_t> weight_compact_;
 
 private:
+    /// Folds one observation into the running average of voxel i
+    void IntegrateVoxel(int i, float tsdf, const float *color);
+    void IntegrateCompactVoxel(int i, float tsdf, const float *color);
+
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
@@ -27,6 +27,7 @@
 #include "Open3D/Odometry/Odometry.h"
 
 #include <Eigen/Dense>
+#include <typeinfo>
 
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -39,170 +40,207 @@ namespace open3d {
 namespace {
 using namespace odometry;
 
-std::tuple<std::shared_ptr<geometry::Image>, std::shared_ptr<geometry::Image>>
-InitializeCorrespondenceMap(int width, int height) {
-    // initialization: filling with any (u,v) to (-1,-1)
-    auto correspondence_map = std::make_shared<geometry::Image>();
-    auto depth_buffer = std::make_shared<geometry::Image>();
-    correspondence_map->PrepareImage(width, height, 2, 4);
-    depth_buffer->PrepareImage(width, height, 1, 4);
-    for (int v = 0; v < correspondence_map->height_; v++) {
-        for (int u = 0; u < correspondence_map->width_; u++) {
-            *geometry::PointerAt<int>(*correspondence_map, u, v, 0) = -1;
-            *geometry::PointerAt<int>(*correspondence_map, u, v, 1) = -1;
-            *geometry::PointerAt<float>(*depth_buffer, u, v, 0) = -1.0f;
-        }
-    }
-    return std::make_tuple(correspondence_map, depth_buffer);
-}
+/// Function to find the pixel correspondences of \param depth_s in
+/// \param depth_t under \param extrinsic. Every source pixel has at most one
+/// correspondence, so rows are matched in parallel into \param
+/// correspondence_map (one linear target index per source pixel, -1 if none)
+/// and then compacted in row-major order. All buffers are reused across calls.
+void ComputeCorrespondence(const Eigen::Matrix3d intrinsic_matrix,
+                           const Eigen::Matrix4d &extrinsic,
+                           const geometry::Image &depth_s,
+                           const geometry::Image &depth_t,
+                           const OdometryOption &option,
+                           CorrespondenceSetPixelWise &correspondence,
+                           std::vector<int> &correspondence_map,
+                           std::vector<int> &row_offset) {
+    const Eigen::Matrix3d K = intrinsic_matrix;
+    const Eigen::Matrix3d K_inv = K.inverse();
+    const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Matrix3d KRK_inv = K * R * K_inv;
+    Eigen::Vector3d Kt = K * extrinsic.block<3, 1>(0, 3);
 
-inline void AddElementToCorrespondenceMap(geometry::Image &correspondence_map,
-                                          geometry::Image &depth_buffer,
-                                          int u_s,
-                                          int v_s,
-                                          int u_t,
-                                          int v_t,
-                                          float transformed_d_t) {
-    int exist_u_t, exist_v_t;
-    double exist_d_t;
-    exist_u_t = *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 0);
-    exist_v_t = *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 1);
-    if (exist_u_t != -1 && exist_v_t != -1) {
-        exist_d_t = *geometry::PointerAt<float>(depth_buffer, u_s, v_s);
-        if (transformed_d_t <
-            exist_d_t) {  // update nearer point as correspondence
-            *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 0) = u_t;
-            *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 1) = v_t;
-            *geometry::PointerAt<float>(depth_buffer, u_s, v_s) =
-                    transformed_d_t;
-        }
-    } else {  // register correspondence
-        *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 0) = u_t;
-        *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 1) = v_t;
-        *geometry::PointerAt<float>(depth_buffer, u_s, v_s) = transformed_d_t;
-    }
-}
+    const int width = depth_s.width_;
+    const int height = depth_s.height_;
+    correspondence_map.resize((size_t)width * height);
+    row_offset.resize(height + 1);
+    row_offset[0] = 0;
 
-void MergeCorrespondenceMaps(geometry::Image &correspondence_map,
-                             geometry::Image &depth_buffer,
-                             geometry::Image &correspondence_map_part,
-                             geometry::Image &depth_buffer_part) {
-    for (int v_s = 0; v_s < correspondence_map.height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map.width_; u_s++) {
-            int u_t = *geometry::PointerAt<int>(correspondence_map_part, u_s,
-                                                v_s, 0);
-            int v_t = *geometry::PointerAt<int>(correspondence_map_part, u_s,
-                                                v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                float transformed_d_t = *geometry::PointerAt<float>(
-                        depth_buffer_part, u_s, v_s);
-                AddElementToCorrespondenceMap(correspondence_map, depth_buffer,
-                                              u_s, v_s, u_t, v_t,
-                                              transformed_d_t);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v_s = 0; v_s < height; v_s++) {
+        int *map_row = correspondence_map.data() + (size_t)v_s * width;
+        int count = 0;
+        for (int u_s = 0; u_s < width; u_s++) {
+            map_row[u_s] = -1;
+            double d_s = *geometry::PointerAt<float>(depth_s, u_s, v_s);
+            if (!std::isnan(d_s)) {
+                Eigen::Vector3d uv_in_s =
+                        d_s * KRK_inv * Eigen::Vector3d(u_s, v_s, 1.0) + Kt;
+                double transformed_d_s = uv_in_s(2);
+                int u_t = (int)(uv_in_s(0) / transformed_d_s + 0.5);
+                int v_t = (int)(uv_in_s(1) / transformed_d_s + 0.5);
+                if (u_t >= 0 && u_t < depth_t.width_ && v_t >= 0 &&
+                    v_t < depth_t.height_) {
+                    double d_t = *geometry::PointerAt<float>(depth_t, u_t, v_t);
+                    if (!std::isnan(d_t) && std::abs(transformed_d_s - d_t) <=
+                                                    option.max_depth_diff_) {
+                        map_row[u_s] = v_t * depth_t.width_ + u_t;
+                        count++;
+                    }
+                }
             }
         }
+        row_offset[v_s + 1] = count;
+    }
+    for (int v_s = 0; v_s < height; v_s++) {
+        row_offset[v_s + 1] += row_offset[v_s];
     }
-}
 
-int CountCorrespondence(const geometry::Image &correspondence_map) {
-    int correspondence_count = 0;
-    for (int v_s = 0; v_s < correspondence_map.height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map.width_; u_s++) {
-            int u_t =
-                    *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 0);
-            int v_t =
-                    *geometry::PointerAt<int>(correspondence_map, u_s, v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                correspondence_count++;
+    correspondence.resize(row_offset[height]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v_s = 0; v_s < height; v_s++) {
+        const int *map_row = correspondence_map.data() + (size_t)v_s * width;
+        int cnt = row_offset[v_s];
+        for (int u_s = 0; u_s < width; u_s++) {
+            if (map_row[u_s] != -1) {
+                correspondence[cnt++] = Eigen::Vector4i(
+                        u_s, v_s, map_row[u_s] % depth_t.width_,
+                        map_row[u_s] / depth_t.width_);
             }
         }
     }
-    return correspondence_count;
 }
 
-std::shared_ptr<CorrespondenceSetPixelWise> ComputeCorrespondence(
-        const Eigen::Matrix3d intrinsic_matrix,
+/// Function to compute JTJ and JTr of \param JacobianType in a single pass
+/// over the source image. Each source pixel is projected into the target and
+/// tested for depth consistency as in ComputeCorrespondence, and its rows of J
+/// and r are accumulated into per-thread JTJ and JTr right away, without
+/// materializing the correspondences.
+template <typename JacobianType>
+std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> ComputeJTJandJTrFused(
+        const geometry::RGBDImage &source,
+        const geometry::RGBDImage &target,
+        const geometry::Image &source_xyz,
+        const geometry::RGBDImage &target_dx,
+        const geometry::RGBDImage &target_dy,
+        const Eigen::Matrix3d &intrinsic,
         const Eigen::Matrix4d &extrinsic,
-        const geometry::Image &depth_s,
-        const geometry::Image &depth_t,
         const OdometryOption &option) {
-    const Eigen::Matrix3d K = intrinsic_matrix;
+    const Eigen::Matrix3d K = intrinsic;
     const Eigen::Matrix3d K_inv = K.inverse();
     const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = extrinsic.block<3, 1>(0, 3);
     const Eigen::Matrix3d KRK_inv = K * R * K_inv;
-    Eigen::Vector3d Kt = K * extrinsic.block<3, 1>(0, 3);
-
-    std::shared_ptr<geometry::Image> correspondence_map;
-    std::shared_ptr<geometry::Image> depth_buffer;
-    std::tie(correspondence_map, depth_buffer) =
-            InitializeCorrespondenceMap(depth_t.width_, depth_t.height_);
-
+    const Eigen::Vector3d Kt = K * t;
+    const double fx = intrinsic(0, 0);
+    const double fy = intrinsic(1, 1);
+
+    const int width = source.depth_.width_;
+    const int height = source.depth_.height_;
+    const int width_t = target.depth_.width_;
+    const int height_t = target.depth_.height_;
+    auto data = [](const geometry::Image &image) {
+        return reinterpret_cast<const float *>(image.data_.data());
+    };
+    const float *color_s = data(source.color_);
+    const float *depth_s = data(source.depth_);
+    const float *xyz_s = data(source_xyz);
+    const float *color_t = data(target.color_);
+    const float *depth_t = data(target.depth_);
+    const float *dx_color_t = data(target_dx.color_);
+    const float *dx_depth_t = data(target_dx.depth_);
+    const float *dy_color_t = data(target_dy.color_);
+    const float *dy_depth_t = data(target_dy.depth_);
+
+    // The upper triangle of JTJ (21 entries, row by row) followed by JTr.
+    const int num_sums = 27;
+    double sums[num_sums] = {0.0};
+    double r2_sum = 0.0;
+    int count = 0;
 #ifdef _OPENMP
 #pragma omp parallel
     {
 #endif
-        std::shared_ptr<geometry::Image> correspondence_map_private;
-        std::shared_ptr<geometry::Image> depth_buffer_private;
-        std::tie(correspondence_map_private, depth_buffer_private) =
-                InitializeCorrespondenceMap(depth_t.width_, depth_t.height_);
+        double sums_private[num_sums] = {0.0};
+        double r2_sum_private = 0.0;
+        int count_private = 0;
+        Eigen::Vector6d J_r[JacobianType::NUM_ROWS];
+        double r[JacobianType::NUM_ROWS];
 #ifdef _OPENMP
 #pragma omp for nowait
 #endif
-        for (int v_s = 0; v_s < depth_s.height_; v_s++) {
-            for (int u_s = 0; u_s < depth_s.width_; u_s++) {
-                double d_s = *geometry::PointerAt<float>(depth_s, u_s, v_s);
-                if (!std::isnan(d_s)) {
-                    Eigen::Vector3d uv_in_s =
-                            d_s * KRK_inv * Eigen::Vector3d(u_s, v_s, 1.0) + Kt;
-                    double transformed_d_s = uv_in_s(2);
-                    int u_t = (int)(uv_in_s(0) / transformed_d_s + 0.5);
-                    int v_t = (int)(uv_in_s(1) / transformed_d_s + 0.5);
-                    if (u_t >= 0 && u_t < depth_t.width_ && v_t >= 0 &&
-                        v_t < depth_t.height_) {
-                        double d_t =
-                                *geometry::PointerAt<float>(depth_t, u_t, v_t);
-                        if (!std::isnan(d_t) &&
-                            std::abs(transformed_d_s - d_t) <=
-                                    option.max_depth_diff_) {
-                            AddElementToCorrespondenceMap(
-                                    *correspondence_map_private,
-                                    *depth_buffer_private, u_s, v_s, u_t, v_t,
-                                    (float)d_s);
+        for (int v_s = 0; v_s < height; v_s++) {
+            for (int u_s = 0; u_s < width; u_s++) {
+                const int i_s = v_s * width + u_s;
+                double d_s = depth_s[i_s];
+                if (std::isnan(d_s)) {
+                    continue;
+                }
+                Eigen::Vector3d uv_in_s =
+                        d_s * KRK_inv * Eigen::Vector3d(u_s, v_s, 1.0) + Kt;
+                double transformed_d_s = uv_in_s(2);
+                int u_t = (int)(uv_in_s(0) / transformed_d_s + 0.5);
+                int v_t = (int)(uv_in_s(1) / transformed_d_s + 0.5);
+                if (u_t < 0 || u_t >= width_t || v_t < 0 || v_t >= height_t) {
+                    continue;
+                }
+                const int i_t = v_t * width_t + u_t;
+                double d_t = depth_t[i_t];
+                if (std::isnan(d_t) ||
+                    std::abs(transformed_d_s - d_t) > option.max_depth_diff_) {
+                    continue;
+                }
+                Eigen::Vector3d p3d_mat(xyz_s[3 * i_s], xyz_s[3 * i_s + 1],
+                                        xyz_s[3 * i_s + 2]);
+                Eigen::Vector3d p3d_trans = R * p3d_mat + t;
+                JacobianType::ComputeJacobianAndResidualFromSamples(
+                        p3d_trans, color_s[i_s], color_t[i_t], dx_color_t[i_t],
+                        dy_color_t[i_t], d_t, dx_depth_t[i_t], dy_depth_t[i_t],
+                        fx, fy, J_r, r);
+                for (int k = 0; k < JacobianType::NUM_ROWS; k++) {
+                    const double *J = J_r[k].data();
+                    int idx = 0;
+                    for (int a = 0; a < 6; a++) {
+                        for (int b = a; b < 6; b++) {
+                            sums_private[idx++] += J[a] * J[b];
                         }
                     }
+                    for (int a = 0; a < 6; a++) {
+                        sums_private[21 + a] += J[a] * r[k];
+                    }
+                    r2_sum_private += r[k] * r[k];
                 }
+                count_private++;
             }
         }
 #ifdef _OPENMP
 #pragma omp critical
         {
 #endif
-            MergeCorrespondenceMaps(*correspondence_map, *depth_buffer,
-                                    *correspondence_map_private,
-                                    *depth_buffer_private);
+            for (int i = 0; i < num_sums; i++) {
+                sums[i] += sums_private[i];
+            }
+            r2_sum += r2_sum_private;
+            count += count_private;
 #ifdef _OPENMP
-        }  //    omp critical
-    }      //    omp parallel
+        }
+    }
 #endif
-
-    auto correspondence = std::make_shared<CorrespondenceSetPixelWise>();
-    int correspondence_count = CountCorrespondence(*correspondence_map);
-    correspondence->resize(correspondence_count);
-    int cnt = 0;
-    for (int v_s = 0; v_s < correspondence_map->height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map->width_; u_s++) {
-            int u_t =
-                    *geometry::PointerAt<int>(*correspondence_map, u_s, v_s, 0);
-            int v_t =
-                    *geometry::PointerAt<int>(*correspondence_map, u_s, v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                Eigen::Vector4i pixel_correspondence(u_s, v_s, u_t, v_t);
-                (*correspondence)[cnt] = pixel_correspondence;
-                cnt++;
-            }
+    Eigen::Matrix6d JTJ;
+    Eigen::Vector6d JTr;
+    int idx = 0;
+    for (int a = 0; a < 6; a++) {
+        for (int b = a; b < 6; b++) {
+            JTJ(a, b) = JTJ(b, a) = sums[idx++];
         }
+        JTr(a) = sums[21 + a];
     }
-    return correspondence;
+    utility::PrintDebug("Residual : %.2e (# of elements : %d)\n",
+                        r2_sum / (double)count, count);
+    return std::make_tuple(std::move(JTJ), std::move(JTr), r2_sum);
 }
 
 std::shared_ptr<geometry::Image> ConvertDepthImageToXYZImage(
@@ -250,74 +288,12 @@ std::vector<Eigen::Matrix3d> CreateCameraMatrixPyramid(
     return pyramid_camera_matrix;
 }
 
-Eigen::Matrix6d CreateInformationMatrix(
-        const Eigen::Matrix4d &extrinsic,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
-        const geometry::Image &depth_s,
-        const geometry::Image &depth_t,
-        const OdometryOption &option) {
-    auto correspondence =
-            ComputeCorrespondence(pinhole_camera_intrinsic.intrinsic_matrix_,
-                                  extrinsic, depth_s, depth_t, option);
-
-    auto xyz_t = ConvertDepthImageToXYZImage(
-            depth_t, pinhole_camera_intrinsic.intrinsic_matrix_);
-
-    // write q^*
-    // see http://redwood-data.org/indoor/registration.html
-    // note: I comes first and q_skew is scaled by factor 2.
-    Eigen::Matrix6d GTG = Eigen::Matrix6d::Identity();
-#ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        Eigen::Matrix6d GTG_private = Eigen::Matrix6d::Identity();
-        Eigen::Vector6d G_r_private = Eigen::Vector6d::Zero();
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (auto row = 0; row < correspondence->size(); row++) {
-            int u_t = (*correspondence)[row](2);
-            int v_t = (*correspondence)[row](3);
-            double x = *geometry::PointerAt<float>(*xyz_t, u_t, v_t, 0);
-            double y = *geometry::PointerAt<float>(*xyz_t, u_t, v_t, 1);
-            double z = *geometry::PointerAt<float>(*xyz_t, u_t, v_t, 2);
-            G_r_private.setZero();
-            G_r_private(1) = z;
-            G_r_private(2) = -y;
-            G_r_private(3) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-            G_r_private.setZero();
-            G_r_private(0) = -z;
-            G_r_private(2) = x;
-            G_r_private(4) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-            G_r_private.setZero();
-            G_r_private(0) = y;
-            G_r_private(1) = -x;
-            G_r_private(5) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-        }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        { GTG += GTG_private; }
-#ifdef _OPENMP
-    }
-#endif
-    return std::move(GTG);
-}
-
-void NormalizeIntensity(geometry::Image &image_s,
-                        geometry::Image &image_t,
-                        CorrespondenceSetPixelWise &correspondence) {
-    if (image_s.width_ != image_t.width_ ||
-        image_s.height_ != image_t.height_) {
-        utility::PrintError(
-                "[NormalizeIntensity] Size of two input images should be "
-                "same\n");
-        return;
-    }
+/// Function to compute the scale factors that bring the mean intensity of the
+/// corresponding pixels of \param image_s and \param image_t to 0.5.
+std::tuple<double, double> ComputeIntensityNormalization(
+        const geometry::Image &image_s,
+        const geometry::Image &image_t,
+        const CorrespondenceSetPixelWise &correspondence) {
     double mean_s = 0.0, mean_t = 0.0;
     for (int row = 0; row < correspondence.size(); row++) {
         int u_s = correspondence[row](0);
@@ -329,14 +305,17 @@ void NormalizeIntensity(geometry::Image &image_s,
     }
     mean_s /= (double)correspondence.size();
     mean_t /= (double)correspondence.size();
-    geometry::LinearTransformImage(image_s, 0.5 / mean_s, 0.0);
-    geometry::LinearTransformImage(image_t, 0.5 / mean_t, 0.0);
+    return std::make_tuple(0.5 / mean_s, 0.5 / mean_t);
 }
 
-inline std::shared_ptr<geometry::RGBDImage> PackRGBDImage(
-        const geometry::Image &color, const geometry::Image &depth) {
-    return std::make_shared<geometry::RGBDImage>(
-            geometry::RGBDImage(color, depth));
+/// Function to copy \param input into \param output, reusing the memory of
+/// \param output, and to scale its color by \param scale.
+void CopyAndScaleColor(const geometry::RGBDImage &input,
+                       double scale,
+                       geometry::RGBDImage &output) {
+    output.color_ = input.color_;
+    output.depth_ = input.depth_;
+    geometry::LinearTransformImage(output.color_, scale, 0.0);
 }
 
 std::shared_ptr<geometry::Image> PreprocessDepth(
@@ -360,50 +339,18 @@ inline bool CheckImagePair(const geometry::Image &image_s,
             image_s.height_ == image_t.height_);
 }
 
-inline bool CheckRGBDImagePair(const geometry::RGBDImage &source,
-                               const geometry::RGBDImage &target) {
-    return (CheckImagePair(source.color_, target.color_) &&
-            CheckImagePair(source.depth_, target.depth_) &&
-            CheckImagePair(source.color_, source.depth_) &&
-            CheckImagePair(target.color_, target.depth_) &&
-            CheckImagePair(source.color_, target.color_) &&
-            source.color_.num_of_channels_ == 1 &&
-            source.depth_.num_of_channels_ == 1 &&
-            target.color_.num_of_channels_ == 1 &&
-            target.depth_.num_of_channels_ == 1 &&
-            source.color_.bytes_per_channel_ == 4 &&
-            target.color_.bytes_per_channel_ == 4 &&
-            source.depth_.bytes_per_channel_ == 4 &&
-            target.depth_.bytes_per_channel_ == 4);
+inline bool CheckRGBDImage(const geometry::RGBDImage &image) {
+    return (CheckImagePair(image.color_, image.depth_) &&
+            image.color_.num_of_channels_ == 1 &&
+            image.depth_.num_of_channels_ == 1 &&
+            image.color_.bytes_per_channel_ == 4 &&
+            image.depth_.bytes_per_channel_ == 4);
 }
 
-std::tuple<std::shared_ptr<geometry::RGBDImage>,
-           std::shared_ptr<geometry::RGBDImage>>
-InitializeRGBDOdometry(
-        const geometry::RGBDImage &source,
-        const geometry::RGBDImage &target,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
-        const Eigen::Matrix4d &odo_init,
-        const OdometryOption &option) {
-    auto source_gray = geometry::FilterImage(
-            source.color_, geometry::Image::FilterType::Gaussian3);
-    auto target_gray = geometry::FilterImage(
-            target.color_, geometry::Image::FilterType::Gaussian3);
-    auto source_depth_preprocessed = PreprocessDepth(source.depth_, option);
-    auto target_depth_preprocessed = PreprocessDepth(target.depth_, option);
-    auto source_depth = geometry::FilterImage(
-            *source_depth_preprocessed, geometry::Image::FilterType::Gaussian3);
-    auto target_depth = geometry::FilterImage(
-            *target_depth_preprocessed, geometry::Image::FilterType::Gaussian3);
-
-    auto correspondence = ComputeCorrespondence(
-            pinhole_camera_intrinsic.intrinsic_matrix_, odo_init, *source_depth,
-            *target_depth, option);
-    NormalizeIntensity(*source_gray, *target_gray, *correspondence);
-
-    auto source_out = PackRGBDImage(*source_gray, *source_depth);
-    auto target_out = PackRGBDImage(*target_gray, *target_depth);
-    return std::make_tuple(source_out, target_out);
+inline bool CheckRGBDImagePair(const geometry::RGBDImage &source,
+                               const geometry::RGBDImage &target) {
+    return (CheckRGBDImage(source) && CheckRGBDImage(target) &&
+            CheckImagePair(source.color_, target.color_));
 }
 
 std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
@@ -417,27 +364,47 @@ std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
         const Eigen::Matrix3d intrinsic,
         const Eigen::Matrix4d &extrinsic_initial,
         const RGBDOdometryJacobian &jacobian_method,
-        const OdometryOption &option) {
-    auto correspondence = ComputeCorrespondence(
-            intrinsic, extrinsic_initial, source.depth_, target.depth_, option);
-    int corresps_count = (int)correspondence->size();
-
-    auto f_lambda =
-            [&](int i,
-                std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
-                std::vector<double> &r) {
-                jacobian_method.ComputeJacobianAndResidual(
-                        i, J_r, r, source, target, source_xyz, target_dx,
-                        target_dy, intrinsic, extrinsic_initial,
-                        *correspondence);
-            };
+        const OdometryOption &option,
+        CorrespondenceSetPixelWise &correspondence,
+        std::vector<int> &correspondence_map,
+        std::vector<int> &row_offset) {
     utility::PrintDebug("Iter : %d, Level : %d, ", iter, level);
     Eigen::Matrix6d JTJ;
     Eigen::Vector6d JTr;
     double r2;
-    std::tie(JTJ, JTr, r2) =
-            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
-                    f_lambda, corresps_count);
+    // The built-in Jacobians run the fused kernel. Other Jacobians, e.g.
+    // subclasses overriding ComputeJacobianAndResidual, go through the
+    // correspondence set and the virtual call.
+    if (typeid(jacobian_method) ==
+        typeid(RGBDOdometryJacobianFromHybridTerm)) {
+        std::tie(JTJ, JTr, r2) =
+                ComputeJTJandJTrFused<RGBDOdometryJacobianFromHybridTerm>(
+                        source, target, source_xyz, target_dx, target_dy,
+                        intrinsic, extrinsic_initial, option);
+    } else if (typeid(jacobian_method) ==
+               typeid(RGBDOdometryJacobianFromColorTerm)) {
+        std::tie(JTJ, JTr, r2) =
+                ComputeJTJandJTrFused<RGBDOdometryJacobianFromColorTerm>(
+                        source, target, source_xyz, target_dx, target_dy,
+                        intrinsic, extrinsic_initial, option);
+    } else {
+        ComputeCorrespondence(intrinsic, extrinsic_initial, source.depth_,
+                              target.depth_, option, correspondence,
+                              correspondence_map, row_offset);
+        int corresps_count = (int)correspondence.size();
+
+        auto f_lambda = [&](int i,
+                            std::vector<Eigen::Vector6d,
+                                        utility::Vector6d_allocator> &J_r,
+                            std::vector<double> &r) {
+            jacobian_method.ComputeJacobianAndResidual(
+                    i, J_r, r, source, target, source_xyz, target_dx,
+                    target_dy, intrinsic, extrinsic_initial, correspondence);
+        };
+        std::tie(JTJ, JTr, r2) =
+                utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                        f_lambda, corresps_count);
+    }
 
     bool is_success;
     Eigen::Matrix4d extrinsic;
@@ -451,53 +418,105 @@ std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
     }
 }
 
-std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
-        const geometry::RGBDImage &source,
-        const geometry::RGBDImage &target,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
+}  // unnamed namespace
+
+namespace odometry {
+
+RGBDOdometry::RGBDOdometry(
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic
+        /*= camera::PinholeCameraIntrinsic()*/,
+        const OdometryOption &option /*= OdometryOption()*/)
+    : pinhole_camera_intrinsic_(pinhole_camera_intrinsic),
+      option_(option),
+      pyramid_camera_matrix_(CreateCameraMatrixPyramid(
+              pinhole_camera_intrinsic,
+              (int)option.iteration_number_per_pyramid_level_.size())) {}
+
+std::shared_ptr<RGBDOdometryFrame> RGBDOdometry::CreateFrame(
+        const geometry::RGBDImage &image) const {
+    auto frame = std::make_shared<RGBDOdometryFrame>();
+    if (!CheckRGBDImage(image)) {
+        utility::PrintError(
+                "[RGBDOdometry] Unsupported RGBD image format.\n");
+        return frame;
+    }
+    int num_levels = (int)option_.iteration_number_per_pyramid_level_.size();
+    auto gray = geometry::FilterImage(image.color_,
+                                      geometry::Image::FilterType::Gaussian3);
+    auto depth_preprocessed = PreprocessDepth(image.depth_, option_);
+    auto depth = geometry::FilterImage(*depth_preprocessed,
+                                       geometry::Image::FilterType::Gaussian3);
+    // The intensity is normalized per pair in Compute(). As the pyramid and
+    // the gradients are linear in the intensity, they are computed here on the
+    // unnormalized intensity and scaled afterwards.
+    frame->pyramid_ = geometry::CreateRGBDImagePyramid(
+            geometry::RGBDImage(*gray, *depth), num_levels);
+    frame->pyramid_dx_ = geometry::FilterRGBDImagePyramid(
+            frame->pyramid_, geometry::Image::FilterType::Sobel3Dx);
+    frame->pyramid_dy_ = geometry::FilterRGBDImagePyramid(
+            frame->pyramid_, geometry::Image::FilterType::Sobel3Dy);
+    frame->pyramid_xyz_.resize(num_levels);
+    for (int level = 0; level < num_levels; level++) {
+        frame->pyramid_xyz_[level] = ConvertDepthImageToXYZImage(
+                frame->pyramid_[level]->depth_, pyramid_camera_matrix_[level]);
+    }
+    return frame;
+}
+
+void RGBDOdometry::NormalizeFramePair(const RGBDOdometryFrame &source,
+                                      const RGBDOdometryFrame &target,
+                                      const Eigen::Matrix4d &odo_init) {
+    ComputeCorrespondence(pinhole_camera_intrinsic_.intrinsic_matrix_,
+                          odo_init, source.pyramid_[0]->depth_,
+                          target.pyramid_[0]->depth_, option_, correspondence_,
+                          correspondence_map_, row_offset_);
+    double scale_s, scale_t;
+    std::tie(scale_s, scale_t) = ComputeIntensityNormalization(
+            source.pyramid_[0]->color_, target.pyramid_[0]->color_,
+            correspondence_);
+
+    int num_levels = (int)source.pyramid_.size();
+    source_level_.resize(num_levels);
+    target_level_.resize(num_levels);
+    target_dx_level_.resize(num_levels);
+    target_dy_level_.resize(num_levels);
+    for (int level = 0; level < num_levels; level++) {
+        CopyAndScaleColor(*source.pyramid_[level], scale_s,
+                          source_level_[level]);
+        CopyAndScaleColor(*target.pyramid_[level], scale_t,
+                          target_level_[level]);
+        CopyAndScaleColor(*target.pyramid_dx_[level], scale_t,
+                          target_dx_level_[level]);
+        CopyAndScaleColor(*target.pyramid_dy_[level], scale_t,
+                          target_dy_level_[level]);
+    }
+}
+
+std::tuple<bool, Eigen::Matrix4d> RGBDOdometry::ComputeMultiscale(
+        const RGBDOdometryFrame &source,
         const Eigen::Matrix4d &extrinsic_initial,
-        const RGBDOdometryJacobian &jacobian_method,
-        const OdometryOption &option) {
-    std::vector<int> iter_counts = option.iteration_number_per_pyramid_level_;
+        const RGBDOdometryJacobian &jacobian_method) {
+    const std::vector<int> &iter_counts =
+            option_.iteration_number_per_pyramid_level_;
     int num_levels = (int)iter_counts.size();
 
-    auto source_pyramid = geometry::CreateRGBDImagePyramid(source, num_levels);
-    auto target_pyramid = geometry::CreateRGBDImagePyramid(target, num_levels);
-    auto target_pyramid_dx = geometry::FilterRGBDImagePyramid(
-            target_pyramid, geometry::Image::FilterType::Sobel3Dx);
-    auto target_pyramid_dy = geometry::FilterRGBDImagePyramid(
-            target_pyramid, geometry::Image::FilterType::Sobel3Dy);
-
     Eigen::Matrix4d result_odo = extrinsic_initial.isZero()
                                          ? Eigen::Matrix4d::Identity()
                                          : extrinsic_initial;
 
-    std::vector<Eigen::Matrix3d> pyramid_camera_matrix =
-            CreateCameraMatrixPyramid(pinhole_camera_intrinsic,
-                                      (int)iter_counts.size());
-
     for (int level = num_levels - 1; level >= 0; level--) {
         const Eigen::Matrix3d level_camera_matrix =
-                pyramid_camera_matrix[level];
-
-        auto source_xyz_level = ConvertDepthImageToXYZImage(
-                source_pyramid[level]->depth_, level_camera_matrix);
-        auto source_level = PackRGBDImage(source_pyramid[level]->color_,
-                                          source_pyramid[level]->depth_);
-        auto target_level = PackRGBDImage(target_pyramid[level]->color_,
-                                          target_pyramid[level]->depth_);
-        auto target_dx_level = PackRGBDImage(target_pyramid_dx[level]->color_,
-                                             target_pyramid_dx[level]->depth_);
-        auto target_dy_level = PackRGBDImage(target_pyramid_dy[level]->color_,
-                                             target_pyramid_dy[level]->depth_);
+                pyramid_camera_matrix_[level];
 
         for (int iter = 0; iter < iter_counts[num_levels - level - 1]; iter++) {
             Eigen::Matrix4d curr_odo;
             bool is_success;
             std::tie(is_success, curr_odo) = DoSingleIteration(
-                    iter, level, *source_level, *target_level,
-                    *source_xyz_level, *target_dx_level, *target_dy_level,
-                    level_camera_matrix, result_odo, jacobian_method, option);
+                    iter, level, source_level_[level], target_level_[level],
+                    *source.pyramid_xyz_[level], target_dx_level_[level],
+                    target_dy_level_[level], level_camera_matrix, result_odo,
+                    jacobian_method, option_, correspondence_,
+                    correspondence_map_, row_offset_);
             result_odo = curr_odo * result_odo;
 
             if (!is_success) {
@@ -509,41 +528,90 @@ std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
     return std::make_tuple(true, result_odo);
 }
 
-}  // unnamed namespace
+Eigen::Matrix6d RGBDOdometry::CreateInformationMatrix(
+        const RGBDOdometryFrame &source,
+        const RGBDOdometryFrame &target,
+        const Eigen::Matrix4d &extrinsic) {
+    ComputeCorrespondence(pinhole_camera_intrinsic_.intrinsic_matrix_,
+                          extrinsic, source.pyramid_[0]->depth_,
+                          target.pyramid_[0]->depth_, option_, correspondence_,
+                          correspondence_map_, row_offset_);
+    const geometry::Image &xyz_t = *target.pyramid_xyz_[0];
 
-namespace odometry {
+    // write q^*
+    // see http://redwood-data.org/indoor/registration.html
+    // note: I comes first and q_skew is scaled by factor 2.
+    Eigen::Matrix6d GTG = Eigen::Matrix6d::Identity();
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        Eigen::Matrix6d GTG_private = Eigen::Matrix6d::Identity();
+        Eigen::Vector6d G_r_private = Eigen::Vector6d::Zero();
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (auto row = 0; row < correspondence_.size(); row++) {
+            int u_t = correspondence_[row](2);
+            int v_t = correspondence_[row](3);
+            double x = *geometry::PointerAt<float>(xyz_t, u_t, v_t, 0);
+            double y = *geometry::PointerAt<float>(xyz_t, u_t, v_t, 1);
+            double z = *geometry::PointerAt<float>(xyz_t, u_t, v_t, 2);
+            G_r_private.setZero();
+            G_r_private(1) = z;
+            G_r_private(2) = -y;
+            G_r_private(3) = 1.0;
+            GTG_private.noalias() += G_r_private * G_r_private.transpose();
+            G_r_private.setZero();
+            G_r_private(0) = -z;
+            G_r_private(2) = x;
+            G_r_private(4) = 1.0;
+            GTG_private.noalias() += G_r_private * G_r_private.transpose();
+            G_r_private.setZero();
+            G_r_private(0) = y;
+            G_r_private(1) = -x;
+            G_r_private(5) = 1.0;
+            GTG_private.noalias() += G_r_private * G_r_private.transpose();
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        { GTG += GTG_private; }
+#ifdef _OPENMP
+    }
+#endif
+    return std::move(GTG);
+}
 
-std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
-        const geometry::RGBDImage &source,
-        const geometry::RGBDImage &target,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic
-        /*= camera::PinholeCameraIntrinsic()*/,
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> RGBDOdometry::Compute(
+        const RGBDOdometryFrame &source,
+        const RGBDOdometryFrame &target,
         const Eigen::Matrix4d &odo_init /*= Eigen::Matrix4d::Identity()*/,
         const RGBDOdometryJacobian &jacobian_method
-        /*=RGBDOdometryJacobianFromHybridTerm*/,
-        const OdometryOption &option /*= OdometryOption()*/) {
-    if (!CheckRGBDImagePair(source, target)) {
+        /*=RGBDOdometryJacobianFromHybridTerm*/) {
+    int num_levels = (int)option_.iteration_number_per_pyramid_level_.size();
+    if ((int)source.pyramid_.size() != num_levels ||
+        (int)target.pyramid_.size() != num_levels || num_levels == 0 ||
+        !CheckImagePair(source.pyramid_[0]->depth_,
+                        target.pyramid_[0]->depth_)) {
         utility::PrintError(
-                "[RGBDOdometry] Two RGBD pairs should be same in size.\n");
+                "[RGBDOdometry] Two frames should be created by the same "
+                "RGBDOdometry and be same in size.\n");
         return std::make_tuple(false, Eigen::Matrix4d::Identity(),
                                Eigen::Matrix6d::Zero());
     }
 
-    std::shared_ptr<geometry::RGBDImage> source_processed, target_processed;
-    std::tie(source_processed, target_processed) = InitializeRGBDOdometry(
-            source, target, pinhole_camera_intrinsic, odo_init, option);
+    NormalizeFramePair(source, target, odo_init);
 
     Eigen::Matrix4d extrinsic;
     bool is_success;
-    std::tie(is_success, extrinsic) = ComputeMultiscale(
-            *source_processed, *target_processed, pinhole_camera_intrinsic,
-            odo_init, jacobian_method, option);
+    std::tie(is_success, extrinsic) =
+            ComputeMultiscale(source, odo_init, jacobian_method);
 
     if (is_success) {
         Eigen::Matrix4d trans_output = extrinsic;
-        Eigen::MatrixXd info_output = CreateInformationMatrix(
-                extrinsic, pinhole_camera_intrinsic, source_processed->depth_,
-                target_processed->depth_, option);
+        Eigen::MatrixXd info_output =
+                CreateInformationMatrix(source, target, extrinsic);
         return std::make_tuple(true, trans_output, info_output);
     } else {
         return std::make_tuple(false, Eigen::Matrix4d::Identity(),
@@ -551,5 +619,28 @@ std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
     }
 }
 
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
+        const geometry::RGBDImage &source,
+        const geometry::RGBDImage &target,
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic
+        /*= camera::PinholeCameraIntrinsic()*/,
+        const Eigen::Matrix4d &odo_init /*= Eigen::Matrix4d::Identity()*/,
+        const RGBDOdometryJacobian &jacobian_method
+        /*=RGBDOdometryJacobianFromHybridTerm*/,
+        const OdometryOption &option /*= OdometryOption()*/) {
+    if (!CheckRGBDImagePair(source, target)) {
+        utility::PrintError(
+                "[RGBDOdometry] Two RGBD pairs should be same in size.\n");
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+
+    RGBDOdometry odometry(pinhole_camera_intrinsic, option);
+    auto source_frame = odometry.CreateFrame(source);
+    auto target_frame = odometry.CreateFrame(target);
+    return odometry.Compute(*source_frame, *target_frame, odo_init,
+                            jacobian_method);
+}
+
 }  // namespace odometry
 }  // namespace open3d
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Odometry/OdometryOption.h"
 #include "Open3D/Odometry/RGBDOdometryJacobian.h"
 #include "Open3D/Utility/Console.h"
@@ -39,11 +40,88 @@
 
 namespace open3d {
 
-namespace geometry {
-class RGBDImage;
-}
-
 namespace odometry {
+
+/// An RGB-D image preprocessed for odometry: pyramids of the smoothed
+/// intensity and depth, of their gradients, and of the back-projected depth.
+/// Created by RGBDOdometry::CreateFrame() and reusable as source or target of
+/// any number of pairs.
+class RGBDOdometryFrame {
+public:
+    RGBDOdometryFrame() {}
+    ~RGBDOdometryFrame() {}
+
+public:
+    bool IsEmpty() const { return pyramid_.empty(); }
+
+public:
+    geometry::RGBDImagePyramid pyramid_;
+    geometry::RGBDImagePyramid pyramid_dx_;
+    geometry::RGBDImagePyramid pyramid_dy_;
+    std::vector<std::shared_ptr<geometry::Image>> pyramid_xyz_;
+};
+
+/// Stateful RGB-D odometry for sequential tracking. Each frame is
+/// preprocessed once by CreateFrame() instead of once per pair, e.g. frame t
+/// serves as target of pair (t, t+1) and as source of pair (t+1, t+2).
+/// The working buffers of Compute() are kept across calls, so that tracking
+/// a sequence of equally sized frames does not allocate after the first pair.
+class RGBDOdometry {
+public:
+    RGBDOdometry(
+            const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic =
+                    camera::PinholeCameraIntrinsic(),
+            const OdometryOption &option = OdometryOption());
+    ~RGBDOdometry() {}
+
+public:
+    /// Function to preprocess an RGB-D image into an odometry frame
+    /// Return an empty frame if the image format is not supported.
+    std::shared_ptr<RGBDOdometryFrame> CreateFrame(
+            const geometry::RGBDImage &image) const;
+
+    /// Function to estimate 6D odometry between two preprocessed frames
+    /// output: is_success, 4x4 motion matrix, 6x6 information matrix
+    std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> Compute(
+            const RGBDOdometryFrame &source,
+            const RGBDOdometryFrame &target,
+            const Eigen::Matrix4d &odo_init = Eigen::Matrix4d::Identity(),
+            const RGBDOdometryJacobian &jacobian_method =
+                    RGBDOdometryJacobianFromHybridTerm());
+
+    const camera::PinholeCameraIntrinsic &GetIntrinsic() const {
+        return pinhole_camera_intrinsic_;
+    }
+    const OdometryOption &GetOption() const { return option_; }
+
+private:
+    void NormalizeFramePair(const RGBDOdometryFrame &source,
+                            const RGBDOdometryFrame &target,
+                            const Eigen::Matrix4d &odo_init);
+    std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
+            const RGBDOdometryFrame &source,
+            const Eigen::Matrix4d &extrinsic_initial,
+            const RGBDOdometryJacobian &jacobian_method);
+    Eigen::Matrix6d CreateInformationMatrix(const RGBDOdometryFrame &source,
+                                            const RGBDOdometryFrame &target,
+                                            const Eigen::Matrix4d &extrinsic);
+
+private:
+    camera::PinholeCameraIntrinsic pinhole_camera_intrinsic_;
+    OdometryOption option_;
+    std::vector<Eigen::Matrix3d> pyramid_camera_matrix_;
+
+    // Working buffers: the pair with normalized intensity, and the
+    // correspondences of the current iteration.
+    std::vector<geometry::RGBDImage> source_level_;
+    std::vector<geometry::RGBDImage> target_level_;
+    std::vector<geometry::RGBDImage> target_dx_level_;
+    std::vector<geometry::RGBDImage> target_dy_level_;
+    CorrespondenceSetPixelWise correspondence_;
+    std::vector<int> correspondence_map_;
+    std::vector<int> row_offset_;
+};
+
 /// Function to estimate 6D odometry between two RGB-D images
 /// output: is_success, 4x4 motion matrix, 6x6 information matrix
 std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
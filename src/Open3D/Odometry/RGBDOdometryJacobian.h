@@ -27,6 +27,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <cmath>
 #include <iostream>
 #include <tuple>
 #include <vector>
@@ -98,6 +99,46 @@ public:
             const Eigen::Matrix3d &intrinsic,
             const Eigen::Matrix4d &extrinsic,
             const CorrespondenceSetPixelWise &corresps) const override;
+
+    /// Number of rows of J and r per correspondence
+    static const int NUM_ROWS = 1;
+
+    /// Function to compute the rows of J and r of a single correspondence
+    /// from its samples: the transformed source point \param p3d_trans, the
+    /// source and target intensities, the raw Sobel responses of the target
+    /// intensity and depth, and the target depth. It is inline and
+    /// non-virtual so that the fused odometry iteration can be specialized
+    /// for this Jacobian.
+    static void ComputeJacobianAndResidualFromSamples(
+            const Eigen::Vector3d &p3d_trans,
+            double intensity_s,
+            double intensity_t,
+            double sobel_dx_intensity_t,
+            double sobel_dy_intensity_t,
+            double depth_t,
+            double sobel_dx_depth_t,
+            double sobel_dy_depth_t,
+            double fx,
+            double fy,
+            Eigen::Vector6d *J_r,
+            double *r) {
+        const double SOBEL_SCALE = 0.125;
+        double diff = intensity_t - intensity_s;
+        double dIdx = SOBEL_SCALE * sobel_dx_intensity_t;
+        double dIdy = SOBEL_SCALE * sobel_dy_intensity_t;
+        double invz = 1. / p3d_trans(2);
+        double c0 = dIdx * fx * invz;
+        double c1 = dIdy * fy * invz;
+        double c2 = -(c0 * p3d_trans(0) + c1 * p3d_trans(1)) * invz;
+
+        J_r[0](0) = -p3d_trans(2) * c1 + p3d_trans(1) * c2;
+        J_r[0](1) = p3d_trans(2) * c0 - p3d_trans(0) * c2;
+        J_r[0](2) = -p3d_trans(1) * c0 + p3d_trans(0) * c1;
+        J_r[0](3) = c0;
+        J_r[0](4) = c1;
+        J_r[0](5) = c2;
+        r[0] = diff;
+    }
 };
 
 /// Class to compute Jacobian using hybrid term
@@ -123,6 +164,69 @@ public:
             const Eigen::Matrix3d &intrinsic,
             const Eigen::Matrix4d &extrinsic,
             const CorrespondenceSetPixelWise &corresps) const override;
+
+    /// Number of rows of J and r per correspondence
+    static const int NUM_ROWS = 2;
+
+    /// Function to compute the rows of J and r of a single correspondence
+    /// from its samples, see
+    /// RGBDOdometryJacobianFromColorTerm::ComputeJacobianAndResidualFromSamples
+    static void ComputeJacobianAndResidualFromSamples(
+            const Eigen::Vector3d &p3d_trans,
+            double intensity_s,
+            double intensity_t,
+            double sobel_dx_intensity_t,
+            double sobel_dy_intensity_t,
+            double depth_t,
+            double sobel_dx_depth_t,
+            double sobel_dy_depth_t,
+            double fx,
+            double fy,
+            Eigen::Vector6d *J_r,
+            double *r) {
+        const double SOBEL_SCALE = 0.125;
+        const double LAMBDA_HYBRID_DEPTH = 0.968;
+        double sqrt_lamba_dep, sqrt_lambda_img;
+        sqrt_lamba_dep = sqrt(LAMBDA_HYBRID_DEPTH);
+        sqrt_lambda_img = sqrt(1.0 - LAMBDA_HYBRID_DEPTH);
+
+        double diff_photo = intensity_t - intensity_s;
+        double dIdx = SOBEL_SCALE * sobel_dx_intensity_t;
+        double dIdy = SOBEL_SCALE * sobel_dy_intensity_t;
+        double dDdx = SOBEL_SCALE * sobel_dx_depth_t;
+        double dDdy = SOBEL_SCALE * sobel_dy_depth_t;
+        if (std::isnan(dDdx)) dDdx = 0;
+        if (std::isnan(dDdy)) dDdy = 0;
+
+        double diff_geo = depth_t - p3d_trans(2);
+        double invz = 1. / p3d_trans(2);
+        double c0 = dIdx * fx * invz;
+        double c1 = dIdy * fy * invz;
+        double c2 = -(c0 * p3d_trans(0) + c1 * p3d_trans(1)) * invz;
+        double d0 = dDdx * fx * invz;
+        double d1 = dDdy * fy * invz;
+        double d2 = -(d0 * p3d_trans(0) + d1 * p3d_trans(1)) * invz;
+
+        J_r[0](0) = sqrt_lambda_img * (-p3d_trans(2) * c1 + p3d_trans(1) * c2);
+        J_r[0](1) = sqrt_lambda_img * (p3d_trans(2) * c0 - p3d_trans(0) * c2);
+        J_r[0](2) = sqrt_lambda_img * (-p3d_trans(1) * c0 + p3d_trans(0) * c1);
+        J_r[0](3) = sqrt_lambda_img * (c0);
+        J_r[0](4) = sqrt_lambda_img * (c1);
+        J_r[0](5) = sqrt_lambda_img * (c2);
+        double r_photo = sqrt_lambda_img * diff_photo;
+        r[0] = r_photo;
+
+        J_r[1](0) = sqrt_lamba_dep *
+                    ((-p3d_trans(2) * d1 + p3d_trans(1) * d2) - p3d_trans(1));
+        J_r[1](1) = sqrt_lamba_dep *
+                    ((p3d_trans(2) * d0 - p3d_trans(0) * d2) + p3d_trans(0));
+        J_r[1](2) = sqrt_lamba_dep * ((-p3d_trans(1) * d0 + p3d_trans(0) * d1));
+        J_r[1](3) = sqrt_lamba_dep * (d0);
+        J_r[1](4) = sqrt_lamba_dep * (d1);
+        J_r[1](5) = sqrt_lamba_dep * (d2 - 1.0f);
+        double r_geo = sqrt_lamba_dep * diff_geo;
+        r[1] = r_geo;
+    }
 };
 
 }  // namespace odometry
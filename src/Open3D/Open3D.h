@@ -33,15 +33,18 @@
 #include "Open3D/Camera/PinholeCameraTrajectory.h"
 #include "Open3D/ColorMap/ColorMapOptimization.h"
 #include "Open3D/ColorMap/ImageWarpingField.h"
+#include "Open3D/Geometry/CompactPointCloud.h"
 #include "Open3D/Geometry/Geometry.h"
 #include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/ImagePool.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/LineSet.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Geometry/VoxelGrid.h"
+#include "Open3D/IO/ClassIO/CompactPointCloudIO.h"
 #include "Open3D/IO/ClassIO/FeatureIO.h"
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/IO/ClassIO/ImageIO.h"
@@ -37,108 +37,7 @@
 
 namespace open3d {
 
-namespace {
-using namespace registration;
-
-class PointCloudForColoredICP : public geometry::PointCloud {
-public:
-    std::vector<Eigen::Vector3d> color_gradient_;
-};
-
-class TransformationEstimationForColoredICP : public TransformationEstimation {
-public:
-    TransformationEstimationType GetTransformationEstimationType()
-            const override {
-        return type_;
-    };
-    TransformationEstimationForColoredICP(double lambda_geometric = 0.968)
-        : lambda_geometric_(lambda_geometric) {
-        if (lambda_geometric_ < 0 || lambda_geometric_ > 1.0)
-            lambda_geometric_ = 0.968;
-    }
-    ~TransformationEstimationForColoredICP() override {}
-
-public:
-    double ComputeRMSE(const geometry::PointCloud &source,
-                       const geometry::PointCloud &target,
-                       const CorrespondenceSet &corres) const override;
-    Eigen::Matrix4d ComputeTransformation(
-            const geometry::PointCloud &source,
-            const geometry::PointCloud &target,
-            const CorrespondenceSet &corres) const override;
-
-public:
-    double lambda_geometric_;
-
-private:
-    const TransformationEstimationType type_ =
-            TransformationEstimationType::ColoredICP;
-};
-
-std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
-        const geometry::PointCloud &target,
-        const geometry::KDTreeSearchParamHybrid &search_param) {
-    utility::PrintDebug("InitializePointCloudForColoredICP\n");
-
-    geometry::KDTreeFlann tree;
-    tree.SetGeometry(target);
-
-    auto output = std::make_shared<PointCloudForColoredICP>();
-    output->colors_ = target.colors_;
-    output->normals_ = target.normals_;
-    output->points_ = target.points_;
-
-    size_t n_points = output->points_.size();
-    output->color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
-
-    for (auto k = 0; k < n_points; k++) {
-        const Eigen::Vector3d &vt = output->points_[k];
-        const Eigen::Vector3d &nt = output->normals_[k];
-        double it = (output->colors_[k](0) + output->colors_[k](1) +
-                     output->colors_[k](2)) /
-                    3.0;
-
-        std::vector<int> point_idx;
-        std::vector<double> point_squared_distance;
-
-        if (tree.SearchHybrid(vt, search_param.radius_, search_param.max_nn_,
-                              point_idx, point_squared_distance) >= 3) {
-            // approximate image gradient of vt's tangential plane
-            size_t nn = point_idx.size();
-            Eigen::MatrixXd A(nn, 3);
-            Eigen::MatrixXd b(nn, 1);
-            A.setZero();
-            b.setZero();
-            for (auto i = 1; i < nn; i++) {
-                int P_adj_idx = point_idx[i];
-                Eigen::Vector3d vt_adj = output->points_[P_adj_idx];
-                Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
-                double it_adj = (output->colors_[P_adj_idx](0) +
-                                 output->colors_[P_adj_idx](1) +
-                                 output->colors_[P_adj_idx](2)) /
-                                3.0;
-                A(i - 1, 0) = (vt_proj(0) - vt(0));
-                A(i - 1, 1) = (vt_proj(1) - vt(1));
-                A(i - 1, 2) = (vt_proj(2) - vt(2));
-                b(i - 1, 0) = (it_adj - it);
-            }
-            // adds orthogonal constraint
-            A(nn - 1, 0) = (nn - 1) * nt(0);
-            A(nn - 1, 1) = (nn - 1) * nt(1);
-            A(nn - 1, 2) = (nn - 1) * nt(2);
-            b(nn - 1, 0) = 0;
-            // solving linear equation
-            bool is_success;
-            Eigen::MatrixXd x;
-            std::tie(is_success, x) = utility::SolveLinearSystemPSD(
-                    A.transpose() * A, A.transpose() * b);
-            if (is_success) {
-                output->color_gradient_[k] = x;
-            }
-        }
-    }
-    return output;
-}
+namespace registration {
 
 Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
         const geometry::PointCloud &source,
@@ -152,8 +51,6 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
     double lambda_photometric = 1.0 - lambda_geometric_;
     double sqrt_lambda_photometric = sqrt(lambda_photometric);
 
-    const auto &target_c = (const PointCloudForColoredICP &)target;
-
     auto compute_jacobian_and_residual =
             [&](int i,
                 std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
@@ -179,7 +76,7 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
                 double it = (target.colors_[ct](0) + target.colors_[ct](1) +
                              target.colors_[ct](2)) /
                             3.0;
-                const Eigen::Vector3d &dit = target_c.color_gradient_[ct];
+                const Eigen::Vector3d &dit = target_color_gradients_[ct];
                 double is0_proj = (dit.dot(vs_proj - vt)) + it;
 
                 const Eigen::Matrix3d M =
@@ -218,7 +115,6 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
     double sqrt_lambda_geometric = sqrt(lambda_geometric_);
     double lambda_photometric = 1.0 - lambda_geometric_;
     double sqrt_lambda_photometric = sqrt(lambda_photometric);
-    const auto &target_c = (const PointCloudForColoredICP &)target;
 
     double residual = 0.0;
     for (size_t i = 0; i < corres.size(); i++) {
@@ -234,7 +130,7 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
         double it = (target.colors_[ct](0) + target.colors_[ct](1) +
                      target.colors_[ct](2)) /
                     3.0;
-        const Eigen::Vector3d &dit = target_c.color_gradient_[ct];
+        const Eigen::Vector3d &dit = target_color_gradients_[ct];
         double is0_proj = (dit.dot(vs_proj - vt)) + it;
         double residual_geometric = sqrt_lambda_geometric * (vs - vt).dot(nt);
         double residual_photometric = sqrt_lambda_photometric * (is - is0_proj);
@@ -242,24 +138,98 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
                     residual_photometric * residual_photometric;
     }
     return residual;
-};
+}
 
-}  // unnamed namespace
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
+        double lambda_geometric /* = 0.968*/) {
+    auto target_color_gradients = ComputeColorGradients(
+            target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+    return RegistrationColoredICP(source, target, target_color_gradients,
+                                  max_distance, init, criteria,
+                                  lambda_geometric);
+}
 
-namespace registration {
+std::vector<Eigen::Vector3d> ComputeColorGradients(
+        const geometry::PointCloud &target,
+        const geometry::KDTreeSearchParamHybrid &search_param) {
+    utility::PrintDebug("ComputeColorGradients\n");
+
+    size_t n_points = target.points_.size();
+    std::vector<Eigen::Vector3d> color_gradients(n_points,
+                                                 Eigen::Vector3d::Zero());
+    if (target.HasNormals() == false || target.HasColors() == false) {
+        utility::PrintDebug(
+                "[ComputeColorGradients] Failed because target point cloud "
+                "has no normal or color.\n");
+        return color_gradients;
+    }
+
+    geometry::KDTreeFlann tree;
+    tree.SetGeometry(target);
+    geometry::KDTreeSearchResult neighbors;
+    tree.SearchBatch(target.points_, search_param, neighbors);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < (int)n_points; k++) {
+        int nn = neighbors.GetNeighborCount(k);
+        if (nn < 3) {
+            continue;
+        }
+        const Eigen::Vector3d &vt = target.points_[k];
+        const Eigen::Vector3d &nt = target.normals_[k];
+        double it = (target.colors_[k](0) + target.colors_[k](1) +
+                     target.colors_[k](2)) /
+                    3.0;
+        // approximate image gradient of vt's tangential plane by least
+        // squares, accumulating the 3x3 normal equations row by row
+        const int *point_idx = neighbors.GetIndices(k);
+        Eigen::Matrix3d ATA = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d ATb = Eigen::Vector3d::Zero();
+        for (int i = 1; i < nn; i++) {
+            int P_adj_idx = point_idx[i];
+            const Eigen::Vector3d &vt_adj = target.points_[P_adj_idx];
+            Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
+            double it_adj = (target.colors_[P_adj_idx](0) +
+                             target.colors_[P_adj_idx](1) +
+                             target.colors_[P_adj_idx](2)) /
+                            3.0;
+            Eigen::Vector3d a = vt_proj - vt;
+            ATA.noalias() += a * a.transpose();
+            ATb += a * (it_adj - it);
+        }
+        // adds orthogonal constraint
+        Eigen::Vector3d a = (nn - 1) * nt;
+        ATA.noalias() += a * a.transpose();
+        color_gradients[k] = ATA.ldlt().solve(ATb);
+    }
+    return color_gradients;
+}
 
 RegistrationResult RegistrationColoredICP(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
+        const std::vector<Eigen::Vector3d> &target_color_gradients,
         double max_distance,
         const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
         const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
         double lambda_geometric /* = 0.968*/) {
-    auto target_c = InitializePointCloudForColoredICP(
-            target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
-    return RegistrationICP(
-            source, *target_c, max_distance, init,
-            TransformationEstimationForColoredICP(lambda_geometric), criteria);
+    if (target_color_gradients.size() != target.points_.size()) {
+        utility::PrintError(
+                "Error: target_color_gradients does not match the target "
+                "point cloud.\n");
+        return RegistrationResult(init);
+    }
+    return RegistrationICP(source, target, max_distance, init,
+                           TransformationEstimationForColoredICP(
+                                   target_color_gradients, lambda_geometric),
+                           criteria);
 }
 
 }  // namespace registration
@@ -27,7 +27,9 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <vector>
 
+#include "Open3D/Geometry/KDTreeSearchParam.h"
 #include "Open3D/Registration/Registration.h"
 
 namespace open3d {
@@ -39,6 +41,44 @@ class PointCloud;
 namespace registration {
 class RegistrationResult;
 
+/// Estimate a transformation for colored ICP, combining the point to plane
+/// distance with the color difference on the tangent plane of the target.
+/// \param target_color_gradients are the color gradients of the target
+/// computed by ComputeColorGradients, which must outlive the estimation.
+class TransformationEstimationForColoredICP : public TransformationEstimation {
+public:
+    TransformationEstimationForColoredICP(
+            const std::vector<Eigen::Vector3d> &target_color_gradients,
+            double lambda_geometric = 0.968)
+        : target_color_gradients_(target_color_gradients),
+          lambda_geometric_(lambda_geometric) {
+        if (lambda_geometric_ < 0 || lambda_geometric_ > 1.0)
+            lambda_geometric_ = 0.968;
+    }
+    ~TransformationEstimationForColoredICP() override {}
+
+public:
+    TransformationEstimationType GetTransformationEstimationType()
+            const override {
+        return type_;
+    };
+    double ComputeRMSE(const geometry::PointCloud &source,
+                       const geometry::PointCloud &target,
+                       const CorrespondenceSet &corres) const override;
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres) const override;
+
+public:
+    const std::vector<Eigen::Vector3d> &target_color_gradients_;
+    double lambda_geometric_;
+
+private:
+    const TransformationEstimationType type_ =
+            TransformationEstimationType::ColoredICP;
+};
+
 /// Function to align colored point clouds
 /// This is implementation of following paper
 /// J. Park, Q.-Y. Zhou, V. Koltun,
@@ -51,5 +91,26 @@ RegistrationResult RegistrationColoredICP(
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
         double lambda_geometric = 0.968);
 
+/// Function to compute the color gradient of every point of \param target on
+/// its tangent plane, which is used by the photometric term of colored ICP.
+/// The gradients only depend on the target and \param search_param, so they
+/// can be computed once and reused when registering several sources, or the
+/// same source from several initial poses, against the same target.
+std::vector<Eigen::Vector3d> ComputeColorGradients(
+        const geometry::PointCloud &target,
+        const geometry::KDTreeSearchParamHybrid &search_param);
+
+/// Function to align colored point clouds with color gradients of the target
+/// precomputed by ComputeColorGradients. RegistrationColoredICP above computes
+/// them with KDTreeSearchParamHybrid(max_distance * 2.0, 30).
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const std::vector<Eigen::Vector3d> &target_color_gradients,
+        double max_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
+        double lambda_geometric = 0.968);
+
 }  // namespace registration
 }  // namespace open3d
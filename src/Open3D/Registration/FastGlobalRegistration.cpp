@@ -26,6 +26,7 @@
 
 #include "Open3D/Registration/FastGlobalRegistration.h"
 
+#include <algorithm>
 #include <ctime>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
@@ -34,6 +35,7 @@
 #include "Open3D/Registration/Registration.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 
@@ -42,7 +44,7 @@ using namespace registration;
 
 std::vector<std::pair<int, int>> AdvancedMatching(
         const std::vector<geometry::PointCloud>& point_cloud_vec,
-        const std::vector<Feature>& features_vec,
+        const std::vector<const Feature*>& features_vec,
         const FastGlobalRegistrationOption& option) {
     // STEP 0) Swap source and target if necessary
     int fi = 0, fj = 1;
@@ -57,125 +59,153 @@ std::vector<std::pair<int, int>> AdvancedMatching(
     }
 
     // STEP 1) Initial matching
+    // Every feature of fj is matched to its nearest feature of fi, and every
+    // feature of fi hit that way is matched back to its nearest one of fj.
+    // Both directions are searched as one batch each.
     int nPti = int(point_cloud_vec[fi].points_.size());
     int nPtj = int(point_cloud_vec[fj].points_.size());
-    geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
-    geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
-    std::vector<int> corresK;
-    std::vector<double> dis;
-    std::vector<std::pair<int, int>> corres;
-    std::vector<std::pair<int, int>> corres_ij;
-    std::vector<std::pair<int, int>> corres_ji;
+    if (nPti == 0 || nPtj == 0) {
+        return std::vector<std::pair<int, int>>();
+    }
+    const Eigen::MatrixXd& features_i = features_vec[fi]->data_;
+    const Eigen::MatrixXd& features_j = features_vec[fj]->data_;
+    geometry::KDTreeFlann feature_tree_i(*features_vec[fi]);
+    geometry::KDTreeFlann feature_tree_j(*features_vec[fj]);
+    geometry::KDTreeSearchResult neighbors;
+    std::vector<int> j_to_i(nPtj, -1);
+    feature_tree_i.SearchKNNBatch(features_j, 1, neighbors);
+    for (int j = 0; j < nPtj; j++) {
+        if (neighbors.GetNeighborCount(j) > 0) {
+            j_to_i[j] = neighbors.GetIndices(j)[0];
+        }
+    }
     std::vector<int> i_to_j(nPti, -1);
+    std::vector<int> matched_i;
     for (int j = 0; j < nPtj; j++) {
-        feature_tree_i.SearchKNN(Eigen::VectorXd(features_vec[fj].data_.col(j)),
-                                 1, corresK, dis);
-        int i = corresK[0];
-        if (i_to_j[i] == -1) {
-            feature_tree_j.SearchKNN(
-                    Eigen::VectorXd(features_vec[fi].data_.col(i)), 1, corresK,
-                    dis);
-            int ij = corresK[0];
-            i_to_j[i] = ij;
+        int i = j_to_i[j];
+        if (i != -1 && i_to_j[i] == -1) {
+            i_to_j[i] = nPtj;  // marks i as queued
+            matched_i.push_back(i);
         }
-        corres_ji.push_back(std::pair<int, int>(i, j));
     }
+    Eigen::MatrixXd queries_i(features_i.rows(), matched_i.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < (int)matched_i.size(); k++) {
+        queries_i.col(k) = features_i.col(matched_i[k]);
+    }
+    feature_tree_j.SearchKNNBatch(queries_i, 1, neighbors);
+    for (int k = 0; k < (int)matched_i.size(); k++) {
+        i_to_j[matched_i[k]] = neighbors.GetNeighborCount(k) > 0
+                                       ? neighbors.GetIndices(k)[0]
+                                       : -1;
+    }
+    int ncorres_ij = 0;
     for (int i = 0; i < nPti; i++) {
-        if (i_to_j[i] != -1)
-            corres_ij.push_back(std::pair<int, int>(i, i_to_j[i]));
+        if (i_to_j[i] != -1) ncorres_ij++;
+    }
+    int ncorres_ji = 0;
+    for (int j = 0; j < nPtj; j++) {
+        if (j_to_i[j] != -1) ncorres_ji++;
     }
-    int ncorres_ij = int(corres_ij.size());
-    int ncorres_ji = int(corres_ji.size());
-    for (int i = 0; i < ncorres_ij; ++i)
-        corres.push_back(
-                std::pair<int, int>(corres_ij[i].first, corres_ij[i].second));
-    for (int j = 0; j < ncorres_ji; ++j)
-        corres.push_back(
-                std::pair<int, int>(corres_ji[j].first, corres_ji[j].second));
-    utility::PrintDebug("points are remained : %d\n", (int)corres.size());
+    utility::PrintDebug("points are remained : %d\n", ncorres_ij + ncorres_ji);
 
     // STEP 2) CROSS CHECK
+    // A match of each direction is unique, so (i, j) passes iff i and j are
+    // each other's nearest neighbors.
     utility::PrintDebug("\t[cross check] ");
-    std::vector<std::pair<int, int>> corres_cross;
-    std::vector<std::vector<int>> Mi(nPti), Mj(nPtj);
-    int ci, cj;
-    for (int i = 0; i < ncorres_ij; ++i) {
-        ci = corres_ij[i].first;
-        cj = corres_ij[i].second;
-        Mi[ci].push_back(cj);
-    }
-    for (int j = 0; j < ncorres_ji; ++j) {
-        ci = corres_ji[j].first;
-        cj = corres_ji[j].second;
-        Mj[cj].push_back(ci);
+    std::vector<char> mutual(nPti, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < nPti; ++i) {
+        mutual[i] = i_to_j[i] != -1 && j_to_i[i_to_j[i]] == i;
     }
+    std::vector<std::pair<int, int>> corres_cross;
     for (int i = 0; i < nPti; ++i) {
-        for (int ii = 0; ii < Mi[i].size(); ++ii) {
-            int j = Mi[i][ii];
-            for (int jj = 0; jj < Mj[j].size(); ++jj) {
-                if (Mj[j][jj] == i)
-                    corres_cross.push_back(std::pair<int, int>(i, j));
-            }
+        if (mutual[i]) {
+            corres_cross.push_back(std::pair<int, int>(i, i_to_j[i]));
         }
     }
     utility::PrintDebug("points are remained : %d\n", (int)corres_cross.size());
 
     // STEP 3) TUPLE CONSTRAINT
+    // Trial t draws from its own random stream and the trials are tested in
+    // parallel block by block. The passing tuples are then taken in trial
+    // order, so the result only depends on the seed.
     utility::PrintDebug("\t[tuple constraint] ");
-    std::srand((unsigned int)std::time(0));
-    int rand0, rand1, rand2, i, cnt = 0;
-    int idi0, idi1, idi2, idj0, idj1, idj2;
+    const uint64_t seed = option.seed_ < 0 ? (uint64_t)std::time(0)
+                                            : (uint64_t)option.seed_;
+    int cnt = 0, num_trial = 0;
     double scale = option.tuple_scale_;
     int ncorr = static_cast<int>(corres_cross.size());
     int number_of_trial = ncorr * 100;
+    const int block_size = 1 << 14;
+    std::vector<Eigen::Vector3i> samples(block_size);
+    std::vector<char> passed(block_size);
     std::vector<std::pair<int, int>> corres_tuple;
-    for (i = 0; i < number_of_trial; i++) {
-        rand0 = rand() % ncorr;
-        rand1 = rand() % ncorr;
-        rand2 = rand() % ncorr;
-        idi0 = corres_cross[rand0].first;
-        idj0 = corres_cross[rand0].second;
-        idi1 = corres_cross[rand1].first;
-        idj1 = corres_cross[rand1].second;
-        idi2 = corres_cross[rand2].first;
-        idj2 = corres_cross[rand2].second;
-
-        // collect 3 points from i-th fragment
-        Eigen::Vector3d pti0 = point_cloud_vec[fi].points_[idi0];
-        Eigen::Vector3d pti1 = point_cloud_vec[fi].points_[idi1];
-        Eigen::Vector3d pti2 = point_cloud_vec[fi].points_[idi2];
-        double li0 = (pti0 - pti1).norm();
-        double li1 = (pti1 - pti2).norm();
-        double li2 = (pti2 - pti0).norm();
-
-        // collect 3 points from j-th fragment
-        Eigen::Vector3d ptj0 = point_cloud_vec[fj].points_[idj0];
-        Eigen::Vector3d ptj1 = point_cloud_vec[fj].points_[idj1];
-        Eigen::Vector3d ptj2 = point_cloud_vec[fj].points_[idj2];
-        double lj0 = (ptj0 - ptj1).norm();
-        double lj1 = (ptj1 - ptj2).norm();
-        double lj2 = (ptj2 - ptj0).norm();
-
-        // check tuple constraint
-        if ((li0 * scale < lj0) && (lj0 < li0 / scale) && (li1 * scale < lj1) &&
-            (lj1 < li1 / scale) && (li2 * scale < lj2) && (lj2 < li2 / scale)) {
-            corres_tuple.push_back(std::pair<int, int>(idi0, idj0));
-            corres_tuple.push_back(std::pair<int, int>(idi1, idj1));
-            corres_tuple.push_back(std::pair<int, int>(idi2, idj2));
+    for (int begin = 0;
+         begin < number_of_trial && cnt < option.maximum_tuple_count_;
+         begin += block_size) {
+        const int end = std::min(number_of_trial, begin + block_size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int t = begin; t < end; t++) {
+            utility::RandomStream rand(seed, (uint64_t)t);
+            Eigen::Vector3i& sample = samples[t - begin];
+            sample(0) = rand(ncorr);
+            sample(1) = rand(ncorr);
+            sample(2) = rand(ncorr);
+            int idi0 = corres_cross[sample(0)].first;
+            int idj0 = corres_cross[sample(0)].second;
+            int idi1 = corres_cross[sample(1)].first;
+            int idj1 = corres_cross[sample(1)].second;
+            int idi2 = corres_cross[sample(2)].first;
+            int idj2 = corres_cross[sample(2)].second;
+
+            // collect 3 points from i-th fragment
+            const Eigen::Vector3d& pti0 = point_cloud_vec[fi].points_[idi0];
+            const Eigen::Vector3d& pti1 = point_cloud_vec[fi].points_[idi1];
+            const Eigen::Vector3d& pti2 = point_cloud_vec[fi].points_[idi2];
+            double li0 = (pti0 - pti1).norm();
+            double li1 = (pti1 - pti2).norm();
+            double li2 = (pti2 - pti0).norm();
+
+            // collect 3 points from j-th fragment
+            const Eigen::Vector3d& ptj0 = point_cloud_vec[fj].points_[idj0];
+            const Eigen::Vector3d& ptj1 = point_cloud_vec[fj].points_[idj1];
+            const Eigen::Vector3d& ptj2 = point_cloud_vec[fj].points_[idj2];
+            double lj0 = (ptj0 - ptj1).norm();
+            double lj1 = (ptj1 - ptj2).norm();
+            double lj2 = (ptj2 - ptj0).norm();
+
+            // check tuple constraint
+            passed[t - begin] = (li0 * scale < lj0) && (lj0 < li0 / scale) &&
+                                (li1 * scale < lj1) && (lj1 < li1 / scale) &&
+                                (li2 * scale < lj2) && (lj2 < li2 / scale);
+        }
+        num_trial = end;
+        for (int t = begin; t < end; t++) {
+            if (!passed[t - begin]) continue;
+            for (int k = 0; k < 3; k++) {
+                corres_tuple.push_back(corres_cross[samples[t - begin](k)]);
+            }
             cnt++;
+            if (cnt >= option.maximum_tuple_count_) {
+                num_trial = t + 1;
+                break;
+            }
         }
-        if (cnt >= option.maximum_tuple_count_) break;
     }
     utility::PrintDebug("%d tuples (%d trial, %d actual).\n", cnt,
-                        number_of_trial, i);
+                        number_of_trial, num_trial);
 
     if (swapped) {
-        std::vector<std::pair<int, int>> temp;
-        for (int i = 0; i < corres_tuple.size(); i++)
-            temp.push_back(std::pair<int, int>(corres_tuple[i].second,
-                                               corres_tuple[i].first));
-        corres_tuple.clear();
-        corres_tuple = temp;
+        for (auto& corres : corres_tuple) {
+            std::swap(corres.first, corres.second);
+        }
     }
     utility::PrintDebug("\t[final] matches %d.\n", (int)corres_tuple.size());
     return corres_tuple;
@@ -243,69 +273,59 @@ Eigen::Matrix4d OptimizePairwiseRegistration(
     int numIter = option.iteration_number_;
 
     int i = 0, j = 1;
-    geometry::PointCloud point_cloud_copy_j = point_cloud_vec[j];
-
     if (corres.size() < 10) return Eigen::Matrix4d::Identity();
 
-    std::vector<double> s(corres.size(), 1.0);
+    // Only the matched points take part, so they are gathered once and only
+    // they are moved by each update instead of the whole fragment.
+    const int num_corres = (int)corres.size();
+    std::vector<Eigen::Vector3d> p(num_corres), q(num_corres);
+    for (int c = 0; c < num_corres; c++) {
+        p[c] = point_cloud_vec[i].points_[corres[c].first];
+        q[c] = point_cloud_vec[j].points_[corres[c].second];
+    }
     Eigen::Matrix4d trans;
     trans.setIdentity();
 
     for (int itr = 0; itr < numIter; itr++) {
-        const int nvariable = 6;
-        Eigen::MatrixXd JTJ(nvariable, nvariable);
-        Eigen::MatrixXd JTr(nvariable, 1);
-        Eigen::MatrixXd J(nvariable, 1);
-        JTJ.setZero();
-        JTr.setZero();
-        double r = 0.0, r2 = 0.0;
-
-        for (int c = 0; c < corres.size(); c++) {
-            int ii = corres[c].first;
-            int jj = corres[c].second;
-            Eigen::Vector3d p, q;
-            p = point_cloud_vec[i].points_[ii];
-            q = point_cloud_copy_j.points_[jj];
-            Eigen::Vector3d rpq = p - q;
-
-            int c2 = c;
-            double temp = par / (rpq.dot(rpq) + par);
-            s[c2] = temp * temp;
-
-            J.setZero();
-            J(1) = -q(2);
-            J(2) = q(1);
-            J(3) = -1;
-            r = rpq(0);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-
-            J.setZero();
-            J(2) = -q(0);
-            J(0) = q(2);
-            J(4) = -1;
-            r = rpq(1);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-
-            J.setZero();
-            J(0) = -q(1);
-            J(1) = q(0);
-            J(5) = -1;
-            r = rpq(2);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-            r2 += (par * (1.0 - sqrt(s[c2])) * (1.0 - sqrt(s[c2])));
-        }
+        // Each correspondence gives three rows weighted by the Geman-McClure
+        // weight s, folded in as sqrt(s) so that JTJ and JTr accumulate
+        // J * J^T * s and J * r * s.
+        auto compute_jacobian_and_residual =
+                [&](int c, std::vector<Eigen::Vector6d,
+                                       utility::Vector6d_allocator>& J_r,
+                    std::vector<double>& r) {
+                    Eigen::Vector3d rpq = p[c] - q[c];
+                    double temp = par / (rpq.dot(rpq) + par);
+                    double w = temp;  // sqrt(s) where s = temp * temp
+                    J_r.resize(3);
+                    r.resize(3);
+                    J_r[0] << 0.0, -q[c](2), q[c](1), -1.0, 0.0, 0.0;
+                    J_r[1] << q[c](2), 0.0, -q[c](0), 0.0, -1.0, 0.0;
+                    J_r[2] << -q[c](1), q[c](0), 0.0, 0.0, 0.0, -1.0;
+                    for (int k = 0; k < 3; k++) {
+                        J_r[k] *= w;
+                        r[k] = rpq(k) * w;
+                    }
+                };
+        Eigen::Matrix6d JTJ;
+        Eigen::Vector6d JTr;
+        double r2;
+        std::tie(JTJ, JTr, r2) =
+                utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                        compute_jacobian_and_residual, num_corres, false);
         bool success;
         Eigen::VectorXd result;
         std::tie(success, result) = utility::SolveLinearSystemPSD(-JTJ, JTr);
         Eigen::Matrix4d delta = utility::TransformVector6dToMatrix4d(result);
         trans = delta * trans;
-        point_cloud_copy_j.Transform(delta);
+        const Eigen::Matrix3d R = delta.block<3, 3>(0, 0);
+        const Eigen::Vector3d t = delta.block<3, 1>(0, 3);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < num_corres; c++) {
+            q[c] = R * q[c] + t;
+        }
 
         // graduated non-convexity.
         if (option.decrease_mu_) {
@@ -343,13 +363,14 @@ RegistrationResult FastGlobalRegistration(
         const Feature& target_feature,
         const FastGlobalRegistrationOption& option /* =
         FastGlobalRegistrationOption()*/) {
-    std::vector<geometry::PointCloud> point_cloud_vec;
-    point_cloud_vec.push_back(source);
-    point_cloud_vec.push_back(target);
-
-    std::vector<Feature> features_vec;
-    features_vec.push_back(source_feature);
-    features_vec.push_back(target_feature);
+    // Only the points are normalized, so the features and the other point
+    // attributes are not copied.
+    std::vector<geometry::PointCloud> point_cloud_vec(2);
+    point_cloud_vec[0].points_ = source.points_;
+    point_cloud_vec[1].points_ = target.points_;
+
+    std::vector<const Feature*> features_vec = {&source_feature,
+                                                &target_feature};
 
     double scale_global, scale_start;
     std::vector<Eigen::Vector3d> pcd_mean_vec;
@@ -47,119 +47,161 @@ Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
     if (result(3) == 0.0) {
         return Eigen::Vector4d::Zero();
     }
-    auto n1_copy = n1;
-    auto n2_copy = n2;
-    double angle1 = n1_copy.dot(dp2p1) / result(3);
-    double angle2 = n2_copy.dot(dp2p1) / result(3);
-    if (acos(fabs(angle1)) > acos(fabs(angle2))) {
-        n1_copy = n2;
-        n2_copy = n1;
+    const Eigen::Vector3d *source_normal = &n1;
+    const Eigen::Vector3d *target_normal = &n2;
+    double angle1 = n1.dot(dp2p1) / result(3);
+    double angle2 = n2.dot(dp2p1) / result(3);
+    // acos is decreasing, so the angles are compared through their cosines.
+    if (fabs(angle1) < fabs(angle2)) {
+        source_normal = &n2;
+        target_normal = &n1;
         dp2p1 *= -1.0;
         result(2) = -angle2;
     } else {
         result(2) = angle1;
     }
-    auto v = dp2p1.cross(n1_copy);
+    Eigen::Vector3d v = dp2p1.cross(*source_normal);
     double v_norm = v.norm();
     if (v_norm == 0.0) {
         return Eigen::Vector4d::Zero();
     }
     v /= v_norm;
-    auto w = n1_copy.cross(v);
-    result(1) = v.dot(n2_copy);
-    result(0) = atan2(w.dot(n2_copy), n1_copy.dot(n2_copy));
+    Eigen::Vector3d w = source_normal->cross(v);
+    result(1) = v.dot(*target_normal);
+    result(0) = atan2(w.dot(*target_normal),
+                      source_normal->dot(*target_normal));
     return result;
 }
 
-std::shared_ptr<Feature> ComputeSPFHFeature(
-        const geometry::PointCloud &input,
-        const geometry::KDTreeFlann &kdtree,
-        const geometry::KDTreeSearchParam &search_param) {
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, (int)input.points_.size());
+int HistogramBin(double value) {
+    int h_index = (int)(floor(value));
+    if (h_index < 0) h_index = 0;
+    if (h_index >= 11) h_index = 10;
+    return h_index;
+}
+
+/// Computes the SPFH of every point into the columns of \param spfh, which is
+/// an Eigen::MatrixXd or an Eigen::MatrixXf. Each histogram is accumulated in
+/// double precision and stored once.
+template <typename MatrixType>
+void ComputeSPFHFeature(const geometry::PointCloud &input,
+                        const geometry::KDTreeSearchResult &neighbors,
+                        MatrixType &spfh) {
+    spfh.setZero(33, (int)input.points_.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)input.points_.size(); i++) {
         const auto &point = input.points_[i];
         const auto &normal = input.normals_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
+        const int *indices = neighbors.GetIndices(i);
+        int num_neighbors = neighbors.GetNeighborCount(i);
+        if (num_neighbors > 1) {
             // only compute SPFH feature when a point has neighbors
-            double hist_incr = 100.0 / (double)(indices.size() - 1);
-            for (size_t k = 1; k < indices.size(); k++) {
+            double histogram[33] = {0.0};
+            double hist_incr = 100.0 / (double)(num_neighbors - 1);
+            for (int k = 1; k < num_neighbors; k++) {
                 // skip the point itself, compute histogram
                 auto pf = ComputePairFeatures(point, normal,
                                               input.points_[indices[k]],
                                               input.normals_[indices[k]]);
-                int h_index = (int)(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(1) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 11, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(2) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 22, i) += hist_incr;
+                histogram[HistogramBin(11 * (pf(0) + M_PI) / (2.0 * M_PI))] +=
+                        hist_incr;
+                histogram[HistogramBin(11 * (pf(1) + 1.0) * 0.5) + 11] +=
+                        hist_incr;
+                histogram[HistogramBin(11 * (pf(2) + 1.0) * 0.5) + 22] +=
+                        hist_incr;
+            }
+            for (int j = 0; j < 33; j++) {
+                spfh(j, i) = histogram[j];
             }
         }
     }
-    return feature;
 }
 
-}  // unnamed namespace
-
-namespace registration {
-std::shared_ptr<Feature> ComputeFPFHFeature(
-        const geometry::PointCloud &input,
-        const geometry::KDTreeSearchParam
-                &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, (int)input.points_.size());
-    if (input.HasNormals() == false) {
-        utility::PrintDebug(
-                "[ComputeFPFHFeature] Failed because input point cloud has no "
-                "normal.\n");
-        return feature;
-    }
+/// Computes the FPFH of every point of \param input into the columns of
+/// \param fpfh. The neighborhoods are searched once and shared by the SPFH
+/// and the weighting pass.
+template <typename MatrixType>
+void ComputeFPFHHistograms(const geometry::PointCloud &input,
+                           const geometry::KDTreeSearchParam &search_param,
+                           MatrixType &fpfh) {
     geometry::KDTreeFlann kdtree(input);
-    auto spfh = ComputeSPFHFeature(input, kdtree, search_param);
+    geometry::KDTreeSearchResult neighbors;
+    kdtree.SearchBatch(input.points_, search_param, neighbors);
+    MatrixType spfh;
+    ComputeSPFHFeature(input, neighbors, spfh);
+    fpfh.setZero(33, (int)input.points_.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
+        const int *indices = neighbors.GetIndices(i);
+        const double *distance2 = neighbors.GetDistance2(i);
+        int num_neighbors = neighbors.GetNeighborCount(i);
+        if (num_neighbors > 1) {
+            double histogram[33] = {0.0};
             double sum[3] = {0.0, 0.0, 0.0};
-            for (size_t k = 1; k < indices.size(); k++) {
+            for (int k = 1; k < num_neighbors; k++) {
                 // skip the point itself
                 double dist = distance2[k];
                 if (dist == 0.0) continue;
-                for (int j = 0; j < 33; j++) {
-                    double val = spfh->data_(j, indices[k]) / dist;
-                    sum[j / 11] += val;
-                    feature->data_(j, i) += val;
+                const auto *neighbor_spfh =
+                        spfh.data() + (size_t)indices[k] * 33;
+                for (int b = 0; b < 3; b++) {
+                    for (int j = b * 11; j < b * 11 + 11; j++) {
+                        double val = neighbor_spfh[j] / dist;
+                        sum[b] += val;
+                        histogram[j] += val;
+                    }
                 }
             }
             for (int j = 0; j < 3; j++)
                 if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
             for (int j = 0; j < 33; j++) {
-                feature->data_(j, i) *= sum[j / 11];
                 // The commented line is the fpfh function in the paper.
                 // But according to PCL implementation, it is skipped.
                 // Our initial test shows that the full fpfh function in the
                 // paper seems to be better than PCL implementation. Further
                 // test required.
-                feature->data_(j, i) += spfh->data_(j, i);
+                fpfh(j, i) = histogram[j] * sum[j / 11] + spfh(j, i);
             }
         }
     }
+}
+
+}  // unnamed namespace
+
+namespace registration {
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam
+                &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
+    auto feature = std::make_shared<Feature>();
+    feature->Resize(33, (int)input.points_.size());
+    if (input.HasNormals() == false) {
+        utility::PrintDebug(
+                "[ComputeFPFHFeature] Failed because input point cloud has no "
+                "normal.\n");
+        return feature;
+    }
+    ComputeFPFHHistograms(input, search_param, feature->data_);
+    return feature;
+}
+
+std::shared_ptr<CompactFeature> ComputeCompactFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam
+                &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
+    auto feature = std::make_shared<CompactFeature>();
+    feature->Resize(33, (int)input.points_.size());
+    if (input.HasNormals() == false) {
+        utility::PrintDebug(
+                "[ComputeCompactFPFHFeature] Failed because input point cloud "
+                "has no normal.\n");
+        return feature;
+    }
+    ComputeFPFHHistograms(input, search_param, feature->data_);
     return feature;
 }
 
@@ -53,11 +53,46 @@ public:
     Eigen::MatrixXd data_;
 };
 
+/// Feature stored in float32, which takes half the memory of Feature. It is
+/// indexed by KDTreeFlann without being converted to double.
+class CompactFeature {
+public:
+    CompactFeature() {}
+    explicit CompactFeature(const Feature &feature)
+        : data_(feature.data_.cast<float>()) {}
+
+public:
+    void Resize(int dim, int n) {
+        data_.resize(dim, n);
+        data_.setZero();
+    }
+    size_t Dimension() const { return data_.rows(); }
+    size_t Num() const { return data_.cols(); }
+
+    /// Converts to a Feature with double precision data.
+    std::shared_ptr<Feature> ToFeature() const {
+        auto feature = std::make_shared<Feature>();
+        feature->data_ = data_.cast<double>();
+        return feature;
+    }
+
+public:
+    Eigen::MatrixXf data_;
+};
+
 /// Function to compute FPFH feature for a point cloud
 std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::PointCloud &input,
         const geometry::KDTreeSearchParam &search_param =
                 geometry::KDTreeSearchParamKNN());
 
+/// Function to compute FPFH feature for a point cloud, same as
+/// ComputeFPFHFeature but with the histograms stored in float32. The
+/// histograms are still accumulated in double precision.
+std::shared_ptr<CompactFeature> ComputeCompactFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam &search_param =
+                geometry::KDTreeSearchParamKNN());
+
 }  // namespace registration
 }  // namespace open3d
@@ -28,6 +28,9 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <algorithm>
+#include <array>
+#include <map>
 #include <tuple>
 #include <vector>
 
@@ -278,48 +281,158 @@ Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
 /// https ://github.com/RainerKuemmerle/g2o/blob/master/doc/g2o.pdf
 /// Eq (20) and Eq (21). (There is a typo in the equation though. B should be J)
 ///
-/// This function focuses the case that every edge has two nodes (not hyper
-/// graph) so we have two Jacobian matrices from one constraint.
-std::tuple<Eigen::MatrixXd, Eigen::VectorXd> ComputeLinearSystem(
-        const PoseGraph &pose_graph, const Eigen::VectorXd &zeta) {
-    int n_nodes = (int)pose_graph.nodes_.size();
-    int n_edges = (int)pose_graph.edges_.size();
-    Eigen::MatrixXd H(n_nodes * 6, n_nodes * 6);
-    Eigen::VectorXd b(n_nodes * 6);
-    H.setZero();
-    b.setZero();
+/// This class focuses the case that every edge has two nodes (not hyper
+/// graph) so we have two Jacobian matrices from one constraint. H is stored as
+/// a sparse matrix made of 6x6 blocks: one diagonal block per node and two
+/// off-diagonal blocks per connected node pair. The sparsity pattern only
+/// depends on the edges, so it is built once per optimization. Every
+/// iteration refills the values in place, and the symbolic analysis of the
+/// sparse Cholesky factorization is shared by all Gauss-Newton/LM steps.
+class PoseGraphLinearSystem {
+public:
+    PoseGraphLinearSystem(const PoseGraph &pose_graph) {
+        int n_nodes = (int)pose_graph.nodes_.size();
+        int n_edges = (int)pose_graph.edges_.size();
+        std::map<std::pair<int, int>, int> block_ids;
+        for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+            block_ids[std::make_pair(iter_node, iter_node)] = iter_node;
+        }
+        auto get_block_id = [&block_ids](int i, int j) {
+            auto inserted = block_ids.insert(std::make_pair(
+                    std::make_pair(i, j), (int)block_ids.size()));
+            return inserted.first->second;
+        };
+        edge_blocks_.resize(n_edges);
+        for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+            const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+            int i = t.source_node_id_;
+            int j = t.target_node_id_;
+            edge_blocks_[iter_edge] = {get_block_id(i, i), get_block_id(i, j),
+                                       get_block_id(j, i), get_block_id(j, j)};
+        }
 
-    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
-        const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
-        Eigen::Vector6d e = zeta.block<6, 1>(iter_edge * 6, 0);
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(block_ids.size() * 36);
+        for (const auto &block : block_ids) {
+            for (int c = 0; c < 6; c++) {
+                for (int r = 0; r < 6; r++) {
+                    triplets.push_back(Eigen::Triplet<double>(
+                            block.first.first * 6 + r,
+                            block.first.second * 6 + c, 0.0));
+                }
+            }
+        }
+        H_.resize(n_nodes * 6, n_nodes * 6);
+        H_.setFromTriplets(triplets.begin(), triplets.end());
+        H_.makeCompressed();
+        b_.resize(n_nodes * 6);
+
+        // Rows of a block are contiguous within each of its columns.
+        block_offsets_.resize(block_ids.size());
+        for (const auto &block : block_ids) {
+            for (int c = 0; c < 6; c++) {
+                int col = block.first.second * 6 + c;
+                const int *begin = H_.innerIndexPtr() + H_.outerIndexPtr()[col];
+                const int *end =
+                        H_.innerIndexPtr() + H_.outerIndexPtr()[col + 1];
+                block_offsets_[block.second][c] = (int)(
+                        std::lower_bound(begin, end, block.first.first * 6) -
+                        H_.innerIndexPtr());
+            }
+        }
+    }
 
-        Eigen::Matrix4d X_inv, Ts, Tt_inv;
-        std::tie(X_inv, Ts, Tt_inv) = GetRelativePoses(pose_graph, iter_edge);
+public:
+    void Compute(const PoseGraph &pose_graph, const Eigen::VectorXd &zeta) {
+        int n_edges = (int)pose_graph.edges_.size();
+        std::fill(H_.valuePtr(), H_.valuePtr() + H_.nonZeros(), 0.0);
+        b_.setZero();
+
+        for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+            const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+            Eigen::Vector6d e = zeta.block<6, 1>(iter_edge * 6, 0);
 
-        Eigen::Matrix6d Js, Jt;
-        std::tie(Js, Jt) = GetJacobian(X_inv, Ts, Tt_inv);
-        Eigen::Matrix6d JsT_Info = Js.transpose() * t.information_;
-        Eigen::Matrix6d JtT_Info = Jt.transpose() * t.information_;
-        Eigen::Vector6d eT_Info = e.transpose() * t.information_;
-        double line_process_iter = t.confidence_;
-
-        int id_i = t.source_node_id_ * 6;
-        int id_j = t.target_node_id_ * 6;
-        H.block<6, 6>(id_i, id_i).noalias() +=
-                line_process_iter * JsT_Info * Js;
-        H.block<6, 6>(id_i, id_j).noalias() +=
-                line_process_iter * JsT_Info * Jt;
-        H.block<6, 6>(id_j, id_i).noalias() +=
-                line_process_iter * JtT_Info * Js;
-        H.block<6, 6>(id_j, id_j).noalias() +=
-                line_process_iter * JtT_Info * Jt;
-        b.block<6, 1>(id_i, 0).noalias() -=
-                line_process_iter * eT_Info.transpose() * Js;
-        b.block<6, 1>(id_j, 0).noalias() -=
-                line_process_iter * eT_Info.transpose() * Jt;
+            Eigen::Matrix4d X_inv, Ts, Tt_inv;
+            std::tie(X_inv, Ts, Tt_inv) =
+                    GetRelativePoses(pose_graph, iter_edge);
+
+            Eigen::Matrix6d Js, Jt;
+            std::tie(Js, Jt) = GetJacobian(X_inv, Ts, Tt_inv);
+            Eigen::Matrix6d JsT_Info = Js.transpose() * t.information_;
+            Eigen::Matrix6d JtT_Info = Jt.transpose() * t.information_;
+            Eigen::Vector6d eT_Info = e.transpose() * t.information_;
+            double line_process_iter = t.confidence_;
+
+            const auto &blocks = edge_blocks_[iter_edge];
+            AddToBlock(blocks[0], line_process_iter * JsT_Info * Js);
+            AddToBlock(blocks[1], line_process_iter * JsT_Info * Jt);
+            AddToBlock(blocks[2], line_process_iter * JtT_Info * Js);
+            AddToBlock(blocks[3], line_process_iter * JtT_Info * Jt);
+            int id_i = t.source_node_id_ * 6;
+            int id_j = t.target_node_id_ * 6;
+            b_.block<6, 1>(id_i, 0).noalias() -=
+                    line_process_iter * eT_Info.transpose() * Js;
+            b_.block<6, 1>(id_j, 0).noalias() -=
+                    line_process_iter * eT_Info.transpose() * Jt;
+        }
     }
-    return std::make_tuple(std::move(H), std::move(b));
-}
+
+    /// Solves (H + lambda * I) @ delta == b.
+    std::tuple<bool, Eigen::VectorXd> Solve(double lambda = 0.0) {
+        H_LM_ = H_;
+        if (lambda != 0.0) {
+            int n_nodes = (int)(H_.cols() / 6);
+            for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+                for (int c = 0; c < 6; c++) {
+                    H_LM_.valuePtr()[block_offsets_[iter_node][c] + c] +=
+                            lambda;
+                }
+            }
+        }
+        if (!analyzed_) {
+            solver_.analyzePattern(H_LM_);
+            analyzed_ = true;
+        }
+        solver_.factorize(H_LM_);
+        if (solver_.info() == Eigen::Success) {
+            Eigen::VectorXd delta = solver_.solve(b_);
+            if (solver_.info() == Eigen::Success) {
+                return std::make_tuple(true, std::move(delta));
+            }
+            utility::PrintInfo(
+                    "Cholesky solve failed, switched to dense solver\n");
+        } else {
+            utility::PrintInfo(
+                    "Cholesky decompose failed, switched to dense solver\n");
+        }
+        Eigen::VectorXd delta = Eigen::MatrixXd(H_LM_).ldlt().solve(b_);
+        return std::make_tuple(true, std::move(delta));
+    }
+
+private:
+    void AddToBlock(int block_id, const Eigen::Matrix6d &value) {
+        double *values = H_.valuePtr();
+        for (int c = 0; c < 6; c++) {
+            for (int r = 0; r < 6; r++) {
+                values[block_offsets_[block_id][c] + r] += value(r, c);
+            }
+        }
+    }
+
+public:
+    Eigen::SparseMatrix<double> H_;
+    Eigen::VectorXd b_;
+
+private:
+    /// For every 6x6 block, the position in H_.valuePtr() of its first row
+    /// in each of its six columns. Blocks 0 .. n_nodes - 1 are the diagonal.
+    std::vector<std::array<int, 6>> block_offsets_;
+    /// Blocks (i, i), (i, j), (j, i) and (j, j) touched by every edge.
+    std::vector<std::array<int, 4>> edge_blocks_;
+    Eigen::SparseMatrix<double> H_LM_;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver_;
+    bool analyzed_ = false;
+};
 
 Eigen::VectorXd UpdatePoseVector(const PoseGraph &pose_graph) {
     int n_nodes = (int)pose_graph.nodes_.size();
@@ -586,16 +699,15 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
     valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H;
-    Eigen::VectorXd b;
+    PoseGraphLinearSystem linear_system(pose_graph);
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    linear_system.Compute(pose_graph, zeta);
 
     utility::PrintDebug("[Initial     ] residual : %e\n", current_residual);
 
     bool stop = false;
-    if (stop || CheckRightTerm(b, criteria)) return;
+    if (stop || CheckRightTerm(linear_system.b_, criteria)) return;
 
     utility::Timer timer_overall;
     timer_overall.Start();
@@ -604,13 +716,11 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
         utility::Timer timer_iter;
         timer_iter.Start();
 
-        Eigen::VectorXd delta(H.cols());
+        Eigen::VectorXd delta;
         bool solver_success = false;
 
-        // Solve H_LM @ delta == b using a sparse solver
-        std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                H, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                /*check_det=*/false, /*check_psd=*/false);
+        // Solve H @ delta == b using a sparse solver
+        std::tie(solver_success, delta) = linear_system.Solve();
 
         stop = stop || CheckRelativeIncrement(delta, x, criteria);
         if (stop) {
@@ -633,9 +743,9 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
             x = UpdatePoseVector(pose_graph);
             valid_edges_num = UpdateConfidence(pose_graph, zeta,
                                                line_process_weight, option);
-            std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+            linear_system.Compute(pose_graph, zeta);
 
-            stop = stop || CheckRightTerm(b, criteria);
+            stop = stop || CheckRightTerm(linear_system.b_, criteria);
             if (stop) break;
         }
         timer_iter.Stop();
@@ -676,14 +786,13 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
     int valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H_I = Eigen::MatrixXd::Identity(n_nodes * 6, n_nodes * 6);
-    Eigen::MatrixXd H;
-    Eigen::VectorXd b;
+    PoseGraphLinearSystem linear_system(pose_graph);
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    linear_system.Compute(pose_graph, zeta);
+    const Eigen::VectorXd &b = linear_system.b_;
 
-    Eigen::VectorXd H_diag = H.diagonal();
+    Eigen::VectorXd H_diag = linear_system.H_.diagonal();
     double tau = 1e-5;
     double current_lambda = tau * H_diag.maxCoeff();
     double ni = 2.0;
@@ -703,14 +812,13 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
         timer_iter.Start();
         int lm_count = 0;
         do {
-            Eigen::MatrixXd H_LM = H + current_lambda * H_I;
-            Eigen::VectorXd delta(H_LM.cols());
+            Eigen::VectorXd delta;
             bool solver_success = false;
 
-            // Solve H_LM @ delta == b using a sparse solver
-            std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                    H_LM, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                    /*check_det=*/false, /*check_psd=*/false);
+            // Solve H_LM @ delta == b using a sparse solver, where
+            // H_LM = H + current_lambda * I
+            std::tie(solver_success, delta) =
+                    linear_system.Solve(current_lambda);
 
             stop = stop || CheckRelativeIncrement(delta, x, criteria);
             if (!stop) {
@@ -741,7 +849,7 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
                     x = UpdatePoseVector(pose_graph);
                     valid_edges_num = UpdateConfidence(
                             pose_graph, zeta, line_process_weight, option);
-                    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+                    linear_system.Compute(pose_graph, zeta);
 
                     stop = stop || CheckRightTerm(b, criteria);
                     if (stop) break;
@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/MultiScaleICP.h"
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/ColoredICP.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+
+namespace {
+using namespace registration;
+
+bool CheckMultiScaleInput(
+        const MultiScalePointCloud &source,
+        const MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria) {
+    size_t num_levels = source.GetLevelCount();
+    if (num_levels == 0 || target.GetLevelCount() != num_levels ||
+        target.engines_.size() != num_levels ||
+        max_correspondence_distances.size() != num_levels ||
+        criteria.size() != num_levels) {
+        utility::PrintError(
+                "Error: Multi-scale ICP requires the same number of levels in "
+                "source, target, distances and criteria.\n");
+        return false;
+    }
+    return true;
+}
+
+/// Runs ICP level by level from coarse to fine, carrying the transformation
+/// from one level to the next. \param get_estimation returns the estimation
+/// of a level.
+template <typename GetEstimation>
+RegistrationResult RegistrationMultiScale(
+        const MultiScalePointCloud &source,
+        MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init,
+        const GetEstimation &get_estimation) {
+    RegistrationResult result(init);
+    Eigen::Matrix4d transformation = init;
+    for (size_t i = 0; i < source.GetLevelCount(); i++) {
+        utility::PrintDebug("Multi-scale ICP level #%d: distance %.4f\n",
+                            (int)i, max_correspondence_distances[i]);
+        result = target.engines_[i]->Compute(
+                *source.levels_[i], max_correspondence_distances[i],
+                transformation, get_estimation(i), criteria[i]);
+        transformation = result.transformation_;
+    }
+    return result;
+}
+
+}  // unnamed namespace
+
+namespace registration {
+
+MultiScalePointCloud::MultiScalePointCloud(
+        const geometry::PointCloud &cloud,
+        const std::vector<double> &voxel_sizes) {
+    Create(cloud, voxel_sizes);
+}
+
+bool MultiScalePointCloud::Create(const geometry::PointCloud &cloud,
+                                  const std::vector<double> &voxel_sizes) {
+    voxel_sizes_.clear();
+    levels_.clear();
+    color_gradients_.clear();
+    engines_.clear();
+    if (cloud.HasPoints() == false || voxel_sizes.empty()) {
+        utility::PrintDebug(
+                "[MultiScalePointCloud::Create] Failed because of no point or "
+                "no level.\n");
+        return false;
+    }
+    for (double voxel_size : voxel_sizes) {
+        if (voxel_size <= 0.0) {
+            utility::PrintDebug(
+                    "[MultiScalePointCloud::Create] voxel_size <= 0.\n");
+            return false;
+        }
+    }
+
+    size_t num_levels = voxel_sizes.size();
+    voxel_sizes_ = voxel_sizes;
+    levels_.resize(num_levels);
+    engines_.resize(num_levels);
+    if (cloud.HasColors()) {
+        color_gradients_.resize(num_levels);
+    }
+    for (size_t i = 0; i < num_levels; i++) {
+        geometry::KDTreeSearchParamHybrid search_param(voxel_sizes[i] * 2.0,
+                                                       30);
+        levels_[i] = geometry::VoxelDownSample(cloud, voxel_sizes[i]);
+        geometry::EstimateNormals(*levels_[i], search_param);
+        if (cloud.HasColors()) {
+            color_gradients_[i] =
+                    ComputeColorGradients(*levels_[i], search_param);
+        }
+        engines_[i].reset(new ICPEngine(*levels_[i]));
+    }
+    return true;
+}
+
+RegistrationResult RegistrationMultiScaleICP(
+        const MultiScalePointCloud &source,
+        MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPlane()*/) {
+    if (CheckMultiScaleInput(source, target, max_correspondence_distances,
+                             criteria) == false) {
+        return RegistrationResult(init);
+    }
+    return RegistrationMultiScale(
+            source, target, max_correspondence_distances, criteria, init,
+            [&](size_t level) -> const TransformationEstimation & {
+                return estimation;
+            });
+}
+
+RegistrationResult RegistrationMultiScaleColoredICP(
+        const MultiScalePointCloud &source,
+        MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        double lambda_geometric /* = 0.968*/) {
+    if (CheckMultiScaleInput(source, target, max_correspondence_distances,
+                             criteria) == false) {
+        return RegistrationResult(init);
+    }
+    if (target.HasColorGradients() == false) {
+        utility::PrintError(
+                "Error: Multi-scale colored ICP requires a target with "
+                "colors.\n");
+        return RegistrationResult(init);
+    }
+    return RegistrationMultiScale(
+            source, target, max_correspondence_distances, criteria, init,
+            [&](size_t level) {
+                return TransformationEstimationForColoredICP(
+                        target.color_gradients_[level], lambda_geometric);
+            });
+}
+
+}  // namespace registration
+}  // namespace open3d
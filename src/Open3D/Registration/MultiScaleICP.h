@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Registration/Registration.h"
+
+namespace open3d {
+
+namespace registration {
+
+/// A point cloud preprocessed for multi-scale ICP: one voxel downsampled copy
+/// per level with estimated normals, the ICPEngine (and KD-tree) of each
+/// level, and the color gradients of each level if the cloud has colors.
+/// Levels are ordered from coarse to fine, as \param voxel_sizes. A fragment
+/// is preprocessed once and can then be the source or the target of any
+/// number of pairs. The normals of a level are estimated with
+/// KDTreeSearchParamHybrid(2 * voxel size, 30), and its color gradients with
+/// the same parameter, as RegistrationColoredICP does for a distance
+/// threshold equal to the voxel size.
+class MultiScalePointCloud {
+public:
+    MultiScalePointCloud() {}
+    MultiScalePointCloud(const geometry::PointCloud &cloud,
+                         const std::vector<double> &voxel_sizes);
+    ~MultiScalePointCloud() {}
+    MultiScalePointCloud(const MultiScalePointCloud &) = delete;
+    MultiScalePointCloud &operator=(const MultiScalePointCloud &) = delete;
+
+public:
+    /// Function to build the levels of \param cloud
+    bool Create(const geometry::PointCloud &cloud,
+                const std::vector<double> &voxel_sizes);
+    size_t GetLevelCount() const { return levels_.size(); }
+    bool HasColorGradients() const {
+        return !levels_.empty() &&
+               color_gradients_.size() == levels_.size();
+    }
+
+public:
+    std::vector<double> voxel_sizes_;
+    std::vector<std::shared_ptr<geometry::PointCloud>> levels_;
+    std::vector<std::vector<Eigen::Vector3d>> color_gradients_;
+    std::vector<std::unique_ptr<ICPEngine>> engines_;
+};
+
+/// Function for coarse-to-fine ICP registration. Level i is registered with
+/// \param max_correspondence_distances[i] and \param criteria[i], starting
+/// from the transformation found at level i - 1, or from \param init at the
+/// first level. Each level stops early as defined by its criteria. The
+/// result is the one of the finest level. \param target is not const because
+/// its ICPEngine buffers are reused, so it cannot be registered against two
+/// sources concurrently.
+RegistrationResult RegistrationMultiScaleICP(
+        const MultiScalePointCloud &source,
+        MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPlane());
+
+/// Function for coarse-to-fine colored ICP registration, same as
+/// RegistrationMultiScaleICP with TransformationEstimationForColoredICP on
+/// the color gradients of each level of \param target.
+RegistrationResult RegistrationMultiScaleColoredICP(
+        const MultiScalePointCloud &source,
+        MultiScalePointCloud &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        double lambda_geometric = 0.968);
+
+}  // namespace registration
+}  // namespace open3d
@@ -26,13 +26,17 @@
 
 #include "Open3D/Registration/Registration.h"
 
-#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <ctime>
+#include <typeinfo>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Feature.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 
@@ -51,40 +55,17 @@ RegistrationResult GetRegistrationResultAndCorrespondences(
     }
 
     double error2 = 0.0;
-
-#ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        double error2_private = 0.0;
-        CorrespondenceSet correspondence_set_private;
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int i = 0; i < (int)source.points_.size(); i++) {
-            std::vector<int> indices(1);
-            std::vector<double> dists(1);
-            const auto &point = source.points_[i];
-            if (target_kdtree.SearchHybrid(point, max_correspondence_distance,
-                                           1, indices, dists) > 0) {
-                error2_private += dists[0];
-                correspondence_set_private.push_back(
-                        Eigen::Vector2i(i, indices[0]));
-            }
+    geometry::KDTreeSearchResult neighbors;
+    target_kdtree.SearchHybridBatch(source.points_, max_correspondence_distance,
+                                    1, neighbors);
+    result.correspondence_set_.reserve(neighbors.indices_.size());
+    for (int i = 0; i < (int)source.points_.size(); i++) {
+        if (neighbors.GetNeighborCount(i) > 0) {
+            error2 += neighbors.GetDistance2(i)[0];
+            result.correspondence_set_.push_back(
+                    Eigen::Vector2i(i, neighbors.GetIndices(i)[0]));
         }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        {
-            for (int i = 0; i < (int)correspondence_set_private.size(); i++) {
-                result.correspondence_set_.push_back(
-                        correspondence_set_private[i]);
-            }
-            error2 += error2_private;
-        }
-#ifdef _OPENMP
     }
-#endif
 
     if (result.correspondence_set_.empty()) {
         result.fitness_ = 0.0;
@@ -97,6 +78,8 @@ RegistrationResult GetRegistrationResultAndCorrespondences(
     return std::move(result);
 }
 
+/// Scores \param transformation on the given correspondences. The source
+/// points are transformed on the fly.
 RegistrationResult EvaluateRANSACBasedOnCorrespondence(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -104,12 +87,15 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
         double max_correspondence_distance,
         const Eigen::Matrix4d &transformation) {
     RegistrationResult result(transformation);
+    const Eigen::Matrix3d R = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = transformation.block<3, 1>(0, 3);
     double error2 = 0.0;
     int good = 0;
     double max_dis2 = max_correspondence_distance * max_correspondence_distance;
     for (const auto &c : corres) {
         double dis2 =
-                (source.points_[c[0]] - target.points_[c[1]]).squaredNorm();
+                (R * source.points_[c[0]] + t - target.points_[c[1]])
+                        .squaredNorm();
         if (dis2 < max_dis2) {
             good++;
             error2 += dis2;
@@ -125,6 +111,77 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
     return result;
 }
 
+/// Scores \param transformation by the fitness and RMSE of the source points
+/// selected by \param indices, or of all source points if \param indices is
+/// empty. The points are transformed on the fly and no correspondence set is
+/// built, so that RANSAC can evaluate many hypotheses cheaply.
+RegistrationResult EvaluateRANSACHypothesis(
+        const geometry::PointCloud &source,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation,
+        const std::vector<int> &indices) {
+    RegistrationResult result(transformation);
+    const Eigen::Matrix3d R = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = transformation.block<3, 1>(0, 3);
+    const int num_points =
+            indices.empty() ? (int)source.points_.size() : (int)indices.size();
+    std::vector<int> neighbor(1);
+    std::vector<double> dist2(1);
+    double error2 = 0.0;
+    int good = 0;
+    for (int i = 0; i < num_points; i++) {
+        int idx = indices.empty() ? i : indices[i];
+        Eigen::Vector3d point = R * source.points_[idx] + t;
+        if (target_kdtree.SearchHybrid(point, max_correspondence_distance, 1,
+                                       neighbor, dist2) > 0) {
+            good++;
+            error2 += dist2[0];
+        }
+    }
+    if (good > 0) {
+        result.fitness_ = (double)good / (double)num_points;
+        result.inlier_rmse_ = std::sqrt(error2 / (double)good);
+    }
+    return result;
+}
+
+/// Preemptive test of a hypothesis whose fitness on a random subset of
+/// \param sample_size source points is \param sample_fitness. It fails if
+/// the subset fitness is more than two standard deviations below what a
+/// hypothesis as good as \param best_fitness would score.
+bool PassRANSACPreemptiveTest(double sample_fitness,
+                              double best_fitness,
+                              int sample_size) {
+    double sigma = std::sqrt(best_fitness * (1.0 - best_fitness) /
+                             (double)sample_size);
+    return sample_fitness >= best_fitness - 2.0 * sigma;
+}
+
+uint64_t GetRANSACSeed(int seed) {
+    return seed < 0 ? (uint64_t)std::time(0) : (uint64_t)seed;
+}
+
+/// Number of iterations needed to draw at least one all-inlier sample of
+/// ransac_n correspondences with probability confidence, given inlier_ratio.
+int ComputeRANSACIterationBound(double inlier_ratio,
+                                int ransac_n,
+                                double confidence,
+                                int max_iteration) {
+    if (confidence >= 1.0 || inlier_ratio <= 0.0) {
+        return max_iteration;
+    }
+    double all_inlier = std::pow(inlier_ratio, ransac_n);
+    if (all_inlier >= 1.0) {
+        return 1;
+    }
+    double bound = std::log(1.0 - confidence) / std::log(1.0 - all_inlier);
+    if (bound >= (double)max_iteration) {
+        return max_iteration;
+    }
+    return std::max(1, (int)std::ceil(bound));
+}
+
 }  // unnamed namespace
 
 namespace registration {
@@ -153,13 +210,37 @@ RegistrationResult RegistrationICP(
         /* = TransformationEstimationPointToPoint(false)*/,
         const ICPConvergenceCriteria
                 &criteria /* = ICPConvergenceCriteria()*/) {
+    ICPEngine engine(target);
+    return engine.Compute(source, max_correspondence_distance, init,
+                          estimation, criteria);
+}
+
+ICPEngine::ICPEngine(const geometry::PointCloud &target) { SetTarget(target); }
+
+bool ICPEngine::SetTarget(const geometry::PointCloud &target) {
+    target_ = &target;
+    return kdtree_.SetGeometry(target);
+}
+
+RegistrationResult ICPEngine::Compute(
+        const geometry::PointCloud &source,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    if (target_ == nullptr) {
+        utility::PrintError("Error: ICPEngine has no target.\n");
+        return RegistrationResult(init);
+    }
     if (max_correspondence_distance <= 0.0) {
         utility::PrintError("Error: Invalid max_correspondence_distance.\n");
         return RegistrationResult(init);
     }
     if (estimation.GetTransformationEstimationType() ==
                 TransformationEstimationType::PointToPlane &&
-        (!source.HasNormals() || !target.HasNormals())) {
+        (!source.HasNormals() || !target_->HasNormals())) {
         utility::PrintError(
                 "Error: TransformationEstimationPointToPlane requires "
                 "pre-computed normal vectors.\n");
@@ -167,26 +248,22 @@ RegistrationResult RegistrationICP(
     }
 
     Eigen::Matrix4d transformation = init;
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
-    geometry::PointCloud pcd = source;
+    source_ = source;
     if (init.isIdentity() == false) {
-        pcd.Transform(init);
+        source_.Transform(init);
     }
     RegistrationResult result;
-    result = GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+    result = UpdateCorrespondences(max_correspondence_distance,
+                                   transformation);
     for (int i = 0; i < criteria.max_iteration_; i++) {
         utility::PrintDebug("ICP Iteration #%d: Fitness %.4f, RMSE %.4f\n", i,
                             result.fitness_, result.inlier_rmse_);
-        Eigen::Matrix4d update = estimation.ComputeTransformation(
-                pcd, target, result.correspondence_set_);
+        Eigen::Matrix4d update = ComputeTransformation(estimation);
         transformation = update * transformation;
-        pcd.Transform(update);
+        source_.Transform(update);
         RegistrationResult backup = result;
-        result = GetRegistrationResultAndCorrespondences(
-                pcd, target, kdtree, max_correspondence_distance,
-                transformation);
+        result = UpdateCorrespondences(max_correspondence_distance,
+                                       transformation);
         if (std::abs(backup.fitness_ - result.fitness_) <
                     criteria.relative_fitness_ &&
             std::abs(backup.inlier_rmse_ - result.inlier_rmse_) <
@@ -194,9 +271,111 @@ RegistrationResult RegistrationICP(
             break;
         }
     }
+    BuildCorrespondenceSet(result.correspondence_set_);
     return result;
 }
 
+RegistrationResult ICPEngine::UpdateCorrespondences(
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation) {
+    RegistrationResult result(transformation);
+    const int num_points = (int)source_.points_.size();
+    kdtree_.SearchHybridBatch(source_.points_, max_correspondence_distance, 1,
+                              neighbors_);
+    correspondence_index_.resize(num_points);
+    double error2 = 0.0;
+    int num_correspondences = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) \
+        reduction(+ : error2, num_correspondences)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        if (neighbors_.GetNeighborCount(i) > 0) {
+            correspondence_index_[i] = neighbors_.GetIndices(i)[0];
+            error2 += neighbors_.GetDistance2(i)[0];
+            num_correspondences++;
+        } else {
+            correspondence_index_[i] = -1;
+        }
+    }
+    num_correspondences_ = num_correspondences;
+    if (num_correspondences > 0) {
+        result.fitness_ = (double)num_correspondences / (double)num_points;
+        result.inlier_rmse_ =
+                std::sqrt(error2 / (double)num_correspondences);
+    }
+    return result;
+}
+
+Eigen::Matrix4d ICPEngine::ComputeTransformation(
+        const TransformationEstimation &estimation) {
+    // Only the built-in point-to-plane estimation runs the fused kernel.
+    // Subclasses overriding ComputeTransformation go through the
+    // correspondence set and the virtual call.
+    if (typeid(estimation) == typeid(TransformationEstimationPointToPlane)) {
+        return ComputePointToPlaneTransformation();
+    }
+    BuildCorrespondenceSet(correspondence_set_);
+    return estimation.ComputeTransformation(source_, *target_,
+                                            correspondence_set_);
+}
+
+Eigen::Matrix4d ICPEngine::ComputePointToPlaneTransformation() const {
+    if (num_correspondences_ == 0 || target_->HasNormals() == false) {
+        return Eigen::Matrix4d::Identity();
+    }
+    const int num_points = (int)source_.points_.size();
+    Eigen::Matrix6d JTJ = Eigen::Matrix6d::Zero();
+    Eigen::Vector6d JTr = Eigen::Vector6d::Zero();
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        Eigen::Matrix6d JTJ_private = Eigen::Matrix6d::Zero();
+        Eigen::Vector6d JTr_private = Eigen::Vector6d::Zero();
+        Eigen::Vector6d J_r;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < num_points; i++) {
+            const int t = correspondence_index_[i];
+            if (t < 0) continue;
+            const Eigen::Vector3d &vs = source_.points_[i];
+            const Eigen::Vector3d &vt = target_->points_[t];
+            const Eigen::Vector3d &nt = target_->normals_[t];
+            double r = (vs - vt).dot(nt);
+            J_r.block<3, 1>(0, 0) = vs.cross(nt);
+            J_r.block<3, 1>(3, 0) = nt;
+            JTJ_private.noalias() += J_r * J_r.transpose();
+            JTr_private.noalias() += J_r * r;
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            JTJ += JTJ_private;
+            JTr += JTr_private;
+        }
+#ifdef _OPENMP
+    }
+#endif
+    bool is_success;
+    Eigen::Matrix4d extrinsic;
+    std::tie(is_success, extrinsic) =
+            utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ, JTr);
+    return is_success ? extrinsic : Eigen::Matrix4d::Identity();
+}
+
+void ICPEngine::BuildCorrespondenceSet(CorrespondenceSet &corres) const {
+    corres.clear();
+    corres.reserve(num_correspondences_);
+    for (int i = 0; i < (int)correspondence_index_.size(); i++) {
+        if (correspondence_index_[i] >= 0) {
+            corres.push_back(Eigen::Vector2i(i, correspondence_index_[i]));
+        }
+    }
+}
+
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -206,34 +385,42 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         /* = TransformationEstimationPointToPoint(false)*/,
         int ransac_n /* = 6*/,
         const RANSACConvergenceCriteria &criteria
-        /* = RANSACConvergenceCriteria()*/) {
+        /* = RANSACConvergenceCriteria()*/,
+        int seed /* = -1*/) {
     if (ransac_n < 3 || (int)corres.size() < ransac_n ||
         max_correspondence_distance <= 0.0) {
         return RegistrationResult();
     }
-    std::srand((unsigned int)std::time(0));
+    utility::RandomStream rand(GetRANSACSeed(seed), 0);
     Eigen::Matrix4d transformation;
     CorrespondenceSet ransac_corres(ransac_n);
     RegistrationResult result;
-    for (int itr = 0;
-         itr < criteria.max_iteration_ && itr < criteria.max_validation_;
-         itr++) {
+    int max_iteration =
+            std::min(criteria.max_iteration_, criteria.max_validation_);
+    int itr = 0;
+    for (; itr < max_iteration; itr++) {
         for (int j = 0; j < ransac_n; j++) {
-            ransac_corres[j] = corres[std::rand() % (int)corres.size()];
+            ransac_corres[j] = corres[rand((int)corres.size())];
         }
         transformation =
                 estimation.ComputeTransformation(source, target, ransac_corres);
-        geometry::PointCloud pcd = source;
-        pcd.Transform(transformation);
         auto this_result = EvaluateRANSACBasedOnCorrespondence(
-                pcd, target, corres, max_correspondence_distance,
+                source, target, corres, max_correspondence_distance,
                 transformation);
         if (this_result.fitness_ > result.fitness_ ||
             (this_result.fitness_ == result.fitness_ &&
              this_result.inlier_rmse_ < result.inlier_rmse_)) {
             result = this_result;
+            // The fitness is measured on the given correspondences, so it is
+            // the fraction of correct correspondences the bound needs.
+            max_iteration = std::min(
+                    max_iteration,
+                    ComputeRANSACIterationBound(result.fitness_, ransac_n,
+                                                criteria.confidence_,
+                                                max_iteration));
         }
     }
+    utility::PrintDebug("RANSAC: %d iterations\n", itr);
     utility::PrintDebug("RANSAC: Fitness %.4f, RMSE %.4f\n", result.fitness_,
                         result.inlier_rmse_);
     return result;
@@ -251,7 +438,8 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers /* = {}*/,
         const RANSACConvergenceCriteria &criteria
-        /* = RANSACConvergenceCriteria()*/) {
+        /* = RANSACConvergenceCriteria()*/,
+        int seed /* = -1*/) {
     if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
         return RegistrationResult();
     }
@@ -259,56 +447,136 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
     RegistrationResult result;
     int total_validation = 0;
     bool finished_validation = false;
+    // Adaptive bound on the number of iterations, shrunk by every validated
+    // hypothesis. Iterations beyond it are skipped.
+    int max_iteration = criteria.max_iteration_;
+    // Best fitness of the fully validated hypotheses, used by the preemptive
+    // test.
+    double best_fitness = 0.0;
     int num_similar_features = 1;
     std::vector<std::vector<int>> similar_features(source.points_.size());
+    const uint64_t seed_number = GetRANSACSeed(seed);
+    const geometry::KDTreeFlann kdtree(target);
+    const geometry::KDTreeFlann kdtree_feature(target_feature);
+
+    // Every hypothesis is first scored on a fixed random subset of the source
+    // points. Only those that pass the preemptive test are fully validated.
+    const int preemptive_sample_size = 100;
+    std::vector<int> preemptive_indices;
+    if ((int)source.points_.size() > preemptive_sample_size) {
+        std::vector<int> shuffled(source.points_.size());
+        for (int i = 0; i < (int)shuffled.size(); i++) {
+            shuffled[i] = i;
+        }
+        utility::RandomStream rand(seed_number, (uint64_t)-1);
+        for (int i = 0; i < preemptive_sample_size; i++) {
+            std::swap(shuffled[i],
+                      shuffled[i + rand((int)shuffled.size() - i)]);
+        }
+        preemptive_indices.assign(shuffled.begin(),
+                                  shuffled.begin() + preemptive_sample_size);
+    }
+
+    // The adaptive bound needs the fraction of correct feature matches, which
+    // is estimated on the feature matches of the same subset of points.
+    CorrespondenceSet sample_matches;
+    if (criteria.confidence_ < 1.0 && !source.points_.empty()) {
+        const int num_samples = preemptive_indices.empty()
+                                        ? (int)source.points_.size()
+                                        : preemptive_sample_size;
+        Eigen::MatrixXd queries(source_feature.Dimension(), num_samples);
+        for (int k = 0; k < num_samples; k++) {
+            int i = preemptive_indices.empty() ? k : preemptive_indices[k];
+            queries.col(k) = source_feature.data_.col(i);
+        }
+        geometry::KDTreeSearchResult neighbors;
+        kdtree_feature.SearchKNNBatch(queries, 1, neighbors);
+        for (int k = 0; k < num_samples; k++) {
+            if (neighbors.GetNeighborCount(k) > 0) {
+                int i = preemptive_indices.empty() ? k : preemptive_indices[k];
+                sample_matches.push_back(
+                        Eigen::Vector2i(i, neighbors.GetIndices(k)[0]));
+            }
+        }
+    }
+
+    // Iterations run block by block. Within a block the hypotheses are drawn
+    // and scored in parallel against the state left by the previous blocks,
+    // and are then committed in iteration order. The validation count, the
+    // adaptive bound and the result therefore depend only on the seed, not on
+    // the number of threads.
+    const int block_size = 64;
+    std::vector<int> sample_ids(block_size * ransac_n);
+    std::vector<int> sample_choices(block_size * ransac_n);
+    std::vector<RegistrationResult> block_results(block_size);
+    std::vector<double> block_inlier_ratios(block_size);
+    std::vector<char> block_validated(block_size);
+    std::vector<int> missing_ids;
+    for (int begin = 0; begin < max_iteration && !finished_validation;
+         begin += block_size) {
+        const int end = std::min(max_iteration, begin + block_size);
 
+        // Draw the samples of every iteration of the block.
 #ifdef _OPENMP
-#pragma omp parallel
-    {
+#pragma omp parallel for schedule(static)
 #endif
-        CorrespondenceSet ransac_corres(ransac_n);
-        geometry::KDTreeFlann kdtree(target);
-        geometry::KDTreeFlann kdtree_feature(target_feature);
-        RegistrationResult result_private;
-        unsigned int seed_number;
+        for (int itr = begin; itr < end; itr++) {
+            utility::RandomStream rand(seed_number, (uint64_t)itr);
+            for (int j = 0; j < ransac_n; j++) {
+                int k = (itr - begin) * ransac_n + j;
+                sample_ids[k] = rand((int)source.points_.size());
+                sample_choices[k] = num_similar_features == 1
+                                            ? 0
+                                            : rand(num_similar_features);
+            }
+        }
+
+        // Match the features of the newly drawn source points.
+        missing_ids.clear();
+        for (int k = 0; k < (end - begin) * ransac_n; k++) {
+            if (similar_features[sample_ids[k]].empty()) {
+                missing_ids.push_back(sample_ids[k]);
+            }
+        }
+        std::sort(missing_ids.begin(), missing_ids.end());
+        missing_ids.erase(std::unique(missing_ids.begin(), missing_ids.end()),
+                          missing_ids.end());
 #ifdef _OPENMP
-        // each thread has different seed_number
-        seed_number = (unsigned int)std::time(0) * (omp_get_thread_num() + 1);
-#else
-    seed_number = (unsigned int)std::time(0);
+#pragma omp parallel for schedule(static)
 #endif
-        std::srand(seed_number);
+        for (int k = 0; k < (int)missing_ids.size(); k++) {
+            std::vector<int> indices(num_similar_features);
+            std::vector<double> dists(num_similar_features);
+            kdtree_feature.SearchKNN(
+                    Eigen::VectorXd(source_feature.data_.col(missing_ids[k])),
+                    num_similar_features, indices, dists);
+            similar_features[missing_ids[k]] = indices;
+        }
 
+        // Compute and score the hypotheses. The preemptive test compares
+        // against the best fitness of the previous blocks, which no thread
+        // writes until the block is committed.
+        const double block_best_fitness = best_fitness;
 #ifdef _OPENMP
-#pragma omp for nowait
+#pragma omp parallel
+        {
 #endif
-        for (int itr = 0; itr < criteria.max_iteration_; itr++) {
-            if (!finished_validation) {
-                std::vector<double> dists(num_similar_features);
-                Eigen::Matrix4d transformation;
-                for (int j = 0; j < ransac_n; j++) {
-                    int source_sample_id =
-                            std::rand() % (int)source.points_.size();
-                    if (similar_features[source_sample_id].empty()) {
-                        std::vector<int> indices(num_similar_features);
-                        kdtree_feature.SearchKNN(
-                                Eigen::VectorXd(source_feature.data_.col(
-                                        source_sample_id)),
-                                num_similar_features, indices, dists);
+            CorrespondenceSet ransac_corres(ransac_n);
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp for schedule(dynamic)
 #endif
-                        { similar_features[source_sample_id] = indices; }
-                    }
+            for (int itr = begin; itr < end; itr++) {
+                const int b = itr - begin;
+                block_validated[b] = 0;
+                Eigen::Matrix4d transformation;
+                for (int j = 0; j < ransac_n; j++) {
+                    int source_sample_id = sample_ids[b * ransac_n + j];
+                    const auto &similar = similar_features[source_sample_id];
                     ransac_corres[j](0) = source_sample_id;
-                    if (num_similar_features == 1)
-                        ransac_corres[j](1) =
-                                similar_features[source_sample_id][0];
-                    else
-                        ransac_corres[j](1) =
-                                similar_features[source_sample_id]
-                                                [std::rand() %
-                                                 num_similar_features];
+                    ransac_corres[j](1) =
+                            similar.empty()
+                                    ? 0
+                                    : similar[sample_choices[b * ransac_n + j]];
                 }
                 bool check = true;
                 for (const auto &checker : checkers) {
@@ -332,40 +600,66 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                     }
                 }
                 if (check == false) continue;
-                geometry::PointCloud pcd = source;
-                pcd.Transform(transformation);
-                auto this_result = GetRegistrationResultAndCorrespondences(
-                        pcd, target, kdtree, max_correspondence_distance,
-                        transformation);
-                if (this_result.fitness_ > result_private.fitness_ ||
-                    (this_result.fitness_ == result_private.fitness_ &&
-                     this_result.inlier_rmse_ < result_private.inlier_rmse_)) {
-                    result_private = this_result;
-                }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                {
-                    total_validation = total_validation + 1;
-                    if (total_validation >= criteria.max_validation_)
-                        finished_validation = true;
+                if (!preemptive_indices.empty()) {
+                    auto sample_result = EvaluateRANSACHypothesis(
+                            source, kdtree, max_correspondence_distance,
+                            transformation, preemptive_indices);
+                    if (!PassRANSACPreemptiveTest(sample_result.fitness_,
+                                                  block_best_fitness,
+                                                  preemptive_sample_size)) {
+                        continue;
+                    }
                 }
-            }  // end of if statement
-        }      // end of for-loop
+                block_results[b] = EvaluateRANSACHypothesis(
+                        source, kdtree, max_correspondence_distance,
+                        transformation, std::vector<int>());
+                block_inlier_ratios[b] =
+                        sample_matches.empty()
+                                ? 0.0
+                                : EvaluateRANSACBasedOnCorrespondence(
+                                          source, target, sample_matches,
+                                          max_correspondence_distance,
+                                          transformation)
+                                          .fitness_;
+                block_validated[b] = 1;
+            }
 #ifdef _OPENMP
-#pragma omp critical
+        }
 #endif
-        {
-            if (result_private.fitness_ > result.fitness_ ||
-                (result_private.fitness_ == result.fitness_ &&
-                 result_private.inlier_rmse_ < result.inlier_rmse_)) {
-                result = result_private;
+
+        // Commit the validated hypotheses in iteration order.
+        for (int itr = begin; itr < end; itr++) {
+            if (finished_validation || itr >= max_iteration) break;
+            const int b = itr - begin;
+            if (!block_validated[b]) continue;
+            const RegistrationResult &this_result = block_results[b];
+            if (this_result.fitness_ > result.fitness_ ||
+                (this_result.fitness_ == result.fitness_ &&
+                 this_result.inlier_rmse_ < result.inlier_rmse_)) {
+                result = this_result;
             }
+            total_validation = total_validation + 1;
+            if (total_validation >= criteria.max_validation_)
+                finished_validation = true;
+            max_iteration = std::min(
+                    max_iteration,
+                    ComputeRANSACIterationBound(
+                            block_inlier_ratios[b], ransac_n,
+                            criteria.confidence_, criteria.max_iteration_));
+            best_fitness = std::max(best_fitness, this_result.fitness_);
         }
-#ifdef _OPENMP
     }
-#endif
+    if (result.fitness_ > 0.0) {
+        // The hypotheses were scored without correspondences. Recover them
+        // for the winner only.
+        geometry::PointCloud pcd = source;
+        pcd.Transform(result.transformation_);
+        result = GetRegistrationResultAndCorrespondences(
+                pcd, target, kdtree, max_correspondence_distance,
+                result.transformation_);
+    }
     utility::PrintDebug("total_validation : %d\n", total_validation);
+    utility::PrintDebug("iteration bound : %d\n", max_iteration);
     utility::PrintDebug("RANSAC: Fitness %.4f, RMSE %.4f\n", result.fitness_,
                         result.inlier_rmse_);
     return result;
@@ -30,16 +30,14 @@
 #include <tuple>
 #include <vector>
 
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Open3D/Utility/Eigen.h"
 
 namespace open3d {
 
-namespace geometry {
-class PointCloud;
-}
-
 namespace registration {
 class Feature;
 
@@ -69,16 +67,29 @@ public:
 /// Note that the validation is the most computational expensive operator in an
 /// iteration. Most iterations do not do full validation. It is crucial to
 /// control max_validation_ so that the computation time is acceptable.
+/// Hypotheses rejected by the preemptive test on a subset of the points do not
+/// count as validations.
+/// In addition, the iteration number is bounded adaptively: once the best
+/// inlier ratio w found so far makes log(1 - confidence_) / log(1 - w^n)
+/// iterations sufficient to have drawn an all-inlier sample with probability
+/// confidence_, the remaining iterations are skipped. w is the fraction of
+/// correspondences (or, for feature matching, of the feature matches of a
+/// random subset of source points) that a hypothesis maps within the maximum
+/// correspondence distance. A confidence_ of 1.0 disables the adaptive bound.
 class RANSACConvergenceCriteria {
 public:
     RANSACConvergenceCriteria(int max_iteration = 1000,
-                              int max_validation = 1000)
-        : max_iteration_(max_iteration), max_validation_(max_validation) {}
+                              int max_validation = 1000,
+                              double confidence = 0.999)
+        : max_iteration_(max_iteration),
+          max_validation_(max_validation),
+          confidence_(confidence) {}
     ~RANSACConvergenceCriteria() {}
 
 public:
     int max_iteration_;
     int max_validation_;
+    double confidence_;
 };
 
 /// Class that contains the registration results
@@ -113,8 +124,59 @@ RegistrationResult RegistrationICP(
                 TransformationEstimationPointToPoint(false),
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
 
+/// Stateful ICP for registering any number of sources against the same
+/// target. The target KD-tree is built once by SetTarget(), and the working
+/// buffers are kept across calls. Each source point owns one correspondence
+/// slot, holding the index of its closest target point or -1 for none, which
+/// is filled in parallel and read directly by the point-to-plane estimation.
+/// The correspondence set of the result is only built once ICP has converged,
+/// or at every iteration for the other estimations, which take it as input.
+/// The target must outlive the engine or the next SetTarget().
+class ICPEngine {
+public:
+    ICPEngine() {}
+    explicit ICPEngine(const geometry::PointCloud &target);
+    ~ICPEngine() {}
+    ICPEngine(const ICPEngine &) = delete;
+    ICPEngine &operator=(const ICPEngine &) = delete;
+
+public:
+    /// Function to set the target point cloud and build its KD-tree
+    bool SetTarget(const geometry::PointCloud &target);
+
+    /// Function for ICP registration, same as RegistrationICP against the
+    /// target of the engine
+    RegistrationResult Compute(
+            const geometry::PointCloud &source,
+            double max_correspondence_distance,
+            const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+            const TransformationEstimation &estimation =
+                    TransformationEstimationPointToPoint(false),
+            const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
+private:
+    RegistrationResult UpdateCorrespondences(
+            double max_correspondence_distance,
+            const Eigen::Matrix4d &transformation);
+    Eigen::Matrix4d ComputeTransformation(
+            const TransformationEstimation &estimation);
+    Eigen::Matrix4d ComputePointToPlaneTransformation() const;
+    void BuildCorrespondenceSet(CorrespondenceSet &corres) const;
+
+private:
+    const geometry::PointCloud *target_ = nullptr;
+    geometry::KDTreeFlann kdtree_;
+    geometry::PointCloud source_;
+    geometry::KDTreeSearchResult neighbors_;
+    std::vector<int> correspondence_index_;
+    int num_correspondences_ = 0;
+    CorrespondenceSet correspondence_set_;
+};
+
 /// Function for global RANSAC registration based on a given set of
 /// correspondences
+/// \param seed seeds the random samples. The same seed gives the same result.
+/// A negative seed draws one from the current time.
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -123,10 +185,14 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const TransformationEstimation &estimation =
                 TransformationEstimationPointToPoint(false),
         int ransac_n = 6,
-        const RANSACConvergenceCriteria &criteria =
-                RANSACConvergenceCriteria());
+        const RANSACConvergenceCriteria &criteria = RANSACConvergenceCriteria(),
+        int seed = -1);
 
 /// Function for global RANSAC registration based on feature matching
+/// \param seed seeds the random samples. Every iteration draws from its own
+/// random stream and the iterations are committed in order, so the same seed
+/// gives the same result whatever the number of threads. A negative seed
+/// draws one from the current time.
 RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -138,8 +204,8 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         int ransac_n = 4,
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers = {},
-        const RANSACConvergenceCriteria &criteria =
-                RANSACConvergenceCriteria());
+        const RANSACConvergenceCriteria &criteria = RANSACConvergenceCriteria(),
+        int seed = -1);
 
 /// Function for computing information matrix from transformation matrix
 Eigen::Matrix6d GetInformationMatrixFromPointClouds(
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -101,6 +102,34 @@ struct hash : std::unary_function<T, size_t> {
 
 }  // namespace hash_eigen
 
+/// Counter-based random number generator. The n-th number of a stream is a
+/// hash of (seed, stream, n), so streams need no shared state and give the
+/// same numbers whichever thread draws from them.
+class RandomStream {
+public:
+    RandomStream(uint64_t seed, uint64_t stream)
+        : key_(Mix(seed ^ Mix(stream + kGolden))), counter_(0) {}
+
+    /// Returns a uniformly distributed integer in [0, n).
+    int operator()(int n) {
+        counter_++;
+        uint64_t r = Mix(key_ + counter_ * kGolden) >> 32;
+        return (int)((r * (uint64_t)n) >> 32);
+    }
+
+private:
+    // splitmix64 finalizer
+    static uint64_t Mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static const uint64_t kGolden = 0x9e3779b97f4a7c15ULL;
+    uint64_t key_;
+    uint64_t counter_;
+};
+
 /// Function to split a string, mimics boost::split
 /// http://stackoverflow.com/questions/236129/split-a-string-in-c
 void SplitString(std::vector<std::string>& tokens,
@@ -141,6 +141,16 @@ point is:
              {"voxel_size", "Voxel size to downsample into."},
              {"invert", "set to ``True`` to invert the selection of indices"}});
 
+    m.def("voxel_down_sample_and_index", &geometry::VoxelDownSampleAndIndex,
+          "Function to downsample using geometry::VoxelDownSample, also "
+          "returns for every input point the index of the output point it is "
+          "merged into",
+          "input"_a, "voxel_size"_a);
+    docstring::FunctionDocInject(
+            m, "voxel_down_sample_and_index",
+            {{"input", "The input point cloud."},
+             {"voxel_size", "Voxel size to downsample into."}});
+
     m.def("voxel_down_sample_and_trace", &geometry::VoxelDownSampleAndTrace,
           "Function to downsample using geometry::VoxelDownSample also records "
           "point "
@@ -69,6 +69,19 @@ void pybind_integration_classes(py::module &m) {
             }),
             py::none(), py::none(), "");
 
+    // open3d.integration.TSDFVolumeStorageType
+    py::enum_<integration::TSDFVolumeStorageType> tsdf_volume_storage_type(
+            m, "TSDFVolumeStorageType", py::arithmetic());
+    tsdf_volume_storage_type
+            .value("Float32", integration::TSDFVolumeStorageType::Float32)
+            .value("Compact", integration::TSDFVolumeStorageType::Compact)
+            .export_values();
+    tsdf_volume_storage_type.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for TSDFVolumeStorageType.";
+            }),
+            py::none(), py::none(), "");
+
     // open3d.integration.TSDFVolume
     py::class_<integration::TSDFVolume, PyTSDFVolume<integration::TSDFVolume>>
             tsdfvolume(m, "TSDFVolume", R"(Base class of the Truncated
@@ -123,11 +136,14 @@ In SIGGRAPH, 1996)");
             uniform_tsdfvolume);
     uniform_tsdfvolume
             .def(py::init([](double length, int resolution, double sdf_trunc,
-                             integration::TSDFVolumeColorType color_type) {
+                             integration::TSDFVolumeColorType color_type,
+                             integration::TSDFVolumeStorageType storage_type) {
                      return new integration::UniformTSDFVolume(
-                             length, resolution, sdf_trunc, color_type);
+                             length, resolution, sdf_trunc, color_type,
+                             Eigen::Vector3d::Zero(), storage_type);
                  }),
-                 "length"_a, "resolution"_a, "sdf_trunc"_a, "color_type"_a)
+                 "length"_a, "resolution"_a, "sdf_trunc"_a, "color_type"_a,
+                 "storage_type"_a = integration::TSDFVolumeStorageType::Float32)
             .def("__repr__",
                  [](const integration::UniformTSDFVolume &vol) {
                      return std::string("integration::UniformTSDFVolume ") +
@@ -178,13 +194,16 @@ In SIGGRAPH, 2013)");
             .def(py::init([](double voxel_length, double sdf_trunc,
                              integration::TSDFVolumeColorType color_type,
                              int volume_unit_resolution,
-                             int depth_sampling_stride) {
+                             int depth_sampling_stride,
+                             integration::TSDFVolumeStorageType storage_type) {
                      return new integration::ScalableTSDFVolume(
                              voxel_length, sdf_trunc, color_type,
-                             volume_unit_resolution, depth_sampling_stride);
+                             volume_unit_resolution, depth_sampling_stride,
+                             storage_type);
                  }),
                  "voxel_length"_a, "sdf_trunc"_a, "color_type"_a,
-                 "volume_unit_resolution"_a = 16, "depth_sampling_stride"_a = 4)
+                 "volume_unit_resolution"_a = 16, "depth_sampling_stride"_a = 4,
+                 "storage_type"_a = integration::TSDFVolumeStorageType::Float32)
             .def("__repr__",
                  [](const integration::ScalableTSDFVolume &vol) {
                      return std::string("integration::ScalableTSDFVolume ") +
@@ -197,9 +216,16 @@ In SIGGRAPH, 2013)");
             .def("extract_voxel_point_cloud",
                  &integration::ScalableTSDFVolume::ExtractVoxelPointCloud,
                  "Debug function to extract the voxel data into a point "
-                 "cloud.");
+                 "cloud.")
+            .def("extract_triangle_mesh_incremental",
+                 &integration::ScalableTSDFVolume::
+                         ExtractTriangleMeshIncremental,
+                 "Function to extract a triangle mesh, re-meshing only the "
+                 "volume units integrated since the previous call.");
     docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
                                     "extract_voxel_point_cloud");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "extract_triangle_mesh_incremental");
 }
 
 void pybind_integration_methods(py::module &m) {
@@ -55,6 +55,9 @@ static const std::unordered_map<std::string, std::string>
                  "The format of the input file. When not specified or set as "
                  "``auto``, the format is inferred from file extension name."},
                 {"quality", "Quality of the output file."},
+                {"storage_type",
+                 "Precision the feature is stored with in the ``.o3d`` "
+                 "format."},
                 {"write_ascii",
                  "Set to ``True`` to output in ascii format, otherwise binary "
                  "format will be used."},
@@ -246,15 +249,29 @@ void pybind_io(py::module &m) {
 
     m_io.def("write_pinhole_camera_trajectory",
              [](const std::string &filename,
-                const camera::PinholeCameraTrajectory &trajectory) {
-                 return io::WritePinholeCameraTrajectory(filename, trajectory);
+                const camera::PinholeCameraTrajectory &trajectory,
+                bool compressed) {
+                 return io::WritePinholeCameraTrajectory(filename, trajectory,
+                                                         compressed);
              },
              "Function to write PinholeCameraTrajectory to file", "filename"_a,
-             "trajectory"_a);
+             "trajectory"_a, "compressed"_a = false);
     docstring::FunctionDocInject(m_io, "write_pinhole_camera_trajectory",
                                  map_shared_argument_docstrings);
 
     // open3d::registration
+    py::enum_<io::FeatureStorageType> feature_storage_type(
+            m_io, "FeatureStorageType", py::arithmetic());
+    feature_storage_type.value("Float64", io::FeatureStorageType::Float64)
+            .value("Float16", io::FeatureStorageType::Float16)
+            .value("UInt8", io::FeatureStorageType::UInt8)
+            .export_values();
+    feature_storage_type.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for FeatureStorageType.";
+            }),
+            py::none(), py::none(), "");
+
     m_io.def("read_feature",
              [](const std::string &filename) {
                  registration::Feature feature;
@@ -267,10 +284,14 @@ void pybind_io(py::module &m) {
 
     m_io.def("write_feature",
              [](const std::string &filename,
-                const registration::Feature &feature) {
-                 return io::WriteFeature(filename, feature);
+                const registration::Feature &feature, bool compressed,
+                io::FeatureStorageType storage_type) {
+                 return io::WriteFeature(filename, feature, compressed,
+                                         storage_type);
              },
-             "Function to write Feature to file", "filename"_a, "feature"_a);
+             "Function to write Feature to file", "filename"_a, "feature"_a,
+             "compressed"_a = false,
+             "storage_type"_a = io::FeatureStorageType::Float64);
     docstring::FunctionDocInject(m_io, "write_feature",
                                  map_shared_argument_docstrings);
 
@@ -286,11 +307,11 @@ void pybind_io(py::module &m) {
 
     m_io.def("write_pose_graph",
              [](const std::string &filename,
-                const registration::PoseGraph pose_graph) {
-                 io::WritePoseGraph(filename, pose_graph);
+                const registration::PoseGraph pose_graph, bool compressed) {
+                 io::WritePoseGraph(filename, pose_graph, compressed);
              },
              "Function to write PoseGraph to file", "filename"_a,
-             "pose_graph"_a);
+             "pose_graph"_a, "compressed"_a = false);
     docstring::FunctionDocInject(m_io, "write_pose_graph",
                                  map_shared_argument_docstrings);
 }
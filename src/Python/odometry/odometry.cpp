@@ -178,6 +178,55 @@ Anonymous submission.)");
             [](const odometry::RGBDOdometryJacobianFromHybridTerm &te) {
                 return std::string("RGBDOdometryJacobianFromHybridTerm");
             });
+
+    // open3d.odometry.RGBDOdometryFrame
+    py::class_<odometry::RGBDOdometryFrame,
+               std::shared_ptr<odometry::RGBDOdometryFrame>>
+            frame(m, "RGBDOdometryFrame",
+                  "RGBD image preprocessed for odometry. Created by "
+                  "``RGBDOdometry.create_frame``.");
+    frame.def("is_empty", &odometry::RGBDOdometryFrame::IsEmpty,
+              "Returns ``True`` if the frame holds no data.")
+            .def("__repr__", [](const odometry::RGBDOdometryFrame &f) {
+                return std::string("RGBDOdometryFrame with ") +
+                       std::to_string(f.pyramid_.size()) +
+                       std::string(" pyramid levels.");
+            });
+
+    // open3d.odometry.RGBDOdometry
+    py::class_<odometry::RGBDOdometry> rgbd_odometry(
+            m, "RGBDOdometry",
+            "Stateful RGBD odometry for sequential tracking. Each frame is "
+            "preprocessed once by ``create_frame`` and can be used in any "
+            "number of pairs; working buffers are reused across calls.");
+    rgbd_odometry
+            .def(py::init<const camera::PinholeCameraIntrinsic &,
+                          const odometry::OdometryOption &>(),
+                 "pinhole_camera_intrinsic"_a =
+                         camera::PinholeCameraIntrinsic(),
+                 "option"_a = odometry::OdometryOption())
+            .def("create_frame", &odometry::RGBDOdometry::CreateFrame,
+                 "Function to preprocess an RGBD image into an odometry "
+                 "frame.",
+                 "rgbd_image"_a)
+            .def("compute", &odometry::RGBDOdometry::Compute,
+                 "Function to estimate 6D rigid motion between two frames. "
+                 "Output: (is_success, 4x4 motion matrix, 6x6 information "
+                 "matrix).",
+                 "source"_a, "target"_a,
+                 "odo_init"_a = Eigen::Matrix4d::Identity(),
+                 "jacobian"_a = odometry::RGBDOdometryJacobianFromHybridTerm())
+            .def("__repr__", [](const odometry::RGBDOdometry &o) {
+                return std::string("RGBDOdometry");
+            });
+    docstring::ClassMethodDocInject(m, "RGBDOdometry", "create_frame",
+                                    {{"rgbd_image", "RGBD image."}});
+    docstring::ClassMethodDocInject(
+            m, "RGBDOdometry", "compute",
+            {{"source", "Source frame."},
+             {"target", "Target frame."},
+             {"odo_init", "Initial 4x4 motion matrix estimation."},
+             {"jacobian", "The odometry Jacobian method to use."}});
 }
 
 void pybind_odometry_methods(py::module &m) {
@@ -31,6 +31,7 @@
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/FastGlobalRegistration.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/MultiScaleICP.h"
 #include "Open3D/Registration/Registration.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Python/docstring.h"
@@ -132,11 +133,13 @@ void pybind_registration_classes(py::module &m) {
     py::detail::bind_copy_functions<registration::RANSACConvergenceCriteria>(
             ransac_criteria);
     ransac_criteria
-            .def(py::init([](int max_iteration, int max_validation) {
+            .def(py::init([](int max_iteration, int max_validation,
+                             double confidence) {
                      return new registration::RANSACConvergenceCriteria(
-                             max_iteration, max_validation);
+                             max_iteration, max_validation, confidence);
                  }),
-                 "max_iteration"_a = 1000, "max_validation"_a = 1000)
+                 "max_iteration"_a = 1000, "max_validation"_a = 1000,
+                 "confidence"_a = 0.999)
             .def_readwrite(
                     "max_iteration",
                     &registration::RANSACConvergenceCriteria::max_iteration_,
@@ -146,6 +149,13 @@ void pybind_registration_classes(py::module &m) {
                     &registration::RANSACConvergenceCriteria::max_validation_,
                     "Maximum times the validation has been run before the "
                     "iteration stops.")
+            .def_readwrite(
+                    "confidence",
+                    &registration::RANSACConvergenceCriteria::confidence_,
+                    "Desired probability of having drawn at least one "
+                    "all-inlier sample. The iteration stops early once the "
+                    "best inlier ratio so far makes this probability reached. "
+                    "1.0 disables the early stop.")
             .def("__repr__",
                  [](const registration::RANSACConvergenceCriteria &c) {
                      return std::string(
@@ -153,8 +163,10 @@ void pybind_registration_classes(py::module &m) {
                                     "class with ") +
                             std::string("max_iteration = ") +
                             std::to_string(c.max_iteration_) +
-                            std::string(", and max_validation = " +
-                                        std::to_string(c.max_validation_));
+                            std::string(", max_validation = ") +
+                            std::to_string(c.max_validation_) +
+                            std::string(", and confidence = ") +
+                            std::to_string(c.confidence_);
                  });
 
     // ope3dn.registration.TransformationEstimation
@@ -383,17 +395,17 @@ must hold true for all edges.)");
                              bool decrease_mu,
                              double maximum_correspondence_distance,
                              int iteration_number, double tuple_scale,
-                             int maximum_tuple_count) {
+                             int maximum_tuple_count, int seed) {
                      return new registration::FastGlobalRegistrationOption(
                              division_factor, use_absolute_scale, decrease_mu,
                              maximum_correspondence_distance, iteration_number,
-                             tuple_scale, maximum_tuple_count);
+                             tuple_scale, maximum_tuple_count, seed);
                  }),
                  "division_factor"_a = 1.4, "use_absolute_scale"_a = false,
                  "decrease_mu"_a = false,
                  "maximum_correspondence_distance"_a = 0.025,
                  "iteration_number"_a = 64, "tuple_scale"_a = 0.95,
-                 "maximum_tuple_count"_a = 1000)
+                 "maximum_tuple_count"_a = 1000, "seed"_a = -1)
             .def_readwrite(
                     "division_factor",
                     &registration::FastGlobalRegistrationOption::
@@ -427,6 +439,10 @@ must hold true for all edges.)");
                            &registration::FastGlobalRegistrationOption::
                                    maximum_tuple_count_,
                            "float: Maximum tuple numbers.")
+            .def_readwrite("seed",
+                           &registration::FastGlobalRegistrationOption::seed_,
+                           "int: Seed of the random tuple sampling. A "
+                           "negative seed draws one from the current time.")
             .def("__repr__",
                  [](const registration::FastGlobalRegistrationOption &c) {
                      return std::string(
@@ -447,7 +463,9 @@ must hold true for all edges.)");
                             std::string("\ntuple_scale = ") +
                             std::to_string(c.tuple_scale_) +
                             std::string("\nmaximum_tuple_count = ") +
-                            std::to_string(c.maximum_tuple_count_);
+                            std::to_string(c.maximum_tuple_count_) +
+                            std::string("\nseed = ") +
+                            std::to_string(c.seed_);
                  });
 
     // ope3dn.registration.RegistrationResult
@@ -487,6 +505,78 @@ must hold true for all edges.)");
                        std::to_string(rr.correspondence_set_.size()) +
                        std::string("\nAccess transformation to get result.");
             });
+
+    // open3d.registration.ICPEngine
+    py::class_<registration::ICPEngine> icp_engine(
+            m, "ICPEngine",
+            "Stateful ICP for registering any number of sources against the "
+            "same target. The target KDTree is built once and working buffers "
+            "are reused across calls.");
+    icp_engine
+            .def(py::init<const geometry::PointCloud &>(), "target"_a,
+                 py::keep_alive<1, 2>())
+            .def("set_target", &registration::ICPEngine::SetTarget,
+                 "Function to set the target point cloud.", "target"_a,
+                 py::keep_alive<1, 2>())
+            .def("compute", &registration::ICPEngine::Compute,
+                 "Function for ICP registration against the target.",
+                 "source"_a, "max_correspondence_distance"_a,
+                 "init"_a = Eigen::Matrix4d::Identity(),
+                 "estimation_method"_a =
+                         registration::TransformationEstimationPointToPoint(
+                                 false),
+                 "criteria"_a = registration::ICPConvergenceCriteria())
+            .def("__repr__", [](const registration::ICPEngine &e) {
+                return std::string("registration::ICPEngine");
+            });
+    docstring::ClassMethodDocInject(m, "ICPEngine", "set_target",
+                                    {{"target", "The target point cloud."}});
+    docstring::ClassMethodDocInject(
+            m, "ICPEngine", "compute",
+            {{"source", "The source point cloud."},
+             {"max_correspondence_distance",
+              "Maximum correspondence points-pair distance."},
+             {"init", "Initial transformation estimation"},
+             {"estimation_method",
+              "Estimation method. One of "
+              "(``registration::TransformationEstimationPointToPoint``, "
+              "``registration::TransformationEstimationPointToPlane``)."},
+             {"criteria", "Convergence criteria"}});
+
+    // open3d.registration.MultiScalePointCloud
+    py::class_<registration::MultiScalePointCloud,
+               std::shared_ptr<registration::MultiScalePointCloud>>
+            multi_scale_point_cloud(
+                    m, "MultiScalePointCloud",
+                    "Point cloud preprocessed for multi-scale ICP: one voxel "
+                    "downsampled level with normals, KDTree and color "
+                    "gradients per voxel size, from coarse to fine.");
+    multi_scale_point_cloud
+            .def(py::init<const geometry::PointCloud &,
+                          const std::vector<double> &>(),
+                 "cloud"_a, "voxel_sizes"_a)
+            .def("get_level_count",
+                 &registration::MultiScalePointCloud::GetLevelCount,
+                 "Returns the number of levels.")
+            .def(
+                    "get_level",
+                    [](const registration::MultiScalePointCloud &msc,
+                       size_t level) {
+                        return std::make_shared<geometry::PointCloud>(
+                                *msc.levels_.at(level));
+                    },
+                    "Returns a copy of the downsampled point cloud of a "
+                    "level. Changing it does not affect the level.",
+                    "level"_a)
+            .def("__repr__", [](const registration::MultiScalePointCloud &msc) {
+                return std::string("registration::MultiScalePointCloud with ") +
+                       std::to_string(msc.GetLevelCount()) +
+                       std::string(" levels.");
+            });
+    docstring::ClassMethodDocInject(m, "MultiScalePointCloud",
+                                    "get_level_count");
+    docstring::ClassMethodDocInject(m, "MultiScalePointCloud", "get_level",
+                                    {{"level", "Index of the level."}});
 }
 
 // Registration functions have similar arguments, sharing arg docstrings
@@ -507,14 +597,23 @@ static const std::unordered_map<std::string, std::string>
                  "``registration::TransformationEstimationPointToPlane``)"},
                 {"init", "Initial transformation estimation"},
                 {"lambda_geometric", "lambda_geometric value"},
+                {"max_correspondence_distances",
+                 "Maximum correspondence points-pair distance of each "
+                 "level."},
                 {"max_correspondence_distance",
                  "Maximum correspondence points-pair distance."},
                 {"option", "Registration option"},
                 {"ransac_n", "Fit ransac with ``ransac_n`` correspondences"},
+                {"seed",
+                 "Random seed. The same seed gives the same result. A "
+                 "negative seed draws one from the current time."},
                 {"source_feature", "Source point cloud feature."},
                 {"source", "The source point cloud."},
                 {"target_feature", "Target point cloud feature."},
                 {"target", "The target point cloud."},
+                {"target_color_gradients",
+                 "Color gradients of ``target`` precomputed by "
+                 "compute_color_gradients, or ``None`` to compute them."},
                 {"transformation",
                  "The 4x4 transformation matrix to transform ``source`` to "
                  "``target``"}};
@@ -537,15 +636,59 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_icp",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_colored_icp", &registration::RegistrationColoredICP,
+    m.def("registration_colored_icp",
+          [](const geometry::PointCloud &source,
+             const geometry::PointCloud &target,
+             double max_correspondence_distance, const Eigen::Matrix4d &init,
+             const registration::ICPConvergenceCriteria &criteria,
+             double lambda_geometric,
+             const std::vector<Eigen::Vector3d> *target_color_gradients) {
+              if (target_color_gradients == nullptr) {
+                  return registration::RegistrationColoredICP(
+                          source, target, max_correspondence_distance, init,
+                          criteria, lambda_geometric);
+              }
+              return registration::RegistrationColoredICP(
+                      source, target, *target_color_gradients,
+                      max_correspondence_distance, init, criteria,
+                      lambda_geometric);
+          },
           "Function for Colored ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
           "criteria"_a = registration::ICPConvergenceCriteria(),
-          "lambda_geometric"_a = 0.968);
+          "lambda_geometric"_a = 0.968, "target_color_gradients"_a = nullptr);
     docstring::FunctionDocInject(m, "registration_colored_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("compute_color_gradients", &registration::ComputeColorGradients,
+          "Function to compute the color gradients of a target point cloud "
+          "for Colored ICP",
+          "target"_a, "search_param"_a);
+    docstring::FunctionDocInject(
+            m, "compute_color_gradients",
+            {{"target", "The target point cloud with normals and colors."},
+             {"search_param", "KDTree hybrid search parameter."}});
+
+    m.def("registration_multi_scale_icp",
+          &registration::RegistrationMultiScaleICP,
+          "Function for coarse-to-fine ICP registration", "source"_a,
+          "target"_a, "max_correspondence_distances"_a, "criteria"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationPointToPlane());
+    docstring::FunctionDocInject(m, "registration_multi_scale_icp",
+                                 map_shared_argument_docstrings);
+
+    m.def("registration_multi_scale_colored_icp",
+          &registration::RegistrationMultiScaleColoredICP,
+          "Function for coarse-to-fine Colored ICP registration", "source"_a,
+          "target"_a, "max_correspondence_distances"_a, "criteria"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "lambda_geometric"_a = 0.968);
+    docstring::FunctionDocInject(m, "registration_multi_scale_colored_icp",
+                                 map_shared_argument_docstrings);
+
     m.def("registration_ransac_based_on_correspondence",
           &registration::RegistrationRANSACBasedOnCorrespondence,
           "Function for global RANSAC registration based on a set of "
@@ -554,7 +697,8 @@ void pybind_registration_methods(py::module &m) {
           "estimation_method"_a =
                   registration::TransformationEstimationPointToPoint(false),
           "ransac_n"_a = 6,
-          "criteria"_a = registration::RANSACConvergenceCriteria());
+          "criteria"_a = registration::RANSACConvergenceCriteria(),
+          "seed"_a = -1);
     docstring::FunctionDocInject(m,
                                  "registration_ransac_based_on_correspondence",
                                  map_shared_argument_docstrings);
@@ -569,7 +713,8 @@ void pybind_registration_methods(py::module &m) {
           "ransac_n"_a = 4,
           "checkers"_a = std::vector<std::reference_wrapper<
                   const registration::CorrespondenceChecker>>(),
-          "criteria"_a = registration::RANSACConvergenceCriteria(100000, 100));
+          "criteria"_a = registration::RANSACConvergenceCriteria(100000, 100),
+          "seed"_a = -1);
     docstring::FunctionDocInject(
             m, "registration_ransac_based_on_feature_matching",
             map_shared_argument_docstrings);
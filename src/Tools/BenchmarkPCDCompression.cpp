@@ -0,0 +1,197 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <liblzf/lzf.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "Open3D/Open3D.h"
+
+void PrintHelp() {
+    using namespace open3d;
+    PrintOpen3DVersion();
+    // clang-format off
+    utility::PrintInfo("Usage:\n");
+    utility::PrintInfo("    > BenchmarkPCDCompression [options]\n");
+    utility::PrintInfo("      Compare the throughput of binary_compressed PCD writing and reading\n");
+    utility::PrintInfo("      against compressing the whole data with a single LZF call.\n");
+    utility::PrintInfo("\n");
+    utility::PrintInfo("Options:\n");
+    utility::PrintInfo("    --help, -h                : Print help information.\n");
+    utility::PrintInfo("    --points n                : Number of points of the synthetic map tile.\n");
+    utility::PrintInfo("    --repeat n                : Number of runs; the fastest run is reported.\n");
+    utility::PrintInfo("    --file filename           : Temporary file, benchmark.pcd by default.\n");
+    // clang-format on
+}
+
+/// A height field with normals and colors, as found in map tiles.
+open3d::geometry::PointCloud CreateMapTile(int num_points) {
+    open3d::geometry::PointCloud pointcloud;
+    pointcloud.points_.resize(num_points);
+    pointcloud.normals_.resize(num_points);
+    pointcloud.colors_.resize(num_points);
+    const int width = (int)std::sqrt((double)num_points) + 1;
+    for (int i = 0; i < num_points; i++) {
+        const double x = (i % width) * 0.05;
+        const double y = (i / width) * 0.05;
+        const double z = std::sin(x * 0.3) * std::cos(y * 0.2);
+        pointcloud.points_[i] = Eigen::Vector3d(x, y, z);
+        pointcloud.normals_[i] = Eigen::Vector3d(-0.3 * std::cos(x * 0.3),
+                                                 0.2 * std::sin(y * 0.2), 1.0)
+                                         .normalized();
+        pointcloud.colors_[i] = Eigen::Vector3d(0.5 + 0.5 * z, 0.5, 0.2);
+    }
+    return pointcloud;
+}
+
+/// The previous binary_compressed writer: one float buffer with all fields
+/// and a single lzf_compress call.
+bool WriteSingleBlock(const std::string &filename,
+                      const open3d::geometry::PointCloud &pointcloud) {
+    const size_t num_points = pointcloud.points_.size();
+    const size_t buffer_size = 7 * num_points;
+    std::vector<float> buffer(buffer_size);
+    std::vector<float> buffer_compressed(buffer_size * 2);
+    for (size_t i = 0; i < num_points; i++) {
+        for (int c = 0; c < 3; c++) {
+            buffer[c * num_points + i] = (float)pointcloud.points_[i](c);
+            buffer[(c + 3) * num_points + i] =
+                    (float)pointcloud.normals_[i](c);
+        }
+        uint8_t rgba[4] = {0, 0, 0, 0};
+        for (int c = 0; c < 3; c++) {
+            rgba[2 - c] = (uint8_t)std::max(
+                    std::min((int)(pointcloud.colors_[i](c) * 255.0), 255),
+                    0);
+        }
+        memcpy(&buffer[6 * num_points + i], rgba, 4);
+    }
+    const uint32_t size = (uint32_t)(buffer_size * sizeof(float));
+    const uint32_t size_compressed =
+            lzf_compress(buffer.data(), size, buffer_compressed.data(),
+                         size * 2);
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL || size_compressed == 0) {
+        return false;
+    }
+    fwrite(&size_compressed, sizeof(size_compressed), 1, file);
+    fwrite(&size, sizeof(size), 1, file);
+    fwrite(buffer_compressed.data(), 1, size_compressed, file);
+    fclose(file);
+    return true;
+}
+
+/// The previous binary_compressed reader: a single lzf_decompress call and a
+/// serial unpacking of the fields.
+bool ReadSingleBlock(const std::string &filename,
+                     open3d::geometry::PointCloud &pointcloud) {
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    uint32_t sizes[2];
+    if (fread(sizes, sizeof(uint32_t), 2, file) != 2) {
+        fclose(file);
+        return false;
+    }
+    std::vector<char> buffer_compressed(sizes[0]);
+    std::vector<float> buffer(sizes[1] / sizeof(float));
+    const bool success =
+            fread(buffer_compressed.data(), 1, sizes[0], file) == sizes[0] &&
+            lzf_decompress(buffer_compressed.data(), sizes[0], buffer.data(),
+                           sizes[1]) == sizes[1];
+    fclose(file);
+    const size_t num_points = buffer.size() / 7;
+    pointcloud.points_.resize(num_points);
+    pointcloud.normals_.resize(num_points);
+    pointcloud.colors_.resize(num_points);
+    for (size_t i = 0; i < num_points; i++) {
+        for (int c = 0; c < 3; c++) {
+            pointcloud.points_[i](c) = buffer[c * num_points + i];
+            pointcloud.normals_[i](c) = buffer[(c + 3) * num_points + i];
+        }
+        uint8_t rgba[4];
+        memcpy(rgba, &buffer[6 * num_points + i], 4);
+        pointcloud.colors_[i] =
+                Eigen::Vector3d(rgba[2], rgba[1], rgba[0]) / 255.0;
+    }
+    return success;
+}
+
+int main(int argc, char **argv) {
+    using namespace open3d;
+
+    utility::SetVerbosityLevel(utility::VerbosityLevel::VerboseAlways);
+    if (utility::ProgramOptionExistsAny(argc, argv, {"-h", "--help"})) {
+        PrintHelp();
+        return 0;
+    }
+    const int num_points =
+            utility::GetProgramOptionAsInt(argc, argv, "--points", 4000000);
+    const int repeat =
+            utility::GetProgramOptionAsInt(argc, argv, "--repeat", 3);
+    const std::string filename = utility::GetProgramOptionAsString(
+            argc, argv, "--file", "benchmark.pcd");
+
+    const geometry::PointCloud pointcloud = CreateMapTile(num_points);
+    const double megabytes = 7.0 * 4.0 * num_points / (1024.0 * 1024.0);
+    double times[4] = {1e30, 1e30, 1e30, 1e30};
+    utility::Timer timer;
+    for (int r = 0; r < repeat; r++) {
+        geometry::PointCloud result;
+        utility::SetVerbosityLevel(utility::VerbosityLevel::VerboseError);
+        timer.Start();
+        WriteSingleBlock(filename, pointcloud);
+        timer.Stop();
+        times[0] = std::min(times[0], timer.GetDuration());
+        timer.Start();
+        ReadSingleBlock(filename, result);
+        timer.Stop();
+        times[1] = std::min(times[1], timer.GetDuration());
+        timer.Start();
+        io::WritePointCloudToPCD(filename, pointcloud, false, true);
+        timer.Stop();
+        times[2] = std::min(times[2], timer.GetDuration());
+        timer.Start();
+        io::ReadPointCloudFromPCD(filename, result);
+        timer.Stop();
+        times[3] = std::min(times[3], timer.GetDuration());
+        utility::SetVerbosityLevel(utility::VerbosityLevel::VerboseAlways);
+    }
+    std::remove(filename.c_str());
+
+    utility::PrintInfo("%d points, %.1f MB of uncompressed data.\n",
+                       num_points, megabytes);
+    const char *const names[4] = {"single block write", "single block read",
+                                  "WritePointCloudToPCD",
+                                  "ReadPointCloudFromPCD"};
+    for (int i = 0; i < 4; i++) {
+        utility::PrintInfo("%-22s: %8.1f ms, %7.1f MB/s\n", names[i], times[i],
+                           megabytes / times[i] * 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/CompactPointCloud.h"
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+/// Random point cloud whose coordinates, normals and colors are exactly
+/// representable in a CompactPointCloud.
+geometry::PointCloud CreateRandomPointCloud(int size) {
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Zero3d, Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(pc.colors_, Zero3d, Vector3d(255.0, 255.0, 255.0), 2);
+    for (int i = 0; i < size; i++) {
+        pc.normals_[i].normalize();
+        for (int c = 0; c < 3; c++) {
+            pc.points_[i](c) = (double)(float)pc.points_[i](c);
+            pc.normals_[i](c) = (double)(float)pc.normals_[i](c);
+            pc.colors_[i](c) = std::floor(pc.colors_[i](c)) / 255.0;
+        }
+    }
+    return pc;
+}
+
+void ExpectNear(const vector<Vector3d> &v0,
+                const vector<Vector3d> &v1,
+                double threshold) {
+    ASSERT_EQ(v0.size(), v1.size());
+    for (size_t i = 0; i < v0.size(); i++) {
+        for (int c = 0; c < 3; c++) {
+            EXPECT_NEAR(v0[i](c), v1[i](c), threshold);
+        }
+    }
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, Constructor) {
+    geometry::CompactPointCloud pc;
+
+    EXPECT_EQ(geometry::Geometry::GeometryType::CompactPointCloud,
+              pc.GetGeometryType());
+    EXPECT_EQ(3, pc.Dimension());
+
+    EXPECT_EQ(0, pc.GetNumberOfPoints());
+    EXPECT_TRUE(pc.IsEmpty());
+
+    ExpectEQ(Zero3d, pc.GetMinBound());
+    ExpectEQ(Zero3d, pc.GetMaxBound());
+
+    EXPECT_FALSE(pc.HasPoints());
+    EXPECT_FALSE(pc.HasNormals());
+    EXPECT_FALSE(pc.HasColors());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, ConvertPointCloud) {
+    int size = 100;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+
+    geometry::CompactPointCloud compact(pc);
+    EXPECT_EQ(size, compact.GetNumberOfPoints());
+    EXPECT_TRUE(compact.HasNormals());
+    EXPECT_TRUE(compact.HasColors());
+    ExpectEQ(pc.GetMinBound(), compact.GetMinBound());
+    ExpectEQ(pc.GetMaxBound(), compact.GetMaxBound());
+
+    auto converted = compact.ToPointCloud();
+    ExpectEQ(pc.points_, converted->points_);
+    ExpectEQ(pc.normals_, converted->normals_);
+    ExpectEQ(pc.colors_, converted->colors_);
+
+    compact.Clear();
+    EXPECT_TRUE(compact.IsEmpty());
+    EXPECT_FALSE(compact.HasNormals());
+    EXPECT_FALSE(compact.HasColors());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, Transform) {
+    int size = 100;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+    geometry::CompactPointCloud compact(pc);
+
+    Matrix4d transformation;
+    transformation << 0.10, 0.20, 0.30, 0.40, 0.50, 0.60, 0.70, 0.80, 0.90,
+            0.10, 0.11, 0.12, 0.0, 0.0, 0.0, 1.0;
+
+    pc.Transform(transformation);
+    compact.Transform(transformation);
+    auto converted = compact.ToPointCloud();
+    ExpectNear(pc.points_, converted->points_, 1e-5);
+    ExpectNear(pc.normals_, converted->normals_, 1e-6);
+
+    pc.Rotate(Vector3d(0.1, 0.2, 0.3));
+    compact.Rotate(Vector3d(0.1, 0.2, 0.3));
+    pc.Translate(Vector3d(1.0, -2.0, 3.0));
+    compact.Translate(Vector3d(1.0, -2.0, 3.0));
+    pc.Scale(2.0);
+    compact.Scale(2.0);
+    converted = compact.ToPointCloud();
+    ExpectNear(pc.points_, converted->points_, 1e-5);
+    ExpectNear(pc.normals_, converted->normals_, 1e-6);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, VoxelDownSample) {
+    int size = 1000;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+    geometry::CompactPointCloud compact(pc);
+
+    double voxel_size = 2.5;
+    auto output_pc = geometry::VoxelDownSample(pc, voxel_size);
+    auto output_compact = geometry::VoxelDownSample(compact, voxel_size);
+    EXPECT_EQ(output_pc->points_.size(), output_compact->GetNumberOfPoints());
+
+    // Both clouds order their output points by voxel.
+    auto converted = output_compact->ToPointCloud();
+    ExpectNear(output_pc->points_, converted->points_, 1e-5);
+    ExpectNear(output_pc->normals_, converted->normals_, 1e-6);
+    ExpectNear(output_pc->colors_, converted->colors_, 0.5 / 255.0 + 1e-9);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, EstimateNormals) {
+    int size = 500;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+    // Flatten the points into a thin slab so that the normals are well
+    // conditioned and insensitive to the float precision of the search.
+    for (int i = 0; i < size; i++) {
+        Vector3d &point = pc.points_[i];
+        point(2) = (double)(float)(0.2 * point(0) + 0.1 * point(1) +
+                                   0.01 * point(2));
+    }
+    geometry::CompactPointCloud compact(pc);
+
+    geometry::KDTreeSearchParamHybrid param(2.0, 20);
+    geometry::EstimateNormals(pc, param);
+    geometry::EstimateNormals(compact, param);
+
+    auto converted = compact.ToPointCloud();
+    ExpectNear(pc.normals_, converted->normals_, 1e-5);
+
+    // Without input normals the estimates are the same up to orientation.
+    geometry::CompactPointCloud unoriented(pc);
+    unoriented.Resize(size, false, true);
+    geometry::EstimateNormals(unoriented, param);
+    EXPECT_TRUE(unoriented.HasNormals());
+    for (int i = 0; i < size; i++) {
+        EXPECT_NEAR(std::abs(unoriented.GetNormal(i).dot(pc.normals_[i])), 1.0,
+                    1e-5);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, KDTreeFlann) {
+    int size = 100;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+    geometry::CompactPointCloud compact(pc);
+
+    geometry::KDTreeFlann kdtree_pc(pc);
+    geometry::KDTreeFlann kdtree_compact(compact);
+    for (int i = 0; i < size; i += 7) {
+        vector<int> indices_pc, indices_compact;
+        vector<double> distance2_pc, distance2_compact;
+        kdtree_pc.SearchKNN(pc.points_[i], 5, indices_pc, distance2_pc);
+        kdtree_compact.SearchKNN(pc.points_[i], 5, indices_compact,
+                                 distance2_compact);
+        ExpectEQ(indices_pc, indices_compact);
+        // the compact index computes the distances in float
+        ASSERT_EQ(distance2_pc.size(), distance2_compact.size());
+        for (size_t k = 0; k < distance2_pc.size(); k++) {
+            EXPECT_NEAR(distance2_pc[k], distance2_compact[k], 1e-5);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloud, CreateFromDepthAndRGBDImage) {
+    int width = 16;
+    int height = 12;
+    geometry::Image depth;
+    depth.PrepareImage(width, height, 1, 2);
+    Rand(depth.data_, 0, 20, 0);
+    geometry::Image color;
+    color.PrepareImage(width, height, 3, 1);
+    Rand(color.data_, 0, 255, 1);
+
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 20.0, 20.0, 8.0,
+                                             6.0);
+    Matrix4d extrinsic = Matrix4d::Identity();
+    extrinsic.block<3, 1>(0, 3) = Vector3d(0.1, 0.2, 0.3);
+
+    auto pc = geometry::CreatePointCloudFromDepthImage(
+            depth, intrinsic, extrinsic, 1000.0, 4.0, 2);
+    auto compact = geometry::CreateCompactPointCloudFromDepthImage(
+            depth, intrinsic, extrinsic, 1000.0, 4.0, 2);
+    EXPECT_LT(0, pc->points_.size());
+    EXPECT_FALSE(compact->HasNormals());
+    EXPECT_FALSE(compact->HasColors());
+    ExpectNear(pc->points_, compact->ToPointCloud()->points_, 1e-6);
+
+    auto float_depth = geometry::ConvertDepthToFloatImage(depth, 1000.0, 4.0);
+    geometry::RGBDImage rgbd(color, *float_depth);
+    auto rgbd_pc = geometry::CreatePointCloudFromRGBDImage(rgbd, intrinsic,
+                                                           extrinsic);
+    auto rgbd_compact = geometry::CreateCompactPointCloudFromRGBDImage(
+            rgbd, intrinsic, extrinsic);
+    EXPECT_TRUE(rgbd_compact->HasColors());
+    auto rgbd_converted = rgbd_compact->ToPointCloud();
+    ExpectNear(rgbd_pc->points_, rgbd_converted->points_, 1e-6);
+    ExpectEQ(rgbd_pc->colors_, rgbd_converted->colors_);
+}
@@ -740,6 +740,41 @@ TEST(Image, DownsampleImage) {
     ExpectEQ(ref, output->data_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Image, FilterAndDownsampleImage) {
+    geometry::Image image;
+
+    // test image dimensions
+    int width = 7;
+    int height = 5;
+    int num_of_channels = 1;
+    int bytes_per_channel = 4;
+
+    image.PrepareImage(width, height, num_of_channels, bytes_per_channel);
+
+    Rand(image.data_, 0, 255, 0);
+
+    auto float_image = CreateFloatImageFromImage(image);
+
+    vector<FilterType> filters = {FilterType::Gaussian3, FilterType::Gaussian5,
+                                  FilterType::Gaussian7, FilterType::Sobel3Dx,
+                                  FilterType::Sobel3Dy};
+    for (const auto& filter : filters) {
+        auto ref = geometry::DownsampleImage(
+                *geometry::FilterImage(*float_image, filter));
+        auto output = geometry::FilterAndDownsampleImage(*float_image, filter);
+
+        EXPECT_FALSE(output->IsEmpty());
+        EXPECT_EQ((int)(width / 2), output->width_);
+        EXPECT_EQ((int)(height / 2), output->height_);
+        EXPECT_EQ(num_of_channels, output->num_of_channels_);
+        EXPECT_EQ(bytes_per_channel, output->bytes_per_channel_);
+        ExpectEQ(ref->data_, output->data_);
+    }
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -1015,3 +1050,120 @@ TEST(Image, CreateImagePyramid) {
         expected_height /= 2;
     }
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Image, CreateImagePyramid_InPlace) {
+    geometry::Image image;
+    image.PrepareImage(12, 10, 1, 4);
+    Rand(image.data_, 0, 255, 0);
+    auto float_image = CreateFloatImageFromImage(image);
+
+    int num_of_levels = 3;
+    auto ref = geometry::CreateImagePyramid(*float_image, num_of_levels);
+
+    geometry::ImagePyramid pyramid;
+    EXPECT_TRUE(geometry::CreateImagePyramid(*float_image, num_of_levels, true,
+                                             pyramid));
+    vector<const uint8_t*> buffers;
+    for (const auto& level : pyramid) {
+        buffers.push_back(level->data_.data());
+    }
+
+    // a level shared with another owner must not be overwritten
+    auto shared_level = pyramid[1];
+    shared_level->data_[0]++;
+    auto shared_data = shared_level->data_;
+    EXPECT_TRUE(geometry::CreateImagePyramid(*float_image, num_of_levels, true,
+                                             pyramid));
+    EXPECT_EQ(num_of_levels, pyramid.size());
+    EXPECT_EQ(buffers[0], pyramid[0]->data_.data());
+    EXPECT_NE(shared_level, pyramid[1]);
+    EXPECT_EQ(buffers[2], pyramid[2]->data_.data());
+    ExpectEQ(shared_data, shared_level->data_);
+    for (int p = 0; p < num_of_levels; p++) {
+        EXPECT_EQ(ref[p]->width_, pyramid[p]->width_);
+        EXPECT_EQ(ref[p]->height_, pyramid[p]->height_);
+        ExpectEQ(ref[p]->data_, pyramid[p]->data_);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Image, FilterImage_OutputParameter) {
+    geometry::Image image;
+    image.PrepareImage(9, 7, 1, 1);
+    Rand(image.data_, 0, 255, 0);
+    auto float_image = CreateFloatImageFromImage(image);
+
+    geometry::Image output;
+    EXPECT_TRUE(geometry::FilterImage(*float_image, FilterType::Sobel3Dx,
+                                      output));
+    const uint8_t* buffer = output.data_.data();
+    auto ref = geometry::FilterImage(*float_image, FilterType::Gaussian5);
+    EXPECT_TRUE(geometry::FilterImage(*float_image, FilterType::Gaussian5,
+                                      output));
+    EXPECT_EQ(buffer, output.data_.data());
+    EXPECT_EQ(ref->width_, output.width_);
+    EXPECT_EQ(ref->height_, output.height_);
+    ExpectEQ(ref->data_, output.data_);
+
+    // unsupported input leaves the output untouched
+    EXPECT_FALSE(geometry::FilterImage(image, FilterType::Gaussian5, output));
+    ExpectEQ(ref->data_, output.data_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Image, ImageView_Crop) {
+    geometry::Image image;
+    int width = 10;
+    int height = 8;
+    image.PrepareImage(width, height, 1, 4);
+    float* const im = Cast<float>(&image.data_[0]);
+    for (int i = 0; i < width * height; i++) {
+        im[i] = (float)((i * 7) % 13);
+    }
+
+    geometry::ImageView view(image);
+    EXPECT_FALSE(view.IsEmpty());
+    EXPECT_EQ(width * 4, view.stride_);
+
+    auto crop = view.Crop(3, 2, 5, 4);
+    EXPECT_EQ(5, crop.width_);
+    EXPECT_EQ(4, crop.height_);
+    EXPECT_EQ(view.stride_, crop.stride_);
+    EXPECT_EQ(*geometry::PointerAt<float>(image, 3, 2),
+              *crop.PointerAt<float>(0, 0));
+    EXPECT_EQ(*geometry::PointerAt<float>(image, 7, 5),
+              *crop.PointerAt<float>(4, 3));
+
+    // crops are clipped to the image boundary
+    auto clipped = view.Crop(8, -1, 5, 4);
+    EXPECT_EQ(2, clipped.width_);
+    EXPECT_EQ(3, clipped.height_);
+    EXPECT_TRUE(view.Crop(20, 0, 5, 4).IsEmpty());
+
+    auto copy = geometry::CreateImageFromImageView(crop);
+    EXPECT_EQ(5, copy->width_);
+    EXPECT_EQ(4, copy->height_);
+    for (int v = 0; v < 4; v++) {
+        for (int u = 0; u < 5; u++) {
+            EXPECT_EQ(*geometry::PointerAt<float>(image, u + 3, v + 2),
+                      *geometry::PointerAt<float>(*copy, u, v));
+        }
+    }
+
+    // filtering a view gives the same result as filtering a copy
+    geometry::Image output;
+    EXPECT_TRUE(geometry::FilterImage(crop, FilterType::Gaussian3, output));
+    auto ref = geometry::FilterImage(*copy, FilterType::Gaussian3);
+    ExpectEQ(ref->data_, output.data_);
+    EXPECT_TRUE(geometry::FilterAndDownsampleImage(crop, FilterType::Gaussian3,
+                                                   output));
+    ref = geometry::FilterAndDownsampleImage(*copy, FilterType::Gaussian3);
+    ExpectEQ(ref->data_, output.data_);
+}
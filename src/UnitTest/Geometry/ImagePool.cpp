@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+
+#include "Open3D/Geometry/ImagePool.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ImagePool, Acquire) {
+    geometry::ImagePool pool;
+
+    auto image = pool.Acquire(16, 8, 1, 4);
+    EXPECT_EQ(16, image->width_);
+    EXPECT_EQ(8, image->height_);
+    EXPECT_EQ(1, image->num_of_channels_);
+    EXPECT_EQ(4, image->bytes_per_channel_);
+    EXPECT_EQ(16 * 8 * 4, image->data_.size());
+
+    // an image in use is never handed out twice
+    auto other = pool.Acquire(16, 8, 1, 4);
+    EXPECT_NE(image, other);
+    EXPECT_EQ(2, pool.GetNumberOfImages());
+
+    // a released image is recycled for the same format only
+    const geometry::Image* released = image.get();
+    image.reset();
+    auto different = pool.Acquire(8, 8, 1, 4);
+    EXPECT_NE(released, different.get());
+    auto recycled = pool.Acquire(16, 8, 1, 4);
+    EXPECT_EQ(released, recycled.get());
+    EXPECT_EQ(3, pool.GetNumberOfImages());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ImagePool, Shrink) {
+    geometry::ImagePool pool;
+
+    auto image = pool.Acquire(16, 8, 3, 1);
+    pool.Acquire(16, 8, 3, 1);
+    pool.Acquire(4, 4, 1, 2);
+    EXPECT_EQ(3, pool.GetNumberOfImages());
+
+    pool.Shrink();
+    EXPECT_EQ(1, pool.GetNumberOfImages());
+
+    pool.Clear();
+    EXPECT_EQ(0, pool.GetNumberOfImages());
+    EXPECT_EQ(16 * 8 * 3, image->data_.size());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ImagePool, Reformat) {
+    geometry::ImagePool pool;
+
+    // an image reformatted while in use returns under its new format
+    auto image = pool.Acquire(16, 8, 1, 4);
+    const geometry::Image* reformatted = image.get();
+    image->PrepareImage(4, 4, 3, 1);
+    image.reset();
+    auto other = pool.Acquire(16, 8, 1, 4);
+    EXPECT_NE(reformatted, other.get());
+    EXPECT_EQ(16 * 8 * 4, other->data_.size());
+    auto recycled = pool.Acquire(4, 4, 3, 1);
+    EXPECT_EQ(reformatted, recycled.get());
+    EXPECT_EQ(4 * 4 * 3, recycled->data_.size());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ImagePool, OutlivePool) {
+    shared_ptr<geometry::Image> image;
+    {
+        geometry::ImagePool pool;
+        image = pool.Acquire(16, 8, 1, 4);
+        auto cleared = pool.Acquire(16, 8, 1, 4);
+        pool.Clear();
+        cleared.reset();
+        EXPECT_EQ(0, pool.GetNumberOfImages());
+    }
+    EXPECT_EQ(16 * 8 * 4, image->data_.size());
+    image.reset();
+}
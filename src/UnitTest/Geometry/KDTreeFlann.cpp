@@ -156,3 +156,137 @@ TEST(KDTreeFlann, SearchHybrid) {
     ExpectEQ(ref_indices, indices);
     ExpectEQ(ref_distance2, distance2);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(KDTreeFlann, SearchKNNBatch) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    vector<Vector3d> queries(50);
+    Rand(queries, vmin, vmax, 1);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    int knn = 30;
+    geometry::KDTreeSearchResult neighbors;
+
+    int result = kdtree.SearchKNNBatch(queries, knn, neighbors);
+
+    EXPECT_EQ(result, knn * (int)queries.size());
+    EXPECT_EQ(queries.size(), neighbors.GetQueryCount());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        vector<int> indices;
+        vector<double> distance2;
+        kdtree.SearchKNN(queries[i], knn, indices, distance2);
+
+        EXPECT_EQ((int)indices.size(), neighbors.GetNeighborCount(i));
+        ExpectEQ(indices, vector<int>(neighbors.GetIndices(i),
+                                      neighbors.GetIndices(i) +
+                                              neighbors.GetNeighborCount(i)));
+        ExpectEQ(distance2,
+                 vector<double>(neighbors.GetDistance2(i),
+                                neighbors.GetDistance2(i) +
+                                        neighbors.GetNeighborCount(i)));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(KDTreeFlann, SearchRadiusBatch) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    vector<Vector3d> queries(50);
+    Rand(queries, vmin, vmax, 1);
+
+    // one query per column
+    MatrixXd query_matrix(3, queries.size());
+    for (size_t i = 0; i < queries.size(); i++) query_matrix.col(i) = queries[i];
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    double radius = 3.0;
+    geometry::KDTreeSearchResult neighbors;
+
+    int result = kdtree.SearchRadiusBatch(query_matrix, radius, neighbors);
+
+    EXPECT_EQ(result, (int)neighbors.indices_.size());
+    EXPECT_EQ(queries.size(), neighbors.GetQueryCount());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        vector<int> indices;
+        vector<double> distance2;
+        kdtree.SearchRadius(queries[i], radius, indices, distance2);
+
+        EXPECT_EQ((int)indices.size(), neighbors.GetNeighborCount(i));
+        ExpectEQ(indices, vector<int>(neighbors.GetIndices(i),
+                                      neighbors.GetIndices(i) +
+                                              neighbors.GetNeighborCount(i)));
+        ExpectEQ(distance2,
+                 vector<double>(neighbors.GetDistance2(i),
+                                neighbors.GetDistance2(i) +
+                                        neighbors.GetNeighborCount(i)));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(KDTreeFlann, SearchHybridBatch) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    vector<Vector3d> queries(50);
+    Rand(queries, vmin, vmax, 1);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    int max_nn = 5;
+    double radius = 3.0;
+    geometry::KDTreeSearchResult neighbors;
+
+    kdtree.SearchBatch(queries, geometry::KDTreeSearchParamHybrid(radius, max_nn),
+                       neighbors);
+
+    EXPECT_EQ(queries.size(), neighbors.GetQueryCount());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        vector<int> indices;
+        vector<double> distance2;
+        kdtree.SearchHybrid(queries[i], radius, max_nn, indices, distance2);
+
+        EXPECT_EQ((int)indices.size(), neighbors.GetNeighborCount(i));
+        ExpectEQ(indices, vector<int>(neighbors.GetIndices(i),
+                                      neighbors.GetIndices(i) +
+                                              neighbors.GetNeighborCount(i)));
+        ExpectEQ(distance2,
+                 vector<double>(neighbors.GetDistance2(i),
+                                neighbors.GetDistance2(i) +
+                                        neighbors.GetNeighborCount(i)));
+    }
+}
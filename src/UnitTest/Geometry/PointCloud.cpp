@@ -24,7 +24,10 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
@@ -582,6 +585,125 @@ TEST(PointCloud, VoxelDownSample) {
     ExpectEQ(ref_colors, output_pc->colors_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, VoxelDownSampleAndIndex) {
+    int size = 1000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    pc.colors_.resize(size);
+
+    Rand(pc.points_, Zero3d, Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.colors_, Zero3d, Vector3d(1.0, 1.0, 1.0), 1);
+
+    double voxel_size = 1.5;
+    shared_ptr<geometry::PointCloud> output_pc;
+    vector<int> point_to_voxel;
+    tie(output_pc, point_to_voxel) =
+            geometry::VoxelDownSampleAndIndex(pc, voxel_size);
+    auto ref_pc = geometry::VoxelDownSample(pc, voxel_size);
+
+    EXPECT_EQ(ref_pc->points_.size(), output_pc->points_.size());
+    EXPECT_EQ(pc.points_.size(), point_to_voxel.size());
+
+    // every output point is the average of the input points mapped onto it
+    vector<Vector3d> sum_points(output_pc->points_.size(), Zero3d);
+    vector<Vector3d> sum_colors(output_pc->colors_.size(), Zero3d);
+    vector<int> count(output_pc->points_.size(), 0);
+    for (size_t i = 0; i < pc.points_.size(); i++) {
+        int v = point_to_voxel[i];
+        EXPECT_GE(v, 0);
+        EXPECT_LT(v, (int)output_pc->points_.size());
+        sum_points[v] += pc.points_[i];
+        sum_colors[v] += pc.colors_[i];
+        count[v]++;
+    }
+    for (size_t v = 0; v < output_pc->points_.size(); v++) {
+        EXPECT_GT(count[v], 0);
+        ExpectEQ(Vector3d(sum_points[v] / count[v]), output_pc->points_[v]);
+        ExpectEQ(Vector3d(sum_colors[v] / count[v]), output_pc->colors_[v]);
+    }
+
+    Sort::Do(output_pc->points_);
+    Sort::Do(ref_pc->points_);
+    ExpectEQ(ref_pc->points_, output_pc->points_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, VoxelDownSampleAndTrace) {
+    int size = 1000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    pc.colors_.resize(size);
+
+    Rand(pc.points_, Zero3d, Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.colors_, Zero3d, Vector3d(1.0, 1.0, 1.0), 1);
+
+    // the grid starts inside the cloud, some points lie below it
+    double voxel_size = 1.5;
+    Vector3d min_bound(1.0, -1.0, 2.0);
+    Vector3d max_bound(12.0, 12.0, 12.0);
+    shared_ptr<geometry::PointCloud> output_pc;
+    MatrixXi cubic_id;
+    tie(output_pc, cubic_id) = geometry::VoxelDownSampleAndTrace(
+            pc, voxel_size, min_bound, max_bound);
+
+    // group the points by voxel and by half-voxel sub-cube
+    map<tuple<int, int, int>, vector<int>> voxels;
+    vector<int> sub_cube(size);
+    for (int i = 0; i < size; i++) {
+        Vector3d ref_coord = (pc.points_[i] - min_bound) / voxel_size;
+        Vector3d voxel_coord = ref_coord.array().floor();
+        voxels[make_tuple((int)voxel_coord(0), (int)voxel_coord(1),
+                          (int)voxel_coord(2))]
+                .push_back(i);
+        sub_cube[i] = 0;
+        for (int c = 0; c < 3; c++) {
+            if (ref_coord(c) - voxel_coord(c) >= 0.5) {
+                sub_cube[i] += 1 << c;
+            }
+        }
+    }
+    ASSERT_EQ(voxels.size(), output_pc->points_.size());
+    ASSERT_EQ((int)voxels.size(), cubic_id.rows());
+    EXPECT_EQ(8, cubic_id.cols());
+
+    // every output point matches one voxel, and its row of cubic_id holds the
+    // last point of each sub-cube
+    vector<bool> matched(voxels.size(), false);
+    for (const auto &voxel : voxels) {
+        const vector<int> &points = voxel.second;
+        Vector3d average = Zero3d;
+        for (int i : points) {
+            average += pc.points_[i];
+        }
+        average /= (double)points.size();
+        int v = 0;
+        while (v < (int)output_pc->points_.size() &&
+               (output_pc->points_[v] - average).norm() > 1e-9) {
+            v++;
+        }
+        ASSERT_LT(v, (int)output_pc->points_.size());
+        EXPECT_FALSE(matched[v]);
+        matched[v] = true;
+
+        Vector3d color = Zero3d;
+        VectorXi expected = VectorXi::Constant(8, -1);
+        for (int i : points) {
+            color += pc.colors_[i];
+            expected(sub_cube[i]) = i;
+        }
+        ExpectEQ(Vector3d(color / (double)points.size()),
+                 output_pc->colors_[v]);
+        EXPECT_EQ(expected, VectorXi(cubic_id.row(v).transpose()));
+    }
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -989,6 +1111,50 @@ TEST(PointCloud, CreatePointCloudFromDepthImage) {
     ExpectEQ(ref, output_pc->points_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, CreatePointCloudFromDepthImage_StrideAndTrunc) {
+    geometry::Image image;
+
+    int width = 11;
+    int height = 9;
+    int stride = 2;
+    double depth_scale = 100.0;
+    double depth_trunc = 2.0;
+
+    image.PrepareImage(width, height, 1, 2);
+    uint16_t* const depth = Cast<uint16_t>(&image.data_[0]);
+    for (int i = 0; i < width * height; i++) {
+        depth[i] = (uint16_t)((i * 37) % 250);
+    }
+
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 20.0, 25.0, 5.0,
+                                             4.0);
+    Matrix4d extrinsic = Matrix4d::Identity();
+    extrinsic.block<3, 3>(0, 0) =
+            AngleAxisd(0.3, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    extrinsic.block<3, 1>(0, 3) = Vector3d(0.5, -1.0, 2.0);
+    Matrix4d camera_pose = extrinsic.inverse();
+
+    vector<Vector3d> ref;
+    for (int v = 0; v < height; v += stride) {
+        for (int u = 0; u < width; u += stride) {
+            float z = (float)depth[v * width + u] / (float)depth_scale;
+            if (z <= 0 || z >= depth_trunc) continue;
+            Vector4d point(((double)u - 5.0) * z / 20.0,
+                           ((double)v - 4.0) * z / 25.0, z, 1.0);
+            ref.push_back((camera_pose * point).block<3, 1>(0, 0));
+        }
+    }
+    EXPECT_LT(0, ref.size());
+
+    auto output_pc = geometry::CreatePointCloudFromDepthImage(
+            image, intrinsic, extrinsic, depth_scale, depth_trunc, stride);
+
+    ExpectEQ(ref, output_pc->points_);
+}
+
 // ----------------------------------------------------------------------------
 // Test CreatePointCloudFromRGBDImage for the following configurations:
 // index | color_num_of_channels | color_bytes_per_channel
@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+
+#include "Open3D/Geometry/CompactPointCloud.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/CompactPointCloudIO.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+geometry::CompactPointCloud CreateCompactPointCloud(int size) {
+    geometry::CompactPointCloud pc;
+    pc.Resize(size, true, true);
+    Rand(pc.x_, -10.0f, 10.0f, 0);
+    Rand(pc.y_, -10.0f, 10.0f, 1);
+    Rand(pc.z_, -10.0f, 10.0f, 2);
+    Rand(pc.nx_, -1.0f, 1.0f, 3);
+    Rand(pc.ny_, -1.0f, 1.0f, 4);
+    Rand(pc.nz_, -1.0f, 1.0f, 5);
+    Rand(pc.r_, 0, 255, 6);
+    Rand(pc.g_, 0, 255, 7);
+    Rand(pc.b_, 0, 255, 8);
+    return pc;
+}
+
+void ExpectNear(const std::vector<float> &v0,
+                const std::vector<float> &v1,
+                float threshold) {
+    ASSERT_EQ(v0.size(), v1.size());
+    for (size_t i = 0; i < v0.size(); i++) {
+        EXPECT_NEAR(v0[i], v1[i], threshold);
+    }
+}
+
+void ExpectNear(const geometry::CompactPointCloud &pc0,
+                const geometry::CompactPointCloud &pc1,
+                float threshold) {
+    ExpectNear(pc0.x_, pc1.x_, threshold);
+    ExpectNear(pc0.y_, pc1.y_, threshold);
+    ExpectNear(pc0.z_, pc1.z_, threshold);
+    ExpectNear(pc0.nx_, pc1.nx_, threshold);
+    ExpectNear(pc0.ny_, pc1.ny_, threshold);
+    ExpectNear(pc0.nz_, pc1.nz_, threshold);
+    ExpectEQ(pc0.r_, pc1.r_);
+    ExpectEQ(pc0.g_, pc1.g_);
+    ExpectEQ(pc0.b_, pc1.b_);
+}
+
+/// Binary files store the float values exactly; ASCII files only keep the
+/// digits printed by the writer, hence \param threshold.
+void WriteReadAndAssertEqual(const geometry::CompactPointCloud &src,
+                             const std::string &extension,
+                             bool write_ascii,
+                             bool compressed,
+                             float threshold = 0.0f) {
+    std::string file_name =
+            std::string(TEST_DATA_DIR) + "/temp_compact." + extension;
+    EXPECT_TRUE(io::WriteCompactPointCloud(file_name, src, write_ascii,
+                                           compressed));
+
+    geometry::CompactPointCloud dst;
+    EXPECT_TRUE(io::ReadCompactPointCloud(file_name, dst));
+    ExpectNear(src, dst, threshold);
+
+    // The files are interchangeable with PointCloud.
+    geometry::PointCloud pc;
+    EXPECT_TRUE(io::ReadPointCloud(file_name, pc));
+    ExpectNear(src, geometry::CompactPointCloud(pc), threshold);
+    EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloudIO, PLY) {
+    geometry::CompactPointCloud pc = CreateCompactPointCloud(100);
+    WriteReadAndAssertEqual(pc, "ply", false, false);
+    WriteReadAndAssertEqual(pc, "ply", true, false, 1e-4f);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(CompactPointCloudIO, PCD) {
+    geometry::CompactPointCloud pc = CreateCompactPointCloud(100);
+    WriteReadAndAssertEqual(pc, "pcd", false, false);
+    WriteReadAndAssertEqual(pc, "pcd", false, true);
+
+    // Only points.
+    pc.Resize(pc.GetNumberOfPoints(), false, false);
+    WriteReadAndAssertEqual(pc, "pcd", false, true);
+}
@@ -24,8 +24,61 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdio>
+
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Timer.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+
+namespace {
+
+registration::PoseGraph CreatePoseGraph(int num_nodes, int num_neighbors) {
+    registration::PoseGraph pose_graph;
+    for (int i = 0; i < num_nodes; i++) {
+        Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3d(0.1 * i, 0.01 * i, 0.3);
+        pose_graph.nodes_.push_back(registration::PoseGraphNode(pose));
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        for (int j = i + 1; j < std::min(num_nodes, i + 1 + num_neighbors);
+             j++) {
+            Eigen::Matrix6d information = Eigen::Matrix6d::Identity();
+            information(0, 1) = information(1, 0) = 0.1 * j;
+            pose_graph.edges_.push_back(registration::PoseGraphEdge(
+                    i, j, pose_graph.nodes_[j].pose_, information, j > i + 1,
+                    j > i + 1 ? 0.5 : 1.0));
+        }
+    }
+    return pose_graph;
+}
+
+void ExpectEQ(const registration::PoseGraph &pose_graph0,
+              const registration::PoseGraph &pose_graph1) {
+    ASSERT_EQ(pose_graph0.nodes_.size(), pose_graph1.nodes_.size());
+    for (size_t i = 0; i < pose_graph0.nodes_.size(); i++) {
+        unit_test::ExpectEQ(pose_graph0.nodes_[i].pose_,
+                            pose_graph1.nodes_[i].pose_);
+    }
+    ASSERT_EQ(pose_graph0.edges_.size(), pose_graph1.edges_.size());
+    for (size_t i = 0; i < pose_graph0.edges_.size(); i++) {
+        const auto &edge0 = pose_graph0.edges_[i];
+        const auto &edge1 = pose_graph1.edges_[i];
+        EXPECT_EQ(edge0.source_node_id_, edge1.source_node_id_);
+        EXPECT_EQ(edge0.target_node_id_, edge1.target_node_id_);
+        unit_test::ExpectEQ(edge0.transformation_, edge1.transformation_);
+        unit_test::ExpectEQ(edge0.information_, edge1.information_);
+        EXPECT_EQ(edge0.uncertain_, edge1.uncertain_);
+        EXPECT_NEAR(edge0.confidence_, edge1.confidence_,
+                    unit_test::THRESHOLD_1E_6);
+    }
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -42,3 +95,35 @@ TEST(PoseGraphIO, DISABLED_ReadPoseGraph) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(PoseGraphIO, DISABLED_WritePoseGraph) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PoseGraphIO, WriteReadPoseGraph_O3DAndJSON) {
+    const std::string filename_json =
+            std::string(TEST_DATA_DIR) + "/temp_pose_graph.json";
+    const std::string filename_o3d =
+            std::string(TEST_DATA_DIR) + "/temp_pose_graph.o3d";
+    const registration::PoseGraph src = CreatePoseGraph(200, 10);
+    registration::PoseGraph dst_json, dst_o3d;
+    utility::Timer timer;
+
+    timer.Start();
+    EXPECT_TRUE(io::WritePoseGraph(filename_json, src));
+    EXPECT_TRUE(io::ReadPoseGraph(filename_json, dst_json));
+    timer.Stop();
+    const double time_json = timer.GetDuration();
+
+    timer.Start();
+    EXPECT_TRUE(io::WritePoseGraph(filename_o3d, src, true));
+    EXPECT_TRUE(io::ReadPoseGraph(filename_o3d, dst_o3d));
+    timer.Stop();
+    const double time_o3d = timer.GetDuration();
+
+    ExpectEQ(src, dst_json);
+    ExpectEQ(src, dst_o3d);
+    utility::PrintInfo("PoseGraph round trip: json %.2f ms, o3d %.2f ms\n",
+                       time_json, time_o3d);
+    std::remove(filename_json.c_str());
+    std::remove(filename_o3d.c_str());
+}
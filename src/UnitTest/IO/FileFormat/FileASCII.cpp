@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "Open3D/IO/FileFormat/FileASCII.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileASCII, ParseDouble) {
+    const std::vector<std::string> numbers = {
+            "0",       "-0.5",     "  12.25", "\t+3.5e2",
+            "1e-3",    ".75",      "5.",      "0.0000000001",
+            "1E+22",   "-2.5e-300", "123456789.0123456789",
+            "12345678901234567890123", "1.7976931348623157e308"};
+    for (const std::string &number : numbers) {
+        double value = -1.0;
+        const char *end =
+                io::ParseDouble(number.data(), number.data() + number.size(),
+                                value);
+        EXPECT_EQ(number.data() + number.size(), end) << number;
+        EXPECT_EQ(strtod(number.c_str(), NULL), value) << number;
+    }
+
+    const std::string line = "1.5 -2e1,x";
+    double value;
+    const char *end = io::ParseDouble(line.data(), line.data() + 3, value);
+    EXPECT_EQ(line.data() + 3, end);
+    EXPECT_EQ(1.5, value);
+    end = io::ParseDouble(end, line.data() + line.size(), value);
+    EXPECT_EQ(-20.0, value);
+    EXPECT_EQ(',', *end);
+    EXPECT_TRUE(io::ParseDouble(end, line.data() + line.size(), value) ==
+                NULL);
+
+    const std::string special = "-inf nan 1e";
+    end = io::ParseDouble(special.data(), special.data() + special.size(),
+                          value);
+    EXPECT_TRUE(std::isinf(value) && value < 0.0);
+    end = io::ParseDouble(end, special.data() + special.size(), value);
+    EXPECT_TRUE(std::isnan(value));
+    end = io::ParseDouble(end, special.data() + special.size(), value);
+    EXPECT_EQ(1.0, value);
+    EXPECT_EQ('e', *end);
+
+    double values[3];
+    EXPECT_TRUE(io::ParseDoubles(line.data(), line.data() + 7, 2, values));
+    EXPECT_FALSE(io::ParseDoubles(line.data(), line.data() + 7, 3, values));
+    EXPECT_EQ(2, io::CountTokens(line.data(), line.data() + line.size()));
+    const std::string tokens = " a  b\t c\r\n";
+    EXPECT_EQ(3, io::CountTokens(tokens.data(), tokens.data() + tokens.size()));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileASCII, FormatDouble) {
+    std::vector<double> values(10000);
+    Rand(values, -1.0, 1.0, 0);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] *= std::pow(10.0, (int)(i % 20) - 8);
+    }
+    values.push_back(0.5);
+    values.push_back(2.5);
+    values.push_back(-0.0);
+    values.push_back(1e300);
+    values.push_back(0.00048828125);
+
+    char buffer[io::MAX_FORMATTED_DOUBLE_SIZE + 1];
+    char expected[io::MAX_FORMATTED_DOUBLE_SIZE + 1];
+    for (int precision : {0, 3, 10, 15}) {
+        for (double value : values) {
+            *io::FormatDouble(value, precision, buffer) = '\0';
+            snprintf(expected, sizeof(expected), "%.*f", precision, value);
+            EXPECT_STREQ(expected, buffer);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileASCII, ReadASCIILines) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_ascii_lines.txt";
+    FILE *file = fopen(filename.c_str(), "w");
+    ASSERT_TRUE(file != NULL);
+    {
+        io::ASCIIWriter writer(file);
+        for (int i = 0; i < 1000; i++) {
+            writer.WriteInt(i);
+            writer.WriteChar(' ');
+            writer.WriteDouble(-0.5 * i, 3);
+            writer.WriteString(i % 10 == 0 ? " comment\n" : "\n");
+            if (i % 100 == 0) {
+                writer.WriteString("# not a number\n\n");
+            }
+        }
+        // A last line without line end.
+        writer.WriteString("1000 -500.000");
+        EXPECT_TRUE(writer.Flush());
+    }
+    fclose(file);
+
+    // Chunks much smaller than a line exercise the chunk boundaries.
+    for (size_t chunk_size : {size_t(5), size_t(64), size_t(1) << 24}) {
+        file = fopen(filename.c_str(), "rb");
+        ASSERT_TRUE(file != NULL);
+        std::vector<double> values;
+        EXPECT_TRUE(io::ReadASCIILines(
+                file, 2,
+                [](const char *begin, const char *end, double *values) {
+                    return io::ParseDoubles(begin, end, 2, values);
+                },
+                [&values](const double *parsed, size_t num) {
+                    values.insert(values.end(), parsed, parsed + 2 * num);
+                },
+                chunk_size));
+        fclose(file);
+        ASSERT_EQ(2002u, values.size());
+        for (int i = 0; i <= 1000; i++) {
+            EXPECT_EQ(i, values[2 * i]);
+            EXPECT_EQ(-0.5 * i, values[2 * i + 1]);
+        }
+    }
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,419 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Geometry/VoxelGrid.h"
+#include "Open3D/IO/ClassIO/FeatureIO.h"
+#include "Open3D/IO/ClassIO/ImageWarpingFieldIO.h"
+#include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
+#include "Open3D/IO/ClassIO/VoxelGridIO.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadPointCloud) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_pointcloud.o3d";
+    const int size = 1000;
+    geometry::PointCloud src;
+    src.points_.resize(size);
+    src.normals_.resize(size);
+    src.colors_.resize(size);
+    Rand(src.points_, Eigen::Vector3d(-10.0, -10.0, -10.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(src.normals_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(src.colors_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 2);
+
+    EXPECT_TRUE(io::WritePointCloud(filename, src));
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloud(filename, dst));
+    EXPECT_EQ(src.points_, dst.points_);
+    EXPECT_EQ(src.normals_, dst.normals_);
+    EXPECT_EQ(src.colors_, dst.colors_);
+
+    // Optional attributes are omitted.
+    src.normals_.clear();
+    src.colors_.clear();
+    EXPECT_TRUE(io::WritePointCloud(filename, src));
+    EXPECT_TRUE(io::ReadPointCloud(filename, dst));
+    EXPECT_EQ(src.points_, dst.points_);
+    EXPECT_FALSE(dst.HasNormals());
+    EXPECT_FALSE(dst.HasColors());
+
+    // Empty point clouds round-trip too.
+    EXPECT_TRUE(io::WritePointCloud(filename, geometry::PointCloud()));
+    EXPECT_TRUE(io::ReadPointCloud(filename, dst));
+    EXPECT_TRUE(dst.IsEmpty());
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadTriangleMesh) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_mesh.o3d";
+    geometry::TriangleMesh src;
+    src.vertices_.resize(100);
+    src.vertex_normals_.resize(100);
+    src.triangles_.resize(150);
+    Rand(src.vertices_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(src.vertex_normals_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(src.triangles_, Eigen::Vector3i(0, 0, 0), Eigen::Vector3i(99, 99, 99),
+         2);
+    src.ComputeTriangleNormals();
+
+    EXPECT_TRUE(io::WriteTriangleMesh(filename, src));
+    geometry::TriangleMesh dst;
+    EXPECT_TRUE(io::ReadTriangleMesh(filename, dst));
+    EXPECT_EQ(src.vertices_, dst.vertices_);
+    EXPECT_EQ(src.vertex_normals_, dst.vertex_normals_);
+    EXPECT_FALSE(dst.HasVertexColors());
+    EXPECT_EQ(src.triangles_, dst.triangles_);
+    EXPECT_EQ(src.triangle_normals_, dst.triangle_normals_);
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadVoxelGrid) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_voxelgrid.o3d";
+    geometry::VoxelGrid src;
+    src.voxel_size_ = 0.25;
+    src.origin_ = Eigen::Vector3d(1.0, -2.0, 3.5);
+    src.voxels_.resize(200);
+    src.colors_.resize(200);
+    Rand(src.voxels_, Eigen::Vector3i(0, 0, 0), Eigen::Vector3i(50, 50, 50),
+         0);
+    Rand(src.colors_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+
+    EXPECT_TRUE(io::WriteVoxelGrid(filename, src));
+    geometry::VoxelGrid dst;
+    EXPECT_TRUE(io::ReadVoxelGrid(filename, dst));
+    EXPECT_EQ(src.voxel_size_, dst.voxel_size_);
+    EXPECT_EQ(src.origin_, dst.origin_);
+    EXPECT_EQ(src.voxels_, dst.voxels_);
+    EXPECT_EQ(src.colors_, dst.colors_);
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadFeature) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_feature.o3d";
+    registration::Feature src;
+    src.Resize(33, 500);
+    Rand(src.data_.data(), src.data_.size(), 0.0, 100.0, 0);
+
+    EXPECT_TRUE(io::WriteFeature(filename, src));
+    registration::Feature dst;
+    EXPECT_TRUE(io::ReadFeature(filename, dst));
+    EXPECT_EQ(src.data_, dst.data_);
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadPoseGraph) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_posegraph.o3d";
+    registration::PoseGraph src;
+    for (int i = 0; i < 10; i++) {
+        Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3d(i, 0.5 * i, -0.25 * i);
+        src.nodes_.push_back(registration::PoseGraphNode(pose));
+    }
+    for (int i = 0; i < 9; i++) {
+        Eigen::Matrix6d information = Eigen::Matrix6d::Identity() * (i + 1);
+        src.edges_.push_back(registration::PoseGraphEdge(
+                i, i + 1, src.nodes_[i + 1].pose_, information, i % 2 == 1,
+                0.1 * i));
+    }
+
+    EXPECT_TRUE(io::WritePoseGraph(filename, src));
+    registration::PoseGraph dst;
+    EXPECT_TRUE(io::ReadPoseGraph(filename, dst));
+    ASSERT_EQ(src.nodes_.size(), dst.nodes_.size());
+    for (size_t i = 0; i < src.nodes_.size(); i++) {
+        EXPECT_EQ(src.nodes_[i].pose_, dst.nodes_[i].pose_);
+    }
+    ASSERT_EQ(src.edges_.size(), dst.edges_.size());
+    for (size_t i = 0; i < src.edges_.size(); i++) {
+        EXPECT_EQ(src.edges_[i].source_node_id_, dst.edges_[i].source_node_id_);
+        EXPECT_EQ(src.edges_[i].target_node_id_, dst.edges_[i].target_node_id_);
+        EXPECT_EQ(src.edges_[i].transformation_,
+                  dst.edges_[i].transformation_);
+        EXPECT_EQ(src.edges_[i].information_, dst.edges_[i].information_);
+        EXPECT_EQ(src.edges_[i].uncertain_, dst.edges_[i].uncertain_);
+        EXPECT_EQ(src.edges_[i].confidence_, dst.edges_[i].confidence_);
+    }
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, ReadInvalidFile) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_invalid.o3d";
+    geometry::PointCloud pointcloud;
+    pointcloud.points_.resize(100);
+    Rand(pointcloud.points_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 0);
+    EXPECT_TRUE(io::WritePointCloud(filename, pointcloud));
+
+    // A point cloud file is not a mesh.
+    geometry::TriangleMesh mesh;
+    EXPECT_FALSE(io::ReadTriangleMesh(filename, mesh));
+
+    // Truncated files are rejected.
+    FILE *file = fopen(filename.c_str(), "rb");
+    std::vector<char> buffer(10000);
+    buffer.resize(fread(buffer.data(), 1, buffer.size(), file));
+    fclose(file);
+    file = fopen(filename.c_str(), "wb");
+    fwrite(buffer.data(), 1, buffer.size() - 8, file);
+    fclose(file);
+    geometry::PointCloud dst;
+    EXPECT_FALSE(io::ReadPointCloud(filename, dst));
+
+    // So are files in other formats.
+    file = fopen(filename.c_str(), "wb");
+    fputs("0.0 0.0 0.0\n", file);
+    fclose(file);
+    EXPECT_FALSE(io::ReadPointCloud(filename, dst));
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadPointCloud_Compressed) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_pointcloud_compressed.o3d";
+    const std::string filename_raw =
+            std::string(TEST_DATA_DIR) + "/temp_pointcloud_raw.o3d";
+    // Larger than a compression block, with compressible normals.
+    const int size = 100000;
+    geometry::PointCloud src;
+    src.points_.resize(size);
+    Rand(src.points_, Eigen::Vector3d(-10.0, -10.0, -10.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    src.normals_.resize(size, Eigen::Vector3d(0.0, 0.0, 1.0));
+
+    EXPECT_TRUE(io::WritePointCloud(filename, src, false, true));
+    EXPECT_TRUE(io::WritePointCloud(filename_raw, src, false, false));
+    FILE *file = fopen(filename.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    const long compressed_size = ftell(file);
+    fclose(file);
+    file = fopen(filename_raw.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    const long raw_size = ftell(file);
+    fclose(file);
+    EXPECT_LT(compressed_size, raw_size * 3 / 4);
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloud(filename, dst));
+    EXPECT_EQ(src.points_, dst.points_);
+    EXPECT_EQ(src.normals_, dst.normals_);
+    EXPECT_FALSE(dst.HasColors());
+    std::remove(filename.c_str());
+    std::remove(filename_raw.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, ReadVersion1) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_version1.o3d";
+    // A version 1 point cloud with a single point, written byte by byte.
+    std::vector<char> buffer(128 + 3 * sizeof(double), 0);
+    const uint32_t header[6] = {1, 0x01020304, 1, 1, 152, 0};
+    memcpy(buffer.data(), "O3DBIN\r\n", 8);
+    memcpy(buffer.data() + 8, header, sizeof(header));
+    const uint32_t chunk_types[2] = {1, 3};
+    const uint64_t chunk_sizes[2] = {1, 128};
+    memcpy(buffer.data() + 32, "points", 6);
+    memcpy(buffer.data() + 64, chunk_types, sizeof(chunk_types));
+    memcpy(buffer.data() + 72, chunk_sizes, sizeof(chunk_sizes));
+    const double point[3] = {1.0, -2.0, 3.5};
+    memcpy(buffer.data() + 128, point, sizeof(point));
+    FILE *file = fopen(filename.c_str(), "wb");
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloud(filename, dst));
+    ASSERT_EQ(1u, dst.points_.size());
+    EXPECT_EQ(Eigen::Vector3d(1.0, -2.0, 3.5), dst.points_[0]);
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadFeature_Quantized) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_feature_quantized.o3d";
+    registration::Feature src;
+    src.Resize(33, 1000);
+    Rand(src.data_.data(), src.data_.size(), 0.0, 100.0, 0);
+    // Dimensions with a single value and exactly representable values.
+    src.data_.row(1).setConstant(7.0);
+    src.data_.row(2).setZero();
+    src.data_(3, 0) = 65504.0;
+    src.data_(3, 1) = -2.5;
+    src.data_(3, 2) = 1.0 / 1024.0 / 16384.0;
+    registration::Feature dst;
+
+    EXPECT_TRUE(io::WriteFeature(filename, src, true,
+                                 io::FeatureStorageType::Float16));
+    EXPECT_TRUE(io::ReadFeature(filename, dst));
+    ASSERT_EQ(src.data_.rows(), dst.data_.rows());
+    ASSERT_EQ(src.data_.cols(), dst.data_.cols());
+    for (int i = 0; i < src.data_.size(); i++) {
+        EXPECT_NEAR(src.data_(i), dst.data_(i),
+                    std::abs(src.data_(i)) / 2048.0 + 1e-7);
+    }
+    EXPECT_EQ(65504.0, dst.data_(3, 0));
+    EXPECT_EQ(-2.5, dst.data_(3, 1));
+    EXPECT_EQ(src.data_(3, 2), dst.data_(3, 2));
+
+    EXPECT_TRUE(io::WriteFeature(filename, src, false,
+                                 io::FeatureStorageType::UInt8));
+    EXPECT_TRUE(io::ReadFeature(filename, dst));
+    ASSERT_EQ(src.data_.rows(), dst.data_.rows());
+    ASSERT_EQ(src.data_.cols(), dst.data_.cols());
+    for (int d = 0; d < src.data_.rows(); d++) {
+        const double range =
+                src.data_.row(d).maxCoeff() - src.data_.row(d).minCoeff();
+        for (int i = 0; i < src.data_.cols(); i++) {
+            EXPECT_NEAR(src.data_(d, i), dst.data_(d, i),
+                        range / 510.0 + 1e-9);
+        }
+    }
+    EXPECT_EQ(src.data_.row(1), dst.data_.row(1));
+    EXPECT_EQ(src.data_.row(2), dst.data_.row(2));
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadFeature_Empty) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_feature_empty.o3d";
+    // FPFH of a cloud without normals has no columns.
+    registration::Feature src;
+    src.Resize(33, 0);
+
+    for (auto storage_type :
+         {io::FeatureStorageType::Float64, io::FeatureStorageType::Float16,
+          io::FeatureStorageType::UInt8}) {
+        for (bool compressed : {false, true}) {
+            registration::Feature dst;
+            dst.Resize(2, 2);
+            EXPECT_TRUE(io::WriteFeature(filename, src, compressed,
+                                         storage_type));
+            EXPECT_TRUE(io::ReadFeature(filename, dst));
+            EXPECT_EQ(33, dst.data_.rows());
+            EXPECT_EQ(0, dst.data_.cols());
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadPinholeCameraTrajectory) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_trajectory.o3d";
+    camera::PinholeCameraTrajectory src;
+    src.parameters_.resize(20);
+    for (size_t i = 0; i < src.parameters_.size(); i++) {
+        auto &parameters = src.parameters_[i];
+        parameters.intrinsic_.SetIntrinsics(640, 480, 525.0 + i, 525.0,
+                                            319.5, 239.5);
+        parameters.extrinsic_ = Eigen::Matrix4d::Identity();
+        parameters.extrinsic_.block<3, 1>(0, 3) =
+                Eigen::Vector3d(0.1 * i, 0.0, -0.2 * i);
+    }
+
+    EXPECT_TRUE(io::WritePinholeCameraTrajectory(filename, src, true));
+    camera::PinholeCameraTrajectory dst;
+    EXPECT_TRUE(io::ReadPinholeCameraTrajectory(filename, dst));
+    ASSERT_EQ(src.parameters_.size(), dst.parameters_.size());
+    for (size_t i = 0; i < src.parameters_.size(); i++) {
+        const auto &p0 = src.parameters_[i];
+        const auto &p1 = dst.parameters_[i];
+        EXPECT_EQ(p0.intrinsic_.width_, p1.intrinsic_.width_);
+        EXPECT_EQ(p0.intrinsic_.height_, p1.intrinsic_.height_);
+        EXPECT_EQ(p0.intrinsic_.intrinsic_matrix_,
+                  p1.intrinsic_.intrinsic_matrix_);
+        EXPECT_EQ(p0.extrinsic_, p1.extrinsic_);
+    }
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3D, WriteReadImageWarpingField) {
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_warping_field.o3d";
+    color_map::ImageWarpingField src(640, 480, 16);
+    src.flow_(5) += 0.25;
+
+    EXPECT_TRUE(io::WriteImageWarpingField(filename, src));
+    color_map::ImageWarpingField dst;
+    EXPECT_TRUE(io::ReadImageWarpingField(filename, dst));
+    EXPECT_EQ(src.anchor_w_, dst.anchor_w_);
+    EXPECT_EQ(src.anchor_h_, dst.anchor_h_);
+    EXPECT_EQ(src.anchor_step_, dst.anchor_step_);
+    EXPECT_EQ(src.flow_, dst.flow_);
+    std::remove(filename.c_str());
+}
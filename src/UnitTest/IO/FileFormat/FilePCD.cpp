@@ -24,8 +24,34 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <liblzf/lzf.h>
+#include <cstdio>
+#include <cstring>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+geometry::PointCloud CreatePointCloud(int size) {
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Eigen::Vector3d(-10.0, -10.0, -10.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(pc.colors_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 2);
+    return pc;
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -100,3 +126,73 @@ TEST(FilePCD, DISABLED_ReadPointCloudFromPCD) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(FilePCD, DISABLED_WritePointCloudToPCD) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePCD, WriteReadPointCloud_BinaryCompressed) {
+    // More than one compression block of data.
+    const geometry::PointCloud src = CreatePointCloud(100000);
+    const std::string binary_file =
+            std::string(TEST_DATA_DIR) + "/temp_binary.pcd";
+    const std::string compressed_file =
+            std::string(TEST_DATA_DIR) + "/temp_compressed.pcd";
+
+    geometry::PointCloud binary;
+    EXPECT_TRUE(io::WritePointCloudToPCD(binary_file, src, false, false));
+    EXPECT_TRUE(io::ReadPointCloudFromPCD(binary_file, binary));
+    ExpectEQ(src.points_, binary.points_);
+    ExpectEQ(src.normals_, binary.normals_);
+    ASSERT_EQ(src.colors_.size(), binary.colors_.size());
+    for (size_t i = 0; i < src.colors_.size(); i++) {
+        EXPECT_LE((src.colors_[i] - binary.colors_[i]).cwiseAbs().maxCoeff(),
+                  1.0 / 255.0);
+    }
+
+    // Both encodings store the same floats.
+    geometry::PointCloud compressed;
+    EXPECT_TRUE(io::WritePointCloudToPCD(compressed_file, src, false, true));
+    EXPECT_TRUE(io::ReadPointCloudFromPCD(compressed_file, compressed));
+    EXPECT_EQ(binary.points_, compressed.points_);
+    EXPECT_EQ(binary.normals_, compressed.normals_);
+    EXPECT_EQ(binary.colors_, compressed.colors_);
+
+    std::remove(binary_file.c_str());
+    std::remove(compressed_file.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePCD, WritePointCloudToPCD_SingleLZFStream) {
+    const geometry::PointCloud src = CreatePointCloud(100000);
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_compressed.pcd";
+    EXPECT_TRUE(io::WritePointCloudToPCD(filename, src, false, true));
+
+    // The blocks compressed in parallel must form one LZF stream, as other
+    // PCD readers decompress the data with a single call.
+    FILE *file = fopen(filename.c_str(), "rb");
+    ASSERT_TRUE(file != NULL);
+    char line[256];
+    while (fgets(line, sizeof(line), file) &&
+           strncmp(line, "DATA binary_compressed", 22) != 0) {
+    }
+    std::uint32_t sizes[2] = {0, 0};
+    ASSERT_EQ(2u, fread(sizes, sizeof(std::uint32_t), 2, file));
+    EXPECT_EQ(7u * 100000u * 4u, sizes[1]);
+    std::vector<char> compressed(sizes[0]);
+    ASSERT_EQ(sizes[0], fread(compressed.data(), 1, sizes[0], file));
+    EXPECT_EQ(EOF, fgetc(file));
+    fclose(file);
+
+    std::vector<float> values(sizes[1] / 4);
+    ASSERT_EQ(sizes[1], lzf_decompress(compressed.data(), sizes[0],
+                                       values.data(), sizes[1]));
+    for (size_t i = 0; i < src.points_.size(); i++) {
+        EXPECT_EQ((float)src.points_[i](0), values[i]);
+        EXPECT_EQ((float)src.normals_[i](2), values[5 * 100000 + i]);
+    }
+
+    std::remove(filename.c_str());
+}
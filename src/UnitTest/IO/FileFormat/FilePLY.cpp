@@ -24,8 +24,61 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <cstring>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+std::string TempFile(const std::string &name) {
+    return std::string(TEST_DATA_DIR) + "/temp_" + name + ".ply";
+}
+
+geometry::PointCloud CreatePointCloud(int size) {
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(pc.normals_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    for (int i = 0; i < size; i++) {
+        // Colors that survive the round trip through uchar exactly.
+        pc.colors_[i] = Eigen::Vector3d(i % 256, (3 * i) % 256, 255 - i % 256) /
+                        255.0;
+    }
+    return pc;
+}
+
+void ExpectNear(const std::vector<Eigen::Vector3d> &v0,
+                const std::vector<Eigen::Vector3d> &v1,
+                double threshold) {
+    ASSERT_EQ(v0.size(), v1.size());
+    for (size_t i = 0; i < v0.size(); i++) {
+        EXPECT_LE((v0[i] - v1[i]).cwiseAbs().maxCoeff(), threshold);
+    }
+}
+
+template <typename T>
+void AppendBigEndian(std::string &data, T value) {
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    for (int i = (int)sizeof(T) - 1; i >= 0; i--) {
+        data.push_back(bytes[i]);
+    }
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -75,3 +128,227 @@ TEST(FilePLY, DISABLED_WriteTriangleMeshToPLY) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(FilePLY, DISABLED_ResetConsoleProgress) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, WriteReadPointCloud) {
+    const geometry::PointCloud src = CreatePointCloud(1000);
+    const std::string binary_file = TempFile("pointcloud_binary");
+    const std::string ascii_file = TempFile("pointcloud_ascii");
+
+    geometry::PointCloud binary;
+    EXPECT_TRUE(io::WritePointCloudToPLY(binary_file, src, false));
+    EXPECT_TRUE(io::ReadPointCloudFromPLY(binary_file, binary));
+    ExpectEQ(src.points_, binary.points_);
+    ExpectEQ(src.normals_, binary.normals_);
+    ExpectEQ(src.colors_, binary.colors_);
+
+    geometry::PointCloud ascii;
+    EXPECT_TRUE(io::WritePointCloudToPLY(ascii_file, src, true));
+    EXPECT_TRUE(io::ReadPointCloudFromPLY(ascii_file, ascii));
+    ExpectNear(src.points_, ascii.points_, 1e-5);
+    ExpectNear(src.normals_, ascii.normals_, 1e-5);
+    ExpectEQ(src.colors_, ascii.colors_);
+
+    geometry::PointCloud points_only;
+    points_only.points_ = src.points_;
+    EXPECT_TRUE(io::WritePointCloudToPLY(binary_file, points_only, false));
+    EXPECT_TRUE(io::ReadPointCloudFromPLY(binary_file, binary));
+    ExpectEQ(src.points_, binary.points_);
+    EXPECT_FALSE(binary.HasNormals());
+    EXPECT_FALSE(binary.HasColors());
+
+    std::remove(binary_file.c_str());
+    std::remove(ascii_file.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, ReadPointCloudFromPLY_BigEndianWithExtraProperties) {
+    const std::string filename = TempFile("big_endian");
+    std::string data =
+            "ply\n"
+            "format binary_big_endian 1.0\n"
+            "comment extra properties are skipped\n"
+            "element vertex 3\n"
+            "property float32 x\n"
+            "property int16 intensity\n"
+            "property float32 y\n"
+            "property float32 z\n"
+            "property uint8 red\n"
+            "property uint8 green\n"
+            "property uint8 blue\n"
+            "end_header\n";
+    for (int i = 0; i < 3; i++) {
+        AppendBigEndian(data, 0.5f * i);
+        AppendBigEndian(data, (int16_t)-i);
+        AppendBigEndian(data, 1.0f + i);
+        AppendBigEndian(data, -2.0f * i);
+        AppendBigEndian(data, (uint8_t)(10 * i));
+        AppendBigEndian(data, (uint8_t)255);
+        AppendBigEndian(data, (uint8_t)0);
+    }
+    FILE *file = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+
+    geometry::PointCloud pc;
+    EXPECT_TRUE(io::ReadPointCloudFromPLY(filename, pc));
+    ASSERT_EQ(3u, pc.points_.size());
+    EXPECT_FALSE(pc.HasNormals());
+    ASSERT_TRUE(pc.HasColors());
+    for (int i = 0; i < 3; i++) {
+        ExpectEQ(Eigen::Vector3d(0.5 * i, 1.0 + i, -2.0 * i), pc.points_[i]);
+        ExpectEQ(Eigen::Vector3d(10.0 * i / 255.0, 1.0, 0.0), pc.colors_[i]);
+    }
+
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, ReadTriangleMeshFromPLY_InvalidFaces) {
+    const std::string filename = TempFile("invalid_faces");
+    auto write_mesh = [&](const std::string &face_header,
+                          const std::string &face_data) {
+        std::string data =
+                "ply\n"
+                "format binary_big_endian 1.0\n"
+                "element vertex 3\n"
+                "property float32 x\n"
+                "property float32 y\n"
+                "property float32 z\n" +
+                face_header + "end_header\n";
+        for (int i = 0; i < 9; i++) {
+            AppendBigEndian(data, (float)i);
+        }
+        data += face_data;
+        FILE *file = fopen(filename.c_str(), "wb");
+        ASSERT_TRUE(file != NULL);
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+    };
+    std::string face;
+    AppendBigEndian(face, (int32_t)0);
+    AppendBigEndian(face, (int32_t)1);
+    AppendBigEndian(face, (int32_t)2);
+
+    // a negative list length
+    std::string negative;
+    AppendBigEndian(negative, (int32_t)-1);
+    write_mesh(
+            "element face 1\n"
+            "property list int32 int32 vertex_indices\n",
+            negative + face);
+    geometry::TriangleMesh mesh;
+    EXPECT_FALSE(io::ReadTriangleMeshFromPLY(filename, mesh));
+
+    // a list length past the end of the file
+    std::string huge;
+    AppendBigEndian(huge, (uint32_t)0xFFFFFFFF);
+    write_mesh(
+            "element face 1\n"
+            "property list uint32 int32 vertex_indices\n",
+            huge + face);
+    EXPECT_FALSE(io::ReadTriangleMeshFromPLY(filename, mesh));
+
+    // more faces than the file can hold
+    std::string valid;
+    AppendBigEndian(valid, (uint8_t)3);
+    write_mesh(
+            "element face 100000000000\n"
+            "property list uint8 int32 vertex_indices\n",
+            valid + face);
+    EXPECT_FALSE(io::ReadTriangleMeshFromPLY(filename, mesh));
+
+    // the same face with the right count is read
+    write_mesh(
+            "element face 1\n"
+            "property list uint8 int32 vertex_indices\n",
+            valid + face);
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY(filename, mesh));
+    ASSERT_EQ(1u, mesh.triangles_.size());
+    ExpectEQ(Eigen::Vector3i(0, 1, 2), mesh.triangles_[0]);
+
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, WriteReadTriangleMesh) {
+    const geometry::PointCloud pc = CreatePointCloud(100);
+    geometry::TriangleMesh src;
+    src.vertices_ = pc.points_;
+    src.vertex_colors_ = pc.colors_;
+    src.triangles_.resize(150);
+    Rand(src.triangles_, Eigen::Vector3i(0, 0, 0), Eigen::Vector3i(99, 99, 99),
+         0);
+    const std::string binary_file = TempFile("mesh_binary");
+    const std::string ascii_file = TempFile("mesh_ascii");
+
+    geometry::TriangleMesh binary;
+    EXPECT_TRUE(io::WriteTriangleMeshToPLY(binary_file, src, false));
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY(binary_file, binary));
+    ExpectEQ(src.vertices_, binary.vertices_);
+    EXPECT_FALSE(binary.HasVertexNormals());
+    ExpectEQ(src.vertex_colors_, binary.vertex_colors_);
+    ExpectEQ(src.triangles_, binary.triangles_);
+
+    geometry::TriangleMesh ascii;
+    EXPECT_TRUE(io::WriteTriangleMeshToPLY(ascii_file, src, true));
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY(ascii_file, ascii));
+    ExpectNear(src.vertices_, ascii.vertices_, 1e-5);
+    ExpectEQ(src.vertex_colors_, ascii.vertex_colors_);
+    ExpectEQ(src.triangles_, ascii.triangles_);
+
+    std::remove(binary_file.c_str());
+    std::remove(ascii_file.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, ReadPointCloudFromPLYInChunks) {
+    const geometry::PointCloud src = CreatePointCloud(1000);
+    for (bool write_ascii : {false, true}) {
+        const std::string filename = TempFile("chunks");
+        EXPECT_TRUE(io::WritePointCloudToPLY(filename, src, write_ascii));
+        geometry::PointCloud full;
+        EXPECT_TRUE(io::ReadPointCloudFromPLY(filename, full));
+
+        geometry::PointCloud merged;
+        int num_chunks = 0;
+        EXPECT_TRUE(io::ReadPointCloudFromPLYInChunks(
+                filename, 64, [&](const geometry::PointCloud &chunk) {
+                    EXPECT_LE(chunk.points_.size(), 64u);
+                    EXPECT_TRUE(chunk.HasNormals());
+                    EXPECT_TRUE(chunk.HasColors());
+                    merged += chunk;
+                    num_chunks++;
+                    return true;
+                }));
+        EXPECT_EQ(16, num_chunks);
+        ExpectEQ(full.points_, merged.points_);
+        ExpectEQ(full.normals_, merged.normals_);
+        ExpectEQ(full.colors_, merged.colors_);
+
+        // Stop after two chunks, downsampling each chunk on the fly.
+        geometry::PointCloud downsampled;
+        num_chunks = 0;
+        EXPECT_TRUE(io::ReadPointCloudFromPLYInChunks(
+                filename, 300, [&](const geometry::PointCloud &chunk) {
+                    downsampled += *geometry::VoxelDownSample(chunk, 0.5);
+                    return ++num_chunks < 2;
+                }));
+        EXPECT_EQ(2, num_chunks);
+        EXPECT_GT(downsampled.points_.size(), 0u);
+        EXPECT_LT(downsampled.points_.size(), 600u);
+
+        std::remove(filename.c_str());
+    }
+}
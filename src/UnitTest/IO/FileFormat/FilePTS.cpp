@@ -24,8 +24,15 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -50,3 +57,32 @@ TEST(FilePTS, DISABLED_AdvanceConsoleProgress) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(FilePTS, DISABLED_WritePointCloudToPTS) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePTS, WriteReadPointCloud) {
+    const std::string filename = std::string(TEST_DATA_DIR) + "/temp.pts";
+    geometry::PointCloud src;
+    src.points_.resize(1000);
+    src.colors_.resize(1000);
+    Rand(src.points_, Eigen::Vector3d(-100.0, -100.0, -100.0),
+         Eigen::Vector3d(100.0, 100.0, 100.0), 0);
+    for (size_t i = 0; i < src.colors_.size(); i++) {
+        src.colors_[i] = Eigen::Vector3d(i % 256, 7 * i % 256, 0) / 255.0;
+    }
+    EXPECT_TRUE(io::WritePointCloudToPTS(filename, src));
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloudFromPTS(filename, dst));
+    ExpectEQ(src.points_, dst.points_);
+    ASSERT_EQ(src.colors_.size(), dst.colors_.size());
+    for (size_t i = 0; i < src.colors_.size(); i++) {
+        // Colors are truncated to integers by the writer.
+        EXPECT_NEAR(src.colors_[i](0), dst.colors_[i](0), 1.0 / 255.0);
+        EXPECT_NEAR(src.colors_[i](1), dst.colors_[i](1), 1.0 / 255.0);
+        EXPECT_NEAR(src.colors_[i](2), dst.colors_[i](2), 1.0 / 255.0);
+    }
+
+    std::remove(filename.c_str());
+}
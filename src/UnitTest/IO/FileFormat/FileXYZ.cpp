@@ -24,8 +24,15 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -35,3 +42,34 @@ TEST(FileXYZ, DISABLED_ReadPointCloudFromXYZ) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(FileXYZ, DISABLED_WritePointCloudToXYZ) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileXYZ, WriteReadPointCloud) {
+    const std::string filename = std::string(TEST_DATA_DIR) + "/temp.xyz";
+    geometry::PointCloud src;
+    src.points_.resize(1000);
+    Rand(src.points_, Eigen::Vector3d(-100.0, -100.0, -100.0),
+         Eigen::Vector3d(100.0, 100.0, 100.0), 0);
+    EXPECT_TRUE(io::WritePointCloudToXYZ(filename, src));
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZ(filename, dst));
+    ExpectEQ(src.points_, dst.points_);
+    EXPECT_FALSE(dst.HasNormals());
+    EXPECT_FALSE(dst.HasColors());
+
+    // Lines that do not start with three numbers are skipped.
+    FILE *file = fopen(filename.c_str(), "w");
+    ASSERT_TRUE(file != NULL);
+    fprintf(file, "# header\n1 2 3\n\n4 5\n-1.5e1\t2 3.25 extra\r\n7 8 9");
+    fclose(file);
+    EXPECT_TRUE(io::ReadPointCloudFromXYZ(filename, dst));
+    ASSERT_EQ(3u, dst.points_.size());
+    ExpectEQ(Eigen::Vector3d(1.0, 2.0, 3.0), dst.points_[0]);
+    ExpectEQ(Eigen::Vector3d(-15.0, 2.0, 3.25), dst.points_[1]);
+    ExpectEQ(Eigen::Vector3d(7.0, 8.0, 9.0), dst.points_[2]);
+
+    std::remove(filename.c_str());
+}
@@ -24,8 +24,15 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -34,4 +41,24 @@ TEST(FileXYZN, DISABLED_ReadPointCloudFromXYZN) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FileXYZN, DISABLED_WritePointCloudToXYZN) { unit_test::NotImplemented(); }
\ No newline at end of file
+TEST(FileXYZN, DISABLED_WritePointCloudToXYZN) { unit_test::NotImplemented(); }
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileXYZN, WriteReadPointCloud) {
+    const std::string filename = std::string(TEST_DATA_DIR) + "/temp.xyzn";
+    geometry::PointCloud src;
+    src.points_.resize(1000);
+    src.normals_.resize(1000);
+    Rand(src.points_, Eigen::Vector3d(-100.0, -100.0, -100.0),
+         Eigen::Vector3d(100.0, 100.0, 100.0), 0);
+    Rand(src.normals_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    EXPECT_TRUE(io::WritePointCloudToXYZN(filename, src));
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZN(filename, dst));
+    ExpectEQ(src.points_, dst.points_);
+    ExpectEQ(src.normals_, dst.normals_);
+
+    std::remove(filename.c_str());
+}
@@ -24,8 +24,15 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -38,4 +45,24 @@ TEST(FileXYZRGB, DISABLED_ReadPointCloudFromXYZRGB) {
 // ----------------------------------------------------------------------------
 TEST(FileXYZRGB, DISABLED_WritePointCloudToXYZRGB) {
     unit_test::NotImplemented();
-}
\ No newline at end of file
+}
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileXYZRGB, WriteReadPointCloud) {
+    const std::string filename = std::string(TEST_DATA_DIR) + "/temp.xyzrgb";
+    geometry::PointCloud src;
+    src.points_.resize(1000);
+    src.colors_.resize(1000);
+    Rand(src.points_, Eigen::Vector3d(-100.0, -100.0, -100.0),
+         Eigen::Vector3d(100.0, 100.0, 100.0), 0);
+    Rand(src.colors_, Zero3d, Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    EXPECT_TRUE(io::WritePointCloudToXYZRGB(filename, src));
+
+    geometry::PointCloud dst;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZRGB(filename, dst));
+    ExpectEQ(src.points_, dst.points_);
+    ExpectEQ(src.colors_, dst.colors_);
+
+    std::remove(filename.c_str());
+}
@@ -24,8 +24,39 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Integration/UniformTSDFVolume.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// RGB-D image of a fronto-parallel plane at the given depth.
+geometry::RGBDImage CreatePlaneRGBDImage(
+        const camera::PinholeCameraIntrinsic &intrinsic, float depth) {
+    geometry::RGBDImage image;
+    image.depth_.PrepareImage(intrinsic.width_, intrinsic.height_, 1, 4);
+    image.color_.PrepareImage(intrinsic.width_, intrinsic.height_, 3, 1);
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            *geometry::PointerAt<float>(image.depth_, u, v) = depth;
+            for (int c = 0; c < 3; c++) {
+                *geometry::PointerAt<uint8_t>(image.color_, u, v, c) =
+                        (uint8_t)(u + v + 50 * c);
+            }
+        }
+    }
+    return image;
+}
+
+}  // namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -54,7 +85,32 @@ TEST(ScalableTSDFVolume, DISABLED_Reset) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(ScalableTSDFVolume, DISABLED_Integrate) { unit_test::NotImplemented(); }
+TEST(ScalableTSDFVolume, Integrate) {
+    camera::PinholeCameraIntrinsic intrinsic(64, 48, 50.0, 50.0, 31.5, 23.5);
+    auto image = CreatePlaneRGBDImage(intrinsic, 1.0f);
+
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    for (int i = 0; i < 3; i++) {
+        volume.Integrate(image, intrinsic, Eigen::Matrix4d::Identity());
+    }
+    EXPECT_FALSE(volume.volume_units_.empty());
+
+    // Every touched unit is integrated exactly once per frame.
+    float max_weight = 0.0f;
+    for (const auto &unit : volume.volume_units_) {
+        for (float w : unit.second.volume_->weight_) {
+            max_weight = std::max(max_weight, w);
+        }
+    }
+    EXPECT_EQ(3.0f, max_weight);
+
+    auto pcd = volume.ExtractPointCloud();
+    EXPECT_FALSE(pcd->points_.empty());
+    for (const auto &point : pcd->points_) {
+        EXPECT_NEAR(1.0, point(2), 1e-3);
+    }
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -66,8 +122,74 @@ TEST(ScalableTSDFVolume, DISABLED_ExtractPointCloud) {
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(ScalableTSDFVolume, DISABLED_ExtractTriangleMesh) {
-    unit_test::NotImplemented();
+TEST(ScalableTSDFVolume, ExtractTriangleMesh) {
+    camera::PinholeCameraIntrinsic intrinsic(64, 48, 50.0, 50.0, 31.5, 23.5);
+    auto image = CreatePlaneRGBDImage(intrinsic, 1.0f);
+
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    volume.Integrate(image, intrinsic, Eigen::Matrix4d::Identity());
+    auto mesh = volume.ExtractTriangleMesh();
+
+    EXPECT_FALSE(mesh->triangles_.empty());
+    EXPECT_EQ(mesh->vertices_.size(), mesh->vertex_colors_.size());
+    for (const auto &vertex : mesh->vertices_) {
+        EXPECT_NEAR(1.0, vertex(2), 1e-3);
+    }
+
+    // Vertices shared by cubes of different volume units are welded.
+    std::vector<Eigen::Vector3d> vertices = mesh->vertices_;
+    std::sort(vertices.begin(), vertices.end(),
+              [](const Eigen::Vector3d &a, const Eigen::Vector3d &b) {
+                  return std::make_tuple(a(0), a(1), a(2)) <
+                         std::make_tuple(b(0), b(1), b(2));
+              });
+    EXPECT_TRUE(std::adjacent_find(vertices.begin(), vertices.end()) ==
+                vertices.end());
+
+    // No edge is shared by more than two triangles.
+    std::map<std::pair<int, int>, int> edge_count;
+    for (const auto &triangle : mesh->triangles_) {
+        for (int j = 0; j < 3; j++) {
+            int v0 = triangle(j);
+            int v1 = triangle((j + 1) % 3);
+            edge_count[std::make_pair(std::min(v0, v1), std::max(v0, v1))]++;
+        }
+    }
+    for (const auto &edge : edge_count) {
+        EXPECT_LE(edge.second, 2);
+    }
+
+    // The parallel extraction is deterministic.
+    auto mesh2 = volume.ExtractTriangleMesh();
+    ExpectEQ(mesh->vertices_, mesh2->vertices_);
+    ExpectEQ(mesh->triangles_, mesh2->triangles_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, ExtractTriangleMeshIncremental) {
+    camera::PinholeCameraIntrinsic intrinsic(64, 48, 50.0, 50.0, 31.5, 23.5);
+
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    // The later frames only touch the volume units behind the first surface,
+    // which changes the mesh of the untouched units in front of them.
+    for (float depth : {1.11f, 1.25f, 1.25f}) {
+        auto image = CreatePlaneRGBDImage(intrinsic, depth);
+        volume.Integrate(image, intrinsic, Eigen::Matrix4d::Identity());
+        auto mesh = volume.ExtractTriangleMeshIncremental();
+        for (const auto &unit : volume.volume_units_) {
+            EXPECT_FALSE(unit.second.is_dirty_);
+        }
+
+        auto expected = volume.ExtractTriangleMesh();
+        EXPECT_FALSE(mesh->triangles_.empty());
+        ExpectEQ(expected->vertices_, mesh->vertices_);
+        ExpectEQ(expected->vertex_colors_, mesh->vertex_colors_);
+        ExpectEQ(expected->triangles_, mesh->triangles_);
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -24,8 +24,12 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Integration/UniformTSDFVolume.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -51,6 +55,122 @@ TEST(UniformTSDFVolume, DISABLED_Reset) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 TEST(UniformTSDFVolume, DISABLED_Integrate) { unit_test::NotImplemented(); }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(UniformTSDFVolume, IntegrateCompact) {
+    camera::PinholeCameraIntrinsic intrinsic(64, 48, 50.0, 50.0, 31.5, 23.5);
+    geometry::RGBDImage image;
+    image.depth_.PrepareImage(intrinsic.width_, intrinsic.height_, 1, 4);
+    image.color_.PrepareImage(intrinsic.width_, intrinsic.height_, 3, 1);
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            *geometry::PointerAt<float>(image.depth_, u, v) =
+                    1.0f + 0.002f * u;
+            for (int c = 0; c < 3; c++) {
+                *geometry::PointerAt<uint8_t>(image.color_, u, v, c) =
+                        (uint8_t)(u + v + 50 * c);
+            }
+        }
+    }
+
+    integration::UniformTSDFVolume volume(
+            1.6, 64, 0.1, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-0.8, -0.8, 0.4));
+    integration::UniformTSDFVolume volume_compact(
+            1.6, 64, 0.1, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-0.8, -0.8, 0.4),
+            integration::TSDFVolumeStorageType::Compact);
+    EXPECT_TRUE(volume_compact.tsdf_.empty());
+    EXPECT_TRUE(volume_compact.weight_.empty());
+    EXPECT_TRUE(volume_compact.color_.empty());
+    EXPECT_EQ(volume_compact.voxel_num_,
+              (int)volume_compact.tsdf_compact_.size());
+
+    for (int i = 0; i < 3; i++) {
+        volume.Integrate(image, intrinsic, Eigen::Matrix4d::Identity());
+        volume_compact.Integrate(image, intrinsic,
+                                 Eigen::Matrix4d::Identity());
+    }
+    for (int i = 0; i < volume.voxel_num_; i++) {
+        EXPECT_EQ(volume.GetWeight(i), volume_compact.GetWeight(i));
+        EXPECT_NEAR(volume.GetTSDF(i), volume_compact.GetTSDF(i), 1e-4);
+        for (int c = 0; c < 3; c++) {
+            EXPECT_NEAR(volume.GetColor(i)(c), volume_compact.GetColor(i)(c),
+                        1.0);
+        }
+    }
+
+    auto mesh = volume.ExtractTriangleMesh();
+    auto mesh_compact = volume_compact.ExtractTriangleMesh();
+    EXPECT_FALSE(mesh->triangles_.empty());
+    EXPECT_EQ(mesh->triangles_.size(), mesh_compact->triangles_.size());
+    EXPECT_EQ(mesh->vertices_.size(), mesh_compact->vertices_.size());
+    for (size_t i = 0; i < mesh->vertices_.size(); i++) {
+        EXPECT_LE((mesh->vertices_[i] - mesh_compact->vertices_[i]).norm(),
+                  1e-4);
+    }
+
+    volume_compact.Reset();
+    for (int i = 0; i < volume_compact.voxel_num_; i++) {
+        EXPECT_EQ(0.0f, volume_compact.GetWeight(i));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(UniformTSDFVolume, IntegrateCompactSlowColorChange) {
+    camera::PinholeCameraIntrinsic intrinsic(32, 24, 25.0, 25.0, 15.5, 11.5);
+    geometry::RGBDImage image;
+    image.depth_.PrepareImage(intrinsic.width_, intrinsic.height_, 1, 4);
+    image.color_.PrepareImage(intrinsic.width_, intrinsic.height_, 3, 1);
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            *geometry::PointerAt<float>(image.depth_, u, v) = 1.0f;
+        }
+    }
+
+    integration::UniformTSDFVolume volume(
+            1.6, 32, 0.1, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-0.8, -0.8, 0.4));
+    integration::UniformTSDFVolume volume_compact(
+            1.6, 32, 0.1, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-0.8, -0.8, 0.4),
+            integration::TSDFVolumeStorageType::Compact);
+
+    // The color rises by a quarter of a level per frame, far less than the
+    // rounding step of a long running average.
+    int num_frames = 600;
+    uint8_t gray = 0;
+    for (int k = 0; k < num_frames; k++) {
+        gray = (uint8_t)(50 + k / 4);
+        for (int v = 0; v < intrinsic.height_; v++) {
+            for (int u = 0; u < intrinsic.width_; u++) {
+                for (int c = 0; c < 3; c++) {
+                    *geometry::PointerAt<uint8_t>(image.color_, u, v, c) =
+                            gray;
+                }
+            }
+        }
+        volume.Integrate(image, intrinsic, Eigen::Matrix4d::Identity());
+        volume_compact.Integrate(image, intrinsic,
+                                 Eigen::Matrix4d::Identity());
+    }
+
+    int num_observed = 0;
+    for (int i = 0; i < volume_compact.voxel_num_; i++) {
+        if (volume_compact.GetWeight(i) == (float)num_frames) {
+            num_observed++;
+            EXPECT_NEAR(volume.GetTSDF(i), volume_compact.GetTSDF(i), 1e-4);
+            for (int c = 0; c < 3; c++) {
+                EXPECT_NEAR((float)gray, volume_compact.GetColor(i)(c), 8.0f);
+            }
+        }
+    }
+    EXPECT_LT(0, num_observed);
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -24,12 +24,159 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cmath>
+#include <cstdio>
+
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/IO/ClassIO/ImageIO.h"
+#include "Open3D/Odometry/Odometry.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+const int width = 64;
+const int height = 48;
+
+// Fronto-parallel plane at depth 1 with a smooth intensity pattern, seen by a
+// camera translated by \param shift along x (in plane units).
+geometry::RGBDImage CreatePlaneImage(double shift) {
+    geometry::RGBDImage image;
+    image.color_.PrepareImage(width, height, 1, 4);
+    image.depth_.PrepareImage(width, height, 1, 4);
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            double x = (u - 32.0) / 50.0 + shift;
+            double y = (v - 24.0) / 50.0;
+            *geometry::PointerAt<float>(image.color_, u, v) =
+                    (float)(0.5 + 0.2 * sin(10.0 * x) * cos(8.0 * y));
+            *geometry::PointerAt<float>(image.depth_, u, v) = 1.0f;
+        }
+    }
+    return image;
+}
+
+// Frame \param index of the RGBD sequence of the test data.
+geometry::RGBDImage ReadTestRGBDImage(int index) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "%05d", index);
+    geometry::Image color;
+    geometry::Image depth;
+    io::ReadImage(string(TEST_DATA_DIR) + "/RGBD/color/" + suffix + ".jpg",
+                  color);
+    io::ReadImage(string(TEST_DATA_DIR) + "/RGBD/depth/" + suffix + ".png",
+                  depth);
+    return *geometry::CreateRGBDImageFromColorAndDepth(color, depth);
+}
+
+// Jacobians of a type other than the built-in ones run through the generic,
+// non-fused iteration.
+class GenericColorTerm : public odometry::RGBDOdometryJacobianFromColorTerm {};
+class GenericHybridTerm : public odometry::RGBDOdometryJacobianFromHybridTerm {
+};
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Odometry, DISABLED_ComputeRGBDOdometry) { unit_test::NotImplemented(); }
+TEST(Odometry, ComputeRGBDOdometry) {
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 50.0, 50.0, 32.0,
+                                             24.0);
+    geometry::RGBDImage source = CreatePlaneImage(0.0);
+    geometry::RGBDImage target = CreatePlaneImage(0.02);
+
+    bool is_success;
+    Matrix4d transformation;
+    Matrix6d information;
+    tie(is_success, transformation, information) =
+            odometry::ComputeRGBDOdometry(source, target, intrinsic);
+
+    EXPECT_TRUE(is_success);
+    EXPECT_NEAR(-0.02, transformation(0, 3), 2e-3);
+    EXPECT_NEAR(0.0, transformation(1, 3), 2e-3);
+    EXPECT_NEAR(0.0, transformation(2, 3), 2e-3);
+    EXPECT_GT(information(0, 0), 1.0);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Odometry, ComputeRGBDOdometryFused) {
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 50.0, 50.0, 32.0,
+                                             24.0);
+    geometry::RGBDImage source = CreatePlaneImage(0.0);
+    geometry::RGBDImage target = CreatePlaneImage(0.02);
+
+    vector<pair<shared_ptr<odometry::RGBDOdometryJacobian>,
+                shared_ptr<odometry::RGBDOdometryJacobian>>>
+            jacobians = {
+                    {make_shared<odometry::RGBDOdometryJacobianFromColorTerm>(),
+                     make_shared<GenericColorTerm>()},
+                    {make_shared<
+                             odometry::RGBDOdometryJacobianFromHybridTerm>(),
+                     make_shared<GenericHybridTerm>()}};
+    for (const auto &jacobian : jacobians) {
+        auto fused = odometry::ComputeRGBDOdometry(
+                source, target, intrinsic, Matrix4d::Identity(),
+                *jacobian.first);
+        auto generic = odometry::ComputeRGBDOdometry(
+                source, target, intrinsic, Matrix4d::Identity(),
+                *jacobian.second);
+
+        EXPECT_TRUE(get<0>(fused));
+        EXPECT_EQ(get<0>(generic), get<0>(fused));
+        ExpectEQ(get<1>(generic), get<1>(fused));
+        ExpectEQ(get<2>(generic), get<2>(fused));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Odometry, RGBDOdometry) {
+    camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    odometry::OdometryOption option;
+
+    // Poses of the first frames of the test sequence, computed by the
+    // ComputeRGBDOdometry function before it was built on RGBDOdometry.
+    vector<Matrix4d> refs(2);
+    refs[0] << 0.99999297333431347, -0.00025108454104869928,
+            -0.0037403527309120216, -0.0010704977538333134,
+            0.0002070460589652734, 0.99993071415671775, -0.011769622677262202,
+            0.023228098289690587, 0.0037430487477271251, 0.011768765550766315,
+            0.99992373996394501, 0.0014059205369120363, 0.0, 0.0, 0.0, 1.0;
+    refs[1] << 0.99999524800912509, -0.00011040615811570866,
+            -0.0030808715729903737, -0.0019257921629968564,
+            7.2467980107040445e-05, 0.99992420796948001, -0.012311501330166841,
+            0.024168323825830684, 0.003081997333040579, 0.012311219561484997,
+            0.99991946433967738, 0.0024352482630096255, 0.0, 0.0, 0.0, 1.0;
+
+    // Track the sequence with one odometry object, each frame being created
+    // once.
+    odometry::RGBDOdometry odometry(intrinsic, option);
+    auto frame = odometry.CreateFrame(ReadTestRGBDImage(0));
+    EXPECT_FALSE(frame->IsEmpty());
+    for (int i = 1; i <= (int)refs.size(); i++) {
+        auto next_frame = odometry.CreateFrame(ReadTestRGBDImage(i));
+        auto result = odometry.Compute(*frame, *next_frame);
+
+        EXPECT_TRUE(get<0>(result));
+        EXPECT_NEAR(0.0, (get<1>(result) - refs[i - 1]).cwiseAbs().maxCoeff(),
+                    THRESHOLD_1E_6);
+        frame = next_frame;
+    }
+
+    geometry::RGBDImage unsupported;
+    unsupported.color_.PrepareImage(width, height, 3, 1);
+    unsupported.depth_.PrepareImage(width, height, 1, 4);
+    EXPECT_TRUE(odometry.CreateFrame(unsupported)->IsEmpty());
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -24,8 +24,35 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/ColoredICP.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Plane z = 0 whose gray level increases linearly along x and y.
+geometry::PointCloud CreateColoredPlane(int size) {
+    geometry::PointCloud pc;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            double x = i * 0.1;
+            double y = j * 0.1;
+            double gray = 0.1 + 0.2 * x + 0.1 * y;
+            pc.points_.push_back(Vector3d(x, y, 0.0));
+            pc.normals_.push_back(Vector3d(0.0, 0.0, 1.0));
+            pc.colors_.push_back(Vector3d(gray, gray, gray));
+        }
+    }
+    return pc;
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -33,6 +60,64 @@ TEST(ColoredICP, DISABLED_RegistrationColoredICP) {
     unit_test::NotImplemented();
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ColoredICP, ComputeColorGradients) {
+    int size = 20;
+    geometry::PointCloud pc = CreateColoredPlane(size);
+
+    auto gradients = registration::ComputeColorGradients(
+            pc, geometry::KDTreeSearchParamHybrid(0.25, 30));
+
+    EXPECT_EQ(pc.points_.size(), gradients.size());
+    for (size_t i = 0; i < gradients.size(); i++) {
+        ExpectEQ(Vector3d(0.2, 0.1, 0.0), gradients[i]);
+    }
+
+    // without colors the gradients are zero
+    pc.colors_.clear();
+    gradients = registration::ComputeColorGradients(
+            pc, geometry::KDTreeSearchParamHybrid(0.25, 30));
+    EXPECT_EQ(pc.points_.size(), gradients.size());
+    for (size_t i = 0; i < gradients.size(); i++) {
+        ExpectEQ(Zero3d, gradients[i]);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ColoredICP, RegistrationColoredICPWithColorGradients) {
+    int size = 20;
+    geometry::PointCloud target = CreateColoredPlane(size);
+    geometry::PointCloud source = target;
+    Matrix4d init = Matrix4d::Identity();
+    init.block<3, 1>(0, 3) = Vector3d(0.02, -0.01, 0.01);
+
+    double max_distance = 0.1;
+    auto gradients = registration::ComputeColorGradients(
+            target,
+            geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+
+    auto result = registration::RegistrationColoredICP(source, target,
+                                                       max_distance, init);
+    auto cached_result = registration::RegistrationColoredICP(
+            source, target, gradients, max_distance, init);
+
+    ExpectEQ(Matrix4d(result.transformation_),
+             Matrix4d(cached_result.transformation_));
+    EXPECT_EQ(result.fitness_, cached_result.fitness_);
+    EXPECT_EQ(result.inlier_rmse_, cached_result.inlier_rmse_);
+    EXPECT_NEAR(1.0, cached_result.fitness_, 1e-6);
+
+    // gradients of another point cloud are rejected
+    gradients.pop_back();
+    auto invalid_result = registration::RegistrationColoredICP(
+            source, target, gradients, max_distance, init);
+    ExpectEQ(init, Matrix4d(invalid_result.transformation_));
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -24,8 +24,19 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/FastGlobalRegistration.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -53,3 +64,47 @@ TEST(FastGlobalRegistration, DISABLED_Constructor) {
 TEST(FastGlobalRegistration, DISABLED_MemberData) {
     unit_test::NotImplemented();
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FastGlobalRegistration, FastGlobalRegistration) {
+    int size = 1000;
+    int dimension = 33;
+
+    vector<Vector3d> points(size);
+    Rand(points, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    vector<double> values(size * dimension);
+    Rand(values, 0.0, 100.0, 1);
+
+    geometry::PointCloud source;
+    source.points_ = points;
+    registration::Feature source_feature;
+    source_feature.Resize(dimension, size);
+    for (int i = 0; i < size; i++) {
+        for (int k = 0; k < dimension; k++) {
+            source_feature.data_(k, i) = values[i * dimension + k];
+        }
+    }
+
+    Matrix4d transformation = Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            AngleAxisd(0.8, Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Vector3d(1.0, -2.0, 0.5);
+    geometry::PointCloud target = source;
+    target.Transform(transformation);
+    registration::Feature target_feature = source_feature;
+
+    registration::FastGlobalRegistrationOption option;
+    option.seed_ = 7;
+    auto result = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    Matrix4d estimated = result.transformation_;
+    EXPECT_NEAR(0.0, (estimated - transformation).cwiseAbs().maxCoeff(), 1e-3);
+
+    auto repeated = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    ExpectEQ(Matrix4d(result.transformation_),
+             Matrix4d(repeated.transformation_));
+}
@@ -24,8 +24,18 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cmath>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -44,7 +54,156 @@ TEST(Feature, DISABLED_Num) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Feature, DISABLED_ComputeFPFHFeature) { unit_test::NotImplemented(); }
+TEST(Feature, ComputeFPFHFeature) {
+    // A smooth surface sampled on a grid, with its exact normals.
+    geometry::PointCloud pc;
+    for (int v = 0; v < 20; v++) {
+        for (int u = 0; u < 20; u++) {
+            double x = 0.25 * u;
+            double y = 0.25 * v;
+            pc.points_.push_back(Vector3d(x, y, sin(x) * cos(y)));
+            pc.normals_.push_back(
+                    Vector3d(-cos(x) * cos(y), sin(x) * sin(y), 1.0)
+                            .normalized());
+        }
+    }
+
+    auto feature = registration::ComputeFPFHFeature(
+            pc, geometry::KDTreeSearchParamHybrid(0.6, 100));
+    EXPECT_EQ(33u, feature->Dimension());
+    EXPECT_EQ(pc.points_.size(), feature->Num());
+
+    // Features of two corners and two inner points, recorded from the
+    // implementation that binned the acos of the pair features.
+    vector<pair<int, vector<double>>> refs = {
+            {0,
+             {0.0, 0.0, 0.0, 0.0, 0.0, 199.4114976, 0.5885023597, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 187.0976073, 12.90239267, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 14.90270942, 184.5087882,
+              0.5885023597, 0.0, 0.0, 0.0, 0.0}},
+            {105,
+             {0.0, 0.0, 0.0, 0.0, 0.0, 183.7056632, 16.29433681, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0, 0.5598897873, 26.9093607, 162.3575928,
+              9.922534264, 0.2506224793, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+              44.38034634, 153.0575661, 2.562087523, 0.0, 0.0, 0.0, 0.0}},
+            {210,
+             {0.0, 0.0, 0.0, 0.0, 41.4330799, 158.5669201, 0.0, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0, 2.386987075, 48.97962748, 99.34143494,
+              47.48252375, 1.809426755, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+              0.9356547627, 102.1111919, 96.95315332, 0.0, 0.0, 0.0, 0.0}},
+            {399,
+             {0.0, 0.0, 0.0, 0.0, 0.0, 200.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+              0.0, 0.0, 11.43353691, 188.5664631, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 13.37805885, 186.6219411, 0.0, 0.0, 0.0, 0.0,
+              0.0}}};
+
+    for (const auto &ref : refs) {
+        for (int j = 0; j < 33; j++) {
+            EXPECT_NEAR(ref.second[j], feature->data_(j, ref.first), 1e-6);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Feature, ComputeCompactFPFHFeature) {
+    int size = 1000;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+    geometry::EstimateNormals(pc, geometry::KDTreeSearchParamKNN(10));
+
+    geometry::KDTreeSearchParamHybrid param(2.0, 30);
+    auto feature = registration::ComputeFPFHFeature(pc, param);
+    auto compact = registration::ComputeCompactFPFHFeature(pc, param);
+
+    EXPECT_EQ(33u, compact->Dimension());
+    EXPECT_EQ((size_t)size, compact->Num());
+    for (int i = 0; i < size; i++) {
+        // each of the three sub-histograms of a point with neighbors sums to
+        // 200: 100 from its own SPFH and 100 from its weighted neighbors
+        for (int b = 0; b < 3; b++) {
+            double sum = compact->data_.col(i).segment(b * 11, 11).sum();
+            if (sum != 0.0) {
+                EXPECT_NEAR(200.0, sum, 1e-3);
+            }
+        }
+        for (int j = 0; j < 33; j++) {
+            EXPECT_NEAR(feature->data_(j, i), compact->data_(j, i), 1e-4);
+        }
+    }
+
+    // without normals both features are all zeros
+    pc.normals_.clear();
+    compact = registration::ComputeCompactFPFHFeature(pc, param);
+    EXPECT_EQ((size_t)size, compact->Num());
+    EXPECT_EQ(0.0f, compact->data_.cwiseAbs().maxCoeff());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Feature, CompactFeatureKDTreeFlann) {
+    int size = 500;
+    int dimension = 33;
+
+    registration::Feature feature;
+    feature.Resize(dimension, size);
+    Rand(feature.data_.data(), dimension * size, 0.0, 100.0, 0);
+
+    registration::CompactFeature compact(feature);
+    EXPECT_EQ(feature.Dimension(), compact.Dimension());
+    EXPECT_EQ(feature.Num(), compact.Num());
+
+    auto converted = compact.ToFeature();
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < dimension; j++) {
+            EXPECT_NEAR(feature.data_(j, i), converted->data_(j, i), 1e-4);
+        }
+    }
+
+    geometry::KDTreeFlann kdtree(feature);
+    geometry::KDTreeFlann compact_kdtree(compact);
+
+    MatrixXd queries = converted->data_.leftCols(50);
+    int knn = 5;
+    geometry::KDTreeSearchResult neighbors;
+    int result = compact_kdtree.SearchKNNBatch(queries, knn, neighbors);
+    EXPECT_EQ(knn * (int)queries.cols(), result);
+
+    for (int i = 0; i < (int)queries.cols(); i++) {
+        VectorXd query = queries.col(i);
+        vector<int> indices;
+        vector<double> distance2;
+        vector<int> compact_indices;
+        vector<double> compact_distance2;
+        kdtree.SearchKNN(query, knn, indices, distance2);
+        compact_kdtree.SearchKNN(query, knn, compact_indices,
+                                 compact_distance2);
+
+        // the query is a point of the dataset
+        EXPECT_EQ(i, compact_indices[0]);
+        ExpectEQ(indices, compact_indices);
+        ExpectEQ(compact_indices,
+                 vector<int>(neighbors.GetIndices(i),
+                             neighbors.GetIndices(i) +
+                                     neighbors.GetNeighborCount(i)));
+        for (int k = 0; k < knn; k++) {
+            EXPECT_NEAR(distance2[k], compact_distance2[k],
+                        1e-4 * distance2[k] + 1e-3);
+        }
+
+        compact_kdtree.SearchHybrid(query, 1e-3, 1, compact_indices,
+                                    compact_distance2);
+        ExpectEQ(vector<int>{i}, compact_indices);
+    }
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -24,8 +24,57 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Dense>
+
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/Registration/GlobalOptimization.h"
+#include "Open3D/Registration/PoseGraph.h"
+#include "Open3D/Utility/Eigen.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// A loop of poses connected by odometry edges and a few loop closures. The
+// node poses are perturbed away from the poses the edges agree on.
+std::tuple<registration::PoseGraph, std::vector<Eigen::Matrix4d>>
+CreateTestPoseGraph(int n_nodes) {
+    std::vector<Eigen::Matrix4d> poses(n_nodes);
+    for (int i = 0; i < n_nodes; i++) {
+        double angle = 2.0 * M_PI * i / n_nodes;
+        Eigen::Vector6d pose;
+        pose << 0.05 * sin(angle), 0.02 * cos(angle), angle, 2.0 * cos(angle),
+                2.0 * sin(angle), 0.1 * sin(2.0 * angle);
+        poses[i] = utility::TransformVector6dToMatrix4d(pose);
+    }
+
+    registration::PoseGraph pose_graph;
+    for (int i = 0; i < n_nodes; i++) {
+        Eigen::Vector6d noise;
+        noise << 0.01 * sin(i), 0.01 * cos(i), 0.02 * sin(2 * i),
+                0.03 * cos(3 * i), 0.03 * sin(3 * i), 0.02 * cos(i);
+        Eigen::Matrix4d pose = i == 0 ? poses[i]
+                                      : utility::TransformVector6dToMatrix4d(
+                                                noise) *
+                                                poses[i];
+        pose_graph.nodes_.push_back(registration::PoseGraphNode(pose));
+    }
+    Eigen::Matrix6d information = Eigen::Matrix6d::Identity() * 100.0;
+    for (int i = 0; i < n_nodes; i++) {
+        for (int j : {i + 1, i + 5}) {
+            if (j >= n_nodes) continue;
+            pose_graph.edges_.push_back(registration::PoseGraphEdge(
+                    i, j, poses[j].inverse() * poses[i], information,
+                    j != i + 1));
+        }
+    }
+    return std::make_tuple(pose_graph, poses);
+}
+
+}  // namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -39,8 +88,106 @@ TEST(GlobalOptimization, DISABLED_MemberData) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(GlobalOptimization, DISABLED_GlobalOptimizationLevenbergMarquardt) {
-    unit_test::NotImplemented();
+TEST(GlobalOptimization, GlobalOptimizationLevenbergMarquardt) {
+    registration::PoseGraph pose_graph;
+    std::vector<Eigen::Matrix4d> poses;
+    std::tie(pose_graph, poses) = CreateTestPoseGraph(30);
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationLevenbergMarquardt(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption(0.03, 0.25, 0.1, 0));
+
+    EXPECT_EQ(30u, pose_graph.nodes_.size());
+    EXPECT_EQ(54u, pose_graph.edges_.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        EXPECT_TRUE(pose_graph.nodes_[i].pose_.isApprox(poses[i], 1e-4));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, GlobalOptimizationLevenbergMarquardt_Reference) {
+    registration::PoseGraph pose_graph;
+    std::vector<Eigen::Matrix4d> poses;
+    std::tie(pose_graph, poses) = CreateTestPoseGraph(8);
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationLevenbergMarquardt(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption(0.03, 0.25, 0.1, 0));
+
+    // Node poses, as TransformMatrix4dToVector6d, found by the dense solver
+    // the block-sparse system replaced.
+    std::vector<std::vector<double>> refs = {
+            {0.0, 0.02, 0.0, 2.0, 0.0, 0.0},
+            {0.0353553030459, 0.0141421293157, 0.785398155214, 1.41421359693,
+             1.41421364872, 0.100000019208},
+            {0.049999925823, 2.45372913418e-08, 1.57079630984,
+             1.59867999785e-07, 2.000000173, -7.19374160069e-08},
+            {0.0353552590796, -0.0141420761571, 2.35619450903, -1.41421328062,
+             1.41421375651, -0.100000229738},
+            {-4.61439960178e-08, -0.0199999471503, -3.14159263046,
+             -1.99999984043, 6.50855526616e-08, -9.41126058894e-08},
+            {-0.0353553542859, -0.0141421282302, -2.35619453758, -1.41421359966,
+             -1.4142133334, 0.0999998666761},
+            {-0.0499999818201, -1.11503199525e-08, -1.57079633374,
+             1.78711202434e-08, -1.99999971972, -1.35330321954e-07},
+            {-0.0353553556725, 0.014142049958, -0.785398152354, 1.41421358164,
+             -1.41421328714, -0.100000112265}};
+
+    ASSERT_EQ(refs.size(), pose_graph.nodes_.size());
+    for (size_t i = 0; i < refs.size(); i++) {
+        Eigen::Vector6d pose = utility::TransformMatrix4dToVector6d(
+                pose_graph.nodes_[i].pose_);
+        for (int k = 0; k < 6; k++) {
+            EXPECT_NEAR(refs[i][k], pose(k), THRESHOLD_1E_6);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, GlobalOptimizationLevenbergMarquardt_TestPoseGraph) {
+    registration::PoseGraph pose_graph;
+    ASSERT_TRUE(io::ReadPoseGraph(
+            std::string(TEST_DATA_DIR) + "/test_pose_graph.json", pose_graph));
+    const registration::PoseGraph ref = pose_graph;
+
+    // The random edges of the test graph reference a node it does not have,
+    // so the graph fails validation and the nodes are left as they are, as
+    // with the dense solver.
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationLevenbergMarquardt(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption());
+
+    ASSERT_EQ(ref.nodes_.size(), pose_graph.nodes_.size());
+    for (size_t i = 0; i < ref.nodes_.size(); i++) {
+        ExpectEQ(ref.nodes_[i].pose_, pose_graph.nodes_[i].pose_);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, GlobalOptimizationGaussNewton) {
+    registration::PoseGraph pose_graph;
+    std::vector<Eigen::Matrix4d> poses;
+    std::tie(pose_graph, poses) = CreateTestPoseGraph(30);
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationGaussNewton(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption(0.03, 0.25, 0.1, 0));
+
+    EXPECT_EQ(30u, pose_graph.nodes_.size());
+    EXPECT_EQ(54u, pose_graph.edges_.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        EXPECT_TRUE(pose_graph.nodes_[i].pose_.isApprox(poses[i], 1e-4));
+    }
 }
 
 // ----------------------------------------------------------------------------
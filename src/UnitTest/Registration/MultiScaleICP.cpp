@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/MultiScaleICP.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Colored points on the faces of a cube and their copy under a small rigid
+// transformation.
+Matrix4d CreateCubePair(geometry::PointCloud &source,
+                        geometry::PointCloud &target,
+                        int size) {
+    vector<Vector3d> samples(size);
+    Rand(samples, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    for (int i = 0; i < size; i++) {
+        int axis = i % 3;
+        Vector3d point = samples[i];
+        point(axis) = (i / 3) % 2 == 0 ? 0.0 : 10.0;
+        double gray = 0.5 + 0.4 * sin(point(0)) * cos(point(1) + point(2));
+        source.points_.push_back(point);
+        source.colors_.push_back(Vector3d(gray, gray, gray));
+    }
+    Matrix4d transformation = Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            AngleAxisd(0.02, Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Vector3d(0.2, -0.3, 0.1);
+    target = source;
+    target.Transform(transformation);
+    return transformation;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(MultiScaleICP, MultiScalePointCloud) {
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    CreateCubePair(source, target, 20000);
+
+    vector<double> voxel_sizes = {1.0, 0.5, 0.25};
+    registration::MultiScalePointCloud msc(source, voxel_sizes);
+
+    EXPECT_EQ(voxel_sizes.size(), msc.GetLevelCount());
+    EXPECT_TRUE(msc.HasColorGradients());
+    ExpectEQ(voxel_sizes, msc.voxel_sizes_);
+    for (size_t i = 0; i < msc.GetLevelCount(); i++) {
+        const auto &level = *msc.levels_[i];
+        EXPECT_TRUE(level.HasNormals());
+        EXPECT_EQ(level.points_.size(), msc.color_gradients_[i].size());
+        if (i > 0) {
+            EXPECT_LT(msc.levels_[i - 1]->points_.size(),
+                      level.points_.size());
+        }
+    }
+
+    // without colors no gradients are computed
+    source.colors_.clear();
+    msc.Create(source, voxel_sizes);
+    EXPECT_EQ(voxel_sizes.size(), msc.GetLevelCount());
+    EXPECT_FALSE(msc.HasColorGradients());
+
+    EXPECT_FALSE(msc.Create(source, {1.0, 0.0}));
+    EXPECT_EQ(0u, msc.GetLevelCount());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(MultiScaleICP, RegistrationMultiScaleICP) {
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    Matrix4d ref = CreateCubePair(source, target, 20000);
+
+    vector<double> voxel_sizes = {1.0, 0.5, 0.25};
+    registration::MultiScalePointCloud source_msc(source, voxel_sizes);
+    registration::MultiScalePointCloud target_msc(target, voxel_sizes);
+
+    vector<double> distances = {2.0, 1.0, 0.5};
+    vector<registration::ICPConvergenceCriteria> criteria = {
+            registration::ICPConvergenceCriteria(1e-6, 1e-6, 50),
+            registration::ICPConvergenceCriteria(1e-6, 1e-6, 30),
+            registration::ICPConvergenceCriteria(1e-6, 1e-6, 14)};
+
+    auto result = registration::RegistrationMultiScaleICP(
+            source_msc, target_msc, distances, criteria);
+    Matrix4d transformation = result.transformation_;
+    EXPECT_NEAR(0.0, (transformation - ref).cwiseAbs().maxCoeff(), 1e-2);
+    EXPECT_GT(result.fitness_, 0.9);
+    EXPECT_FALSE(result.correspondence_set_.empty());
+
+    auto colored = registration::RegistrationMultiScaleColoredICP(
+            source_msc, target_msc, distances, criteria);
+    transformation = colored.transformation_;
+    EXPECT_NEAR(0.0, (transformation - ref).cwiseAbs().maxCoeff(), 1e-2);
+
+    // the number of levels must match
+    distances.pop_back();
+    auto invalid = registration::RegistrationMultiScaleICP(
+            source_msc, target_msc, distances, criteria, ref);
+    ExpectEQ(ref, Matrix4d(invalid.transformation_));
+}
@@ -24,8 +24,109 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Create a random source cloud and its copy under a rigid transformation.
+Eigen::Matrix4d CreateRegistrationPair(geometry::PointCloud &source,
+                                       geometry::PointCloud &target,
+                                       int size) {
+    Eigen::Vector3d vmin(0.0, 0.0, 0.0);
+    Eigen::Vector3d vmax(10.0, 10.0, 10.0);
+    source.points_.resize(size);
+    Rand(source.points_, vmin, vmax, 0);
+
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.3, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(1.0, -2.0, 0.5);
+    target = source;
+    target.Transform(transformation);
+    return transformation;
+}
+
+// Point-to-plane estimation counting the calls of ComputeTransformation.
+class CountingPointToPlane
+    : public registration::TransformationEstimationPointToPlane {
+public:
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const registration::CorrespondenceSet &corres) const override {
+        num_calls_++;
+        return registration::TransformationEstimationPointToPlane::
+                ComputeTransformation(source, target, corres);
+    }
+
+public:
+    mutable int num_calls_ = 0;
+};
+
+// A 10 x 10 x 4 lattice and its copy under a rigid transformation, without
+// the last x slab. Two feature matches in five are correct and two in five
+// are shifted by one lattice step in x, which is a consistent wrong
+// hypothesis with a geometric overlap of 0.8. The rest are random.
+Eigen::Matrix4d CreateLatticeMatchingPair(
+        geometry::PointCloud &source,
+        geometry::PointCloud &target,
+        registration::Feature &source_feature,
+        registration::Feature &target_feature) {
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            for (int z = 0; z < 4; z++) {
+                source.points_.push_back(Eigen::Vector3d(x, y, z));
+            }
+        }
+    }
+    int size = (int)source.points_.size();
+    int overlap = 360;
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.3, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(1.0, -2.0, 0.5);
+    target = source;
+    target.Transform(transformation);
+    target.points_.resize(overlap);
+
+    int dimension = 8;
+    vector<double> values(overlap * dimension);
+    Rand(values, 0.0, 1.0, 1);
+    target_feature.Resize(dimension, overlap);
+    for (int k = 0; k < overlap; k++) {
+        for (int d = 0; d < dimension; d++) {
+            target_feature.data_(d, k) = values[k * dimension + d];
+        }
+    }
+    source_feature.Resize(dimension, size);
+    for (int i = 0; i < size; i++) {
+        int k = (i * 7 + 13) % overlap;
+        if (i % 5 < 2 && i < overlap) {
+            k = i;
+        } else if (i % 5 < 4 && i + 40 < overlap) {
+            k = i + 40;
+        }
+        source_feature.data_.col(i) = target_feature.data_.col(k);
+    }
+    return transformation;
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -51,8 +152,12 @@ TEST(Registration, DISABLED_MemberData) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Registration, DISABLED_RANSACConvergenceCriteria) {
-    unit_test::NotImplemented();
+TEST(Registration, RANSACConvergenceCriteria) {
+    registration::RANSACConvergenceCriteria criteria;
+
+    EXPECT_EQ(1000, criteria.max_iteration_);
+    EXPECT_EQ(1000, criteria.max_validation_);
+    EXPECT_NEAR(0.999, criteria.confidence_, THRESHOLD_1E_6);
 }
 
 // ----------------------------------------------------------------------------
@@ -72,6 +177,93 @@ TEST(Registration, DISABLED_EvaluateRegistration) {
 // ----------------------------------------------------------------------------
 TEST(Registration, DISABLED_RegistrationICP) { unit_test::NotImplemented(); }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Registration, ICPEngine) {
+    // Points on the faces of a cube, with their normals.
+    int size = 1000;
+    geometry::PointCloud source;
+    vector<Eigen::Vector3d> samples(size);
+    Rand(samples, Eigen::Vector3d(0.0, 0.0, 0.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    for (int i = 0; i < size; i++) {
+        int axis = i % 3;
+        Eigen::Vector3d point = samples[i];
+        point(axis) = (i / 3) % 2 == 0 ? 0.0 : 10.0;
+        Eigen::Vector3d normal = Eigen::Vector3d::Zero();
+        normal(axis) = 1.0;
+        source.points_.push_back(point);
+        source.normals_.push_back(normal);
+    }
+    Eigen::Matrix4d ref = Eigen::Matrix4d::Identity();
+    ref.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.02, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    ref.block<3, 1>(0, 3) = Eigen::Vector3d(0.05, -0.1, 0.05);
+    geometry::PointCloud target = source;
+    target.Transform(ref);
+
+    registration::ICPConvergenceCriteria criteria(1e-9, 1e-9, 100);
+    registration::ICPEngine engine(target);
+
+    auto point_to_plane = engine.Compute(
+            source, 1.0, Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPlane(), criteria);
+    auto point_to_point = engine.Compute(
+            source, 1.0, Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPoint(), criteria);
+    auto repeat = engine.Compute(
+            source, 1.0, Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPlane(), criteria);
+
+    // one iteration of the fused point-to-plane path against the generic
+    // estimation on the same correspondences
+    registration::TransformationEstimationPointToPlane estimation;
+    auto one_step = engine.Compute(source, 1.0, Eigen::Matrix4d::Identity(),
+                                   estimation,
+                                   registration::ICPConvergenceCriteria(
+                                           1e-9, 1e-9, 1));
+    auto corres = registration::EvaluateRegistration(source, target, 1.0)
+                          .correspondence_set_;
+    Eigen::Matrix4d one_step_ref =
+            estimation.ComputeTransformation(source, target, corres);
+
+    ExpectEQ(ref, Eigen::Matrix4d(point_to_plane.transformation_));
+    EXPECT_NEAR(1.0, point_to_plane.fitness_, THRESHOLD_1E_6);
+    EXPECT_NEAR(0.0, point_to_plane.inlier_rmse_, THRESHOLD_1E_6);
+    EXPECT_EQ((size_t)size, point_to_plane.correspondence_set_.size());
+    for (int i = 0; i < size; i++) {
+        EXPECT_EQ(i, point_to_plane.correspondence_set_[i](0));
+    }
+
+    ExpectEQ(ref, Eigen::Matrix4d(point_to_point.transformation_));
+    EXPECT_NEAR(1.0, point_to_point.fitness_, THRESHOLD_1E_6);
+
+    // the buffers reused from the previous calls do not change the result
+    ExpectEQ(Eigen::Matrix4d(point_to_plane.transformation_),
+             Eigen::Matrix4d(repeat.transformation_));
+
+    EXPECT_FALSE(one_step_ref.isIdentity(THRESHOLD_1E_6));
+    EXPECT_NEAR(0.0,
+                (Eigen::Matrix4d(one_step.transformation_) - one_step_ref)
+                        .cwiseAbs()
+                        .maxCoeff(),
+                THRESHOLD_1E_6);
+
+    // a subclass overriding ComputeTransformation is called
+    CountingPointToPlane counting;
+    auto subclassed = engine.Compute(source, 1.0, Eigen::Matrix4d::Identity(),
+                                     counting, criteria);
+    EXPECT_LT(0, counting.num_calls_);
+    ExpectEQ(ref, Eigen::Matrix4d(subclassed.transformation_));
+
+    // without a target the initial transformation is returned
+    registration::ICPEngine empty_engine;
+    auto empty = empty_engine.Compute(source, 1.0, ref);
+    ExpectEQ(ref, Eigen::Matrix4d(empty.transformation_));
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -82,15 +274,130 @@ TEST(Registration, DISABLED_TransformationEstimationPointToPoint) {
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Registration, DISABLED_RegistrationRANSACBasedOnCorrespondence) {
-    unit_test::NotImplemented();
+TEST(Registration, RegistrationRANSACBasedOnCorrespondence) {
+    int size = 200;
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    Eigen::Matrix4d ref = CreateRegistrationPair(source, target, size);
+
+    // Half of the correspondences are outliers.
+    registration::CorrespondenceSet corres(size);
+    for (int i = 0; i < size; i++) {
+        corres[i] = Eigen::Vector2i(i, i % 2 == 0 ? i : (i + 17) % size);
+    }
+
+    registration::TransformationEstimationPointToPoint estimation;
+    registration::RANSACConvergenceCriteria criteria(100000, 100000);
+    auto result = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01, estimation, 3, criteria, 7);
+    auto repeat = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01, estimation, 3, criteria, 7);
+
+    EXPECT_NEAR(0.5, result.fitness_, THRESHOLD_1E_6);
+    ExpectEQ(ref, Eigen::Matrix4d(result.transformation_));
+    ExpectEQ(Eigen::Matrix4d(result.transformation_),
+             Eigen::Matrix4d(repeat.transformation_));
 }
 
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Registration, DISABLED_RegistrationRANSACBasedOnFeatureMatching) {
-    unit_test::NotImplemented();
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatching) {
+    int size = 200;
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    Eigen::Matrix4d ref = CreateRegistrationPair(source, target, size);
+
+    // Features are the source coordinates, so feature matching recovers the
+    // ground truth correspondences.
+    registration::Feature source_feature;
+    source_feature.Resize(3, size);
+    for (int i = 0; i < size; i++) {
+        source_feature.data_.col(i) = source.points_[i];
+    }
+    registration::Feature target_feature = source_feature;
+
+    // Without the adaptive bound this would run a million validations.
+    registration::TransformationEstimationPointToPoint estimation;
+    registration::RANSACConvergenceCriteria criteria(1000000, 1000000);
+    auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01, estimation,
+            4, {}, criteria, 3);
+    auto repeat = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01, estimation,
+            4, {}, criteria, 3);
+
+    EXPECT_NEAR(1.0, result.fitness_, THRESHOLD_1E_6);
+    EXPECT_EQ(size, (int)result.correspondence_set_.size());
+    ExpectEQ(ref, Eigen::Matrix4d(result.transformation_));
+    ExpectEQ(Eigen::Matrix4d(result.transformation_),
+             Eigen::Matrix4d(repeat.transformation_));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatchingWithOutliers) {
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    registration::Feature source_feature;
+    registration::Feature target_feature;
+    Eigen::Matrix4d ref = CreateLatticeMatchingPair(
+            source, target, source_feature, target_feature);
+    int overlap = (int)target.points_.size();
+
+    // Bounding the iterations by the geometric overlap would stop as soon as
+    // the shifted pose is found.
+    registration::TransformationEstimationPointToPoint estimation;
+    registration::RANSACConvergenceCriteria criteria(100000, 100000);
+    auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01, estimation,
+            3, {}, criteria, 6);
+    auto repeat = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01, estimation,
+            3, {}, criteria, 6);
+
+    EXPECT_NEAR(0.9, result.fitness_, THRESHOLD_1E_6);
+    EXPECT_EQ(overlap, (int)result.correspondence_set_.size());
+    ExpectEQ(ref, Eigen::Matrix4d(result.transformation_));
+    ExpectEQ(Eigen::Matrix4d(result.transformation_),
+             Eigen::Matrix4d(repeat.transformation_));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatchingThreadCount) {
+    geometry::PointCloud source;
+    geometry::PointCloud target;
+    registration::Feature source_feature;
+    registration::Feature target_feature;
+    CreateLatticeMatchingPair(source, target, source_feature, target_feature);
+
+    // The preemptive test and the adaptive bound only see hypotheses of
+    // previous blocks, so the result does not depend on the thread count.
+    registration::TransformationEstimationPointToPoint estimation;
+    registration::RANSACConvergenceCriteria criteria(100000, 50);
+    vector<registration::RegistrationResult> results;
+    for (int num_threads : {1, 4}) {
+#ifdef _OPENMP
+        int max_threads = omp_get_max_threads();
+        omp_set_num_threads(num_threads);
+#endif
+        auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+                source, target, source_feature, target_feature, 0.01,
+                estimation, 3, {}, criteria, 11);
+        results.push_back(result);
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads);
+#endif
+    }
+
+    EXPECT_NEAR(results[0].fitness_, results[1].fitness_, THRESHOLD_1E_6);
+    EXPECT_NEAR(results[0].inlier_rmse_, results[1].inlier_rmse_,
+                THRESHOLD_1E_6);
+    ExpectEQ(Eigen::Matrix4d(results[0].transformation_),
+             Eigen::Matrix4d(results[1].transformation_));
 }
 
 // ----------------------------------------------------------------------------